@@ -11,13 +11,16 @@
 
 #pragma once
 
-#include "LRU.h"
+#include "CachePolicy.h"
 #include "utils/Log.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
-#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace milvus {
 namespace cache {
@@ -26,8 +29,11 @@ template <typename ItemObj>
 class Cache {
  public:
     // mem_capacity, units:GB
-    Cache(int64_t capacity_gb, uint64_t cache_max_count);
-    ~Cache() = default;
+    // shard_num: number of independently locked partitions, keys are distributed by hash
+    // policy: eviction policy used by every shard
+    Cache(int64_t capacity_gb, uint64_t cache_max_count, uint64_t shard_num = 1,
+          CachePolicyType policy = CachePolicyType::LRU);
+    ~Cache();
 
     int64_t
     usage() const {
@@ -54,6 +60,39 @@ class Cache {
         freemem_percent_ = percent;
     }
 
+    double
+    high_watermark() const {
+        return high_watermark_;
+    }
+
+    // when usage passes capacity * high_watermark, a background thread frees memory down to
+    // capacity * freemem_percent, and inserting threads only free memory beyond the capacity.
+    // 1.0 disables the background thread, inserting threads then free down to capacity * freemem_percent
+    void
+    set_high_watermark(double percent) {
+        high_watermark_ = percent;
+    }
+
+    uint64_t
+    shard_num() const {
+        return shards_.size();
+    }
+
+    const char*
+    policy_name() const {
+        return shards_[0]->policy_->name();
+    }
+
+    uint64_t
+    hit_count() const {
+        return hit_count_;
+    }
+
+    uint64_t
+    miss_count() const {
+        return miss_count_;
+    }
+
     size_t
     size() const;
 
@@ -76,16 +115,72 @@ class Cache {
     clear();
 
  private:
+    using Entry = CacheEntry<ItemObj>;
+
+    struct CacheShard {
+        CacheShard(size_t max_count, CachePolicyType policy);
+
+        int64_t usage_;
+        size_t max_count_;
+        std::unique_ptr<CachePolicy<ItemObj>> policy_;
+        mutable std::mutex mutex_;
+    };
+
+    CacheShard&
+    shard_of(const std::string& key) const;
+
+    uint64_t
+    next_tick() {
+        return ++tick_;
+    }
+
+    // remove an item of a shard, the caller must hold the shard lock
     void
-    free_memory();
+    erase_locked(CacheShard& shard, const std::string& key);
 
- private:
-    int64_t usage_;
-    int64_t capacity_;
-    double freemem_percent_;
+    // evict the next victim of a shard, the caller must hold the shard lock
+    int64_t
+    evict_one(CacheShard& shard);
+
+    // evict an item of a shard, return 0 if the key doesn't exist any more, the caller must hold the shard lock
+    int64_t
+    evict_locked(CacheShard& shard, const std::string& key);
 
-    LRU<std::string, ItemObj> lru_;
-    mutable std::mutex mutex_;
+    // pick the victim of a shard for releasing 'need' bytes: the first of the next few victims
+    // whose size class isn't larger than that of 'need', so that a big item isn't freed to make room
+    // for a small one; the caller must hold the shard lock
+    const Entry*
+    select_victim(CacheShard& shard, int64_t need, std::string& key);
+
+    // free memory until usage drops to 'target' bytes, the background thread always keeps the last item
+    void
+    free_memory(int64_t target, bool background = false);
+
+    void
+    wake_reclaimer();
+
+    void
+    reclaim_loop();
+
+ private:
+    CachePolicyType policy_type_;
+    std::atomic<int64_t> usage_;
+    std::atomic<int64_t> capacity_;
+    std::atomic<double> freemem_percent_;
+    std::atomic<double> high_watermark_;
+    std::atomic<uint64_t> tick_;
+    std::atomic<uint64_t> hit_count_;
+    std::atomic<uint64_t> miss_count_;
+    std::atomic<int64_t> item_count_;
+
+    std::vector<std::unique_ptr<CacheShard>> shards_;
+    std::mutex free_mutex_;
+
+    std::thread reclaimer_;
+    std::mutex reclaim_mutex_;
+    std::condition_variable reclaim_cv_;
+    bool reclaim_requested_ = false;
+    bool reclaim_stopped_ = false;
 };
 
 }  // namespace cache
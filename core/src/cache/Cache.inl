@@ -9,15 +9,88 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include "cache/LRUPolicy.h"
+#include "cache/TinyLFUPolicy.h"
+#include "cache/TwoQueuePolicy.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 namespace milvus {
 namespace cache {
 
 constexpr double DEFAULT_THRESHHOLD_PERCENT = 0.85;
+constexpr double DEFAULT_HIGH_WATERMARK_PERCENT = 1.0;
+
+// number of victims of a shard examined when picking one by size class
+constexpr size_t VICTIM_CANDIDATE_NUM = 8;
+
+inline int
+size_class(int64_t size) {
+    int cls = 0;
+    for (; size > 0; size >>= 1) {
+        ++cls;
+    }
+    return cls;
+}
+
+template <typename ItemObj>
+Cache<ItemObj>::CacheShard::CacheShard(size_t max_count, CachePolicyType policy) : usage_(0), max_count_(max_count) {
+    switch (policy) {
+        case CachePolicyType::TWO_QUEUE:
+            policy_ = std::make_unique<TwoQueuePolicy<ItemObj>>();
+            break;
+        case CachePolicyType::W_TINY_LFU:
+            policy_ = std::make_unique<TinyLFUPolicy<ItemObj>>();
+            break;
+        default:
+            policy_ = std::make_unique<LRUPolicy<ItemObj>>();
+            break;
+    }
+}
+
+template <typename ItemObj>
+Cache<ItemObj>::Cache(int64_t capacity, uint64_t cache_max_count, uint64_t shard_num, CachePolicyType policy)
+    : policy_type_(policy),
+      usage_(0),
+      capacity_(capacity),
+      freemem_percent_(DEFAULT_THRESHHOLD_PERCENT),
+      high_watermark_(DEFAULT_HIGH_WATERMARK_PERCENT),
+      tick_(0),
+      hit_count_(0),
+      miss_count_(0),
+      item_count_(0) {
+    if (shard_num == 0) {
+        shard_num = 1;
+    }
+
+    // item count limit is split evenly, capacity is a global budget shared by all shards
+    size_t shard_max_count = std::max<uint64_t>(1, (cache_max_count + shard_num - 1) / shard_num);
+    for (uint64_t i = 0; i < shard_num; ++i) {
+        shards_.emplace_back(std::make_unique<CacheShard>(shard_max_count, policy));
+    }
+}
+
+template <typename ItemObj>
+Cache<ItemObj>::~Cache() {
+    {
+        std::lock_guard<std::mutex> lock(reclaim_mutex_);
+        reclaim_stopped_ = true;
+    }
+    reclaim_cv_.notify_all();
+    if (reclaimer_.joinable()) {
+        reclaimer_.join();
+    }
+}
 
 template <typename ItemObj>
-Cache<ItemObj>::Cache(int64_t capacity, uint64_t cache_max_count)
-    : usage_(0), capacity_(capacity), freemem_percent_(DEFAULT_THRESHHOLD_PERCENT), lru_(cache_max_count) {
-    //    AGENT_LOG_DEBUG << "Construct Cache with capacity " << std::to_string(mem_capacity)
+typename Cache<ItemObj>::CacheShard&
+Cache<ItemObj>::shard_of(const std::string& key) const {
+    if (shards_.size() == 1) {
+        return *shards_[0];
+    }
+    return *shards_[std::hash<std::string>()(key) % shards_.size()];
 }
 
 template <typename ItemObj>
@@ -25,33 +98,46 @@ void
 Cache<ItemObj>::set_capacity(int64_t capacity) {
     if (capacity > 0) {
         capacity_ = capacity;
-        free_memory();
+        // only a capacity below the usage evicts, the entries that fit are kept
+        if (usage_ > capacity_) {
+            free_memory(capacity_ * freemem_percent_);
+        }
     }
 }
 
 template <typename ItemObj>
 size_t
 Cache<ItemObj>::size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.size();
+    size_t count = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        count += shard->policy_->size();
+    }
+    return count;
 }
 
 template <typename ItemObj>
 bool
 Cache<ItemObj>::exists(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return lru_.exists(key);
+    CacheShard& shard = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    return shard.policy_->exists(key);
 }
 
 template <typename ItemObj>
 ItemObj
 Cache<ItemObj>::get(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
+    CacheShard& shard = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    Entry* entry = shard.policy_->get(key);
+    if (entry == nullptr) {
+        ++miss_count_;
         return nullptr;
     }
 
-    return lru_.get(key);
+    ++hit_count_;
+    entry->last_access_ = next_tick();
+    return entry->item_;
 }
 
 template <typename ItemObj>
@@ -67,119 +153,238 @@ Cache<ItemObj>::insert(const std::string& key, const ItemObj& item) {
     //        return;
     //    }
 
+    CacheShard& shard = shard_of(key);
+
     // calculate usage
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
 
-        // if key already exist, subtract old item size
-        if (lru_.exists(key)) {
-            const ItemObj& old_item = lru_.get(key);
-            usage_ -= old_item->Size();
-        }
+        // if key already exist, drop the old item so that it can't be counted twice while freeing memory
+        erase_locked(shard, key);
 
         // plus new item size
+        shard.usage_ += item->Size();
         usage_ += item->Size();
     }
 
-    // if usage exceed capacity, free some items
+    // if usage exceed capacity, free some items; with the background reclaimer only the part beyond
+    // capacity is freed here, so that the inserting thread isn't blocked longer than necessary
+    bool background_reclaim = high_watermark_ < 1.0;
     if (usage_ > capacity_) {
         SERVER_LOG_DEBUG << "Current usage " << usage_ << " exceeds cache capacity " << capacity_
                          << ", start free memory";
-        free_memory();
+        free_memory(background_reclaim ? capacity_.load() : (int64_t)(capacity_ * freemem_percent_));
     }
 
     // insert new item
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+
+        // another thread may have inserted the same key in the meantime
+        erase_locked(shard, key);
+
+        // keep the item count limit here, so that evicted items are deducted from usage
+        while (shard.policy_->size() >= shard.max_count_) {
+            evict_one(shard);
+        }
 
-        lru_.put(key, item);
+        shard.policy_->put(key, Entry{item, item->Size(), next_tick()});
+        ++item_count_;
         SERVER_LOG_DEBUG << "Insert " << key << " size: " << item->Size() << " bytes into cache, usage: " << usage_
                          << " bytes," << " capacity: " << capacity_ << " bytes";
     }
+
+    if (background_reclaim && usage_ > capacity_ * high_watermark_) {
+        wake_reclaimer();
+    }
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::erase(const std::string& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!lru_.exists(key)) {
+    CacheShard& shard = shard_of(key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    erase_locked(shard, key);
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::erase_locked(CacheShard& shard, const std::string& key) {
+    Entry old_entry;
+    if (!shard.policy_->erase(key, old_entry)) {
         return;
     }
 
-    const ItemObj& old_item = lru_.get(key);
-    usage_ -= old_item->Size();
+    shard.usage_ -= old_entry.size_;
+    usage_ -= old_entry.size_;
+    --item_count_;
 
-    SERVER_LOG_DEBUG << "Erase " << key << " size: " << old_item->Size() << " bytes from cache, usage: " << usage_
+    SERVER_LOG_DEBUG << "Erase " << key << " size: " << old_entry.size_ << " bytes from cache, usage: " << usage_
                      << " bytes," << " capacity: " << capacity_ << " bytes";
-
-    lru_.erase(key);
 }
 
 template <typename ItemObj>
 void
 Cache<ItemObj>::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    lru_.clear();
-    usage_ = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex_);
+        usage_ -= shard->usage_;
+        item_count_ -= shard->policy_->size();
+        shard->usage_ = 0;
+        shard->policy_->clear();
+    }
     SERVER_LOG_DEBUG << "Clear cache !";
 }
 
+template <typename ItemObj>
+int64_t
+Cache<ItemObj>::evict_one(CacheShard& shard) {
+    std::string key;
+    if (shard.policy_->victim(key) == nullptr) {
+        return 0;
+    }
+    return evict_locked(shard, key);
+}
+
+template <typename ItemObj>
+int64_t
+Cache<ItemObj>::evict_locked(CacheShard& shard, const std::string& key) {
+    if (!shard.policy_->exists(key)) {
+        return 0;
+    }
+
+    Entry entry;
+    shard.policy_->evict(key, entry);
+    shard.usage_ -= entry.size_;
+    usage_ -= entry.size_;
+    --item_count_;
+    return entry.size_;
+}
+
+template <typename ItemObj>
+const typename Cache<ItemObj>::Entry*
+Cache<ItemObj>::select_victim(CacheShard& shard, int64_t need, std::string& key) {
+    typename CachePolicy<ItemObj>::VictimList candidates;
+    shard.policy_->victims(VICTIM_CANDIDATE_NUM, candidates);
+    if (candidates.empty()) {
+        return nullptr;
+    }
+
+    int need_class = size_class(need);
+    for (auto& candidate : candidates) {
+        if (size_class(candidate.second->size_) <= need_class) {
+            key = candidate.first;
+            return candidate.second;
+        }
+    }
+
+    // all of them are bigger than needed, follow the policy order
+    key = candidates[0].first;
+    return candidates[0].second;
+}
+
 /* free memory space when CACHE occupation exceed its capacity */
 template <typename ItemObj>
 void
-Cache<ItemObj>::free_memory() {
-    if (usage_ <= capacity_)
+Cache<ItemObj>::free_memory(int64_t target, bool background) {
+    // only one thread evicts at a time, others see the reduced usage and return directly
+    std::lock_guard<std::mutex> free_lock(free_mutex_);
+    if (usage_ <= target)
         return;
 
-    int64_t threshhold = capacity_ * freemem_percent_;
-    int64_t delta_size = usage_ - threshhold;
-    if (delta_size <= 0) {
-        delta_size = 1;  // ensure at least one item erased
-    }
-
-    std::set<std::string> key_array;
+    int64_t delta_size = usage_ - target;
     int64_t released_size = 0;
 
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
+    // with LRU policy the victim of the shard with the oldest access tick goes first, so that the global LRU
+    // order is kept; other policies only order items of their own shard, and the largest shard is freed first.
+    // victims are sampled once and only the shard being evicted is sampled again, so that the shard locks are
+    // not taken per victim
+    std::vector<int64_t> victim_ranks(shards_.size());
+    std::vector<std::string> victim_keys(shards_.size());
+    auto sample_victim = [&](size_t i) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        const Entry* entry = select_victim(*shards_[i], delta_size - released_size, victim_keys[i]);
+        if (entry == nullptr) {
+            victim_ranks[i] = std::numeric_limits<int64_t>::max();
+        } else if (policy_type_ == CachePolicyType::LRU) {
+            victim_ranks[i] = static_cast<int64_t>(entry->last_access_);
+        } else {
+            victim_ranks[i] = -shards_[i]->usage_;
+        }
+    };
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        sample_victim(i);
+    }
 
-        auto it = lru_.rbegin();
-        while (it != lru_.rend() && released_size < delta_size) {
-            auto& key = it->first;
-            auto& obj_ptr = it->second;
+    while (released_size < delta_size) {
+        // an item larger than the capacity was admitted by insert on purpose, the reclaimer leaves it alone
+        if (background && item_count_ <= 1) {
+            break;
+        }
 
-            key_array.emplace(key);
-            released_size += obj_ptr->Size();
-            ++it;
+        auto first = std::min_element(victim_ranks.begin(), victim_ranks.end());
+        if (*first == std::numeric_limits<int64_t>::max()) {
+            break;
         }
+
+        size_t victim = first - victim_ranks.begin();
+        {
+            std::lock_guard<std::mutex> lock(shards_[victim]->mutex_);
+            released_size += evict_locked(*shards_[victim], victim_keys[victim]);
+        }
+        sample_victim(victim);
     }
 
-    SERVER_LOG_DEBUG << "to be released memory size: " << released_size;
+    SERVER_LOG_DEBUG << "released memory size: " << released_size;
+
+    print();
+}
 
-    for (auto& key : key_array) {
-        erase(key);
+template <typename ItemObj>
+void
+Cache<ItemObj>::wake_reclaimer() {
+    std::lock_guard<std::mutex> lock(reclaim_mutex_);
+    if (reclaim_stopped_) {
+        return;
     }
 
-    print();
+    // the thread is started at the first time memory needs to be freed
+    if (!reclaimer_.joinable()) {
+        reclaimer_ = std::thread(&Cache::reclaim_loop, this);
+    }
+    reclaim_requested_ = true;
+    reclaim_cv_.notify_one();
 }
 
 template <typename ItemObj>
 void
-Cache<ItemObj>::print() {
-    size_t cache_count = 0;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_count = lru_.size();
-#if 0
-        for (auto it = lru_.begin(); it != lru_.end(); ++it) {
-            SERVER_LOG_DEBUG << it->first;
+Cache<ItemObj>::reclaim_loop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(reclaim_mutex_);
+            reclaim_cv_.wait(lock, [this] { return reclaim_requested_ || reclaim_stopped_; });
+            if (reclaim_stopped_) {
+                return;
+            }
+            reclaim_requested_ = false;
         }
-#endif
+
+        free_memory(capacity_ * freemem_percent_, true);
     }
+}
+
+template <typename ItemObj>
+void
+Cache<ItemObj>::print() {
+    size_t cache_count = size();
 
     SERVER_LOG_DEBUG << "[Cache item count]: " << cache_count;
+    SERVER_LOG_DEBUG << "[Cache shard count]: " << shards_.size();
+    SERVER_LOG_DEBUG << "[Cache policy]: " << policy_name();
+    SERVER_LOG_DEBUG << "[Cache hit/miss]: " << hit_count_ << "/" << miss_count_;
     SERVER_LOG_DEBUG << "[Cache usage]: " << usage_ << " bytes";
     SERVER_LOG_DEBUG << "[Cache capacity]: " << capacity_ << " bytes";
+    SERVER_LOG_DEBUG << "[Cache high watermark]: " << high_watermark_;
 }
 
 }  // namespace cache
@@ -54,6 +54,15 @@ class CacheMgr {
     void
     SetCapacity(int64_t capacity);
 
+    uint64_t
+    CacheHitCount() const;
+
+    uint64_t
+    CacheMissCount() const;
+
+    std::string
+    CachePolicyName() const;
+
  protected:
     CacheMgr();
 
@@ -131,5 +131,35 @@ CacheMgr<ItemObj>::SetCapacity(int64_t capacity) {
     cache_->set_capacity(capacity);
 }
 
+template <typename ItemObj>
+uint64_t
+CacheMgr<ItemObj>::CacheHitCount() const {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return 0;
+    }
+    return cache_->hit_count();
+}
+
+template <typename ItemObj>
+uint64_t
+CacheMgr<ItemObj>::CacheMissCount() const {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return 0;
+    }
+    return cache_->miss_count();
+}
+
+template <typename ItemObj>
+std::string
+CacheMgr<ItemObj>::CachePolicyName() const {
+    if (cache_ == nullptr) {
+        SERVER_LOG_ERROR << "Cache doesn't exist";
+        return "";
+    }
+    return cache_->policy_name();
+}
+
 }  // namespace cache
 }  // namespace milvus
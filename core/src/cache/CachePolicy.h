@@ -0,0 +1,99 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace milvus {
+namespace cache {
+
+enum class CachePolicyType {
+    LRU = 0,
+    TWO_QUEUE,
+    W_TINY_LFU,
+};
+
+static const char* CACHE_POLICY_LRU = "lru";
+static const char* CACHE_POLICY_TWO_QUEUE = "2q";
+static const char* CACHE_POLICY_W_TINY_LFU = "tinylfu";
+
+template <typename ItemObj>
+struct CacheEntry {
+    ItemObj item_;
+    int64_t size_;
+    uint64_t last_access_;
+};
+
+// Decides which item of a cache shard is evicted first.
+// A policy only orders entries, the capacity is managed by Cache, and it is not thread safe,
+// the owner shard lock must be held while calling it.
+template <typename ItemObj>
+class CachePolicy {
+ public:
+    using Entry = CacheEntry<ItemObj>;
+    using VictimList = std::vector<std::pair<std::string, const Entry*>>;
+
+    virtual ~CachePolicy() = default;
+
+    virtual const char*
+    name() const = 0;
+
+    virtual bool
+    exists(const std::string& key) const = 0;
+
+    // record an access, return nullptr if the key is not cached
+    virtual Entry*
+    get(const std::string& key) = 0;
+
+    // the key must not exist in the policy
+    virtual void
+    put(const std::string& key, const Entry& entry) = 0;
+
+    // remove an entry on request of user, the removed entry is returned through 'entry'
+    virtual bool
+    erase(const std::string& key, Entry& entry) = 0;
+
+    // the entry to be evicted next, nullptr if the policy is empty
+    virtual const Entry*
+    victim(std::string& key) = 0;
+
+    // up to 'count' entries in eviction order, the first one is victim(); a policy that can't order more
+    // than one item only returns its victim
+    virtual void
+    victims(size_t count, VictimList& result) {
+        std::string key;
+        const Entry* entry = victim(key);
+        if (entry != nullptr && count > 0) {
+            result.emplace_back(key, entry);
+        }
+    }
+
+    // remove an entry returned by victims(), policies may keep some history of evicted keys
+    virtual void
+    evict(const std::string& key, Entry& entry) = 0;
+
+    virtual size_t
+    size() const = 0;
+
+    virtual void
+    clear() = 0;
+
+ protected:
+    static constexpr size_t UNLIMITED = std::numeric_limits<size_t>::max();
+};
+
+}  // namespace cache
+}  // namespace milvus
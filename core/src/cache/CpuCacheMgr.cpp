@@ -14,6 +14,7 @@
 #include "utils/Log.h"
 
 #include <fiu-local.h>
+#include <string>
 #include <utility>
 
 namespace milvus {
@@ -21,7 +22,17 @@ namespace cache {
 
 namespace {
 constexpr int64_t unit = 1024 * 1024 * 1024;
+
+CachePolicyType
+ParsePolicyType(const std::string& policy) {
+    if (policy == CACHE_POLICY_TWO_QUEUE) {
+        return CachePolicyType::TWO_QUEUE;
+    } else if (policy == CACHE_POLICY_W_TINY_LFU) {
+        return CachePolicyType::W_TINY_LFU;
+    }
+    return CachePolicyType::LRU;
 }
+}  // namespace
 
 CpuCacheMgr::CpuCacheMgr() {
     // All config values have been checked in Config::ValidateConfig()
@@ -30,11 +41,20 @@ CpuCacheMgr::CpuCacheMgr() {
     int64_t cpu_cache_cap;
     config.GetCacheConfigCpuCacheCapacity(cpu_cache_cap);
     int64_t cap = cpu_cache_cap * unit;
-    cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32);
+
+    int64_t cpu_cache_shard_num;
+    config.GetCacheConfigCpuCacheShardNum(cpu_cache_shard_num);
+    std::string cpu_cache_policy;
+    config.GetCacheConfigCpuCachePolicy(cpu_cache_policy);
+    cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32, cpu_cache_shard_num, ParsePolicyType(cpu_cache_policy));
 
     float cpu_cache_threshold;
     config.GetCacheConfigCpuCacheThreshold(cpu_cache_threshold);
     cache_->set_freemem_percent(cpu_cache_threshold);
+
+    float cpu_cache_watermark;
+    config.GetCacheConfigCpuCacheWatermark(cpu_cache_watermark);
+    cache_->set_high_watermark(cpu_cache_watermark);
 }
 
 CpuCacheMgr*
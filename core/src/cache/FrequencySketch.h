@@ -0,0 +1,99 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace milvus {
+namespace cache {
+
+// Count-Min sketch with small saturating counters, used by TinyLFU to estimate how often a key was
+// accessed recently. All counters are halved once the number of samples reaches a limit, so that
+// old popularity fades out.
+class FrequencySketch {
+ public:
+    static constexpr int DEPTH = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
+
+    explicit FrequencySketch(size_t width = 1024) {
+        width_ = 1;
+        while (width_ < width) {
+            width_ <<= 1;
+        }
+        table_.assign(DEPTH * width_, 0);
+        sample_limit_ = 10 * width_;
+    }
+
+    void
+    increment(const std::string& key) {
+        uint64_t hash = std::hash<std::string>()(key);
+        bool added = false;
+        for (int i = 0; i < DEPTH; ++i) {
+            uint8_t& counter = table_[i * width_ + index_of(hash, i)];
+            if (counter < MAX_COUNT) {
+                ++counter;
+                added = true;
+            }
+        }
+
+        if (added && ++samples_ >= sample_limit_) {
+            reset();
+        }
+    }
+
+    uint8_t
+    frequency(const std::string& key) const {
+        uint64_t hash = std::hash<std::string>()(key);
+        uint8_t freq = MAX_COUNT;
+        for (int i = 0; i < DEPTH; ++i) {
+            freq = std::min(freq, table_[i * width_ + index_of(hash, i)]);
+        }
+        return freq;
+    }
+
+    void
+    clear() {
+        std::fill(table_.begin(), table_.end(), 0);
+        samples_ = 0;
+    }
+
+ private:
+    size_t
+    index_of(uint64_t hash, int row) const {
+        static const uint64_t SEEDS[DEPTH] = {0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+                                              0xcbf29ce484222325ULL};
+        uint64_t h = (hash + SEEDS[row]) * SEEDS[(row + 1) % DEPTH];
+        h ^= h >> 32;
+        return h & (width_ - 1);
+    }
+
+    void
+    reset() {
+        for (auto& counter : table_) {
+            counter >>= 1;
+        }
+        samples_ /= 2;
+    }
+
+ private:
+    size_t width_;
+    std::vector<uint8_t> table_;
+    size_t samples_ = 0;
+    size_t sample_limit_;
+};
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,40 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "cache/IdCacheMgr.h"
+#include "config/Config.h"
+
+namespace milvus {
+namespace cache {
+
+namespace {
+constexpr int64_t unit = 1024 * 1024 * 1024;
+constexpr uint64_t shard_num = 16;
+}  // namespace
+
+IdCacheMgr::IdCacheMgr() {
+    // All config values have been checked in Config::ValidateConfig()
+    server::Config& config = server::Config::GetInstance();
+
+    int64_t id_cache_cap;
+    config.GetCacheConfigIdCacheCapacity(id_cache_cap);
+    int64_t cap = id_cache_cap * unit;
+    cache_ = std::make_shared<Cache<DataObjPtr>>(cap, 1UL << 32, shard_num, CachePolicyType::LRU);
+}
+
+IdCacheMgr*
+IdCacheMgr::GetInstance() {
+    static IdCacheMgr s_mgr;
+    return &s_mgr;
+}
+
+}  // namespace cache
+}  // namespace milvus
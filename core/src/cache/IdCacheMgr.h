@@ -0,0 +1,36 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "CacheMgr.h"
+#include "DataObj.h"
+
+#include <memory>
+#include <string>
+
+namespace milvus {
+namespace cache {
+
+// Cache of the id lookup structures of segments, bloom filters and id indexes. They are small and read for
+// every segment by search by id, get by id and delete, so they are kept apart from the vector indexes of the
+// cpu cache, whose eviction would drop them. Items are erased when their segment is deleted.
+class IdCacheMgr : public CacheMgr<DataObjPtr> {
+ private:
+    IdCacheMgr();
+
+ public:
+    static IdCacheMgr*
+    GetInstance();
+};
+
+}  // namespace cache
+}  // namespace milvus
@@ -59,6 +59,16 @@ class LRU {
         }
     }
 
+    // same as get(), but doesn't change the order of items
+    value_t&
+    peek(const key_t& key) {
+        auto it = cache_items_map_.find(key);
+        if (it == cache_items_map_.end()) {
+            throw std::range_error("There is no such key in cache");
+        }
+        return it->second->second;
+    }
+
     void
     erase(const key_t& key) {
         auto it = cache_items_map_.find(key);
@@ -0,0 +1,101 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/CachePolicy.h"
+#include "cache/LRU.h"
+
+#include <string>
+
+namespace milvus {
+namespace cache {
+
+template <typename ItemObj>
+class LRUPolicy : public CachePolicy<ItemObj> {
+ public:
+    using Entry = CacheEntry<ItemObj>;
+    using VictimList = typename CachePolicy<ItemObj>::VictimList;
+
+    LRUPolicy() : lru_(CachePolicy<ItemObj>::UNLIMITED) {
+    }
+
+    const char*
+    name() const override {
+        return CACHE_POLICY_LRU;
+    }
+
+    bool
+    exists(const std::string& key) const override {
+        return lru_.exists(key);
+    }
+
+    Entry*
+    get(const std::string& key) override {
+        if (!lru_.exists(key)) {
+            return nullptr;
+        }
+        lru_.get(key);
+        return &(lru_.begin()->second);
+    }
+
+    void
+    put(const std::string& key, const Entry& entry) override {
+        lru_.put(key, entry);
+    }
+
+    bool
+    erase(const std::string& key, Entry& entry) override {
+        if (!lru_.exists(key)) {
+            return false;
+        }
+        entry = lru_.get(key);
+        lru_.erase(key);
+        return true;
+    }
+
+    const Entry*
+    victim(std::string& key) override {
+        if (lru_.size() == 0) {
+            return nullptr;
+        }
+        key = lru_.rbegin()->first;
+        return &(lru_.rbegin()->second);
+    }
+
+    void
+    victims(size_t count, VictimList& result) override {
+        for (auto it = lru_.rbegin(); it != lru_.rend() && result.size() < count; ++it) {
+            result.emplace_back(it->first, &(it->second));
+        }
+    }
+
+    void
+    evict(const std::string& key, Entry& entry) override {
+        erase(key, entry);
+    }
+
+    size_t
+    size() const override {
+        return lru_.size();
+    }
+
+    void
+    clear() override {
+        lru_.clear();
+    }
+
+ private:
+    LRU<std::string, Entry> lru_;
+};
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,203 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/CachePolicy.h"
+#include "cache/FrequencySketch.h"
+#include "cache/LRU.h"
+
+#include <string>
+
+namespace milvus {
+namespace cache {
+
+// W-TinyLFU: new items enter a small window LRU and then the probation segment of the main segmented
+// LRU, items hit in probation are promoted to the protected segment. When memory must be freed, the
+// newest probation item competes with the oldest one, and the one accessed less often according to the
+// frequency sketch is evicted. Items loaded once by a scan therefore don't push out hot items.
+template <typename ItemObj>
+class TinyLFUPolicy : public CachePolicy<ItemObj> {
+ public:
+    using Entry = CacheEntry<ItemObj>;
+
+    // share of cached bytes used by the window LRU
+    static constexpr double WINDOW_RATIO = 0.01;
+    // share of main region bytes used by the protected segment
+    static constexpr double PROTECTED_RATIO = 0.8;
+
+    TinyLFUPolicy()
+        : window_(CachePolicy<ItemObj>::UNLIMITED),
+          probation_(CachePolicy<ItemObj>::UNLIMITED),
+          protected_(CachePolicy<ItemObj>::UNLIMITED) {
+    }
+
+    const char*
+    name() const override {
+        return CACHE_POLICY_W_TINY_LFU;
+    }
+
+    bool
+    exists(const std::string& key) const override {
+        return window_.exists(key) || probation_.exists(key) || protected_.exists(key);
+    }
+
+    Entry*
+    get(const std::string& key) override {
+        // misses are counted too, a frequently requested key is admitted at its next insert
+        sketch_.increment(key);
+
+        if (window_.exists(key)) {
+            window_.get(key);
+            return &(window_.begin()->second);
+        }
+        if (protected_.exists(key)) {
+            protected_.get(key);
+            return &(protected_.begin()->second);
+        }
+        if (probation_.exists(key)) {
+            // promote to protected segment, demote the oldest protected items if it grows too large
+            Entry entry = probation_.peek(key);
+            probation_.erase(key);
+            protected_.put(key, entry);
+            protected_bytes_ += entry.size_;
+            while (protected_.size() > 1 && protected_bytes_ > main_bytes() * PROTECTED_RATIO) {
+                auto last = protected_.rbegin();
+                protected_bytes_ -= last->second.size_;
+                probation_.put(last->first, last->second);
+                protected_.erase(last->first);
+            }
+            protected_.get(key);
+            return &(protected_.begin()->second);
+        }
+        return nullptr;
+    }
+
+    void
+    put(const std::string& key, const Entry& entry) override {
+        sketch_.increment(key);
+        window_.put(key, entry);
+        window_bytes_ += entry.size_;
+        total_bytes_ += entry.size_;
+
+        // items leaving the window enter the probation segment, they compete with the other
+        // probation items only when the cache is full
+        while (window_.size() > 1 && window_bytes_ > total_bytes_ * WINDOW_RATIO) {
+            auto last = window_.rbegin();
+            window_bytes_ -= last->second.size_;
+            probation_.put(last->first, last->second);
+            window_.erase(last->first);
+        }
+    }
+
+    bool
+    erase(const std::string& key, Entry& entry) override {
+        if (window_.exists(key)) {
+            entry = window_.peek(key);
+            window_.erase(key);
+            window_bytes_ -= entry.size_;
+        } else if (protected_.exists(key)) {
+            entry = protected_.peek(key);
+            protected_.erase(key);
+            protected_bytes_ -= entry.size_;
+        } else if (probation_.exists(key)) {
+            entry = probation_.peek(key);
+            probation_.erase(key);
+        } else {
+            return false;
+        }
+        total_bytes_ -= entry.size_;
+        return true;
+    }
+
+    const Entry*
+    victim(std::string& key) override {
+        // the newest item of probation (or the window) is the admission candidate, and the oldest item
+        // of the main region is the item it would replace
+        LRU<std::string, Entry>* candidate_queue = nullptr;
+        if (probation_.size() > 1) {
+            candidate_queue = &probation_;
+        } else if (window_.size() > 0) {
+            candidate_queue = &window_;
+        }
+
+        LRU<std::string, Entry>* victim_queue = nullptr;
+        if (probation_.size() > 0) {
+            victim_queue = &probation_;
+        } else if (protected_.size() > 0) {
+            victim_queue = &protected_;
+        }
+
+        if (victim_queue == nullptr && candidate_queue == nullptr) {
+            return nullptr;
+        }
+
+        // admission: the candidate stays only if it is more popular than the main victim,
+        // otherwise the candidate itself is evicted
+        if (victim_queue == nullptr ||
+            (candidate_queue != nullptr &&
+             sketch_.frequency(candidate_key(*candidate_queue)) <= sketch_.frequency(victim_queue->rbegin()->first))) {
+            key = candidate_key(*candidate_queue);
+            return &candidate_queue->peek(key);
+        }
+
+        key = victim_queue->rbegin()->first;
+        return &(victim_queue->rbegin()->second);
+    }
+
+    void
+    evict(const std::string& key, Entry& entry) override {
+        erase(key, entry);
+    }
+
+    size_t
+    size() const override {
+        return window_.size() + probation_.size() + protected_.size();
+    }
+
+    void
+    clear() override {
+        window_.clear();
+        probation_.clear();
+        protected_.clear();
+        sketch_.clear();
+        window_bytes_ = 0;
+        protected_bytes_ = 0;
+        total_bytes_ = 0;
+    }
+
+ private:
+    int64_t
+    main_bytes() const {
+        return total_bytes_ - window_bytes_;
+    }
+
+    // the window candidate is its oldest item, the probation candidate is its newest item
+    const std::string&
+    candidate_key(LRU<std::string, Entry>& queue) {
+        if (&queue == &window_) {
+            return window_.rbegin()->first;
+        }
+        return queue.begin()->first;
+    }
+
+ private:
+    LRU<std::string, Entry> window_;
+    LRU<std::string, Entry> probation_;
+    LRU<std::string, Entry> protected_;
+    FrequencySketch sketch_;
+    int64_t window_bytes_ = 0;
+    int64_t protected_bytes_ = 0;
+    int64_t total_bytes_ = 0;
+};
+
+}  // namespace cache
+}  // namespace milvus
@@ -0,0 +1,162 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "cache/CachePolicy.h"
+#include "cache/LRU.h"
+
+#include <algorithm>
+#include <string>
+
+namespace milvus {
+namespace cache {
+
+// Full 2Q: new items enter a FIFO queue (A1in), items evicted from it are remembered in a ghost
+// queue (A1out), and only items inserted again while remembered enter the main LRU queue (Am).
+// A one-pass scan therefore only cycles through A1in and doesn't flush the hot items of Am.
+template <typename ItemObj>
+class TwoQueuePolicy : public CachePolicy<ItemObj> {
+ public:
+    using Entry = CacheEntry<ItemObj>;
+    using VictimList = typename CachePolicy<ItemObj>::VictimList;
+
+    // share of cached bytes reserved for A1in
+    static constexpr double IN_RATIO = 0.25;
+    // ghost keys kept per cached item
+    static constexpr size_t OUT_FACTOR = 2;
+    static constexpr size_t OUT_MIN_COUNT = 64;
+
+    TwoQueuePolicy()
+        : a1in_(CachePolicy<ItemObj>::UNLIMITED),
+          am_(CachePolicy<ItemObj>::UNLIMITED),
+          a1out_(CachePolicy<ItemObj>::UNLIMITED) {
+    }
+
+    const char*
+    name() const override {
+        return CACHE_POLICY_TWO_QUEUE;
+    }
+
+    bool
+    exists(const std::string& key) const override {
+        return a1in_.exists(key) || am_.exists(key);
+    }
+
+    Entry*
+    get(const std::string& key) override {
+        if (am_.exists(key)) {
+            am_.get(key);
+            return &(am_.begin()->second);
+        }
+        if (a1in_.exists(key)) {
+            // hits in A1in don't change its FIFO order
+            return &a1in_.peek(key);
+        }
+        return nullptr;
+    }
+
+    void
+    put(const std::string& key, const Entry& entry) override {
+        if (a1out_.exists(key)) {
+            a1out_.erase(key);
+            am_.put(key, entry);
+        } else {
+            a1in_.put(key, entry);
+            a1in_bytes_ += entry.size_;
+        }
+        total_bytes_ += entry.size_;
+    }
+
+    bool
+    erase(const std::string& key, Entry& entry) override {
+        if (am_.exists(key)) {
+            entry = am_.peek(key);
+            am_.erase(key);
+        } else if (a1in_.exists(key)) {
+            entry = a1in_.peek(key);
+            a1in_.erase(key);
+            a1in_bytes_ -= entry.size_;
+        } else {
+            return false;
+        }
+        total_bytes_ -= entry.size_;
+        return true;
+    }
+
+    const Entry*
+    victim(std::string& key) override {
+        LRU<std::string, Entry>* queue = victim_queue();
+        if (queue->size() == 0) {
+            return nullptr;
+        }
+        key = queue->rbegin()->first;
+        return &(queue->rbegin()->second);
+    }
+
+    void
+    victims(size_t count, VictimList& result) override {
+        LRU<std::string, Entry>* queue = victim_queue();
+        for (auto it = queue->rbegin(); it != queue->rend() && result.size() < count; ++it) {
+            result.emplace_back(it->first, &(it->second));
+        }
+    }
+
+    void
+    evict(const std::string& key, Entry& entry) override {
+        bool from_in = a1in_.exists(key);
+        if (!erase(key, entry)) {
+            return;
+        }
+
+        // remember the keys leaving A1in, a second insert of them goes into Am
+        if (from_in) {
+            a1out_.put(key, true);
+            size_t out_limit = std::max(OUT_MIN_COUNT, size() * OUT_FACTOR);
+            while (a1out_.size() > out_limit) {
+                a1out_.erase(a1out_.rbegin()->first);
+            }
+        }
+    }
+
+    size_t
+    size() const override {
+        return a1in_.size() + am_.size();
+    }
+
+    void
+    clear() override {
+        a1in_.clear();
+        am_.clear();
+        a1out_.clear();
+        a1in_bytes_ = 0;
+        total_bytes_ = 0;
+    }
+
+ private:
+    LRU<std::string, Entry>*
+    victim_queue() {
+        if (am_.size() == 0 || (a1in_.size() > 0 && a1in_bytes_ > total_bytes_ * IN_RATIO)) {
+            return &a1in_;
+        }
+        return &am_;
+    }
+
+ private:
+    LRU<std::string, Entry> a1in_;
+    LRU<std::string, Entry> am_;
+    LRU<std::string, bool> a1out_;
+    int64_t a1in_bytes_ = 0;
+    int64_t total_bytes_ = 0;
+};
+
+}  // namespace cache
+}  // namespace milvus
@@ -39,20 +39,20 @@ class Codec {
     virtual IdBloomFilterFormatPtr
     GetIdBloomFilterFormat() = 0;
 
+    virtual IdIndexFormatPtr
+    GetIdIndexFormat() = 0;
+
+    virtual VectorsIndexFormatPtr
+    GetVectorsIndexFormat() = 0;
+
     // TODO(zhiru)
     /*
     virtual AttrsFormat
     GetAttrsFormat() = 0;
 
-    virtual VectorsIndexFormat
-    GetVectorsIndexFormat() = 0;
-
     virtual AttrsIndexFormat
     GetAttrsIndexFormat() = 0;
 
-    virtual IdIndexFormat
-    GetIdIndexFormat() = 0;
-
     */
 };
 
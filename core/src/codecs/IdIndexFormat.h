@@ -17,17 +17,24 @@
 
 #pragma once
 
+#include <memory>
+
+#include "segment/IdIndex.h"
+#include "storage/FSHandler.h"
+
 namespace milvus {
 namespace codec {
 
 class IdIndexFormat {
-    // public:
-    //    virtual IdIndex
-    //    read() = 0;
-    //
-    //    virtual void
-    //    write(IdIndex id_index) = 0;
+ public:
+    virtual void
+    read(const storage::FSHandlerPtr& fs_ptr, segment::IdIndexPtr& id_index_ptr) = 0;
+
+    virtual void
+    write(const storage::FSHandlerPtr& fs_ptr, const segment::IdIndexPtr& id_index_ptr) = 0;
 };
 
+using IdIndexFormatPtr = std::shared_ptr<IdIndexFormat>;
+
 }  // namespace codec
 }  // namespace milvus
@@ -18,8 +18,10 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "segment/MappedVectors.h"
 #include "segment/Vectors.h"
 #include "storage/FSHandler.h"
 
@@ -34,12 +36,19 @@ class VectorsFormat {
     virtual void
     write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) = 0;
 
+    virtual void
+    append(const storage::FSHandlerPtr& fs_ptr, const std::string& name, const uint8_t* data, size_t size,
+           const segment::doc_id_t* uids, size_t count) = 0;
+
     virtual void
     read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) = 0;
 
     virtual void
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) = 0;
+
+    virtual void
+    read_vectors_mapped(const storage::FSHandlerPtr& fs_ptr, segment::MappedVectorsPtr& mapped_vectors) = 0;
 };
 
 using VectorsFormatPtr = std::shared_ptr<VectorsFormat>;
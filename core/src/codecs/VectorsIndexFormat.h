@@ -17,17 +17,28 @@
 
 #pragma once
 
+#include <memory>
+
+#include "segment/VectorIndex.h"
+#include "storage/FSHandler.h"
+
 namespace milvus {
 namespace codec {
 
 class VectorsIndexFormat {
-    // public:
-    //    virtual VectorsIndex
-    //    read() = 0;
-    //
-    //    virtual void
-    //    write(VectorsIndex vectors_index) = 0;
+ public:
+    virtual void
+    read(const storage::FSHandlerPtr& fs_ptr, segment::VectorIndexPtr& vector_index_ptr) = 0;
+
+    virtual void
+    write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorIndexPtr& vector_index_ptr) = 0;
+
+    // whether the segment has a checkpoint of its vector index
+    virtual bool
+    exists(const storage::FSHandlerPtr& fs_ptr) = 0;
 };
 
+using VectorsIndexFormatPtr = std::shared_ptr<VectorsIndexFormat>;
+
 }  // namespace codec
 }  // namespace milvus
@@ -21,7 +21,9 @@
 
 #include "DefaultDeletedDocsFormat.h"
 #include "DefaultIdBloomFilterFormat.h"
+#include "DefaultIdIndexFormat.h"
 #include "DefaultVectorsFormat.h"
+#include "DefaultVectorsIndexFormat.h"
 
 namespace milvus {
 namespace codec {
@@ -30,6 +32,8 @@ DefaultCodec::DefaultCodec() {
     vectors_format_ptr_ = std::make_shared<DefaultVectorsFormat>();
     deleted_docs_format_ptr_ = std::make_shared<DefaultDeletedDocsFormat>();
     id_bloom_filter_format_ptr_ = std::make_shared<DefaultIdBloomFilterFormat>();
+    id_index_format_ptr_ = std::make_shared<DefaultIdIndexFormat>();
+    vectors_index_format_ptr_ = std::make_shared<DefaultVectorsIndexFormat>();
 }
 
 VectorsFormatPtr
@@ -47,5 +51,15 @@ DefaultCodec::GetIdBloomFilterFormat() {
     return id_bloom_filter_format_ptr_;
 }
 
+IdIndexFormatPtr
+DefaultCodec::GetIdIndexFormat() {
+    return id_index_format_ptr_;
+}
+
+VectorsIndexFormatPtr
+DefaultCodec::GetVectorsIndexFormat() {
+    return vectors_index_format_ptr_;
+}
+
 }  // namespace codec
 }  // namespace milvus
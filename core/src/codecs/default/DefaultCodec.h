@@ -35,10 +35,18 @@ class DefaultCodec : public Codec {
     IdBloomFilterFormatPtr
     GetIdBloomFilterFormat() override;
 
+    IdIndexFormatPtr
+    GetIdIndexFormat() override;
+
+    VectorsIndexFormatPtr
+    GetVectorsIndexFormat() override;
+
  private:
     VectorsFormatPtr vectors_format_ptr_;
     DeletedDocsFormatPtr deleted_docs_format_ptr_;
     IdBloomFilterFormatPtr id_bloom_filter_format_ptr_;
+    IdIndexFormatPtr id_index_format_ptr_;
+    VectorsIndexFormatPtr vectors_index_format_ptr_;
 };
 
 }  // namespace codec
@@ -23,8 +23,12 @@
 #define BOOST_NO_CXX11_SCOPED_ENUMS
 #include <boost/filesystem.hpp>
 #undef BOOST_NO_CXX11_SCOPED_ENUMS
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "segment/Types.h"
@@ -34,116 +38,253 @@
 namespace milvus {
 namespace codec {
 
-void
-DefaultDeletedDocsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::DeletedDocsPtr& deleted_docs) {
-    const std::lock_guard<std::mutex> lock(mutex_);
+namespace {
 
-    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
-    const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
+// leading word of a file holding a serialized bitmap, files written by older versions start with the byte
+// size of a plain offset array instead
+constexpr size_t DELETED_DOCS_BITMAP_MAGIC = 0x31504d4254454c44;  // "DLETBMP1"
+
+// bitmap file whose header also holds the sequence number of the next delta file
+constexpr size_t DELETED_DOCS_BITMAP_SEQ_MAGIC = 0x32504d4254454c44;  // "DLETBMP2"
 
-    int del_fd = open(del_file_path.c_str(), O_RDONLY, 00664);
+// delta files are folded into the base file once a segment has this many of them
+constexpr size_t DELETED_DOCS_MAX_DELTA_NUM = 16;
+
+// a read that loses a delta file to a concurrent fold starts over from the new base file
+constexpr int DELETED_DOCS_READ_RETRY = 3;
+
+}  // namespace
+
+bool
+DefaultDeletedDocsFormat::read_internal(const std::string& file_path, segment::RoaringBitmap& bitmap,
+                                        uint64_t& next_seq, bool header_only) {
+    int del_fd = open(file_path.c_str(), O_RDONLY, 00664);
     if (del_fd == -1) {
-        std::string err_msg = "Failed to open file: " + del_file_path + ", error: " + std::strerror(errno);
+        if (errno == ENOENT) {
+            return false;
+        }
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
         ENGINE_LOG_ERROR << err_msg;
         throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
     }
 
+    auto read_section = [&](void* data, size_t num_bytes) {
+        if (::read(del_fd, data, num_bytes) != static_cast<ssize_t>(num_bytes)) {
+            ::close(del_fd);
+            std::string err_msg = "Failed to read from file: " + file_path + ", error: " + std::strerror(errno);
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+    };
+
+    // files without sequence number were written before the numbers were kept, their deltas start at 0
+    size_t header;
     size_t num_bytes;
-    if (::read(del_fd, &num_bytes, sizeof(size_t)) == -1) {
-        std::string err_msg = "Failed to read from file: " + del_file_path + ", error: " + std::strerror(errno);
+    bool legacy = false;
+    next_seq = 0;
+    read_section(&header, sizeof(size_t));
+    if (header == DELETED_DOCS_BITMAP_SEQ_MAGIC) {
+        read_section(&next_seq, sizeof(uint64_t));
+        read_section(&num_bytes, sizeof(size_t));
+    } else if (header == DELETED_DOCS_BITMAP_MAGIC) {
+        read_section(&num_bytes, sizeof(size_t));
+    } else {
+        num_bytes = header;
+        legacy = true;
+    }
+
+    std::vector<uint8_t> buffer;
+    if (!header_only) {
+        buffer.resize(num_bytes);
+        read_section(buffer.data(), num_bytes);
+    }
+
+    if (::close(del_fd) == -1) {
+        std::string err_msg = "Failed to close file: " + file_path + ", error: " + std::strerror(errno);
         ENGINE_LOG_ERROR << err_msg;
         throw Exception(SERVER_WRITE_ERROR, err_msg);
     }
 
-    auto deleted_docs_size = num_bytes / sizeof(segment::offset_t);
-    std::vector<segment::offset_t> deleted_docs_list;
-    deleted_docs_list.resize(deleted_docs_size);
+    if (header_only) {
+        return true;
+    }
+    if (legacy) {
+        bitmap.Clear();
+        auto offsets = reinterpret_cast<const segment::offset_t*>(buffer.data());
+        for (size_t i = 0; i < num_bytes / sizeof(segment::offset_t); ++i) {
+            bitmap.Add(offsets[i]);
+        }
+    } else if (!bitmap.Deserialize(buffer.data(), buffer.size())) {
+        std::string err_msg = "Invalid deleted docs in file: " + file_path;
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    return true;
+}
+
+void
+DefaultDeletedDocsFormat::write_internal(const std::string& dir_path, const std::string& file_path,
+                                         const segment::RoaringBitmap& bitmap, uint64_t next_seq) {
+    std::vector<uint8_t> buffer;
+    bitmap.Serialize(buffer);
+    size_t num_bytes = buffer.size();
 
-    if (::read(del_fd, deleted_docs_list.data(), num_bytes) == -1) {
-        std::string err_msg = "Failed to read from file: " + del_file_path + ", error: " + std::strerror(errno);
+    // Write to a temp file, in order to avoid possible race condition with search (concurrent read and write)
+    const std::string temp_path = dir_path + "/" + "temp_del";
+    int del_fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 00664);
+    if (del_fd == -1) {
+        std::string err_msg = "Failed to open file: " + temp_path + ", error: " + std::strerror(errno);
         ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
     }
 
-    deleted_docs = std::make_shared<segment::DeletedDocs>(deleted_docs_list);
+    if (::write(del_fd, &DELETED_DOCS_BITMAP_SEQ_MAGIC, sizeof(size_t)) == -1 ||
+        ::write(del_fd, &next_seq, sizeof(uint64_t)) == -1 || ::write(del_fd, &num_bytes, sizeof(size_t)) == -1 ||
+        ::write(del_fd, buffer.data(), num_bytes) == -1) {
+        ::close(del_fd);
+        std::string err_msg = "Failed to write to file" + temp_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
 
     if (::close(del_fd) == -1) {
-        std::string err_msg = "Failed to close file: " + del_file_path + ", error: " + std::strerror(errno);
+        std::string err_msg = "Failed to close file: " + temp_path + ", error: " + std::strerror(errno);
         ENGINE_LOG_ERROR << err_msg;
         throw Exception(SERVER_WRITE_ERROR, err_msg);
     }
+
+    // Move temp file to target file
+    boost::filesystem::rename(temp_path, file_path);
 }
 
 void
-DefaultDeletedDocsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::DeletedDocsPtr& deleted_docs) {
+DefaultDeletedDocsFormat::list_deltas(const std::string& dir_path, std::vector<uint64_t>& delta_seqs) {
+    delta_seqs.clear();
+    const std::string prefix = deleted_docs_filename_ + delta_extension_;
+    boost::filesystem::directory_iterator it_end;
+    for (boost::filesystem::directory_iterator it(dir_path); it != it_end; ++it) {
+        auto name = it->path().filename().string();
+        if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0) {
+            try {
+                delta_seqs.push_back(std::stoull(name.substr(prefix.size())));
+            } catch (std::exception& e) {
+                ENGINE_LOG_WARNING << "Ignore invalid deleted docs file: " << name;
+            }
+        }
+    }
+    std::sort(delta_seqs.begin(), delta_seqs.end());
+}
+
+std::string
+DefaultDeletedDocsFormat::delta_path(const std::string& dir_path, uint64_t seq) {
+    return dir_path + "/" + deleted_docs_filename_ + delta_extension_ + std::to_string(seq);
+}
+
+uint64_t
+DefaultDeletedDocsFormat::read_next_seq(const std::string& file_path) {
+    segment::RoaringBitmap bitmap;
+    uint64_t next_seq = 0;
+    read_internal(file_path, bitmap, next_seq, true);
+    return next_seq;
+}
+
+void
+DefaultDeletedDocsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::DeletedDocsPtr& deleted_docs) {
     const std::lock_guard<std::mutex> lock(mutex_);
 
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
 
-    // Create a temporary file from the existing file
-    const std::string temp_path = dir_path + "/" + "temp_del";
-    bool exists = boost::filesystem::exists(del_file_path);
-    if (exists) {
-        boost::filesystem::copy_file(del_file_path, temp_path, boost::filesystem::copy_option::fail_if_exists);
-    }
+    // The deleted docs are the union of the base file and the delta files appended after it. Delta sequence
+    // numbers never restart, the base file holds the next one: the deltas below it are folded into the base
+    for (int attempt = 0; attempt < DELETED_DOCS_READ_RETRY; ++attempt) {
+        segment::RoaringBitmap bitmap;
+        uint64_t base_seq = 0;
+        if (!read_internal(del_file_path, bitmap, base_seq)) {
+            std::string err_msg = "Failed to open file: " + del_file_path + ", error: " + std::strerror(ENOENT);
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+        }
 
-    // Write to the temp file, in order to avoid possible race condition with search (concurrent read and write)
-    int del_fd = open(temp_path.c_str(), O_RDWR | O_CREAT, 00664);
-    if (del_fd == -1) {
-        std::string err_msg = "Failed to open file: " + temp_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
-    }
+        std::vector<uint64_t> delta_seqs;
+        list_deltas(dir_path, delta_seqs);
+        bool complete = true;
+        for (auto seq : delta_seqs) {
+            if (seq < base_seq) {
+                continue;
+            }
+            segment::RoaringBitmap delta;
+            uint64_t delta_seq;
+            if (!read_internal(delta_path(dir_path, seq), delta, delta_seq)) {
+                // folded into the base file after it was read
+                complete = false;
+                break;
+            }
+            bitmap.Union(delta);
+        }
 
-    size_t old_num_bytes;
-    if (exists) {
-        if (::read(del_fd, &old_num_bytes, sizeof(size_t)) == -1) {
-            std::string err_msg = "Failed to read from file: " + temp_path + ", error: " + std::strerror(errno);
-            ENGINE_LOG_ERROR << err_msg;
-            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        // a fold after the base file was read may have removed deltas before they were listed
+        if (complete && read_next_seq(del_file_path) == base_seq) {
+            deleted_docs = std::make_shared<segment::DeletedDocs>(std::move(bitmap));
+            return;
         }
-    } else {
-        old_num_bytes = 0;
     }
 
-    auto deleted_docs_list = deleted_docs->GetDeletedDocs();
-    size_t new_num_bytes = old_num_bytes + sizeof(segment::offset_t) * deleted_docs->GetSize();
+    std::string err_msg = "Failed to read deleted docs in: " + dir_path + ", delta files keep changing";
+    ENGINE_LOG_ERROR << err_msg;
+    throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+}
 
-    // rewind and overwrite with the new_num_bytes
-    int off = lseek(del_fd, 0, SEEK_SET);
-    if (off == -1) {
-        std::string err_msg = "Failed to seek file: " + temp_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
-    }
-    if (::write(del_fd, &new_num_bytes, sizeof(size_t)) == -1) {
-        std::string err_msg = "Failed to write to file" + temp_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+void
+DefaultDeletedDocsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::DeletedDocsPtr& deleted_docs) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string del_file_path = dir_path + "/" + deleted_docs_filename_;
+
+    // The first write of a segment creates the base file
+    if (!boost::filesystem::exists(del_file_path)) {
+        write_internal(dir_path, del_file_path, deleted_docs->GetBitmap(), 0);
+        return;
     }
 
-    // Move to the end of file and append
-    off = lseek(del_fd, 0, SEEK_END);
-    if (off == -1) {
-        std::string err_msg = "Failed to seek file: " + temp_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    // Deltas below the next sequence number of the base file are folded already, they are only left by an
+    // interrupted fold
+    uint64_t base_seq = read_next_seq(del_file_path);
+    std::vector<uint64_t> delta_seqs;
+    list_deltas(dir_path, delta_seqs);
+    auto folded_end = std::lower_bound(delta_seqs.begin(), delta_seqs.end(), base_seq);
+    for (auto iter = delta_seqs.begin(); iter != folded_end; ++iter) {
+        boost::filesystem::remove(delta_path(dir_path, *iter));
     }
-    if (::write(del_fd, deleted_docs_list.data(), sizeof(segment::offset_t) * deleted_docs->GetSize()) == -1) {
-        std::string err_msg = "Failed to write to file" + temp_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    delta_seqs.erase(delta_seqs.begin(), folded_end);
+    uint64_t seq = delta_seqs.empty() ? base_seq : delta_seqs.back() + 1;
+
+    // Later deleted docs are only appended as a delta file, so applying deletes doesn't rewrite
+    // the deleted docs of the whole segment
+    if (delta_seqs.size() + 1 < DELETED_DOCS_MAX_DELTA_NUM) {
+        write_internal(dir_path, delta_path(dir_path, seq), deleted_docs->GetBitmap(), 0);
+        return;
     }
 
-    if (::close(del_fd) == -1) {
-        std::string err_msg = "Failed to close file: " + temp_path + ", error: " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    // Too many delta files, fold them into the base file, older files are converted to bitmap format.
+    // The new base file is in place before the delta files are removed, readers never miss a deleted doc.
+    // The new base file takes the sequence number the delta would have had, numbers never restart
+    segment::RoaringBitmap bitmap;
+    uint64_t unused_seq;
+    read_internal(del_file_path, bitmap, unused_seq);
+    for (auto delta_seq : delta_seqs) {
+        segment::RoaringBitmap delta;
+        if (read_internal(delta_path(dir_path, delta_seq), delta, unused_seq)) {
+            bitmap.Union(delta);
+        }
     }
+    bitmap.Union(deleted_docs->GetBitmap());
+    write_internal(dir_path, del_file_path, bitmap, seq + 1);
 
-    // Move temp file to delete file
-    boost::filesystem::rename(temp_path, del_file_path);
+    for (auto delta_seq : delta_seqs) {
+        boost::filesystem::remove(delta_path(dir_path, delta_seq));
+    }
 }
 
 }  // namespace codec
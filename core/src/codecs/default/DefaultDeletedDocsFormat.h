@@ -19,12 +19,15 @@
 
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "codecs/DeletedDocsFormat.h"
 
 namespace milvus {
 namespace codec {
 
+// The deleted docs of a segment are kept in a base file and the delta files written by later deletes,
+// a read returns the union of them. The delta files are folded into the base file when there are too many.
 class DefaultDeletedDocsFormat : public DeletedDocsFormat {
  public:
     DefaultDeletedDocsFormat() = default;
@@ -44,10 +47,32 @@ class DefaultDeletedDocsFormat : public DeletedDocsFormat {
     DefaultDeletedDocsFormat&
     operator=(DefaultDeletedDocsFormat&&) = delete;
 
+ private:
+    // return false if the file doesn't exist; next_seq is the sequence number of the next delta file, kept
+    // in the base file
+    bool
+    read_internal(const std::string& file_path, segment::RoaringBitmap& bitmap, uint64_t& next_seq,
+                  bool header_only = false);
+
+    uint64_t
+    read_next_seq(const std::string& file_path);
+
+    void
+    write_internal(const std::string& dir_path, const std::string& file_path, const segment::RoaringBitmap& bitmap,
+                   uint64_t next_seq);
+
+    // sequence numbers of the delta files in ascending order
+    void
+    list_deltas(const std::string& dir_path, std::vector<uint64_t>& delta_seqs);
+
+    std::string
+    delta_path(const std::string& dir_path, uint64_t seq);
+
  private:
     std::mutex mutex_;
 
     const std::string deleted_docs_filename_ = "deleted_docs";
+    const std::string delta_extension_ = ".delta_";
 };
 
 }  // namespace codec
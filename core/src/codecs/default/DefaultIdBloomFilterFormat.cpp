@@ -17,17 +17,29 @@
 
 #include "codecs/default/DefaultIdBloomFilterFormat.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#define BOOST_NO_CXX11_SCOPED_ENUMS
+#include <boost/filesystem.hpp>
+#undef BOOST_NO_CXX11_SCOPED_ENUMS
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "codecs/default/DefaultVectorsFormat.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 
 namespace milvus {
 namespace codec {
 
-constexpr unsigned int bloom_filter_capacity = 500000;
-constexpr double bloom_filter_error_rate = 0.01;
+namespace {
+
+// file layout: magic, capacity, block count, filter words
+constexpr uint64_t BLOOM_FILTER_MAGIC = 0x314d4f4f4c424449;  // "IDBLOOM1"
+
+}  // namespace
 
 void
 DefaultIdBloomFilterFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
@@ -35,15 +47,48 @@ DefaultIdBloomFilterFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::I
 
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
-    scaling_bloom_t* bloom_filter =
-        new_scaling_bloom_from_file(bloom_filter_capacity, bloom_filter_error_rate, bloom_filter_file_path.c_str());
-    if (bloom_filter == nullptr) {
-        std::string err_msg =
-            "Failed to read bloom filter from file: " + bloom_filter_file_path + ". " + std::strerror(errno);
+
+    int bf_fd = open(bloom_filter_file_path.c_str(), O_RDONLY, 00664);
+    if (bf_fd == -1) {
+        std::string err_msg = "Failed to open file: " + bloom_filter_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    uint64_t header[3];
+    bool valid = ::read(bf_fd, header, sizeof(header)) == sizeof(header) && header[0] == BLOOM_FILTER_MAGIC;
+    if (valid) {
+        id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(header[1]);
+        valid = id_bloom_filter_ptr->BlockCount() == header[2];
+    }
+    if (valid) {
+        auto num_bytes = static_cast<ssize_t>(id_bloom_filter_ptr->Size());
+        if (::read(bf_fd, id_bloom_filter_ptr->Data(), num_bytes) != num_bytes) {
+            ::close(bf_fd);
+            std::string err_msg =
+                "Failed to read from file: " + bloom_filter_file_path + ", error: " + std::strerror(errno);
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+    }
+
+    if (::close(bf_fd) == -1) {
+        std::string err_msg = "Failed to close file: " + bloom_filter_file_path + ", error: " + std::strerror(errno);
         ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    if (!valid) {
+        // written by an older version in another format, rebuild the filter from the uids of the segment
+        ENGINE_LOG_DEBUG << "Rebuilding bloom filter of " << dir_path;
+        std::vector<segment::doc_id_t> uids;
+        DefaultVectorsFormat vectors_format;
+        vectors_format.read_uids(fs_ptr, uids);
+        id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(uids.size());
+        for (auto uid : uids) {
+            id_bloom_filter_ptr->Add(uid);
+        }
     }
-    id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(bloom_filter);
 }
 
 void
@@ -53,28 +98,38 @@ DefaultIdBloomFilterFormat::write(const storage::FSHandlerPtr& fs_ptr,
 
     std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
     const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
-    if (scaling_bloom_flush(id_bloom_filter_ptr->GetBloomFilter()) == -1) {
-        std::string err_msg =
-            "Failed to write bloom filter to file: " + bloom_filter_file_path + ". " + std::strerror(errno);
+
+    // Write to a temp file, in order to avoid possible race condition with readers
+    const std::string temp_path = dir_path + "/" + "temp_bloom_filter";
+    int bf_fd = open(temp_path.c_str(), O_WRONLY | O_TRUNC | O_CREAT, 00664);
+    if (bf_fd == -1) {
+        std::string err_msg = "Failed to open file: " + temp_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    uint64_t header[3] = {BLOOM_FILTER_MAGIC, id_bloom_filter_ptr->Capacity(), id_bloom_filter_ptr->BlockCount()};
+    if (::write(bf_fd, header, sizeof(header)) == -1 ||
+        ::write(bf_fd, id_bloom_filter_ptr->Data(), id_bloom_filter_ptr->Size()) == -1) {
+        ::close(bf_fd);
+        std::string err_msg = "Failed to write to file: " + temp_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    if (::close(bf_fd) == -1) {
+        std::string err_msg = "Failed to close file: " + temp_path + ", error: " + std::strerror(errno);
         ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
     }
+
+    boost::filesystem::rename(temp_path, bloom_filter_file_path);
 }
 
 void
-DefaultIdBloomFilterFormat::create(const storage::FSHandlerPtr& fs_ptr,
+DefaultIdBloomFilterFormat::create(const storage::FSHandlerPtr& fs_ptr, size_t capacity,
                                    segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
-    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
-    const std::string bloom_filter_file_path = dir_path + "/" + bloom_filter_filename_;
-    scaling_bloom_t* bloom_filter =
-        new_scaling_bloom(bloom_filter_capacity, bloom_filter_error_rate, bloom_filter_file_path.c_str());
-    if (bloom_filter == nullptr) {
-        std::string err_msg =
-            "Failed to read bloom filter from file: " + bloom_filter_file_path + ". " + std::strerror(errno);
-        ENGINE_LOG_ERROR << err_msg;
-        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
-    }
-    id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(bloom_filter);
+    id_bloom_filter_ptr = std::make_shared<segment::IdBloomFilter>(capacity);
 }
 
 }  // namespace codec
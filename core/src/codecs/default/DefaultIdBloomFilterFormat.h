@@ -22,7 +22,6 @@
 
 #include "codecs/IdBloomFilterFormat.h"
 #include "segment/IdBloomFilter.h"
-#include "storage/disk/DiskOperation.h"
 
 namespace milvus {
 namespace codec {
@@ -38,7 +37,8 @@ class DefaultIdBloomFilterFormat : public IdBloomFilterFormat {
     write(const storage::FSHandlerPtr& fs_ptr, const segment::IdBloomFilterPtr& id_bloom_filter_ptr) override;
 
     void
-    create(const storage::FSHandlerPtr& fs_ptr, segment::IdBloomFilterPtr& id_bloom_filter_ptr) override;
+    create(const storage::FSHandlerPtr& fs_ptr, size_t capacity,
+           segment::IdBloomFilterPtr& id_bloom_filter_ptr) override;
 
     // No copy and move
     DefaultIdBloomFilterFormat(const DefaultIdBloomFilterFormat&) = delete;
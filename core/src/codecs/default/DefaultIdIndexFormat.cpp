@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/default/DefaultIdIndexFormat.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+// file layout: byte size of the sorted uids, sorted uids, byte size of the offsets, offsets
+void
+DefaultIdIndexFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::IdIndexPtr& id_index_ptr) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string id_index_file_path = dir_path + "/" + id_index_filename_;
+
+    int id_fd = open(id_index_file_path.c_str(), O_RDONLY, 00664);
+    if (id_fd == -1) {
+        std::string err_msg = "Failed to open file: " + id_index_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    auto read_section = [&](void* data, size_t num_bytes) {
+        if (::read(id_fd, data, num_bytes) != static_cast<ssize_t>(num_bytes)) {
+            ::close(id_fd);
+            std::string err_msg =
+                "Failed to read from file: " + id_index_file_path + ", error: " + std::strerror(errno);
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+    };
+
+    size_t num_bytes;
+    read_section(&num_bytes, sizeof(size_t));
+    std::vector<segment::doc_id_t> sorted_uids(num_bytes / sizeof(segment::doc_id_t));
+    read_section(sorted_uids.data(), num_bytes);
+
+    read_section(&num_bytes, sizeof(size_t));
+    std::vector<segment::offset_t> offsets(num_bytes / sizeof(segment::offset_t));
+    read_section(offsets.data(), num_bytes);
+
+    if (::close(id_fd) == -1) {
+        std::string err_msg = "Failed to close file: " + id_index_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    if (!offsets.empty() && offsets.size() != sorted_uids.size()) {
+        std::string err_msg = "Invalid id index in file: " + id_index_file_path;
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+
+    id_index_ptr = std::make_shared<segment::IdIndex>(std::move(sorted_uids), std::move(offsets));
+}
+
+void
+DefaultIdIndexFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::IdIndexPtr& id_index_ptr) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string id_index_file_path = dir_path + "/" + id_index_filename_;
+
+    int id_fd = open(id_index_file_path.c_str(), O_WRONLY | O_TRUNC | O_CREAT, 00664);
+    if (id_fd == -1) {
+        std::string err_msg = "Failed to open file: " + id_index_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    auto write_section = [&](const void* data, size_t num_bytes) {
+        if (::write(id_fd, &num_bytes, sizeof(size_t)) == -1 || ::write(id_fd, data, num_bytes) == -1) {
+            ::close(id_fd);
+            std::string err_msg = "Failed to write to file: " + id_index_file_path + ", error: " + std::strerror(errno);
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+    };
+
+    auto& sorted_uids = id_index_ptr->GetSortedUids();
+    write_section(sorted_uids.data(), sorted_uids.size() * sizeof(segment::doc_id_t));
+    auto& offsets = id_index_ptr->GetOffsets();
+    write_section(offsets.data(), offsets.size() * sizeof(segment::offset_t));
+
+    if (::close(id_fd) == -1) {
+        std::string err_msg = "Failed to close file: " + id_index_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+}
+
+}  // namespace codec
+}  // namespace milvus
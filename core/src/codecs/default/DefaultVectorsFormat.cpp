@@ -18,6 +18,8 @@
 #include "codecs/default/DefaultVectorsFormat.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <algorithm>
 
@@ -101,6 +103,80 @@ DefaultVectorsFormat::read_uids_internal(const std::string& file_path, std::vect
     }
 }
 
+segment::MappedVectorsPtr
+DefaultVectorsFormat::map_vectors_internal(const std::string& file_path) {
+    int rv_fd = open(file_path.c_str(), O_RDONLY, 00664);
+    if (rv_fd == -1) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    struct stat file_stat;
+    if (fstat(rv_fd, &file_stat) == -1 || file_stat.st_size < (off_t)sizeof(size_t)) {
+        std::string err_msg = "Invalid raw vectors file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        ::close(rv_fd);
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+
+    // the mapping stays valid after the file is closed
+    size_t length = file_stat.st_size;
+    void* addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, rv_fd, 0);
+    ::close(rv_fd);
+    if (addr == MAP_FAILED) {
+        std::string err_msg = "Failed to map file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+
+    // Beginning of file is num_bytes, a file shorter than it claims is corrupted
+    size_t num_bytes = *static_cast<size_t*>(addr);
+    if (num_bytes > length - sizeof(size_t)) {
+        std::string err_msg = "Invalid raw vectors file: " + file_path + ", " + std::to_string(num_bytes) +
+                              " bytes of vectors recorded but file length is " + std::to_string(length);
+        ENGINE_LOG_ERROR << err_msg;
+        munmap(addr, length);
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    return std::make_shared<segment::MappedVectors>(addr, length, sizeof(size_t), num_bytes);
+}
+
+void
+DefaultVectorsFormat::append_internal(const std::string& file_path, const void* data, size_t num) {
+    int fd = open(file_path.c_str(), O_RDWR, 00664);
+    if (fd == -1) {
+        std::string err_msg = "Failed to open file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    size_t num_bytes;
+    if (::pread(fd, &num_bytes, sizeof(size_t), 0) != sizeof(size_t)) {
+        ::close(fd);
+        std::string err_msg = "Failed to read from file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    // data first, then the size at the beginning of file, a failed append leaves the file as it was
+    auto size = static_cast<ssize_t>(num);
+    size_t new_num_bytes = num_bytes + num;
+    if (::pwrite(fd, data, num, sizeof(size_t) + num_bytes) != size ||
+        ::pwrite(fd, &new_num_bytes, sizeof(size_t), 0) != sizeof(size_t)) {
+        ::close(fd);
+        std::string err_msg = "Failed to write to file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    if (::close(fd) == -1) {
+        std::string err_msg = "Failed to close file: " + file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+}
+
 void
 DefaultVectorsFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::VectorsPtr& vectors_read) {
     const std::lock_guard<std::mutex> lock(mutex_);
@@ -196,6 +272,16 @@ DefaultVectorsFormat::write(const storage::FSHandlerPtr& fs_ptr, const segment::
     rc.RecordSection("write uids done");
 }
 
+void
+DefaultVectorsFormat::append(const storage::FSHandlerPtr& fs_ptr, const std::string& name, const uint8_t* data,
+                             size_t size, const segment::doc_id_t* uids, size_t count) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    append_internal(dir_path + "/" + name + raw_vector_extension_, data, size);
+    append_internal(dir_path + "/" + name + user_id_extension_, uids, count * sizeof(segment::doc_id_t));
+}
+
 void
 DefaultVectorsFormat::read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) {
     const std::lock_guard<std::mutex> lock(mutex_);
@@ -245,5 +331,29 @@ DefaultVectorsFormat::read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t of
     }
 }
 
+void
+DefaultVectorsFormat::read_vectors_mapped(const storage::FSHandlerPtr& fs_ptr,
+                                          segment::MappedVectorsPtr& mapped_vectors) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    if (!boost::filesystem::is_directory(dir_path)) {
+        std::string err_msg = "Directory: " + dir_path + "does not exist";
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_INVALID_ARGUMENT, err_msg);
+    }
+
+    boost::filesystem::path target_path(dir_path);
+    typedef boost::filesystem::directory_iterator d_it;
+    d_it it_end;
+    d_it it(target_path);
+    for (; it != it_end; ++it) {
+        const auto& path = it->path();
+        if (path.extension().string() == raw_vector_extension_) {
+            mapped_vectors = map_vectors_internal(path.string());
+        }
+    }
+}
+
 }  // namespace codec
 }  // namespace milvus
@@ -37,6 +37,11 @@ class DefaultVectorsFormat : public VectorsFormat {
     void
     write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorsPtr& vectors) override;
 
+    // append vectors and uids to the files written by write(), the files are complete after every append
+    void
+    append(const storage::FSHandlerPtr& fs_ptr, const std::string& name, const uint8_t* data, size_t size,
+           const segment::doc_id_t* uids, size_t count) override;
+
     void
     read_uids(const storage::FSHandlerPtr& fs_ptr, std::vector<segment::doc_id_t>& uids) override;
 
@@ -44,6 +49,10 @@ class DefaultVectorsFormat : public VectorsFormat {
     read_vectors(const storage::FSHandlerPtr& fs_ptr, off_t offset, size_t num_bytes,
                  std::vector<uint8_t>& raw_vectors) override;
 
+    // map the raw vectors file into memory instead of reading it
+    void
+    read_vectors_mapped(const storage::FSHandlerPtr& fs_ptr, segment::MappedVectorsPtr& mapped_vectors) override;
+
     // No copy and move
     DefaultVectorsFormat(const DefaultVectorsFormat&) = delete;
     DefaultVectorsFormat(DefaultVectorsFormat&&) = delete;
@@ -60,6 +69,12 @@ class DefaultVectorsFormat : public VectorsFormat {
     void
     read_uids_internal(const std::string&, std::vector<segment::doc_id_t>&);
 
+    segment::MappedVectorsPtr
+    map_vectors_internal(const std::string&);
+
+    void
+    append_internal(const std::string&, const void*, size_t);
+
  private:
     std::mutex mutex_;
 
@@ -0,0 +1,180 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "codecs/default/DefaultVectorsIndexFormat.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+#include "utils/Exception.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace codec {
+
+namespace {
+
+// writers of the same segment may run concurrently with their own codec, each writes its own temp file
+std::atomic<uint64_t> temp_file_seq(0);
+
+}  // namespace
+
+void
+DefaultVectorsIndexFormat::read(const storage::FSHandlerPtr& fs_ptr, segment::VectorIndexPtr& vector_index_ptr) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string index_file_path = dir_path + "/" + vectors_index_filename_;
+
+    int index_fd = open(index_file_path.c_str(), O_RDONLY, 00664);
+    if (index_fd == -1) {
+        std::string err_msg = "Failed to open file: " + index_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    struct stat file_stat;
+    if (fstat(index_fd, &file_stat) == -1) {
+        std::string err_msg = "Failed to stat file: " + index_file_path + ", error: " + std::strerror(errno);
+        ::close(index_fd);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    // bytes of the file not read yet, every length read from the file is checked against it before use
+    size_t remaining = file_stat.st_size;
+
+    auto read_section = [&](void* data, size_t num_bytes) {
+        if (::read(index_fd, data, num_bytes) != static_cast<ssize_t>(num_bytes)) {
+            std::string err_msg = "Failed to read from file: " + index_file_path + ", error: " + std::strerror(errno);
+            ::close(index_fd);
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+        remaining -= num_bytes;
+    };
+    auto check_length = [&](bool valid) {
+        if (!valid) {
+            ::close(index_fd);
+            std::string err_msg = "Invalid vectors index in file: " + index_file_path;
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+        }
+    };
+
+    knowhere::BinarySet binary_set;
+    size_t binary_count;
+    check_length(remaining >= sizeof(size_t));
+    read_section(&binary_count, sizeof(size_t));
+    // a binary takes at least its name length and its size
+    check_length(binary_count <= remaining / (sizeof(size_t) + sizeof(int64_t)));
+    for (size_t i = 0; i < binary_count; ++i) {
+        size_t name_length;
+        check_length(remaining >= sizeof(size_t));
+        read_section(&name_length, sizeof(size_t));
+        check_length(name_length <= remaining);
+        std::string name(name_length, '\0');
+        read_section(&name[0], name_length);
+
+        int64_t binary_size;
+        check_length(remaining >= sizeof(int64_t));
+        read_section(&binary_size, sizeof(int64_t));
+        check_length(binary_size >= 0 && static_cast<uint64_t>(binary_size) <= remaining);
+        std::shared_ptr<uint8_t> data(new uint8_t[binary_size], std::default_delete<uint8_t[]>());
+        read_section(data.get(), binary_size);
+        binary_set.Append(name, data, binary_size);
+    }
+    check_length(remaining == 0);
+
+    if (::close(index_fd) == -1) {
+        std::string err_msg = "Failed to close file: " + index_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    vector_index_ptr = std::make_shared<segment::VectorIndex>(std::move(binary_set));
+}
+
+void
+DefaultVectorsIndexFormat::write(const storage::FSHandlerPtr& fs_ptr,
+                                 const segment::VectorIndexPtr& vector_index_ptr) {
+    const std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    const std::string index_file_path = dir_path + "/" + vectors_index_filename_;
+    const std::string temp_file_path =
+        index_file_path + "." + std::to_string(getpid()) + "_" + std::to_string(temp_file_seq++) + ".tmp";
+
+    int index_fd = open(temp_file_path.c_str(), O_WRONLY | O_TRUNC | O_CREAT, 00664);
+    if (index_fd == -1) {
+        std::string err_msg = "Failed to open file: " + temp_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_CANNOT_CREATE_FILE, err_msg);
+    }
+
+    auto write_section = [&](const void* data, size_t num_bytes) {
+        if (::write(index_fd, data, num_bytes) != static_cast<ssize_t>(num_bytes)) {
+            std::string err_msg = "Failed to write to file: " + temp_file_path + ", error: " + std::strerror(errno);
+            ::close(index_fd);
+            std::remove(temp_file_path.c_str());
+            ENGINE_LOG_ERROR << err_msg;
+            throw Exception(SERVER_WRITE_ERROR, err_msg);
+        }
+    };
+
+    auto& binary_map = vector_index_ptr->GetBinarySet().binary_map_;
+    size_t binary_count = binary_map.size();
+    write_section(&binary_count, sizeof(size_t));
+    for (auto& pair : binary_map) {
+        size_t name_length = pair.first.size();
+        write_section(&name_length, sizeof(size_t));
+        write_section(pair.first.data(), name_length);
+        write_section(&pair.second->size, sizeof(int64_t));
+        write_section(pair.second->data.get(), pair.second->size);
+    }
+
+    if (::close(index_fd) == -1) {
+        std::string err_msg = "Failed to close file: " + temp_file_path + ", error: " + std::strerror(errno);
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+
+    if (std::rename(temp_file_path.c_str(), index_file_path.c_str()) != 0) {
+        std::string err_msg = "Failed to rename file: " + temp_file_path + ", error: " + std::strerror(errno);
+        std::remove(temp_file_path.c_str());
+        ENGINE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_WRITE_ERROR, err_msg);
+    }
+}
+
+bool
+DefaultVectorsIndexFormat::exists(const storage::FSHandlerPtr& fs_ptr) {
+    std::string dir_path = fs_ptr->operation_ptr_->GetDirectory();
+    return boost::filesystem::exists(dir_path + "/" + vectors_index_filename_);
+}
+
+}  // namespace codec
+}  // namespace milvus
@@ -0,0 +1,59 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include "codecs/VectorsIndexFormat.h"
+#include "segment/VectorIndex.h"
+
+namespace milvus {
+namespace codec {
+
+class DefaultVectorsIndexFormat : public VectorsIndexFormat {
+ public:
+    DefaultVectorsIndexFormat() = default;
+
+    void
+    read(const storage::FSHandlerPtr& fs_ptr, segment::VectorIndexPtr& vector_index_ptr) override;
+
+    // the file is replaced as a whole, a reader sees the previous checkpoint or the new one
+    void
+    write(const storage::FSHandlerPtr& fs_ptr, const segment::VectorIndexPtr& vector_index_ptr) override;
+
+    bool
+    exists(const storage::FSHandlerPtr& fs_ptr) override;
+
+    // No copy and move
+    DefaultVectorsIndexFormat(const DefaultVectorsIndexFormat&) = delete;
+    DefaultVectorsIndexFormat(DefaultVectorsIndexFormat&&) = delete;
+
+    DefaultVectorsIndexFormat&
+    operator=(const DefaultVectorsIndexFormat&) = delete;
+    DefaultVectorsIndexFormat&
+    operator=(DefaultVectorsIndexFormat&&) = delete;
+
+ private:
+    std::mutex mutex_;
+
+    const std::string vectors_index_filename_ = "vectors_index";
+};
+
+}  // namespace codec
+}  // namespace milvus
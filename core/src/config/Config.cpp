@@ -11,6 +11,7 @@
 
 #include <cache/CpuCacheMgr.h>
 #include <cache/GpuCacheMgr.h>
+#include <cache/IdCacheMgr.h>
 #include <fiu-local.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -27,6 +28,8 @@
 
 #include "config/Config.h"
 #include "config/YamlConfigMgr.h"
+#include "db/merge/MergePolicy.h"
+#include "db/wal/WalDefinations.h"
 #include "server/DBWrapper.h"
 #include "thirdparty/nlohmann/json.hpp"
 #include "utils/CommonUtil.h"
@@ -127,6 +130,15 @@ Config::ValidateConfig() {
     std::string server_web_port;
     CONFIG_CHECK(GetServerConfigWebPort(server_web_port));
 
+    int64_t server_request_worker_num;
+    CONFIG_CHECK(GetServerConfigRequestWorkerNum(server_request_worker_num));
+
+    int64_t server_dql_max_in_flight;
+    CONFIG_CHECK(GetServerConfigDqlMaxInFlight(server_dql_max_in_flight));
+
+    int64_t server_dql_max_queue;
+    CONFIG_CHECK(GetServerConfigDqlMaxQueue(server_dql_max_queue));
+
     /* db config */
     std::string db_backend_url;
     CONFIG_CHECK(GetDBConfigBackendUrl(db_backend_url));
@@ -143,6 +155,15 @@ Config::ValidateConfig() {
     int64_t auto_flush_interval;
     CONFIG_CHECK(GetDBConfigAutoFlushInterval(auto_flush_interval));
 
+    std::string merge_policy;
+    CONFIG_CHECK(GetDBConfigMergePolicy(merge_policy));
+
+    int64_t merge_io_rate_limit;
+    CONFIG_CHECK(GetDBConfigMergeIORateLimit(merge_io_rate_limit));
+
+    int64_t meta_snapshot_interval;
+    CONFIG_CHECK(GetDBConfigMetaSnapshotInterval(meta_snapshot_interval));
+
     /* storage config */
     std::string storage_primary_path;
     CONFIG_CHECK(GetStorageConfigPrimaryPath(storage_primary_path));
@@ -169,6 +190,15 @@ Config::ValidateConfig() {
     std::string storage_s3_bucket;
     CONFIG_CHECK(GetStorageConfigS3Bucket(storage_s3_bucket));
 
+    int64_t storage_s3_read_chunk_size;
+    CONFIG_CHECK(GetStorageConfigS3ReadChunkSize(storage_s3_read_chunk_size));
+
+    int64_t storage_s3_read_thread_num;
+    CONFIG_CHECK(GetStorageConfigS3ReadThreadNum(storage_s3_read_thread_num));
+
+    int64_t storage_s3_disk_cache_capacity;
+    CONFIG_CHECK(GetStorageConfigS3DiskCacheCapacity(storage_s3_disk_cache_capacity));
+
     /* metric config */
     bool metric_enable_monitor;
     CONFIG_CHECK(GetMetricConfigEnableMonitor(metric_enable_monitor));
@@ -192,6 +222,18 @@ Config::ValidateConfig() {
     bool cache_insert_data;
     CONFIG_CHECK(GetCacheConfigCacheInsertData(cache_insert_data));
 
+    int64_t cache_cpu_cache_shard_num;
+    CONFIG_CHECK(GetCacheConfigCpuCacheShardNum(cache_cpu_cache_shard_num));
+
+    std::string cache_cpu_cache_policy;
+    CONFIG_CHECK(GetCacheConfigCpuCachePolicy(cache_cpu_cache_policy));
+
+    float cache_cpu_cache_watermark;
+    CONFIG_CHECK(GetCacheConfigCpuCacheWatermark(cache_cpu_cache_watermark));
+
+    int64_t id_cache_capacity;
+    CONFIG_CHECK(GetCacheConfigIdCacheCapacity(id_cache_capacity));
+
     /* engine config */
     int64_t engine_use_blas_threshold;
     CONFIG_CHECK(GetEngineConfigUseBlasThreshold(engine_use_blas_threshold));
@@ -202,6 +244,24 @@ Config::ValidateConfig() {
     bool engine_use_avx512;
     CONFIG_CHECK(GetEngineConfigUseAVX512(engine_use_avx512));
 
+    bool engine_use_mmap;
+    CONFIG_CHECK(GetEngineConfigUseMmap(engine_use_mmap));
+
+    int64_t engine_search_worker_num;
+    CONFIG_CHECK(GetEngineConfigSearchWorkerNum(engine_search_worker_num));
+
+    int64_t engine_search_batch_max_nq;
+    CONFIG_CHECK(GetEngineConfigSearchBatchMaxNq(engine_search_batch_max_nq));
+
+    int64_t engine_search_batch_max_wait;
+    CONFIG_CHECK(GetEngineConfigSearchBatchMaxWait(engine_search_batch_max_wait));
+
+    bool engine_incremental_hnsw;
+    CONFIG_CHECK(GetEngineConfigIncrementalHnsw(engine_incremental_hnsw));
+
+    bool shared_ivf_quantizer;
+    CONFIG_CHECK(GetEngineConfigSharedIvfQuantizer(shared_ivf_quantizer));
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold;
     CONFIG_CHECK(GetEngineConfigGpuSearchThreshold(engine_gpu_search_threshold));
@@ -242,6 +302,9 @@ Config::ValidateConfig() {
     int64_t buffer_size;
     CONFIG_CHECK(GetWalConfigBufferSize(buffer_size));
 
+    std::string durability;
+    CONFIG_CHECK(GetWalConfigDurability(durability));
+
     std::string wal_path;
     CONFIG_CHECK(GetWalConfigWalPath(wal_path));
 
@@ -256,6 +319,9 @@ Config::ResetDefaultConfig() {
     CONFIG_CHECK(SetServerConfigDeployMode(CONFIG_SERVER_DEPLOY_MODE_DEFAULT));
     CONFIG_CHECK(SetServerConfigTimeZone(CONFIG_SERVER_TIME_ZONE_DEFAULT));
     CONFIG_CHECK(SetServerConfigWebPort(CONFIG_SERVER_WEB_PORT_DEFAULT));
+    CONFIG_CHECK(SetServerConfigRequestWorkerNum(CONFIG_SERVER_REQUEST_WORKER_NUM_DEFAULT));
+    CONFIG_CHECK(SetServerConfigDqlMaxInFlight(CONFIG_SERVER_DQL_MAX_IN_FLIGHT_DEFAULT));
+    CONFIG_CHECK(SetServerConfigDqlMaxQueue(CONFIG_SERVER_DQL_MAX_QUEUE_DEFAULT));
 
     /* db config */
     CONFIG_CHECK(SetDBConfigBackendUrl(CONFIG_DB_BACKEND_URL_DEFAULT));
@@ -263,6 +329,9 @@ Config::ResetDefaultConfig() {
     CONFIG_CHECK(SetDBConfigArchiveDiskThreshold(CONFIG_DB_ARCHIVE_DISK_THRESHOLD_DEFAULT));
     CONFIG_CHECK(SetDBConfigArchiveDaysThreshold(CONFIG_DB_ARCHIVE_DAYS_THRESHOLD_DEFAULT));
     CONFIG_CHECK(SetDBConfigAutoFlushInterval(CONFIG_DB_AUTO_FLUSH_INTERVAL_DEFAULT));
+    CONFIG_CHECK(SetDBConfigMergePolicy(CONFIG_DB_MERGE_POLICY_DEFAULT));
+    CONFIG_CHECK(SetDBConfigMergeIORateLimit(CONFIG_DB_MERGE_IO_RATE_LIMIT_DEFAULT));
+    CONFIG_CHECK(SetDBConfigMetaSnapshotInterval(CONFIG_DB_META_SNAPSHOT_INTERVAL_DEFAULT));
 
     /* storage config */
     CONFIG_CHECK(SetStorageConfigPrimaryPath(CONFIG_STORAGE_PRIMARY_PATH_DEFAULT));
@@ -273,6 +342,9 @@ Config::ResetDefaultConfig() {
     CONFIG_CHECK(SetStorageConfigS3AccessKey(CONFIG_STORAGE_S3_ACCESS_KEY_DEFAULT));
     CONFIG_CHECK(SetStorageConfigS3SecretKey(CONFIG_STORAGE_S3_SECRET_KEY_DEFAULT));
     CONFIG_CHECK(SetStorageConfigS3Bucket(CONFIG_STORAGE_S3_BUCKET_DEFAULT));
+    CONFIG_CHECK(SetStorageConfigS3ReadChunkSize(CONFIG_STORAGE_S3_READ_CHUNK_SIZE_DEFAULT));
+    CONFIG_CHECK(SetStorageConfigS3ReadThreadNum(CONFIG_STORAGE_S3_READ_THREAD_NUM_DEFAULT));
+    CONFIG_CHECK(SetStorageConfigS3DiskCacheCapacity(CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY_DEFAULT));
 
     /* metric config */
     CONFIG_CHECK(SetMetricConfigEnableMonitor(CONFIG_METRIC_ENABLE_MONITOR_DEFAULT));
@@ -284,16 +356,27 @@ Config::ResetDefaultConfig() {
     CONFIG_CHECK(SetCacheConfigCpuCacheThreshold(CONFIG_CACHE_CPU_CACHE_THRESHOLD_DEFAULT));
     CONFIG_CHECK(SetCacheConfigInsertBufferSize(CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT));
     CONFIG_CHECK(SetCacheConfigCacheInsertData(CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT));
+    CONFIG_CHECK(SetCacheConfigCpuCacheShardNum(CONFIG_CACHE_CPU_CACHE_SHARD_NUM_DEFAULT));
+    CONFIG_CHECK(SetCacheConfigCpuCachePolicy(CONFIG_CACHE_CPU_CACHE_POLICY_DEFAULT));
+    CONFIG_CHECK(SetCacheConfigCpuCacheWatermark(CONFIG_CACHE_CPU_CACHE_WATERMARK_DEFAULT));
+    CONFIG_CHECK(SetCacheConfigIdCacheCapacity(CONFIG_CACHE_ID_CACHE_CAPACITY_DEFAULT));
 
     /* engine config */
     CONFIG_CHECK(SetEngineConfigUseBlasThreshold(CONFIG_ENGINE_USE_BLAS_THRESHOLD_DEFAULT));
     CONFIG_CHECK(SetEngineConfigOmpThreadNum(CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT));
     CONFIG_CHECK(SetEngineConfigUseAVX512(CONFIG_ENGINE_USE_AVX512_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigUseMmap(CONFIG_ENGINE_USE_MMAP_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigSearchWorkerNum(CONFIG_ENGINE_SEARCH_WORKER_NUM_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigSearchBatchMaxNq(CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigSearchBatchMaxWait(CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigIncrementalHnsw(CONFIG_ENGINE_INCREMENTAL_HNSW_DEFAULT));
+    CONFIG_CHECK(SetEngineConfigSharedIvfQuantizer(CONFIG_ENGINE_SHARED_IVF_QUANTIZER_DEFAULT));
 
     /* wal config */
     CONFIG_CHECK(SetWalConfigEnable(CONFIG_WAL_ENABLE_DEFAULT));
     CONFIG_CHECK(SetWalConfigRecoveryErrorIgnore(CONFIG_WAL_RECOVERY_ERROR_IGNORE_DEFAULT));
     CONFIG_CHECK(SetWalConfigBufferSize(CONFIG_WAL_BUFFER_SIZE_DEFAULT));
+    CONFIG_CHECK(SetWalConfigDurability(CONFIG_WAL_DURABILITY_DEFAULT));
     CONFIG_CHECK(SetWalConfigWalPath(CONFIG_WAL_WAL_PATH_DEFAULT));
 #ifdef MILVUS_GPU_VERSION
     CONFIG_CHECK(SetEngineConfigGpuSearchThreshold(CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT));
@@ -345,6 +428,12 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetServerConfigTimeZone(value);
         } else if (child_key == CONFIG_SERVER_WEB_PORT) {
             status = SetServerConfigWebPort(value);
+        } else if (child_key == CONFIG_SERVER_REQUEST_WORKER_NUM) {
+            status = SetServerConfigRequestWorkerNum(value);
+        } else if (child_key == CONFIG_SERVER_DQL_MAX_IN_FLIGHT) {
+            status = SetServerConfigDqlMaxInFlight(value);
+        } else if (child_key == CONFIG_SERVER_DQL_MAX_QUEUE) {
+            status = SetServerConfigDqlMaxQueue(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -355,6 +444,12 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetDBConfigPreloadTable(value);
         } else if (child_key == CONFIG_DB_AUTO_FLUSH_INTERVAL) {
             status = SetDBConfigAutoFlushInterval(value);
+        } else if (child_key == CONFIG_DB_MERGE_POLICY) {
+            status = SetDBConfigMergePolicy(value);
+        } else if (child_key == CONFIG_DB_MERGE_IO_RATE_LIMIT) {
+            status = SetDBConfigMergeIORateLimit(value);
+        } else if (child_key == CONFIG_DB_META_SNAPSHOT_INTERVAL) {
+            status = SetDBConfigMetaSnapshotInterval(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -375,6 +470,12 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetStorageConfigS3SecretKey(value);
         } else if (child_key == CONFIG_STORAGE_S3_BUCKET) {
             status = SetStorageConfigS3Bucket(value);
+        } else if (child_key == CONFIG_STORAGE_S3_READ_CHUNK_SIZE) {
+            status = SetStorageConfigS3ReadChunkSize(value);
+        } else if (child_key == CONFIG_STORAGE_S3_READ_THREAD_NUM) {
+            status = SetStorageConfigS3ReadThreadNum(value);
+        } else if (child_key == CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY) {
+            status = SetStorageConfigS3DiskCacheCapacity(value);
         } else {
             status = Status(SERVER_UNEXPECTED_ERROR, invalid_node_str);
         }
@@ -395,6 +496,14 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetCacheConfigCpuCacheThreshold(value);
         } else if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA) {
             status = SetCacheConfigCacheInsertData(value);
+        } else if (child_key == CONFIG_CACHE_CPU_CACHE_SHARD_NUM) {
+            status = SetCacheConfigCpuCacheShardNum(value);
+        } else if (child_key == CONFIG_CACHE_CPU_CACHE_POLICY) {
+            status = SetCacheConfigCpuCachePolicy(value);
+        } else if (child_key == CONFIG_CACHE_CPU_CACHE_WATERMARK) {
+            status = SetCacheConfigCpuCacheWatermark(value);
+        } else if (child_key == CONFIG_CACHE_ID_CACHE_CAPACITY) {
+            status = SetCacheConfigIdCacheCapacity(value);
         } else if (child_key == CONFIG_CACHE_INSERT_BUFFER_SIZE) {
             status = SetCacheConfigInsertBufferSize(value);
         } else {
@@ -407,6 +516,18 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetEngineConfigOmpThreadNum(value);
         } else if (child_key == CONFIG_ENGINE_USE_AVX512) {
             status = SetEngineConfigUseAVX512(value);
+        } else if (child_key == CONFIG_ENGINE_USE_MMAP) {
+            status = SetEngineConfigUseMmap(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_WORKER_NUM) {
+            status = SetEngineConfigSearchWorkerNum(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ) {
+            status = SetEngineConfigSearchBatchMaxNq(value);
+        } else if (child_key == CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT) {
+            status = SetEngineConfigSearchBatchMaxWait(value);
+        } else if (child_key == CONFIG_ENGINE_INCREMENTAL_HNSW) {
+            status = SetEngineConfigIncrementalHnsw(value);
+        } else if (child_key == CONFIG_ENGINE_SHARED_IVF_QUANTIZER) {
+            status = SetEngineConfigSharedIvfQuantizer(value);
 #ifdef MILVUS_GPU_VERSION
         } else if (child_key == CONFIG_ENGINE_GPU_SEARCH_THRESHOLD) {
             status = SetEngineConfigGpuSearchThreshold(value);
@@ -443,6 +564,8 @@ Config::SetConfigCli(const std::string& parent_key, const std::string& child_key
             status = SetWalConfigRecoveryErrorIgnore(value);
         } else if (child_key == CONFIG_WAL_BUFFER_SIZE) {
             status = SetWalConfigBufferSize(value);
+        } else if (child_key == CONFIG_WAL_DURABILITY) {
+            status = SetWalConfigDurability(value);
         } else if (child_key == CONFIG_WAL_WAL_PATH) {
             status = SetWalConfigWalPath(value);
         } else {
@@ -548,9 +671,11 @@ Config::UpdateFileConfigFromMem(const std::string& parent_key, const std::string
 
     // convert value string to standard string stored in yaml file
     std::string value_str;
-    if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA || child_key == CONFIG_STORAGE_S3_ENABLE ||
-        child_key == CONFIG_METRIC_ENABLE_MONITOR || child_key == CONFIG_GPU_RESOURCE_ENABLE ||
-        child_key == CONFIG_WAL_ENABLE || child_key == CONFIG_WAL_RECOVERY_ERROR_IGNORE) {
+    if (child_key == CONFIG_CACHE_CACHE_INSERT_DATA || child_key == CONFIG_ENGINE_USE_MMAP ||
+        child_key == CONFIG_ENGINE_INCREMENTAL_HNSW || child_key == CONFIG_ENGINE_SHARED_IVF_QUANTIZER ||
+        child_key == CONFIG_STORAGE_S3_ENABLE || child_key == CONFIG_METRIC_ENABLE_MONITOR ||
+        child_key == CONFIG_GPU_RESOURCE_ENABLE || child_key == CONFIG_WAL_ENABLE ||
+        child_key == CONFIG_WAL_RECOVERY_ERROR_IGNORE) {
         bool ok = false;
         status = StringHelpFunctions::ConvertToBoolean(value, ok);
         if (!status.ok()) {
@@ -757,6 +882,58 @@ Config::CheckServerConfigWebPort(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckServerConfigRequestWorkerNum(const std::string& value) {
+    fiu_return_on("check_config_request_worker_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid request worker num: " + value +
+                          ". Possible reason: server_config.request_worker_num is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t worker_num = std::stoll(value);
+    if (worker_num < 1 || worker_num > CONFIG_SERVER_REQUEST_WORKER_NUM_MAX) {
+        std::string msg = "Invalid request worker num: " + value +
+                          ". Possible reason: server_config.request_worker_num is not in range [1, " +
+                          std::to_string(CONFIG_SERVER_REQUEST_WORKER_NUM_MAX) + "].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckServerConfigDqlMaxInFlight(const std::string& value) {
+    fiu_return_on("check_config_dql_max_in_flight_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid dql max in flight: " + value +
+                          ". Possible reason: server_config.dql_max_in_flight is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t max_in_flight = std::stoll(value);
+    if (max_in_flight < 1 || max_in_flight > CONFIG_SERVER_REQUEST_WORKER_NUM_MAX) {
+        std::string msg = "Invalid dql max in flight: " + value +
+                          ". Possible reason: server_config.dql_max_in_flight is not in range [1, " +
+                          std::to_string(CONFIG_SERVER_REQUEST_WORKER_NUM_MAX) + "].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckServerConfigDqlMaxQueue(const std::string& value) {
+    fiu_return_on("check_config_dql_max_queue_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid dql max queue: " + value +
+                          ". Possible reason: server_config.dql_max_queue is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* DB config */
 Status
 Config::CheckDBConfigBackendUrl(const std::string& value) {
@@ -847,6 +1024,48 @@ Config::CheckDBConfigAutoFlushInterval(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckDBConfigMergePolicy(const std::string& value) {
+    auto exist_error = (value != engine::MERGE_POLICY_SIMPLE && value != engine::MERGE_POLICY_TIERED);
+    fiu_do_on("check_config_merge_policy_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid db configuration merge_policy: " + value +
+                          ". Possible reason: db_config.merge_policy is not one of simple and tiered.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
+Status
+Config::CheckDBConfigMergeIORateLimit(const std::string& value) {
+    auto exist_error = !ValidationUtil::ValidateStringIsNumber(value).ok();
+    fiu_do_on("check_config_merge_io_rate_limit_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid db configuration merge_io_rate_limit: " + value +
+                          ". Possible reason: db_config.merge_io_rate_limit is not a natural number.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
+Status
+Config::CheckDBConfigMetaSnapshotInterval(const std::string& value) {
+    auto exist_error = !ValidationUtil::ValidateStringIsNumber(value).ok();
+    fiu_do_on("check_config_meta_snapshot_interval_fail", exist_error = true);
+
+    if (exist_error) {
+        std::string msg = "Invalid db configuration meta_snapshot_interval: " + value +
+                          ". Possible reason: db_config.meta_snapshot_interval is not a natural number.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    return Status::OK();
+}
+
 /* storage config */
 Status
 Config::CheckStorageConfigPrimaryPath(const std::string& value) {
@@ -947,6 +1166,60 @@ Config::CheckStorageConfigS3Bucket(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckStorageConfigS3ReadChunkSize(const std::string& value) {
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid s3 read chunk size: " + value +
+                          ". Possible reason: storage_config.s3_read_chunk_size is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t chunk_size = std::stoll(value);
+    if (chunk_size < 1 || chunk_size > CONFIG_STORAGE_S3_READ_CHUNK_SIZE_MAX) {
+        std::string msg = "Invalid s3 read chunk size: " + value +
+                          ". Possible reason: storage_config.s3_read_chunk_size is not in range [1, " +
+                          std::to_string(CONFIG_STORAGE_S3_READ_CHUNK_SIZE_MAX) + "].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigS3ReadThreadNum(const std::string& value) {
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid s3 read thread num: " + value +
+                          ". Possible reason: storage_config.s3_read_thread_num is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t thread_num = std::stoll(value);
+    if (thread_num < 1 || thread_num > CONFIG_STORAGE_S3_READ_THREAD_NUM_MAX) {
+        std::string msg = "Invalid s3 read thread num: " + value +
+                          ". Possible reason: storage_config.s3_read_thread_num is not in range [1, " +
+                          std::to_string(CONFIG_STORAGE_S3_READ_THREAD_NUM_MAX) + "].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckStorageConfigS3DiskCacheCapacity(const std::string& value) {
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid s3 disk cache capacity: " + value +
+                          ". Possible reason: storage_config.s3_disk_cache_capacity is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t capacity = std::stoll(value);
+    if (capacity < 0 || capacity > CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY_MAX) {
+        std::string msg = "Invalid s3 disk cache capacity: " + value +
+                          ". Possible reason: storage_config.s3_disk_cache_capacity is not in range [0, " +
+                          std::to_string(CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY_MAX) + "].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* metric config */
 Status
 Config::CheckMetricConfigEnableMonitor(const std::string& value) {
@@ -1088,6 +1361,78 @@ Config::CheckCacheConfigCacheInsertData(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckCacheConfigCpuCacheShardNum(const std::string& value) {
+    fiu_return_on("check_config_cpu_cache_shard_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid cpu cache shard num: " + value +
+                          ". Possible reason: cache_config.cpu_cache_shard_num is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        int64_t shard_num = std::stoll(value);
+        if (shard_num < 1 || shard_num > CONFIG_CACHE_CPU_CACHE_SHARD_NUM_MAX) {
+            std::string msg = "Invalid cpu cache shard num: " + value +
+                              ". Possible reason: cache_config.cpu_cache_shard_num is not in range [1, " +
+                              std::to_string(CONFIG_CACHE_CPU_CACHE_SHARD_NUM_MAX) + "].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigCpuCachePolicy(const std::string& value) {
+    fiu_return_on("check_config_cpu_cache_policy_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value != cache::CACHE_POLICY_LRU && value != cache::CACHE_POLICY_TWO_QUEUE &&
+        value != cache::CACHE_POLICY_W_TINY_LFU) {
+        std::string msg = "Invalid cpu cache policy: " + value +
+                          ". Possible reason: cache_config.cpu_cache_policy is not one of lru, 2q and tinylfu.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigCpuCacheWatermark(const std::string& value) {
+    fiu_return_on("check_config_cpu_cache_watermark_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsFloat(value).ok()) {
+        std::string msg = "Invalid cpu cache watermark: " + value +
+                          ". Possible reason: cache_config.cpu_cache_watermark is not in range (0.0, 1.0].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    } else {
+        float cpu_cache_watermark = std::stof(value);
+        if (cpu_cache_watermark <= 0.0 || cpu_cache_watermark > 1.0) {
+            std::string msg = "Invalid cpu cache watermark: " + value +
+                              ". Possible reason: cache_config.cpu_cache_watermark is not in range (0.0, 1.0].";
+            return Status(SERVER_INVALID_ARGUMENT, msg);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckCacheConfigIdCacheCapacity(const std::string& value) {
+    fiu_return_on("check_config_id_cache_capacity_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok() || std::stoll(value) <= 0) {
+        std::string msg = "Invalid id cache capacity: " + value +
+                          ". Possible reason: cache_config.id_cache_capacity is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    uint64_t total_mem = 0, free_mem = 0;
+    CommonUtil::GetSystemMemInfo(total_mem, free_mem);
+    if (static_cast<uint64_t>(std::stoll(value) * GB) >= total_mem) {
+        std::string msg = "Invalid id cache capacity: " + value +
+                          ". Possible reason: cache_config.id_cache_capacity exceeds system memory.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::CheckEngineConfigUseBlasThreshold(const std::string& value) {
@@ -1132,6 +1477,103 @@ Config::CheckEngineConfigUseAVX512(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckEngineConfigUseMmap(const std::string& value) {
+    fiu_return_on("check_config_use_mmap_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsBool(value).ok()) {
+        std::string msg =
+            "Invalid engine config: " + value + ". Possible reason: engine_config.use_mmap is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchWorkerNum(const std::string& value) {
+    fiu_return_on("check_config_search_worker_num_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid search worker num: " + value +
+                          ". Possible reason: engine_config.search_worker_num is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t worker_num = std::stoll(value);
+    int64_t sys_thread_cnt = 8;
+    CommonUtil::GetSystemAvailableThreads(sys_thread_cnt);
+    if (worker_num < 1 || worker_num > sys_thread_cnt) {
+        std::string msg = "Invalid search worker num: " + value +
+                          ". Possible reason: engine_config.search_worker_num is not in range [1, system cpu cores].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchBatchMaxNq(const std::string& value) {
+    fiu_return_on("check_config_search_batch_max_nq_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid search batch max nq: " + value +
+                          ". Possible reason: engine_config.search_batch_max_nq is not a positive integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t max_nq = std::stoll(value);
+    if (max_nq < 1 || max_nq > CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_MAX) {
+        std::string msg = "Invalid search batch max nq: " + value +
+                          ". Possible reason: engine_config.search_batch_max_nq is not in range [1, " +
+                          std::to_string(CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_MAX) + "].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSearchBatchMaxWait(const std::string& value) {
+    fiu_return_on("check_config_search_batch_max_wait_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsNumber(value).ok()) {
+        std::string msg = "Invalid search batch max wait: " + value +
+                          ". Possible reason: engine_config.search_batch_max_wait is not a non-negative integer.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+
+    int64_t max_wait = std::stoll(value);
+    if (max_wait > CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT_MAX) {
+        std::string msg = "Invalid search batch max wait: " + value +
+                          ". Possible reason: engine_config.search_batch_max_wait is not in range [0, " +
+                          std::to_string(CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT_MAX) + "].";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigIncrementalHnsw(const std::string& value) {
+    fiu_return_on("check_config_incremental_hnsw_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsBool(value).ok()) {
+        std::string msg =
+            "Invalid engine config: " + value + ". Possible reason: engine_config.incremental_hnsw is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
+Status
+Config::CheckEngineConfigSharedIvfQuantizer(const std::string& value) {
+    fiu_return_on("check_config_shared_ivf_quantizer_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (!ValidationUtil::ValidateStringIsBool(value).ok()) {
+        std::string msg = "Invalid engine config: " + value +
+                          ". Possible reason: engine_config.shared_ivf_quantizer is not a boolean.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 #ifdef MILVUS_GPU_VERSION
 
 Status
@@ -1335,6 +1777,19 @@ Config::CheckWalConfigBufferSize(const std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::CheckWalConfigDurability(const std::string& value) {
+    fiu_return_on("check_config_wal_durability_fail", Status(SERVER_INVALID_ARGUMENT, ""));
+
+    if (value != engine::wal::WAL_DURABILITY_NONE && value != engine::wal::WAL_DURABILITY_FLUSH &&
+        value != engine::wal::WAL_DURABILITY_SYNC) {
+        std::string msg = "Invalid wal durability: " + value +
+                          ". Possible reason: wal_config.durability is not one of none, flush and fsync.";
+        return Status(SERVER_INVALID_ARGUMENT, msg);
+    }
+    return Status::OK();
+}
+
 Status
 Config::CheckWalConfigWalPath(const std::string& value) {
     fiu_return_on("check_wal_path_fail", Status(SERVER_INVALID_ARGUMENT, ""));
@@ -1473,6 +1928,32 @@ Config::GetServerConfigWebPort(std::string& value) {
     return CheckServerConfigWebPort(value);
 }
 
+Status
+Config::GetServerConfigRequestWorkerNum(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_SERVER, CONFIG_SERVER_REQUEST_WORKER_NUM, CONFIG_SERVER_REQUEST_WORKER_NUM_DEFAULT);
+    CONFIG_CHECK(CheckServerConfigRequestWorkerNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetServerConfigDqlMaxInFlight(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_SERVER, CONFIG_SERVER_DQL_MAX_IN_FLIGHT, CONFIG_SERVER_DQL_MAX_IN_FLIGHT_DEFAULT);
+    CONFIG_CHECK(CheckServerConfigDqlMaxInFlight(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetServerConfigDqlMaxQueue(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_SERVER, CONFIG_SERVER_DQL_MAX_QUEUE, CONFIG_SERVER_DQL_MAX_QUEUE_DEFAULT);
+    CONFIG_CHECK(CheckServerConfigDqlMaxQueue(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* DB config */
 Status
 Config::GetDBConfigBackendUrl(std::string& value) {
@@ -1512,6 +1993,29 @@ Config::GetDBConfigAutoFlushInterval(int64_t& value) {
     return Status::OK();
 }
 
+Status
+Config::GetDBConfigMergePolicy(std::string& value) {
+    value = GetConfigStr(CONFIG_DB, CONFIG_DB_MERGE_POLICY, CONFIG_DB_MERGE_POLICY_DEFAULT);
+    return CheckDBConfigMergePolicy(value);
+}
+
+Status
+Config::GetDBConfigMergeIORateLimit(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_DB, CONFIG_DB_MERGE_IO_RATE_LIMIT, CONFIG_DB_MERGE_IO_RATE_LIMIT_DEFAULT);
+    CONFIG_CHECK(CheckDBConfigMergeIORateLimit(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetDBConfigMetaSnapshotInterval(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_DB, CONFIG_DB_META_SNAPSHOT_INTERVAL, CONFIG_DB_META_SNAPSHOT_INTERVAL_DEFAULT);
+    CONFIG_CHECK(CheckDBConfigMetaSnapshotInterval(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* storage config */
 Status
 Config::GetStorageConfigPrimaryPath(std::string& value) {
@@ -1563,6 +2067,33 @@ Config::GetStorageConfigS3Bucket(std::string& value) {
     return Status::OK();
 }
 
+Status
+Config::GetStorageConfigS3ReadChunkSize(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_S3_READ_CHUNK_SIZE, CONFIG_STORAGE_S3_READ_CHUNK_SIZE_DEFAULT);
+    CONFIG_CHECK(CheckStorageConfigS3ReadChunkSize(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigS3ReadThreadNum(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_S3_READ_THREAD_NUM, CONFIG_STORAGE_S3_READ_THREAD_NUM_DEFAULT);
+    CONFIG_CHECK(CheckStorageConfigS3ReadThreadNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetStorageConfigS3DiskCacheCapacity(int64_t& value) {
+    std::string str = GetConfigStr(CONFIG_STORAGE, CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY,
+                                   CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY_DEFAULT);
+    CONFIG_CHECK(CheckStorageConfigS3DiskCacheCapacity(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* metric config */
 Status
 Config::GetMetricConfigEnableMonitor(bool& value) {
@@ -1622,6 +2153,39 @@ Config::GetCacheConfigCacheInsertData(bool& value) {
     return Status::OK();
 }
 
+Status
+Config::GetCacheConfigCpuCacheShardNum(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_SHARD_NUM, CONFIG_CACHE_CPU_CACHE_SHARD_NUM_DEFAULT);
+    CONFIG_CHECK(CheckCacheConfigCpuCacheShardNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigCpuCachePolicy(std::string& value) {
+    value = GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_POLICY, CONFIG_CACHE_CPU_CACHE_POLICY_DEFAULT);
+    return CheckCacheConfigCpuCachePolicy(value);
+}
+
+Status
+Config::GetCacheConfigCpuCacheWatermark(float& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_WATERMARK, CONFIG_CACHE_CPU_CACHE_WATERMARK_DEFAULT);
+    CONFIG_CHECK(CheckCacheConfigCpuCacheWatermark(str));
+    value = std::stof(str);
+    return Status::OK();
+}
+
+Status
+Config::GetCacheConfigIdCacheCapacity(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_CACHE, CONFIG_CACHE_ID_CACHE_CAPACITY, CONFIG_CACHE_ID_CACHE_CAPACITY_DEFAULT);
+    CONFIG_CHECK(CheckCacheConfigIdCacheCapacity(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::GetEngineConfigUseBlasThreshold(int64_t& value) {
@@ -1649,6 +2213,59 @@ Config::GetEngineConfigUseAVX512(bool& value) {
     return Status::OK();
 }
 
+Status
+Config::GetEngineConfigUseMmap(bool& value) {
+    std::string str = GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_USE_MMAP, CONFIG_ENGINE_USE_MMAP_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigUseMmap(str));
+    CONFIG_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchWorkerNum(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_WORKER_NUM, CONFIG_ENGINE_SEARCH_WORKER_NUM_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigSearchWorkerNum(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchBatchMaxNq(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ, CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigSearchBatchMaxNq(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSearchBatchMaxWait(int64_t& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT, CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigSearchBatchMaxWait(str));
+    value = std::stoll(str);
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigIncrementalHnsw(bool& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_INCREMENTAL_HNSW, CONFIG_ENGINE_INCREMENTAL_HNSW_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigIncrementalHnsw(str));
+    CONFIG_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
+Status
+Config::GetEngineConfigSharedIvfQuantizer(bool& value) {
+    std::string str =
+        GetConfigStr(CONFIG_ENGINE, CONFIG_ENGINE_SHARED_IVF_QUANTIZER, CONFIG_ENGINE_SHARED_IVF_QUANTIZER_DEFAULT);
+    CONFIG_CHECK(CheckEngineConfigSharedIvfQuantizer(str));
+    CONFIG_CHECK(StringHelpFunctions::ConvertToBoolean(str, value));
+    return Status::OK();
+}
+
 #ifdef MILVUS_GPU_VERSION
 
 Status
@@ -1797,6 +2414,12 @@ Config::GetWalConfigBufferSize(int64_t& buffer_size) {
     return Status::OK();
 }
 
+Status
+Config::GetWalConfigDurability(std::string& value) {
+    value = GetConfigStr(CONFIG_WAL, CONFIG_WAL_DURABILITY, CONFIG_WAL_DURABILITY_DEFAULT);
+    return CheckWalConfigDurability(value);
+}
+
 Status
 Config::GetWalConfigWalPath(std::string& wal_path) {
     wal_path = GetConfigStr(CONFIG_WAL, CONFIG_WAL_WAL_PATH, CONFIG_WAL_WAL_PATH_DEFAULT);
@@ -1842,6 +2465,24 @@ Config::SetServerConfigWebPort(const std::string& value) {
     return SetConfigValueInMem(CONFIG_SERVER, CONFIG_SERVER_WEB_PORT, value);
 }
 
+Status
+Config::SetServerConfigRequestWorkerNum(const std::string& value) {
+    CONFIG_CHECK(CheckServerConfigRequestWorkerNum(value));
+    return SetConfigValueInMem(CONFIG_SERVER, CONFIG_SERVER_REQUEST_WORKER_NUM, value);
+}
+
+Status
+Config::SetServerConfigDqlMaxInFlight(const std::string& value) {
+    CONFIG_CHECK(CheckServerConfigDqlMaxInFlight(value));
+    return SetConfigValueInMem(CONFIG_SERVER, CONFIG_SERVER_DQL_MAX_IN_FLIGHT, value);
+}
+
+Status
+Config::SetServerConfigDqlMaxQueue(const std::string& value) {
+    CONFIG_CHECK(CheckServerConfigDqlMaxQueue(value));
+    return SetConfigValueInMem(CONFIG_SERVER, CONFIG_SERVER_DQL_MAX_QUEUE, value);
+}
+
 /* db config */
 Status
 Config::SetDBConfigBackendUrl(const std::string& value) {
@@ -1874,6 +2515,24 @@ Config::SetDBConfigAutoFlushInterval(const std::string& value) {
     return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_AUTO_FLUSH_INTERVAL, value);
 }
 
+Status
+Config::SetDBConfigMergePolicy(const std::string& value) {
+    CONFIG_CHECK(CheckDBConfigMergePolicy(value));
+    return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_MERGE_POLICY, value);
+}
+
+Status
+Config::SetDBConfigMergeIORateLimit(const std::string& value) {
+    CONFIG_CHECK(CheckDBConfigMergeIORateLimit(value));
+    return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_MERGE_IO_RATE_LIMIT, value);
+}
+
+Status
+Config::SetDBConfigMetaSnapshotInterval(const std::string& value) {
+    CONFIG_CHECK(CheckDBConfigMetaSnapshotInterval(value));
+    return SetConfigValueInMem(CONFIG_DB, CONFIG_DB_META_SNAPSHOT_INTERVAL, value);
+}
+
 /* storage config */
 Status
 Config::SetStorageConfigPrimaryPath(const std::string& value) {
@@ -1923,6 +2582,24 @@ Config::SetStorageConfigS3Bucket(const std::string& value) {
     return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_S3_BUCKET, value);
 }
 
+Status
+Config::SetStorageConfigS3ReadChunkSize(const std::string& value) {
+    CONFIG_CHECK(CheckStorageConfigS3ReadChunkSize(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_S3_READ_CHUNK_SIZE, value);
+}
+
+Status
+Config::SetStorageConfigS3ReadThreadNum(const std::string& value) {
+    CONFIG_CHECK(CheckStorageConfigS3ReadThreadNum(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_S3_READ_THREAD_NUM, value);
+}
+
+Status
+Config::SetStorageConfigS3DiskCacheCapacity(const std::string& value) {
+    CONFIG_CHECK(CheckStorageConfigS3DiskCacheCapacity(value));
+    return SetConfigValueInMem(CONFIG_STORAGE, CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY, value);
+}
+
 /* metric config */
 Status
 Config::SetMetricConfigEnableMonitor(const std::string& value) {
@@ -1971,6 +2648,32 @@ Config::SetCacheConfigCacheInsertData(const std::string& value) {
     return ExecCallBacks(CONFIG_CACHE, CONFIG_CACHE_CACHE_INSERT_DATA, value);
 }
 
+Status
+Config::SetCacheConfigCpuCacheShardNum(const std::string& value) {
+    CONFIG_CHECK(CheckCacheConfigCpuCacheShardNum(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_SHARD_NUM, value);
+}
+
+Status
+Config::SetCacheConfigCpuCachePolicy(const std::string& value) {
+    CONFIG_CHECK(CheckCacheConfigCpuCachePolicy(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_POLICY, value);
+}
+
+Status
+Config::SetCacheConfigCpuCacheWatermark(const std::string& value) {
+    CONFIG_CHECK(CheckCacheConfigCpuCacheWatermark(value));
+    return SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_CPU_CACHE_WATERMARK, value);
+}
+
+Status
+Config::SetCacheConfigIdCacheCapacity(const std::string& value) {
+    CONFIG_CHECK(CheckCacheConfigIdCacheCapacity(value));
+    CONFIG_CHECK(SetConfigValueInMem(CONFIG_CACHE, CONFIG_CACHE_ID_CACHE_CAPACITY, value));
+    cache::IdCacheMgr::GetInstance()->SetCapacity(std::stol(value) << 30);
+    return Status::OK();
+}
+
 /* engine config */
 Status
 Config::SetEngineConfigUseBlasThreshold(const std::string& value) {
@@ -1991,6 +2694,42 @@ Config::SetEngineConfigUseAVX512(const std::string& value) {
     return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_USE_AVX512, value);
 }
 
+Status
+Config::SetEngineConfigUseMmap(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigUseMmap(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_USE_MMAP, value);
+}
+
+Status
+Config::SetEngineConfigSearchWorkerNum(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigSearchWorkerNum(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_WORKER_NUM, value);
+}
+
+Status
+Config::SetEngineConfigSearchBatchMaxNq(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigSearchBatchMaxNq(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ, value);
+}
+
+Status
+Config::SetEngineConfigSearchBatchMaxWait(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigSearchBatchMaxWait(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT, value);
+}
+
+Status
+Config::SetEngineConfigIncrementalHnsw(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigIncrementalHnsw(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_INCREMENTAL_HNSW, value);
+}
+
+Status
+Config::SetEngineConfigSharedIvfQuantizer(const std::string& value) {
+    CONFIG_CHECK(CheckEngineConfigSharedIvfQuantizer(value));
+    return SetConfigValueInMem(CONFIG_ENGINE, CONFIG_ENGINE_SHARED_IVF_QUANTIZER, value);
+}
+
 /* tracing config */
 Status
 Config::SetTracingConfigJsonConfigPath(const std::string& value) {
@@ -2017,6 +2756,12 @@ Config::SetWalConfigBufferSize(const std::string& value) {
     return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_BUFFER_SIZE, value);
 }
 
+Status
+Config::SetWalConfigDurability(const std::string& value) {
+    CONFIG_CHECK(CheckWalConfigDurability(value));
+    return SetConfigValueInMem(CONFIG_WAL, CONFIG_WAL_DURABILITY, value);
+}
+
 Status
 Config::SetWalConfigWalPath(const std::string& value) {
     CONFIG_CHECK(CheckWalConfigWalPath(value));
@@ -48,6 +48,13 @@ static const char* CONFIG_SERVER_TIME_ZONE = "time_zone";
 static const char* CONFIG_SERVER_TIME_ZONE_DEFAULT = "UTC+8";
 static const char* CONFIG_SERVER_WEB_PORT = "web_port";
 static const char* CONFIG_SERVER_WEB_PORT_DEFAULT = "19121";
+static const char* CONFIG_SERVER_REQUEST_WORKER_NUM = "request_worker_num";
+static const char* CONFIG_SERVER_REQUEST_WORKER_NUM_DEFAULT = "8";
+static const int64_t CONFIG_SERVER_REQUEST_WORKER_NUM_MAX = 256;
+static const char* CONFIG_SERVER_DQL_MAX_IN_FLIGHT = "dql_max_in_flight";
+static const char* CONFIG_SERVER_DQL_MAX_IN_FLIGHT_DEFAULT = "6";
+static const char* CONFIG_SERVER_DQL_MAX_QUEUE = "dql_max_queue";
+static const char* CONFIG_SERVER_DQL_MAX_QUEUE_DEFAULT = "1024";
 
 /* db config */
 static const char* CONFIG_DB = "db_config";
@@ -61,6 +68,12 @@ static const char* CONFIG_DB_PRELOAD_TABLE = "preload_table";
 static const char* CONFIG_DB_PRELOAD_TABLE_DEFAULT = "";
 static const char* CONFIG_DB_AUTO_FLUSH_INTERVAL = "auto_flush_interval";
 static const char* CONFIG_DB_AUTO_FLUSH_INTERVAL_DEFAULT = "1";
+static const char* CONFIG_DB_MERGE_POLICY = "merge_policy";
+static const char* CONFIG_DB_MERGE_POLICY_DEFAULT = "simple";
+static const char* CONFIG_DB_MERGE_IO_RATE_LIMIT = "merge_io_rate_limit";
+static const char* CONFIG_DB_MERGE_IO_RATE_LIMIT_DEFAULT = "0";
+static const char* CONFIG_DB_META_SNAPSHOT_INTERVAL = "meta_snapshot_interval";
+static const char* CONFIG_DB_META_SNAPSHOT_INTERVAL_DEFAULT = "0";
 
 /* storage config */
 static const char* CONFIG_STORAGE = "storage_config";
@@ -80,6 +93,15 @@ static const char* CONFIG_STORAGE_S3_SECRET_KEY = "s3_secret_key";
 static const char* CONFIG_STORAGE_S3_SECRET_KEY_DEFAULT = "minioadmin";
 static const char* CONFIG_STORAGE_S3_BUCKET = "s3_bucket";
 static const char* CONFIG_STORAGE_S3_BUCKET_DEFAULT = "milvus-bucket";
+static const char* CONFIG_STORAGE_S3_READ_CHUNK_SIZE = "s3_read_chunk_size";
+static const char* CONFIG_STORAGE_S3_READ_CHUNK_SIZE_DEFAULT = "8";
+static const int64_t CONFIG_STORAGE_S3_READ_CHUNK_SIZE_MAX = 1024;
+static const char* CONFIG_STORAGE_S3_READ_THREAD_NUM = "s3_read_thread_num";
+static const char* CONFIG_STORAGE_S3_READ_THREAD_NUM_DEFAULT = "8";
+static const int64_t CONFIG_STORAGE_S3_READ_THREAD_NUM_MAX = 64;
+static const char* CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY = "s3_disk_cache_capacity";
+static const char* CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY_DEFAULT = "0";
+static const int64_t CONFIG_STORAGE_S3_DISK_CACHE_CAPACITY_MAX = 65536;
 
 /* cache config */
 static const char* CONFIG_CACHE = "cache_config";
@@ -91,6 +113,15 @@ static const char* CONFIG_CACHE_INSERT_BUFFER_SIZE = "insert_buffer_size";
 static const char* CONFIG_CACHE_INSERT_BUFFER_SIZE_DEFAULT = "1";
 static const char* CONFIG_CACHE_CACHE_INSERT_DATA = "cache_insert_data";
 static const char* CONFIG_CACHE_CACHE_INSERT_DATA_DEFAULT = "false";
+static const char* CONFIG_CACHE_CPU_CACHE_SHARD_NUM = "cpu_cache_shard_num";
+static const char* CONFIG_CACHE_CPU_CACHE_SHARD_NUM_DEFAULT = "16";
+static const char* CONFIG_CACHE_CPU_CACHE_POLICY = "cpu_cache_policy";
+static const char* CONFIG_CACHE_CPU_CACHE_POLICY_DEFAULT = "lru";
+static const char* CONFIG_CACHE_CPU_CACHE_WATERMARK = "cpu_cache_watermark";
+static const char* CONFIG_CACHE_CPU_CACHE_WATERMARK_DEFAULT = "0.95";
+static const char* CONFIG_CACHE_ID_CACHE_CAPACITY = "id_cache_capacity";
+static const char* CONFIG_CACHE_ID_CACHE_CAPACITY_DEFAULT = "1";
+static const int64_t CONFIG_CACHE_CPU_CACHE_SHARD_NUM_MAX = 256;
 
 /* metric config */
 static const char* CONFIG_METRIC = "metric_config";
@@ -109,6 +140,20 @@ static const char* CONFIG_ENGINE_OMP_THREAD_NUM = "omp_thread_num";
 static const char* CONFIG_ENGINE_OMP_THREAD_NUM_DEFAULT = "0";
 static const char* CONFIG_ENGINE_USE_AVX512 = "use_avx512";
 static const char* CONFIG_ENGINE_USE_AVX512_DEFAULT = "true";
+static const char* CONFIG_ENGINE_USE_MMAP = "use_mmap";
+static const char* CONFIG_ENGINE_USE_MMAP_DEFAULT = "false";
+static const char* CONFIG_ENGINE_SEARCH_WORKER_NUM = "search_worker_num";
+static const char* CONFIG_ENGINE_SEARCH_WORKER_NUM_DEFAULT = "1";
+static const char* CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ = "search_batch_max_nq";
+static const char* CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT = "64";
+static const int64_t CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_MAX = 1024;
+static const char* CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT = "search_batch_max_wait";
+static const char* CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT_DEFAULT = "0";
+static const int64_t CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT_MAX = 1000;
+static const char* CONFIG_ENGINE_INCREMENTAL_HNSW = "incremental_hnsw";
+static const char* CONFIG_ENGINE_INCREMENTAL_HNSW_DEFAULT = "false";
+static const char* CONFIG_ENGINE_SHARED_IVF_QUANTIZER = "shared_ivf_quantizer";
+static const char* CONFIG_ENGINE_SHARED_IVF_QUANTIZER_DEFAULT = "false";
 static const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD = "gpu_search_threshold";
 static const char* CONFIG_ENGINE_GPU_SEARCH_THRESHOLD_DEFAULT = "1000";
 
@@ -144,6 +189,8 @@ static const char* CONFIG_WAL_BUFFER_SIZE = "buffer_size";
 static const char* CONFIG_WAL_BUFFER_SIZE_DEFAULT = "256";
 static const int64_t CONFIG_WAL_BUFFER_SIZE_MAX = 4096;
 static const int64_t CONFIG_WAL_BUFFER_SIZE_MIN = 64;
+static const char* CONFIG_WAL_DURABILITY = "durability";
+static const char* CONFIG_WAL_DURABILITY_DEFAULT = "flush";
 static const char* CONFIG_WAL_WAL_PATH = "wal_path";
 static const char* CONFIG_WAL_WAL_PATH_DEFAULT = "/tmp/milvus/wal";
 
@@ -209,6 +256,12 @@ class Config {
     CheckServerConfigTimeZone(const std::string& value);
     Status
     CheckServerConfigWebPort(const std::string& value);
+    Status
+    CheckServerConfigRequestWorkerNum(const std::string& value);
+    Status
+    CheckServerConfigDqlMaxInFlight(const std::string& value);
+    Status
+    CheckServerConfigDqlMaxQueue(const std::string& value);
 
     /* db config */
     Status
@@ -221,6 +274,12 @@ class Config {
     CheckDBConfigArchiveDaysThreshold(const std::string& value);
     Status
     CheckDBConfigAutoFlushInterval(const std::string& value);
+    Status
+    CheckDBConfigMergePolicy(const std::string& value);
+    Status
+    CheckDBConfigMergeIORateLimit(const std::string& value);
+    Status
+    CheckDBConfigMetaSnapshotInterval(const std::string& value);
 
     /* storage config */
     Status
@@ -239,6 +298,12 @@ class Config {
     CheckStorageConfigS3SecretKey(const std::string& value);
     Status
     CheckStorageConfigS3Bucket(const std::string& value);
+    Status
+    CheckStorageConfigS3ReadChunkSize(const std::string& value);
+    Status
+    CheckStorageConfigS3ReadThreadNum(const std::string& value);
+    Status
+    CheckStorageConfigS3DiskCacheCapacity(const std::string& value);
 
     /* metric config */
     Status
@@ -257,6 +322,14 @@ class Config {
     CheckCacheConfigInsertBufferSize(const std::string& value);
     Status
     CheckCacheConfigCacheInsertData(const std::string& value);
+    Status
+    CheckCacheConfigCpuCacheShardNum(const std::string& value);
+    Status
+    CheckCacheConfigCpuCachePolicy(const std::string& value);
+    Status
+    CheckCacheConfigCpuCacheWatermark(const std::string& value);
+    Status
+    CheckCacheConfigIdCacheCapacity(const std::string& value);
 
     /* engine config */
     Status
@@ -265,6 +338,18 @@ class Config {
     CheckEngineConfigOmpThreadNum(const std::string& value);
     Status
     CheckEngineConfigUseAVX512(const std::string& value);
+    Status
+    CheckEngineConfigUseMmap(const std::string& value);
+    Status
+    CheckEngineConfigSearchWorkerNum(const std::string& value);
+    Status
+    CheckEngineConfigSearchBatchMaxNq(const std::string& value);
+    Status
+    CheckEngineConfigSearchBatchMaxWait(const std::string& value);
+    Status
+    CheckEngineConfigIncrementalHnsw(const std::string& value);
+    Status
+    CheckEngineConfigSharedIvfQuantizer(const std::string& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -295,6 +380,8 @@ class Config {
     Status
     CheckWalConfigBufferSize(const std::string& value);
     Status
+    CheckWalConfigDurability(const std::string& value);
+    Status
     CheckWalConfigWalPath(const std::string& value);
 
     std::string
@@ -320,6 +407,12 @@ class Config {
     GetServerConfigTimeZone(std::string& value);
     Status
     GetServerConfigWebPort(std::string& value);
+    Status
+    GetServerConfigRequestWorkerNum(int64_t& value);
+    Status
+    GetServerConfigDqlMaxInFlight(int64_t& value);
+    Status
+    GetServerConfigDqlMaxQueue(int64_t& value);
 
     /* db config */
     Status
@@ -332,6 +425,12 @@ class Config {
     GetDBConfigPreloadTable(std::string& value);
     Status
     GetDBConfigAutoFlushInterval(int64_t& value);
+    Status
+    GetDBConfigMergePolicy(std::string& value);
+    Status
+    GetDBConfigMergeIORateLimit(int64_t& value);
+    Status
+    GetDBConfigMetaSnapshotInterval(int64_t& value);
 
     /* storage config */
     Status
@@ -350,6 +449,12 @@ class Config {
     GetStorageConfigS3SecretKey(std::string& value);
     Status
     GetStorageConfigS3Bucket(std::string& value);
+    Status
+    GetStorageConfigS3ReadChunkSize(int64_t& value);
+    Status
+    GetStorageConfigS3ReadThreadNum(int64_t& value);
+    Status
+    GetStorageConfigS3DiskCacheCapacity(int64_t& value);
 
     /* metric config */
     Status
@@ -368,6 +473,14 @@ class Config {
     GetCacheConfigInsertBufferSize(int64_t& value);
     Status
     GetCacheConfigCacheInsertData(bool& value);
+    Status
+    GetCacheConfigCpuCacheShardNum(int64_t& value);
+    Status
+    GetCacheConfigCpuCachePolicy(std::string& value);
+    Status
+    GetCacheConfigCpuCacheWatermark(float& value);
+    Status
+    GetCacheConfigIdCacheCapacity(int64_t& value);
 
     /* engine config */
     Status
@@ -376,6 +489,18 @@ class Config {
     GetEngineConfigOmpThreadNum(int64_t& value);
     Status
     GetEngineConfigUseAVX512(bool& value);
+    Status
+    GetEngineConfigUseMmap(bool& value);
+    Status
+    GetEngineConfigSearchWorkerNum(int64_t& value);
+    Status
+    GetEngineConfigSearchBatchMaxNq(int64_t& value);
+    Status
+    GetEngineConfigSearchBatchMaxWait(int64_t& value);
+    Status
+    GetEngineConfigIncrementalHnsw(bool& value);
+    Status
+    GetEngineConfigSharedIvfQuantizer(bool& value);
 
 #ifdef MILVUS_GPU_VERSION
     Status
@@ -406,6 +531,8 @@ class Config {
     Status
     GetWalConfigBufferSize(int64_t& value);
     Status
+    GetWalConfigDurability(std::string& value);
+    Status
     GetWalConfigWalPath(std::string& value);
 
     Status
@@ -423,6 +550,12 @@ class Config {
     SetServerConfigTimeZone(const std::string& value);
     Status
     SetServerConfigWebPort(const std::string& value);
+    Status
+    SetServerConfigRequestWorkerNum(const std::string& value);
+    Status
+    SetServerConfigDqlMaxInFlight(const std::string& value);
+    Status
+    SetServerConfigDqlMaxQueue(const std::string& value);
 
     /* db config */
     Status
@@ -435,6 +568,12 @@ class Config {
     SetDBConfigArchiveDaysThreshold(const std::string& value);
     Status
     SetDBConfigAutoFlushInterval(const std::string& value);
+    Status
+    SetDBConfigMergePolicy(const std::string& value);
+    Status
+    SetDBConfigMergeIORateLimit(const std::string& value);
+    Status
+    SetDBConfigMetaSnapshotInterval(const std::string& value);
 
     /* storage config */
     Status
@@ -453,6 +592,12 @@ class Config {
     SetStorageConfigS3SecretKey(const std::string& value);
     Status
     SetStorageConfigS3Bucket(const std::string& value);
+    Status
+    SetStorageConfigS3ReadChunkSize(const std::string& value);
+    Status
+    SetStorageConfigS3ReadThreadNum(const std::string& value);
+    Status
+    SetStorageConfigS3DiskCacheCapacity(const std::string& value);
 
     /* metric config */
     Status
@@ -471,6 +616,14 @@ class Config {
     SetCacheConfigInsertBufferSize(const std::string& value);
     Status
     SetCacheConfigCacheInsertData(const std::string& value);
+    Status
+    SetCacheConfigCpuCacheShardNum(const std::string& value);
+    Status
+    SetCacheConfigCpuCachePolicy(const std::string& value);
+    Status
+    SetCacheConfigCpuCacheWatermark(const std::string& value);
+    Status
+    SetCacheConfigIdCacheCapacity(const std::string& value);
 
     /* engine config */
     Status
@@ -479,6 +632,18 @@ class Config {
     SetEngineConfigOmpThreadNum(const std::string& value);
     Status
     SetEngineConfigUseAVX512(const std::string& value);
+    Status
+    SetEngineConfigUseMmap(const std::string& value);
+    Status
+    SetEngineConfigSearchWorkerNum(const std::string& value);
+    Status
+    SetEngineConfigSearchBatchMaxNq(const std::string& value);
+    Status
+    SetEngineConfigSearchBatchMaxWait(const std::string& value);
+    Status
+    SetEngineConfigIncrementalHnsw(const std::string& value);
+    Status
+    SetEngineConfigSharedIvfQuantizer(const std::string& value);
 
     /* tracing config */
     Status
@@ -492,6 +657,8 @@ class Config {
     Status
     SetWalConfigBufferSize(const std::string& value);
     Status
+    SetWalConfigDurability(const std::string& value);
+    Status
     SetWalConfigWalPath(const std::string& value);
 
 #ifdef MILVUS_GPU_VERSION
@@ -30,7 +30,9 @@
 #include "cache/GpuCacheMgr.h"
 #include "db/IDGenerator.h"
 #include "engine/EngineFactory.h"
+#include "engine/IncrementalGraphMgr.h"
 #include "insert/MemMenagerFactory.h"
+#include "merge/MergePolicyFactory.h"
 #include "meta/MetaConsts.h"
 #include "meta/MetaFactory.h"
 #include "meta/SqliteMetaImpl.h"
@@ -41,6 +43,7 @@
 #include "scheduler/job/SearchJob.h"
 #include "segment/SegmentReader.h"
 #include "segment/SegmentWriter.h"
+#include "segment/VectorIndex.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
 #include "utils/StringHelpFunctions.h"
@@ -59,12 +62,42 @@ constexpr uint64_t INDEX_ACTION_INTERVAL = 1;
 
 static const Status SHUTDOWN_ERROR = Status(DB_ERROR, "Milvus server is shutdown!");
 
+// the vectors of the first file keep their offsets in the merged segment, so does the graph checkpoint of its
+// segment; move the largest file with a checkpoint and without deleted docs to the front, return its segment
+std::string
+MoveGraphSourceToFront(meta::TableFilesSchema& files) {
+    int64_t source = -1;
+    std::string source_dir;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::string segment_dir;
+        utils::GetParentPath(files[i].location_, segment_dir);
+        segment::SegmentReader segment_reader(segment_dir);
+        if (!segment_reader.HasVectorsIndex()) {
+            continue;
+        }
+        segment::DeletedDocsPtr deleted_docs_ptr;
+        if (!segment_reader.LoadDeletedDocs(deleted_docs_ptr).ok() || deleted_docs_ptr->GetSize() > 0) {
+            continue;
+        }
+        if (source < 0 || files[i].row_count_ > files[source].row_count_) {
+            source = i;
+            source_dir = segment_dir;
+        }
+    }
+
+    if (source > 0) {
+        std::rotate(files.begin(), files.begin() + source, files.begin() + source + 1);
+    }
+    return source_dir;
+}
+
 }  // namespace
 
 DBImpl::DBImpl(const DBOptions& options)
     : options_(options), initialized_(false), merge_thread_pool_(1, 1), index_thread_pool_(1, 1) {
     meta_ptr_ = MetaFactory::Build(options.meta_, options.mode_);
     mem_mgr_ = MemManagerFactory::Build(meta_ptr_, options_);
+    merge_policy_ = MergePolicyFactory::Build(options_);
 
     if (options_.wal_enable_) {
         wal::MXLogConfiguration mxlog_config;
@@ -72,6 +105,11 @@ DBImpl::DBImpl(const DBOptions& options)
         // 2 buffers in the WAL
         mxlog_config.buffer_size = options_.buffer_size_ / 2;
         mxlog_config.mxlog_path = options_.mxlog_path_;
+        if (options_.durability_ == wal::WAL_DURABILITY_NONE) {
+            mxlog_config.durability = wal::MXLogDurability::None;
+        } else if (options_.durability_ == wal::WAL_DURABILITY_SYNC) {
+            mxlog_config.durability = wal::MXLogDurability::Sync;
+        }
         wal_mgr_ = std::make_shared<wal::WalManager>(mxlog_config);
     }
 
@@ -766,11 +804,13 @@ DBImpl::CompactFile(const std::string& table_id, const meta::TableFileSchema& fi
     utils::GetParentPath(file.location_, segment_dir_to_merge);
 
     ENGINE_LOG_DEBUG << "Compacting begin...";
-    segment_writer_ptr->Merge(segment_dir_to_merge, compacted_file.file_id_);
+    status = segment_writer_ptr->Merge(segment_dir_to_merge, compacted_file.file_id_);
 
     // Serialize
     ENGINE_LOG_DEBUG << "Serializing compacted segment...";
-    status = segment_writer_ptr->Serialize();
+    if (status.ok()) {
+        status = segment_writer_ptr->Serialize();
+    }
     if (!status.ok()) {
         ENGINE_LOG_ERROR << "Failed to serialize compacted segment: " << status.message();
         compacted_file.file_type_ = meta::TableFileSchema::TO_DELETE;
@@ -816,6 +856,7 @@ DBImpl::CompactFile(const std::string& table_id, const meta::TableFileSchema& fi
     ENGINE_LOG_DEBUG << "Compacted segment " << compacted_file.segment_id_ << " from "
                      << std::to_string(file.file_size_) << " bytes to " << std::to_string(compacted_file.file_size_)
                      << " bytes";
+    server::Metrics::GetInstance().MergeWriteBytesTotalIncrement(compacted_file.file_size_);
 
     if (options_.insert_cache_immediately_) {
         segment_writer_ptr->Cache();
@@ -939,15 +980,14 @@ DBImpl::GetVectorIDs(const std::string& table_id, const std::string& segment_id,
     }
 
     // step 4: construct id array
-    // avoid duplicate offset and erase from max offset to min offset
-    auto& deleted_offset = deleted_docs_ptr->GetDeletedDocs();
-    std::set<segment::offset_t, std::greater<segment::offset_t>> ordered_offset;
-    for (segment::offset_t offset : deleted_offset) {
-        ordered_offset.insert(offset);
-    }
-    for (segment::offset_t offset : ordered_offset) {
-        uids.erase(uids.begin() + offset);
+    // keep the uids whose offsets are not deleted
+    size_t remain = 0;
+    for (size_t i = 0; i < uids.size(); ++i) {
+        if (!deleted_docs_ptr->IsDeleted(i)) {
+            uids[remain++] = uids[i];
+        }
     }
+    uids.resize(remain);
     vector_ids.swap(uids);
 
     return status;
@@ -968,17 +1008,15 @@ DBImpl::GetVectorByIdHelper(const std::string& table_id, IDNumber vector_id, Vec
 
         // Check if the id is present in bloom filter.
         if (id_bloom_filter_ptr->Check(vector_id)) {
-            // Load uids and check if the id is indeed present. If yes, find its offset.
-            std::vector<int64_t> offsets;
-            std::vector<segment::doc_id_t> uids;
-            auto status = segment_reader.LoadUids(uids);
+            // Look up the id index to check if the id is indeed present. If yes, find its offset.
+            segment::IdIndexPtr id_index_ptr;
+            auto status = segment_reader.LoadIdIndex(id_index_ptr);
             if (!status.ok()) {
                 return status;
             }
 
-            auto found = std::find(uids.begin(), uids.end(), vector_id);
-            if (found != uids.end()) {
-                auto offset = std::distance(uids.begin(), found);
+            segment::offset_t offset;
+            if (id_index_ptr->Find(vector_id, offset)) {
 
                 // Check whether the id has been deleted
                 segment::DeletedDocsPtr deleted_docs_ptr;
@@ -986,10 +1024,7 @@ DBImpl::GetVectorByIdHelper(const std::string& table_id, IDNumber vector_id, Vec
                 if (!status.ok()) {
                     return status;
                 }
-                auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
-
-                auto deleted = std::find(deleted_docs.begin(), deleted_docs.end(), offset);
-                if (deleted == deleted_docs.end()) {
+                if (!deleted_docs_ptr->IsDeleted(offset)) {
                     // Load raw vector
                     bool is_binary = utils::IsBinaryMetricType(file.metric_type_);
                     size_t single_vector_bytes = is_binary ? file.dimension_ / 8 : file.dimension_ * sizeof(float);
@@ -1306,6 +1341,19 @@ DBImpl::StartMetricTask() {
         server::Metrics::GetInstance().CpuCacheUsageGaugeSet(0);
     }
 
+    // hit ratio of the cpu cache since last report
+    static uint64_t last_cache_hit = 0, last_cache_miss = 0;
+    uint64_t cache_hit = cache::CpuCacheMgr::GetInstance()->CacheHitCount();
+    uint64_t cache_miss = cache::CpuCacheMgr::GetInstance()->CacheMissCount();
+    uint64_t cache_access = (cache_hit - last_cache_hit) + (cache_miss - last_cache_miss);
+    if (cache_access > 0) {
+        double hit_ratio = (double)(cache_hit - last_cache_hit) / cache_access;
+        server::Metrics::GetInstance().CpuCacheHitRatioGaugeSet(cache::CpuCacheMgr::GetInstance()->CachePolicyName(),
+                                                                hit_ratio);
+    }
+    last_cache_hit = cache_hit;
+    last_cache_miss = cache_miss;
+
     server::Metrics::GetInstance().GpuCacheUsageGaugeSet();
     uint64_t size;
     Size(size);
@@ -1400,11 +1448,17 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::TableFilesSchema& fi
     utils::GetParentPath(table_file.location_, new_segment_dir);
     auto segment_writer_ptr = std::make_shared<segment::SegmentWriter>(new_segment_dir);
 
-    for (auto& file : files) {
+    meta::TableFilesSchema files_to_merge = files;
+    std::string graph_source_dir = MoveGraphSourceToFront(files_to_merge);
+
+    for (auto& file : files_to_merge) {
         server::CollectMergeFilesMetrics metrics;
         std::string segment_dir_to_merge;
         utils::GetParentPath(file.location_, segment_dir_to_merge);
-        segment_writer_ptr->Merge(segment_dir_to_merge, table_file.file_id_);
+        status = segment_writer_ptr->Merge(segment_dir_to_merge, table_file.file_id_);
+        if (!status.ok()) {
+            break;
+        }
         auto file_schema = file;
         file_schema.file_type_ = meta::TableFileSchema::TO_DELETE;
         updated.push_back(file_schema);
@@ -1416,7 +1470,9 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::TableFilesSchema& fi
 
     // step 3: serialize to disk
     try {
-        status = segment_writer_ptr->Serialize();
+        if (status.ok()) {
+            status = segment_writer_ptr->Serialize();
+        }
         fiu_do_on("DBImpl.MergeFiles.Serialize_ThrowException", throw std::exception());
         fiu_do_on("DBImpl.MergeFiles.Serialize_ErrorStatus", status = Status(DB_ERROR, ""));
     } catch (std::exception& ex) {
@@ -1431,8 +1487,11 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::TableFilesSchema& fi
         // if failed to serialize merge file to disk
         // typical error: out of disk space, out of memory or permission denied
         table_file.file_type_ = meta::TableFileSchema::TO_DELETE;
-        status = meta_ptr_->UpdateTableFile(table_file);
-        ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << table_file.file_id_ << " to to_delete";
+        auto mark_status = meta_ptr_->UpdateTableFile(table_file);
+        if (mark_status.ok()) {
+            ENGINE_LOG_DEBUG << "Failed to update file to index, mark file: " << table_file.file_id_
+                             << " to to_delete";
+        }
 
         return status;
     }
@@ -1449,10 +1508,22 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::TableFilesSchema& fi
     }
     table_file.file_size_ = segment_writer_ptr->Size();
     table_file.row_count_ = segment_writer_ptr->VectorCount();
+
+    if (table_file.row_count_ == 0) {
+        ENGINE_LOG_DEBUG << "Merged segment is empty. Mark it as TO_DELETE";
+        table_file.file_type_ = meta::TableFileSchema::TO_DELETE;
+    }
+
+    // the graph of the largest merged segment is extended by the vectors of the others in background
+    if (utils::IsIncrementalGraphFile(table_file)) {
+        IncrementalGraphMgr::GetInstance().Schedule(table_file, graph_source_dir);
+    }
+
     updated.push_back(table_file);
     status = meta_ptr_->UpdateTableFiles(updated);
     ENGINE_LOG_DEBUG << "New merged segment " << table_file.segment_id_ << " of size " << segment_writer_ptr->Size()
                      << " bytes";
+    server::Metrics::GetInstance().MergeWriteBytesTotalIncrement(segment_writer_ptr->Size());
 
     if (options_.insert_cache_immediately_) {
         segment_writer_ptr->Cache();
@@ -1463,7 +1534,34 @@ DBImpl::MergeFiles(const std::string& table_id, const meta::TableFilesSchema& fi
 
 Status
 DBImpl::BackgroundMergeFiles(const std::string& table_id) {
+    // merge one group of files at a time, flush waits for one merge only and the merge io is throttled between
+    // merges; the files are picked again after each merge since flush and compact change them meanwhile
+    while (true) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t io_size = 0;
+        auto status = MergeOrCompactOnce(table_id, io_size);
+        if (!status.ok()) {
+            return status;
+        }
+
+        if (!initialized_.load(std::memory_order_acquire)) {
+            ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action for table: " << table_id;
+            break;
+        }
+
+        if (io_size == 0) {
+            break;
+        }
+        ThrottleMergeIO(start, io_size);
+    }
+
+    return Status::OK();
+}
+
+Status
+DBImpl::MergeOrCompactOnce(const std::string& table_id, uint64_t& io_size) {
     const std::lock_guard<std::mutex> lock(flush_merge_compact_mutex_);
+    io_size = 0;
 
     meta::TableFilesSchema raw_files;
     auto status = meta_ptr_->FilesToMerge(table_id, raw_files);
@@ -1472,20 +1570,81 @@ DBImpl::BackgroundMergeFiles(const std::string& table_id) {
         return status;
     }
 
-    if (raw_files.size() < options_.merge_trigger_number_) {
-        ENGINE_LOG_TRACE << "Files number not greater equal than merge trigger number, skip merge action";
+    MergeFilesGroups groups;
+    merge_policy_->PickFilesToMerge(raw_files, groups);
+    if (!groups.empty()) {
+        auto& files = groups.front();
+        for (auto& file : files) {
+            io_size += 2 * file.file_size_;  // read and written again
+        }
+
+        status = OngoingFileChecker::GetInstance().MarkOngoingFiles(files);
+        status = MergeFiles(table_id, files);
+        OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files);
+        return status;
+    }
+
+    // the segments of index_file_size or larger are compacted when they have too many deleted vectors,
+    // skip it while an index is being built, the segment may be in use
+    std::unique_lock<std::mutex> index_lock(build_index_mutex_, std::try_to_lock);
+    if (!index_lock.owns_lock()) {
         return Status::OK();
     }
 
-    status = OngoingFileChecker::GetInstance().MarkOngoingFiles(raw_files);
-    MergeFiles(table_id, raw_files);
-    status = OngoingFileChecker::GetInstance().UnmarkOngoingFiles(raw_files);
+    std::vector<int> file_types{meta::TableFileSchema::FILE_TYPE::RAW, meta::TableFileSchema::FILE_TYPE::TO_INDEX,
+                                meta::TableFileSchema::FILE_TYPE::BACKUP};
+    meta::TableFilesSchema files;
+    status = meta_ptr_->FilesByType(table_id, file_types, files);
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to get compact files for table: " << table_id;
+        return status;
+    }
 
-    if (!initialized_.load(std::memory_order_acquire)) {
-        ENGINE_LOG_DEBUG << "Server will shutdown, skip merge action for table: " << table_id;
+    meta::TableFilesSchema large_files;
+    for (auto& file : files) {
+        if (file.file_size_ >= static_cast<size_t>(file.index_file_size_)) {
+            large_files.push_back(file);
+        }
     }
 
-    return Status::OK();
+    meta::TableFilesSchema files_to_compact;
+    merge_policy_->PickFilesToCompact(large_files, files_to_compact);
+    if (files_to_compact.empty()) {
+        return Status::OK();
+    }
+
+    auto& file = files_to_compact.front();
+    io_size = 2 * file.file_size_;
+    ENGINE_LOG_DEBUG << "Segment " << file.segment_id_ << " has " << file.row_count_ << " vectors in "
+                     << file.file_size_ << " bytes, compact it";
+
+    OngoingFileChecker::GetInstance().MarkOngoingFile(file);
+    meta::TableFilesSchema files_to_update;
+    status = CompactFile(table_id, file, files_to_update);
+    if (status.ok()) {
+        status = meta_ptr_->UpdateTableFiles(files_to_update);
+    }
+    OngoingFileChecker::GetInstance().UnmarkOngoingFile(file);
+
+    return status;
+}
+
+void
+DBImpl::ThrottleMergeIO(const std::chrono::steady_clock::time_point& start, uint64_t io_size) {
+    if (options_.merge_io_rate_limit_ <= 0) {
+        return;
+    }
+
+    // wait until the merge io is within the rate limit, wake up in time for shutdown
+    auto deadline = start + std::chrono::microseconds(io_size * 1000000 / options_.merge_io_rate_limit_);
+    const auto max_sleep = std::chrono::milliseconds(100);
+    while (initialized_.load(std::memory_order_acquire)) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            break;
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, max_sleep));
+    }
 }
 
 void
@@ -1588,6 +1747,9 @@ DBImpl::BackgroundBuildIndex() {
 
         ENGINE_LOG_DEBUG << "Background build index thread finished";
     }
+
+    // graphs of raw segments scheduled by flushes, merges and searches
+    IncrementalGraphMgr::GetInstance().BuildScheduled(options_.insert_cache_immediately_);
 }
 
 Status
@@ -1807,6 +1969,9 @@ DBImpl::DropTableIndexRecursively(const std::string& table_id) {
         return status;
     }
 
+    // the index files built for the next index must not be trained with the quantizer of this one
+    utils::EraseTableQuantizers(options_.meta_, table_id);
+
     // drop partition index
     std::vector<meta::TableSchema> partition_array;
     status = meta_ptr_->ShowPartitions(table_id, partition_array);
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <map>
@@ -28,6 +29,7 @@
 #include "db/OngoingFileChecker.h"
 #include "db/Types.h"
 #include "db/insert/MemManager.h"
+#include "db/merge/MergePolicy.h"
 #include "utils/ThreadPool.h"
 #include "wal/WalManager.h"
 
@@ -178,6 +180,10 @@ class DBImpl : public DB, public server::CacheConfigHandler {
     MergeFiles(const std::string& table_id, const meta::TableFilesSchema& files);
     Status
     BackgroundMergeFiles(const std::string& table_id);
+    Status
+    MergeOrCompactOnce(const std::string& table_id, uint64_t& io_size);
+    void
+    ThrottleMergeIO(const std::chrono::steady_clock::time_point& start, uint64_t io_size);
     void
     BackgroundMerge(std::set<std::string> table_ids);
 
@@ -291,6 +297,7 @@ class DBImpl : public DB, public server::CacheConfigHandler {
     std::mutex merge_result_mutex_;
     std::list<std::future<void>> merge_thread_results_;
     std::set<std::string> merge_table_ids_;
+    MergePolicyPtr merge_policy_;
 
     ThreadPool index_thread_pool_;
     std::mutex index_result_mutex_;
@@ -59,12 +59,18 @@ struct DBMetaOptions {
     std::vector<std::string> slave_paths_;
     std::string backend_uri_;
     ArchiveConf archive_conf_ = ArchiveConf("delete");
+    int64_t snapshot_interval_ = 0;  // seconds between reconciliations of the meta snapshot, 0 means no snapshot
 };  // DBMetaOptions
 
 struct DBOptions {
     typedef enum { SINGLE = 0, CLUSTER_READONLY, CLUSTER_WRITABLE } MODE;
 
     uint16_t merge_trigger_number_ = 2;
+    // merge policy relative configurations
+    std::string merge_policy_ = "simple";
+    uint64_t merge_tier_factor_ = 4;
+    double merge_deleted_ratio_ = 0.5;
+    int64_t merge_io_rate_limit_ = 0;  // bytes per second read and written by merges, 0 means no limit
     DBMetaOptions meta_;
     int mode_ = MODE::SINGLE;
 
@@ -77,6 +83,7 @@ struct DBOptions {
     bool wal_enable_ = true;
     bool recovery_error_ignore_ = true;
     int64_t buffer_size_ = 256;
+    std::string durability_ = "flush";
     std::string mxlog_path_ = "/tmp/milvus/wal/";
 };  // Options
 
@@ -18,7 +18,13 @@
 #include <regex>
 #include <vector>
 
+#include "cache/CpuCacheMgr.h"
+#include "cache/IdCacheMgr.h"
 #include "config/Config.h"
+#include "db/engine/SharedQuantizerMgr.h"
+#include "segment/IdBloomFilter.h"
+#include "segment/IdIndex.h"
+#include "segment/VectorIndex.h"
 #include "storage/s3/S3ClientWrapper.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
@@ -109,9 +115,11 @@ DeleteTablePath(const DBMetaOptions& options, const std::string& table_id, bool
         std::string table_path = path + TABLES_FOLDER + table_id;
         if (force) {
             boost::filesystem::remove_all(table_path);
+            SharedQuantizerMgr::GetInstance().EraseTable(table_path);
             ENGINE_LOG_DEBUG << "Remove table folder: " << table_path;
         } else if (boost::filesystem::exists(table_path) && boost::filesystem::is_empty(table_path)) {
             boost::filesystem::remove_all(table_path);
+            SharedQuantizerMgr::GetInstance().EraseTable(table_path);
             ENGINE_LOG_DEBUG << "Remove table folder: " << table_path;
         }
     }
@@ -133,6 +141,16 @@ DeleteTablePath(const DBMetaOptions& options, const std::string& table_id, bool
     return Status::OK();
 }
 
+void
+EraseTableQuantizers(const DBMetaOptions& options, const std::string& table_id) {
+    std::vector<std::string> paths = options.slave_paths_;
+    paths.push_back(options.path_);
+
+    for (auto& path : paths) {
+        SharedQuantizerMgr::GetInstance().EraseTable(path + TABLES_FOLDER + table_id);
+    }
+}
+
 Status
 CreateTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file) {
     std::string parent_path = GetTableFileParentFolder(options, table_file);
@@ -198,6 +216,9 @@ DeleteSegment(const DBMetaOptions& options, meta::TableFileSchema& table_file) {
     utils::GetTableFilePath(options, table_file);
     std::string segment_dir;
     GetParentPath(table_file.location_, segment_dir);
+    cache::IdCacheMgr::GetInstance()->EraseItem(segment::IdBloomFilter::CacheKey(segment_dir));
+    cache::IdCacheMgr::GetInstance()->EraseItem(segment::IdIndex::CacheKey(segment_dir));
+    cache::CpuCacheMgr::GetInstance()->EraseItem(segment::VectorIndex::CacheKey(segment_dir));
     boost::filesystem::remove_all(segment_dir);
     return Status::OK();
 }
@@ -220,6 +241,16 @@ IsRawIndexType(int32_t type) {
     return (type == (int32_t)EngineType::FAISS_IDMAP) || (type == (int32_t)EngineType::FAISS_BIN_IDMAP);
 }
 
+bool
+IsIncrementalGraphFile(const meta::TableFileSchema& file) {
+    if (file.file_type_ != meta::TableFileSchema::RAW || file.engine_type_ != (int32_t)EngineType::HNSW) {
+        return false;
+    }
+    bool incremental_hnsw = false;
+    server::Config::GetInstance().GetEngineConfigIncrementalHnsw(incremental_hnsw);
+    return incremental_hnsw;
+}
+
 bool
 IsBinaryIndexType(int32_t index_type) {
     return (index_type == (int32_t)engine::EngineType::FAISS_BIN_IDMAP) ||
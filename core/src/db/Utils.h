@@ -29,6 +29,9 @@ Status
 CreateTablePath(const DBMetaOptions& options, const std::string& table_id);
 Status
 DeleteTablePath(const DBMetaOptions& options, const std::string& table_id, bool force = true);
+// drop the coarse quantizers shared by the index files of a table, once its index is dropped
+void
+EraseTableQuantizers(const DBMetaOptions& options, const std::string& table_id);
 
 Status
 CreateTableFilePath(const DBMetaOptions& options, meta::TableFileSchema& table_file);
@@ -48,6 +51,10 @@ IsSameIndex(const TableIndex& index1, const TableIndex& index2);
 bool
 IsRawIndexType(int32_t type);
 
+// raw files of HNSW tables are searched through a graph of their segment if engine_config.incremental_hnsw is on
+bool
+IsIncrementalGraphFile(const meta::TableFileSchema& file);
+
 static bool
 IsBinaryIndexType(int32_t index_type);
 
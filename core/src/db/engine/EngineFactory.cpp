@@ -20,15 +20,15 @@ namespace engine {
 
 ExecutionEnginePtr
 EngineFactory::Build(uint16_t dimension, const std::string& location, EngineType index_type, MetricType metric_type,
-                     const milvus::json& index_params) {
+                     const milvus::json& index_params, bool incremental_graph) {
     if (index_type == EngineType::INVALID) {
         ENGINE_LOG_ERROR << "Unsupported engine type";
         return nullptr;
     }
 
     ENGINE_LOG_DEBUG << "EngineFactory index type: " << (int)index_type;
-    ExecutionEnginePtr execution_engine_ptr =
-        std::make_shared<ExecutionEngineImpl>(dimension, location, index_type, metric_type, index_params);
+    ExecutionEnginePtr execution_engine_ptr = std::make_shared<ExecutionEngineImpl>(
+        dimension, location, index_type, metric_type, index_params, incremental_graph);
 
     execution_engine_ptr->Init();
     return execution_engine_ptr;
@@ -22,9 +22,10 @@ namespace engine {
 
 class EngineFactory {
  public:
+    // incremental_graph: load a raw file of an HNSW collection as a graph, see ExecutionEngineImpl
     static ExecutionEnginePtr
     Build(uint16_t dimension, const std::string& location, EngineType index_type, MetricType metric_type,
-          const milvus::json& index_params);
+          const milvus::json& index_params, bool incremental_graph = false);
 };
 
 }  // namespace engine
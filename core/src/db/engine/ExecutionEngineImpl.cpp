@@ -14,6 +14,9 @@
 #include <faiss/utils/ConcurrentBitset.h>
 #include <fiu-local.h>
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -22,9 +25,14 @@
 #include "cache/GpuCacheMgr.h"
 #include "config/Config.h"
 #include "db/Utils.h"
+#include "db/engine/IncrementalGraphMgr.h"
+#include "db/engine/SharedQuantizerMgr.h"
 #include "knowhere/common/Config.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "metrics/Metrics.h"
 #include "scheduler/Utils.h"
+#include "segment/SegmentWriter.h"
+#include "segment/VectorIndex.h"
 #include "utils/CommonUtil.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
@@ -94,12 +102,14 @@ class CachedQuantizer : public cache::DataObj {
 };
 
 ExecutionEngineImpl::ExecutionEngineImpl(uint16_t dimension, const std::string& location, EngineType index_type,
-                                         MetricType metric_type, const milvus::json& index_params)
+                                         MetricType metric_type, const milvus::json& index_params,
+                                         bool incremental_graph)
     : location_(location),
       dim_(dimension),
       index_type_(index_type),
       metric_type_(metric_type),
-      index_params_(index_params) {
+      index_params_(index_params),
+      incremental_graph_(incremental_graph) {
     EngineType tmp_index_type =
         utils::IsBinaryMetricType((int32_t)metric_type) ? EngineType::FAISS_BIN_IDMAP : EngineType::FAISS_IDMAP;
     index_ = CreatetVecIndex(tmp_index_type);
@@ -398,14 +408,25 @@ Status
 ExecutionEngineImpl::Load(bool to_cache) {
     // TODO(zhiru): refactor
 
-    index_ = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(location_));
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+
+    index_ = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(CacheKey()));
+    if (index_ == nullptr && incremental_graph_ && !segment::SegmentReader(segment_dir).HasVectorsIndex()) {
+        FallBackToBruteForce();
+        index_ = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(CacheKey()));
+    }
     bool already_in_cache = (index_ != nullptr);
     if (!already_in_cache) {
-        std::string segment_dir;
-        utils::GetParentPath(location_, segment_dir);
         auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
 
-        if (utils::IsRawIndexType((int32_t)index_type_)) {
+        if (incremental_graph_ && !LoadIncrementalGraph(segment_reader_ptr, segment_reader_ptr, false).ok()) {
+            FallBackToBruteForce();
+        }
+
+        if (incremental_graph_) {
+            // the graph is loaded
+        } else if (utils::IsRawIndexType((int32_t)index_type_)) {
             index_ = index_type_ == EngineType::FAISS_IDMAP ? GetVecIndexFactory(IndexType::FAISS_IDMAP)
                                                             : GetVecIndexFactory(IndexType::FAISS_BIN_IDMAP);
             milvus::json conf{{knowhere::meta::DEVICEID, gpu_num_}, {knowhere::meta::DIM, dim_}};
@@ -416,65 +437,98 @@ ExecutionEngineImpl::Load(bool to_cache) {
                 throw Exception(DB_ERROR, "Illegal index params");
             }
 
-            auto status = segment_reader_ptr->Load();
+            bool use_mmap = false;
+            server::Config::GetInstance().GetEngineConfigUseMmap(use_mmap);
+
+            // with mmap the raw vectors are searched in place from page cache, otherwise they are read into
+            // the segment and copied into the index
+            segment::SegmentPtr segment_ptr;
+            segment::MappedVectorsPtr mapped_vectors;
+            segment::DeletedDocsPtr deleted_docs_ptr;
+            std::vector<segment::doc_id_t> vectors_uids;
+            const uint8_t* vectors_data = nullptr;
+            Status status;
+            if (use_mmap) {
+                status = segment_reader_ptr->LoadVectorsMapped(mapped_vectors);
+                if (status.ok()) {
+                    status = segment_reader_ptr->LoadUids(vectors_uids);
+                }
+                if (status.ok()) {
+                    status = segment_reader_ptr->LoadDeletedDocs(deleted_docs_ptr);
+                }
+            } else {
+                status = segment_reader_ptr->Load();
+                if (status.ok()) {
+                    segment_reader_ptr->GetSegment(segment_ptr);
+                    vectors_uids = segment_ptr->vectors_ptr_->GetUids();
+                    deleted_docs_ptr = segment_ptr->deleted_docs_ptr_;
+                    vectors_data = segment_ptr->vectors_ptr_->GetData().data();
+                }
+            }
             if (!status.ok()) {
                 std::string msg = "Failed to load segment from " + location_;
                 ENGINE_LOG_ERROR << msg;
                 return Status(DB_ERROR, msg);
             }
 
-            segment::SegmentPtr segment_ptr;
-            segment_reader_ptr->GetSegment(segment_ptr);
-            auto& vectors = segment_ptr->vectors_ptr_;
-            auto& deleted_docs = segment_ptr->deleted_docs_ptr_->GetDeletedDocs();
-
-            auto vectors_uids = vectors->GetUids();
+            int64_t count = vectors_uids.size();
+            if (use_mmap) {
+                size_t code_size = (index_type_ == EngineType::FAISS_BIN_IDMAP) ? dim_ / 8 : dim_ * sizeof(float);
+                if (mapped_vectors->GetDataSize() != count * code_size) {
+                    std::string msg = "Raw vectors of " + location_ + " don't match " + std::to_string(count) +
+                                      " uids of dimension " + std::to_string(dim_);
+                    ENGINE_LOG_ERROR << msg;
+                    return Status(DB_ERROR, msg);
+                }
+            }
             index_->SetUids(vectors_uids);
             ENGINE_LOG_DEBUG << "set uids " << index_->GetUids().size() << " for index " << location_;
 
-            auto vectors_data = vectors->GetData();
-
-            faiss::ConcurrentBitsetPtr concurrent_bitset_ptr =
-                std::make_shared<faiss::ConcurrentBitset>(vectors->GetCount());
-            for (auto& offset : deleted_docs) {
-                if (!concurrent_bitset_ptr->test(offset)) {
-                    concurrent_bitset_ptr->set(offset);
-                }
-            }
+            faiss::ConcurrentBitsetPtr concurrent_bitset_ptr;
+            deleted_docs_ptr->GetBitset(count, concurrent_bitset_ptr);
 
             ErrorCode ec = KNOWHERE_UNEXPECTED_ERROR;
+            int64_t index_size = 0;
             if (index_type_ == EngineType::FAISS_IDMAP) {
-                std::vector<float> float_vectors;
-                float_vectors.resize(vectors_data.size() / sizeof(float));
-                memcpy(float_vectors.data(), vectors_data.data(), vectors_data.size());
-                ec = std::static_pointer_cast<BFIndex>(index_)->Build(conf);
+                auto bf_index = std::static_pointer_cast<BFIndex>(index_);
+                ec = bf_index->Build(conf);
                 if (ec != KNOWHERE_SUCCESS) {
                     return status;
                 }
-                status = std::static_pointer_cast<BFIndex>(index_)->AddWithoutIds(vectors->GetCount(),
-                                                                                  float_vectors.data(), Config());
-                status = std::static_pointer_cast<BFIndex>(index_)->SetBlacklist(concurrent_bitset_ptr);
-
-                int64_t index_size = vectors->GetCount() * dim_ * sizeof(float);
-                int64_t bitset_size = vectors->GetCount() / 8;
-                index_->set_size(index_size + bitset_size);
+                if (use_mmap) {
+                    auto raw_data = reinterpret_cast<const float*>(mapped_vectors->GetData());
+                    status = bf_index->AddWithoutIdsNoCopy(count, raw_data, mapped_vectors);
+                } else {
+                    status = bf_index->AddWithoutIds(count, reinterpret_cast<const float*>(vectors_data), Config());
+                }
+                if (status.ok()) {
+                    status = bf_index->SetBlacklist(concurrent_bitset_ptr);
+                }
+                index_size = count * dim_ * sizeof(float);
             } else if (index_type_ == EngineType::FAISS_BIN_IDMAP) {
-                ec = std::static_pointer_cast<BinBFIndex>(index_)->Build(conf);
+                auto bin_bf_index = std::static_pointer_cast<BinBFIndex>(index_);
+                ec = bin_bf_index->Build(conf);
                 if (ec != KNOWHERE_SUCCESS) {
                     return status;
                 }
-                status = std::static_pointer_cast<BinBFIndex>(index_)->AddWithoutIds(vectors->GetCount(),
-                                                                                     vectors_data.data(), Config());
-                status = std::static_pointer_cast<BinBFIndex>(index_)->SetBlacklist(concurrent_bitset_ptr);
-
-                int64_t index_size = vectors->GetCount() * dim_ * sizeof(uint8_t);
-                int64_t bitset_size = vectors->GetCount() / 8;
-                index_->set_size(index_size + bitset_size);
+                if (use_mmap) {
+                    status = bin_bf_index->AddWithoutIdsNoCopy(count, mapped_vectors->GetData(), mapped_vectors);
+                } else {
+                    status = bin_bf_index->AddWithoutIds(count, vectors_data, Config());
+                }
+                if (status.ok()) {
+                    status = bin_bf_index->SetBlacklist(concurrent_bitset_ptr);
+                }
+                index_size = count * dim_ * sizeof(uint8_t);
             }
             if (!status.ok()) {
                 return status;
             }
 
+            // a mapped segment is charged for its whole data, the pages resident in memory change over time
+            int64_t bitset_size = count / 8;
+            index_->set_size(index_size + bitset_size);
+
             ENGINE_LOG_DEBUG << "Finished loading raw data from segment " << segment_dir;
 
         } else {
@@ -495,15 +549,8 @@ ExecutionEngineImpl::Load(bool to_cache) {
                         ENGINE_LOG_ERROR << msg;
                         return Status(DB_ERROR, msg);
                     }
-                    auto& deleted_docs = deleted_docs_ptr->GetDeletedDocs();
-
-                    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr =
-                        std::make_shared<faiss::ConcurrentBitset>(index_->Count());
-                    for (auto& offset : deleted_docs) {
-                        if (!concurrent_bitset_ptr->test(offset)) {
-                            concurrent_bitset_ptr->set(offset);
-                        }
-                    }
+                    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr;
+                    deleted_docs_ptr->GetBitset(index_->Count(), concurrent_bitset_ptr);
 
                     index_->SetBlacklist(concurrent_bitset_ptr);
 
@@ -512,6 +559,12 @@ ExecutionEngineImpl::Load(bool to_cache) {
                     index_->SetUids(uids);
                     ENGINE_LOG_DEBUG << "set uids " << index_->GetUids().size() << " for index " << location_;
 
+                    if (SharedQuantizerMgr::IsShared(index_type_) &&
+                        index_params_.contains(knowhere::IndexParams::nlist)) {
+                        auto nlist = index_params_[knowhere::IndexParams::nlist].get<int64_t>();
+                        SharedQuantizerMgr::GetInstance().Share(location_, index_type_, nlist, index_);
+                    }
+
                     ENGINE_LOG_DEBUG << "Finished loading index file from segment " << segment_dir;
                 }
             } catch (std::exception& e) {
@@ -527,6 +580,144 @@ ExecutionEngineImpl::Load(bool to_cache) {
     return Status::OK();
 }  // namespace engine
 
+Status
+ExecutionEngineImpl::BuildGraph(const std::string& graph_source_dir, bool to_cache) {
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+    auto segment_reader_ptr = std::make_shared<segment::SegmentReader>(segment_dir);
+    auto checkpoint_reader_ptr = segment_reader_ptr;
+    if (!graph_source_dir.empty()) {
+        checkpoint_reader_ptr = std::make_shared<segment::SegmentReader>(graph_source_dir);
+    }
+
+    auto status = LoadIncrementalGraph(segment_reader_ptr, checkpoint_reader_ptr, true);
+    if (status.ok() && to_cache) {
+        Cache();
+    }
+    return status;
+}
+
+void
+ExecutionEngineImpl::FallBackToBruteForce() {
+    // e.g. the segment was written before incremental_hnsw was enabled, or its graph is still being built
+    ENGINE_LOG_DEBUG << "No graph checkpoint of " << location_ << ", search it by brute force";
+    IncrementalGraphMgr::GetInstance().Schedule(location_, dim_, metric_type_, index_params_);
+    incremental_graph_ = false;
+    index_type_ = EngineType::FAISS_IDMAP;
+    index_ = nullptr;
+}
+
+Status
+ExecutionEngineImpl::LoadIncrementalGraph(const segment::SegmentReaderPtr& segment_reader_ptr,
+                                          const segment::SegmentReaderPtr& checkpoint_reader_ptr, bool allow_build) {
+    TimeRecorder rc("ExecutionEngineImpl::LoadIncrementalGraph");
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+
+    auto status = segment_reader_ptr->Load();
+    if (!status.ok()) {
+        std::string msg = "Failed to load segment from " + location_;
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
+    }
+    segment::SegmentPtr segment_ptr;
+    segment_reader_ptr->GetSegment(segment_ptr);
+    std::vector<segment::doc_id_t> vectors_uids = segment_ptr->vectors_ptr_->GetUids();
+    auto vectors_data = reinterpret_cast<const float*>(segment_ptr->vectors_ptr_->GetData().data());
+    int64_t count = vectors_uids.size();
+
+    // the checkpoint covers the vectors of the segment up to the time it was written, or the vectors of the
+    // merge source at the front of the segment
+    int64_t graph_count = 0;
+    index_ = nullptr;
+    segment::VectorIndexPtr vector_index_ptr;
+    status = checkpoint_reader_ptr->LoadVectorsIndex(vector_index_ptr);
+    if (status.ok() && vector_index_ptr != nullptr) {
+        try {
+            index_ = LoadVecIndex(IndexType::HNSW, vector_index_ptr->GetBinarySet(), vector_index_ptr->Size());
+            graph_count = (index_ != nullptr) ? index_->Count() : 0;
+        } catch (std::exception& e) {
+            ENGINE_LOG_ERROR << "Failed to load graph checkpoint of " << segment_dir << ": " << e.what();
+            index_ = nullptr;
+        }
+        if (graph_count > count) {
+            ENGINE_LOG_WARNING << "Graph checkpoint of " << segment_dir << " has more vectors than the segment";
+            index_ = nullptr;
+        }
+    }
+    if (index_ == nullptr) {
+        graph_count = 0;
+    }
+    if (!allow_build && graph_count < count) {
+        index_ = nullptr;
+        return Status(DB_ERROR, "Graph checkpoint of " + segment_dir + " doesn't cover the segment");
+    }
+    rc.RecordSection("load segment and checkpoint");
+
+    // labels of the graph are offsets in the segment, like the raw index
+    std::vector<int64_t> offsets(count - graph_count);
+    std::iota(offsets.begin(), offsets.end(), graph_count);
+    if (index_ == nullptr) {
+        index_ = GetVecIndexFactory(IndexType::HNSW);
+        milvus::json conf = index_params_;
+        conf[knowhere::meta::DIM] = dim_;
+        conf[knowhere::meta::ROWS] = count;
+        conf[knowhere::meta::DEVICEID] = gpu_num_;
+        MappingMetricType(metric_type_, conf);
+        auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
+        if (!adapter->CheckTrain(conf)) {
+            throw Exception(DB_ERROR, "Illegal index params");
+        }
+        status = index_->BuildAll(count, vectors_data, offsets.data(), conf);
+    } else if (graph_count < count) {
+        status = index_->Add(count - graph_count, vectors_data + graph_count * dim_, offsets.data());
+    }
+    if (!status.ok()) {
+        ENGINE_LOG_ERROR << "Failed to build graph of " << segment_dir << ": " << status.message();
+        return status;
+    }
+    rc.RecordSection("add " + std::to_string(count - graph_count) + " vectors to graph");
+
+    // a failed checkpoint only costs a longer build next time
+    if (graph_count < count || checkpoint_reader_ptr != segment_reader_ptr) {
+        auto checkpoint = std::make_shared<segment::VectorIndex>(index_->Serialize());
+        segment::SegmentWriter segment_writer(segment_dir);
+        status = segment_writer.WriteVectorsIndex(checkpoint);
+        if (!status.ok()) {
+            ENGINE_LOG_WARNING << "Failed to checkpoint graph of " << segment_dir << ": " << status.message();
+        }
+        rc.RecordSection("checkpoint graph");
+    }
+
+    index_->SetUids(vectors_uids);
+    faiss::ConcurrentBitsetPtr concurrent_bitset_ptr;
+    segment_ptr->deleted_docs_ptr_->GetBitset(count, concurrent_bitset_ptr);
+    index_->SetBlacklist(concurrent_bitset_ptr);
+
+    // raw vectors and links of the base layer, upper layers are small
+    int64_t M = 16;
+    if (index_params_.contains(knowhere::IndexParams::M)) {
+        M = index_params_[knowhere::IndexParams::M].get<int64_t>();
+    }
+    int64_t element_size = dim_ * sizeof(float) + 2 * M * sizeof(uint32_t) + sizeof(int64_t);
+    index_->set_size(count * element_size + count / 8);
+
+    ENGINE_LOG_DEBUG << "Finished loading graph of segment " << segment_dir << ", " << graph_count
+                     << " vectors from checkpoint, " << count - graph_count << " vectors added";
+    return Status::OK();
+}
+
+std::string
+ExecutionEngineImpl::CacheKey() const {
+    // the graph belongs to the segment, a brute force index of the same file is cached by its location
+    if (incremental_graph_) {
+        std::string segment_dir;
+        utils::GetParentPath(location_, segment_dir);
+        return segment::VectorIndex::CacheKey(segment_dir);
+    }
+    return location_;
+}
+
 Status
 ExecutionEngineImpl::CopyToGpu(uint64_t device_id, bool hybrid) {
 #if 0
@@ -736,6 +927,17 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     }
     ENGINE_LOG_DEBUG << "Index config: " << conf.dump();
 
+    // the IVF index files of a table are trained with the coarse quantizer of the table
+    int64_t nlist = 0;
+    bool share_quantizer = SharedQuantizerMgr::IsShared(engine_type) && conf.contains(knowhere::IndexParams::nlist);
+    if (share_quantizer) {
+        nlist = conf[knowhere::IndexParams::nlist].get<int64_t>();
+        auto quantizer = SharedQuantizerMgr::GetInstance().Get(location, engine_type, nlist);
+        if (quantizer != nullptr) {
+            to_index->SetSharedQuantizer(quantizer);
+        }
+    }
+
     auto status = Status::OK();
     std::vector<segment::doc_id_t> uids;
     faiss::ConcurrentBitsetPtr blacklist;
@@ -758,6 +960,9 @@ ExecutionEngineImpl::BuildIndex(const std::string& location, EngineType engine_t
     if (!status.ok()) {
         throw Exception(DB_ERROR, status.message());
     }
+    if (share_quantizer) {
+        SharedQuantizerMgr::GetInstance().Share(location, engine_type, nlist, to_index);
+    }
 
     ENGINE_LOG_DEBUG << "Finish build index file: " << location << " size: " << to_index->Size();
     return std::make_shared<ExecutionEngineImpl>(to_index, location, engine_type, metric_type_, index_params_);
@@ -838,6 +1043,10 @@ ExecutionEngineImpl::Search(int64_t n, const float* data, int64_t k, const milvu
 
     milvus::json conf = extra_params;
     conf[knowhere::meta::TOPK] = k;
+    // ef is not required by the searches on raw files
+    if (incremental_graph_ && !conf.contains(knowhere::IndexParams::ef)) {
+        conf[knowhere::IndexParams::ef] = std::max<int64_t>(k, 64);
+    }
     auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
     ENGINE_LOG_DEBUG << "Search params: " << conf.dump();
     if (!adapter->CheckSearch(conf, index_->GetType())) {
@@ -922,6 +1131,9 @@ ExecutionEngineImpl::Search(int64_t n, const std::vector<int64_t>& ids, int64_t
 
     milvus::json conf = extra_params;
     conf[knowhere::meta::TOPK] = k;
+    if (incremental_graph_ && !conf.contains(knowhere::IndexParams::ef)) {
+        conf[knowhere::IndexParams::ef] = std::max<int64_t>(k, 64);
+    }
     auto adapter = AdapterMgr::GetInstance().GetAdapter(index_->GetType());
     ENGINE_LOG_DEBUG << "Search params: " << conf.dump();
     if (!adapter->CheckSearch(conf, index_->GetType())) {
@@ -934,48 +1146,58 @@ ExecutionEngineImpl::Search(int64_t n, const std::vector<int64_t>& ids, int64_t
 
     rc.RecordSection("search prepare");
 
-    // std::string segment_dir;
-    // utils::GetParentPath(location_, segment_dir);
-    // segment::SegmentReader segment_reader(segment_dir);
-    //    segment::IdBloomFilterPtr id_bloom_filter_ptr;
-    //    segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+    std::string segment_dir;
+    utils::GetParentPath(location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+    segment::IdIndexPtr id_index_ptr;
+    auto status = segment_reader.LoadIdIndex(id_index_ptr);
+    if (!status.ok()) {
+        return status;
+    }
 
     // Check if the id is present. If so, find its offset
     const std::vector<segment::doc_id_t>& uids = index_->GetUids();
 
+    // ids stay in the id index after they are deleted, deleted offsets are not found
+    segment::DeletedDocsPtr deleted_docs_ptr;
     std::vector<int64_t> offsets;
-    /*
-    std::vector<segment::doc_id_t> uids;
-    auto status = segment_reader.LoadUids(uids);
-    if (!status.ok()) {
-        return status;
-    }
-     */
-
     // There is only one id in ids
     for (auto& id : ids) {
-        //        if (id_bloom_filter_ptr->Check(id)) {
-        //            if (uids.empty()) {
-        //                segment_reader.LoadUids(uids);
-        //            }
-        //            auto found = std::find(uids.begin(), uids.end(), id);
-        //            if (found != uids.end()) {
-        //                auto offset = std::distance(uids.begin(), found);
-        //                offsets.emplace_back(offset);
-        //            }
-        //        }
-        auto found = std::find(uids.begin(), uids.end(), id);
-        if (found != uids.end()) {
-            auto offset = std::distance(uids.begin(), found);
+        segment::offset_t offset;
+        if (!id_index_ptr->Find(id, offset)) {
+            continue;
+        }
+        if (deleted_docs_ptr == nullptr) {
+            status = segment_reader.LoadDeletedDocs(deleted_docs_ptr);
+            if (!status.ok()) {
+                return status;
+            }
+        }
+        if (!deleted_docs_ptr->IsDeleted(offset)) {
             offsets.emplace_back(offset);
         }
     }
 
     rc.RecordSection("get offset");
 
-    auto status = Status::OK();
     if (!offsets.empty()) {
-        status = index_->SearchById(offsets.size(), offsets.data(), distances, labels, conf);
+        if (incremental_graph_) {
+            // the graph can't search by offset, the vectors are read from the segment
+            size_t single_vector_bytes = dim_ * sizeof(float);
+            std::vector<float> vectors(offsets.size() * dim_);
+            for (size_t i = 0; i < offsets.size() && status.ok(); ++i) {
+                std::vector<uint8_t> raw_vector;
+                status = segment_reader.LoadVectors(offsets[i] * single_vector_bytes, single_vector_bytes, raw_vector);
+                if (status.ok()) {
+                    memcpy(vectors.data() + i * dim_, raw_vector.data(), single_vector_bytes);
+                }
+            }
+            if (status.ok()) {
+                status = index_->Search(offsets.size(), vectors.data(), distances, labels, conf);
+            }
+        } else {
+            status = index_->SearchById(offsets.size(), offsets.data(), distances, labels, conf);
+        }
         rc.RecordSection("search done");
 
         // map offsets to ids
@@ -1050,7 +1272,7 @@ ExecutionEngineImpl::GetVectorByID(const int64_t& id, uint8_t* vector, bool hybr
 Status
 ExecutionEngineImpl::Cache() {
     cache::DataObjPtr obj = std::static_pointer_cast<cache::DataObj>(index_);
-    milvus::cache::CpuCacheMgr::GetInstance()->InsertItem(location_, obj);
+    milvus::cache::CpuCacheMgr::GetInstance()->InsertItem(CacheKey(), obj);
 
     return Status::OK();
 }
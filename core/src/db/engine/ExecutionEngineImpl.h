@@ -26,8 +26,10 @@ namespace engine {
 
 class ExecutionEngineImpl : public ExecutionEngine {
  public:
+    // with incremental_graph an HNSW engine loads a raw file as the graph checkpointed in its segment, a segment
+    // without checkpoint is searched by brute force until its graph is built in background
     ExecutionEngineImpl(uint16_t dimension, const std::string& location, EngineType index_type, MetricType metric_type,
-                        const milvus::json& index_params);
+                        const milvus::json& index_params, bool incremental_graph = false);
 
     ExecutionEngineImpl(VecIndexPtr index, const std::string& location, EngineType index_type, MetricType metric_type,
                         const milvus::json& index_params);
@@ -56,6 +58,10 @@ class ExecutionEngineImpl : public ExecutionEngine {
     Status
     Load(bool to_cache) override;
 
+    // build and checkpoint the graph of a raw file, extending the checkpoint of graph_source_dir if not empty
+    Status
+    BuildGraph(const std::string& graph_source_dir, bool to_cache);
+
     Status
     CopyToGpu(uint64_t device_id, bool hybrid = false) override;
 
@@ -123,6 +129,19 @@ class ExecutionEngineImpl : public ExecutionEngine {
     VecIndexPtr
     Load(const std::string& location);
 
+    // load the graph from the checkpoint read by checkpoint_reader_ptr and add the vectors it doesn't cover, with
+    // allow_build false the checkpoint must exist
+    Status
+    LoadIncrementalGraph(const segment::SegmentReaderPtr& segment_reader_ptr,
+                         const segment::SegmentReaderPtr& checkpoint_reader_ptr, bool allow_build);
+
+    // search the raw file by brute force and build its graph in background
+    void
+    FallBackToBruteForce();
+
+    std::string
+    CacheKey() const;
+
     void
     HybridLoad() const;
 
@@ -139,6 +158,7 @@ class ExecutionEngineImpl : public ExecutionEngine {
 
     milvus::json index_params_;
     int64_t gpu_num_ = 0;
+    bool incremental_graph_ = false;
 };
 
 }  // namespace engine
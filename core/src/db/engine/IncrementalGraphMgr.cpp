@@ -0,0 +1,97 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/IncrementalGraphMgr.h"
+
+#include <boost/filesystem.hpp>
+
+#include <memory>
+#include <utility>
+
+#include "cache/CpuCacheMgr.h"
+#include "db/Utils.h"
+#include "db/engine/ExecutionEngineImpl.h"
+#include "segment/VectorIndex.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+void
+IncrementalGraphMgr::Schedule(const std::string& location, uint16_t dimension, MetricType metric_type,
+                              const milvus::json& index_params, const std::string& graph_source_dir) {
+    GraphTask task;
+    task.dimension_ = dimension;
+    task.metric_type_ = metric_type;
+    task.index_params_ = index_params;
+    task.graph_source_dir_ = graph_source_dir;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.insert(std::make_pair(location, std::move(task)));
+}
+
+void
+IncrementalGraphMgr::Schedule(const meta::TableFileSchema& file, const std::string& graph_source_dir) {
+    milvus::json index_params;
+    try {
+        if (!file.index_params_.empty()) {
+            index_params = milvus::json::parse(file.index_params_);
+        }
+    } catch (std::exception& ex) {
+        ENGINE_LOG_WARNING << "Invalid index params of " << file.location_ << ": " << ex.what();
+        return;
+    }
+    Schedule(file.location_, file.dimension_, (MetricType)file.metric_type_, index_params, graph_source_dir);
+}
+
+void
+IncrementalGraphMgr::BuildScheduled(bool to_cache) {
+    std::map<std::string, GraphTask> tasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks.swap(tasks_);
+    }
+
+    for (auto& pair : tasks) {
+        auto& location = pair.first;
+        auto& task = pair.second;
+
+        // the segment was merged or deleted meanwhile, or its graph is loaded already
+        std::string segment_dir;
+        utils::GetParentPath(location, segment_dir);
+        if (!boost::filesystem::exists(segment_dir) ||
+            cache::CpuCacheMgr::GetInstance()->GetIndex(segment::VectorIndex::CacheKey(segment_dir)) != nullptr) {
+            continue;
+        }
+
+        Status status;
+        try {
+            auto engine = std::make_shared<ExecutionEngineImpl>(task.dimension_, location, EngineType::HNSW,
+                                                                task.metric_type_, task.index_params_, true);
+            engine->Init();
+            status = engine->BuildGraph(task.graph_source_dir_, to_cache);
+        } catch (std::exception& ex) {
+            status = Status(DB_ERROR, ex.what());
+        }
+        if (!status.ok()) {
+            ENGINE_LOG_WARNING << "Failed to build graph of segment " << segment_dir << ": " << status.message();
+        }
+    }
+}
+
+size_t
+IncrementalGraphMgr::ScheduledCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+}  // namespace engine
+}  // namespace milvus
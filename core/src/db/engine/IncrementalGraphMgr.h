@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "db/engine/ExecutionEngine.h"
+#include "db/meta/MetaTypes.h"
+#include "utils/Json.h"
+
+namespace milvus {
+namespace engine {
+
+// Raw segments of HNSW tables whose graph is still to be built and checkpointed. Flushes and merges schedule
+// their new segments, searches schedule the segments they find without checkpoint and search them by brute
+// force meanwhile. The graphs are built by the background build index thread, outside the flush and merge lock.
+class IncrementalGraphMgr {
+ public:
+    static IncrementalGraphMgr&
+    GetInstance() {
+        static IncrementalGraphMgr mgr;
+        return mgr;
+    }
+
+    // build the graph of a raw file, starting from the checkpoint of graph_source_dir if not empty
+    void
+    Schedule(const std::string& location, uint16_t dimension, MetricType metric_type,
+             const milvus::json& index_params, const std::string& graph_source_dir = "");
+
+    void
+    Schedule(const meta::TableFileSchema& file, const std::string& graph_source_dir = "");
+
+    // build and checkpoint the graphs of the scheduled files
+    void
+    BuildScheduled(bool to_cache);
+
+    size_t
+    ScheduledCount();
+
+ private:
+    struct GraphTask {
+        uint16_t dimension_ = 0;
+        MetricType metric_type_ = MetricType::L2;
+        milvus::json index_params_;
+        std::string graph_source_dir_;
+    };
+
+    IncrementalGraphMgr() = default;
+
+ private:
+    std::mutex mutex_;
+    // keyed by file location, the first schedule of a file keeps its graph source
+    std::map<std::string, GraphTask> tasks_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,76 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/engine/SharedQuantizerMgr.h"
+
+#include <boost/filesystem.hpp>
+
+#include "config/Config.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+bool
+SharedQuantizerMgr::IsShared(EngineType type) {
+    if (type != EngineType::FAISS_IVFFLAT && type != EngineType::FAISS_IVFSQ8 && type != EngineType::FAISS_PQ) {
+        return false;
+    }
+
+    bool shared = false;
+    server::Config::GetInstance().GetEngineConfigSharedIvfQuantizer(shared);
+    return shared;
+}
+
+knowhere::SharedQuantizerPtr
+SharedQuantizerMgr::Get(const std::string& location, EngineType type, int64_t nlist) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = quantizers_.find(Key(location, type, nlist));
+    return iter == quantizers_.end() ? nullptr : iter->second;
+}
+
+void
+SharedQuantizerMgr::Share(const std::string& location, EngineType type, int64_t nlist, const VecIndexPtr& index) {
+    std::string key = Key(location, type, nlist);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = quantizers_.find(key);
+    if (iter != quantizers_.end()) {
+        index->SetSharedQuantizer(iter->second);
+        return;
+    }
+
+    // an index file built with other parameters doesn't provide the quantizer
+    auto quantizer = index->GetSharedQuantizer();
+    if (quantizer != nullptr && quantizer->quantizer()->ntotal == nlist) {
+        ENGINE_LOG_DEBUG << "Share the coarse quantizer of " << location << " with the index files of its table";
+        quantizers_[key] = quantizer;
+    }
+}
+
+void
+SharedQuantizerMgr::EraseTable(const std::string& table_path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string prefix = table_path + "/";
+    auto iter = quantizers_.lower_bound(prefix);
+    while (iter != quantizers_.end() && iter->first.compare(0, prefix.size(), prefix) == 0) {
+        iter = quantizers_.erase(iter);
+    }
+}
+
+std::string
+SharedQuantizerMgr::Key(const std::string& location, EngineType type, int64_t nlist) {
+    // location is <table path>/<segment id>/<file id>
+    boost::filesystem::path table_path = boost::filesystem::path(location).parent_path().parent_path();
+    return table_path.string() + "/" + std::to_string(static_cast<int>(type)) + "_" + std::to_string(nlist);
+}
+
+}  // namespace engine
+}  // namespace milvus
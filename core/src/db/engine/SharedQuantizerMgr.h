@@ -0,0 +1,65 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "db/engine/ExecutionEngine.h"
+#include "wrapper/VecIndex.h"
+
+namespace milvus {
+namespace engine {
+
+// Coarse quantizers shared by the IVF index files of a table, one per index type and nlist. A partition is a
+// table of its own and has its own quantizer. The first index file built or loaded provides the quantizer,
+// the index files built afterwards are trained with it, and index files with the same centroids point to it
+// instead of keeping a copy. Queries then compute the lists to probe once for all the index files.
+class SharedQuantizerMgr {
+ public:
+    static SharedQuantizerMgr&
+    GetInstance() {
+        static SharedQuantizerMgr mgr;
+        return mgr;
+    }
+
+    // whether the index files of this type share the quantizer of their table
+    static bool
+    IsShared(EngineType type);
+
+    // the quantizer of the table of an index file, nullptr if the table has none yet
+    knowhere::SharedQuantizerPtr
+    Get(const std::string& location, EngineType type, int64_t nlist);
+
+    // make an index file use the quantizer of its table, the quantizer of the index becomes the quantizer of
+    // the table if the table has none yet
+    void
+    Share(const std::string& location, EngineType type, int64_t nlist, const VecIndexPtr& index);
+
+    // drop the quantizers of a table when its folder is deleted or its index is dropped
+    void
+    EraseTable(const std::string& table_path);
+
+ private:
+    SharedQuantizerMgr() = default;
+
+    static std::string
+    Key(const std::string& location, EngineType type, int64_t nlist);
+
+ private:
+    std::mutex mutex_;
+    std::map<std::string, knowhere::SharedQuantizerPtr> quantizers_;
+};
+
+}  // namespace engine
+}  // namespace milvus
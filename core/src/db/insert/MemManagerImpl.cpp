@@ -44,13 +44,8 @@ MemManagerImpl::InsertVectors(const std::string& table_id, int64_t length, const
         }
     }
 
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.float_data_.resize(length * dim);
-    memcpy(vectors_data.float_data_.data(), vectors, length * dim * sizeof(float));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
+    // the source refers to the caller's buffer, the vectors are copied once into the mem table files
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors);
 
     std::unique_lock<std::mutex> lock(mutex_);
 
@@ -70,13 +65,8 @@ MemManagerImpl::InsertVectors(const std::string& table_id, int64_t length, const
         }
     }
 
-    VectorsData vectors_data;
-    vectors_data.vector_count_ = length;
-    vectors_data.binary_data_.resize(length * dim);
-    memcpy(vectors_data.binary_data_.data(), vectors, length * dim * sizeof(uint8_t));
-    vectors_data.id_array_.resize(length);
-    memcpy(vectors_data.id_array_.data(), vector_ids, length * sizeof(IDNumber));
-    VectorSourcePtr source = std::make_shared<VectorSource>(vectors_data);
+    // the source refers to the caller's buffer, the vectors are copied once into the mem table files
+    VectorSourcePtr source = std::make_shared<VectorSource>(length, vector_ids, vectors);
 
     std::unique_lock<std::mutex> lock(mutex_);
 
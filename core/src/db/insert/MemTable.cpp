@@ -13,21 +13,37 @@
 
 #include <cache/CpuCacheMgr.h>
 #include <segment/SegmentReader.h>
+#include <segment/VectorIndex.h>
 #include <wrapper/VecIndex.h>
 
 #include <algorithm>
 #include <chrono>
+#include <future>
 #include <memory>
+#include <set>
 #include <string>
-#include <unordered_map>
+#include <thread>
+#include <vector>
 
 #include "db/OngoingFileChecker.h"
 #include "db/Utils.h"
 #include "utils/Log.h"
+#include "utils/ThreadPool.h"
 
 namespace milvus {
 namespace engine {
 
+namespace {
+
+// the deletes of every table are applied by one long-lived pool, no thread is created per apply
+ThreadPool&
+ApplyDeletesPool() {
+    static ThreadPool pool(std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), MAX_THREADS_NUM));
+    return pool;
+}
+
+}  // namespace
+
 MemTable::MemTable(const std::string& table_id, const meta::MetaPtr& meta, const DBOptions& options)
     : table_id_(table_id), meta_(meta), options_(options) {
     SetIdentity("MemTable");
@@ -161,26 +177,22 @@ MemTable::GetCurrentMem() {
 Status
 MemTable::ApplyDeletes() {
     // Applying deletes to other segments on disk and their corresponding cache:
-    // For each segment in table:
+    // For each segment in table, in parallel:
     //     Load its bloom filter
-    //     For each id in delete list:
-    //         If present, add the uid to segment's uid list
-    // For each segment
+    //     Probe the sorted delete list in one batch, keep the ids that may exist
+    // For each segment with ids that may exist, in parallel:
     //     Get its cache if exists
-    //     Load its uids file.
-    //     Scan the uids, if any uid in segment's uid list exists:
+    //     Load its id index and deleted docs
+    //     Merge the sorted ids with the sorted uids of the id index, for each offset not deleted before:
     //         add its offset to deletedDoc
-    //         remove the id from bloom filter
     //         set black list in cache
-    //     Serialize segment's deletedDoc TODO(zhiru): append directly to previous file for now, may have duplicates
-    //     Serialize bloom filter
+    //     Append segment's deletedDoc as a delta file
+    // Update row count of the changed files in meta
 
     ENGINE_LOG_DEBUG << "Applying " << doc_ids_to_delete_.size() << " deletes in table: " << table_id_;
 
     auto start_total = std::chrono::high_resolution_clock::now();
 
-    //    auto start = std::chrono::high_resolution_clock::now();
-
     std::vector<int> file_types{meta::TableFileSchema::FILE_TYPE::RAW, meta::TableFileSchema::FILE_TYPE::TO_INDEX,
                                 meta::TableFileSchema::FILE_TYPE::BACKUP};
     meta::TableFilesSchema table_files;
@@ -193,201 +205,221 @@ MemTable::ApplyDeletes() {
 
     OngoingFileChecker::GetInstance().MarkOngoingFiles(table_files);
 
-    std::unordered_map<size_t, std::vector<segment::doc_id_t>> ids_to_check_map;
+    // the ids come from a std::set, they are already sorted
+    std::vector<segment::doc_id_t> ids_to_delete(doc_ids_to_delete_.begin(), doc_ids_to_delete_.end());
 
-    for (size_t i = 0; i < table_files.size(); ++i) {
-        auto& table_file = table_files[i];
-        std::string segment_dir;
-        utils::GetParentPath(table_file.location_, segment_dir);
+    ThreadPool& pool = ApplyDeletesPool();
 
-        segment::SegmentReader segment_reader(segment_dir);
-        segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+    std::vector<std::vector<segment::doc_id_t>> ids_to_check_list(table_files.size());
+    std::vector<std::future<Status>> check_results;
+    for (size_t i = 0; i < table_files.size(); ++i) {
+        check_results.emplace_back(pool.enqueue([&, i]() {
+            std::string segment_dir;
+            utils::GetParentPath(table_files[i].location_, segment_dir);
+
+            segment::SegmentReader segment_reader(segment_dir);
+            segment::IdBloomFilterPtr id_bloom_filter_ptr;
+            auto load_status = segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
+            if (!load_status.ok()) {
+                return load_status;
+            }
 
-        for (auto& id : doc_ids_to_delete_) {
-            if (id_bloom_filter_ptr->Check(id)) {
-                ids_to_check_map[i].emplace_back(id);
+            std::vector<uint64_t> maybe_exist;
+            id_bloom_filter_ptr->CheckMany(ids_to_delete.data(), ids_to_delete.size(), maybe_exist);
+            for (size_t j = 0; j < ids_to_delete.size(); ++j) {
+                if (maybe_exist[j >> 6] & (1ULL << (j & 63))) {
+                    ids_to_check_list[i].emplace_back(ids_to_delete[j]);
+                }
             }
+            return Status::OK();
+        }));
+    }
+    for (auto& result : check_results) {
+        auto check_status = result.get();
+        if (status.ok() && !check_status.ok()) {
+            status = check_status;
         }
     }
 
+    // a segment is applied once even if several of its files are listed, the workers own distinct segments
+    std::vector<size_t> files_to_check_index;
     meta::TableFilesSchema files_to_check;
-    for (auto& kv : ids_to_check_map) {
-        files_to_check.emplace_back(table_files[kv.first]);
+    std::set<std::string> segments_to_check;
+    for (size_t i = 0; i < table_files.size(); ++i) {
+        if (!ids_to_check_list[i].empty() && segments_to_check.insert(table_files[i].segment_id_).second) {
+            files_to_check_index.push_back(i);
+            files_to_check.emplace_back(table_files[i]);
+        }
     }
 
+    OngoingFileChecker::GetInstance().MarkOngoingFiles(files_to_check);
     OngoingFileChecker::GetInstance().UnmarkOngoingFiles(table_files);
 
-    OngoingFileChecker::GetInstance().MarkOngoingFiles(files_to_check);
+    if (!status.ok()) {
+        OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files_to_check);
+        std::string err_msg = "Failed to apply deletes: " + status.ToString();
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
 
     auto time0 = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> diff0 = time0 - start_total;
-    ENGINE_LOG_DEBUG << "Found " << ids_to_check_map.size() << " segment to apply deletes in " << diff0.count() << " s";
-
-    meta::TableFilesSchema table_files_to_update;
+    ENGINE_LOG_DEBUG << "Found " << files_to_check.size() << " segment to apply deletes in " << diff0.count() << " s";
 
-    for (auto& kv : ids_to_check_map) {
-        auto& table_file = table_files[kv.first];
-        ENGINE_LOG_DEBUG << "Applying deletes in segment: " << table_file.segment_id_;
-
-        auto time1 = std::chrono::high_resolution_clock::now();
-
-        std::string segment_dir;
-        utils::GetParentPath(table_file.location_, segment_dir);
-        segment::SegmentReader segment_reader(segment_dir);
+    // the files of the segments are fetched up front, the meta isn't queried by the workers
+    std::vector<meta::TableFilesSchema> segment_files_list(files_to_check.size());
+    for (size_t i = 0; i < files_to_check.size() && status.ok(); ++i) {
+        status = meta_->GetTableFilesBySegmentId(files_to_check[i].segment_id_, segment_files_list[i]);
+    }
 
-        auto& segment_id = table_file.segment_id_;
-        meta::TableFilesSchema segment_files;
-        status = meta_->GetTableFilesBySegmentId(segment_id, segment_files);
-        if (!status.ok()) {
-            break;
+    std::vector<std::future<Status>> apply_results;
+    for (size_t i = 0; i < files_to_check.size() && status.ok(); ++i) {
+        apply_results.emplace_back(pool.enqueue([&, i]() {
+            return ApplyDeletesToSegment(files_to_check[i], ids_to_check_list[files_to_check_index[i]],
+                                         segment_files_list[i]);
+        }));
+    }
+    for (auto& result : apply_results) {
+        auto apply_status = result.get();
+        if (status.ok() && !apply_status.ok()) {
+            status = apply_status;
         }
+    }
 
-        // Get all index that contains blacklist in cache
-        std::vector<VecIndexPtr> indexes;
-        std::vector<faiss::ConcurrentBitsetPtr> blacklists;
-        for (auto& file : segment_files) {
-            auto index =
-                std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(file.location_));
-            faiss::ConcurrentBitsetPtr blacklist = nullptr;
-            if (index != nullptr) {
-                index->GetBlacklist(blacklist);
-                if (blacklist != nullptr) {
-                    indexes.emplace_back(index);
-                    blacklists.emplace_back(blacklist);
-                }
-            }
-        }
+    if (!status.ok()) {
+        OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files_to_check);
+        std::string err_msg = "Failed to apply deletes: " + status.ToString();
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
 
-        std::vector<segment::doc_id_t> uids;
-        status = segment_reader.LoadUids(uids);
-        if (!status.ok()) {
-            break;
-        }
-        segment::IdBloomFilterPtr id_bloom_filter_ptr;
-        status = segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
-        if (!status.ok()) {
-            break;
-        }
+    auto time1 = std::chrono::high_resolution_clock::now();
 
-        auto& ids_to_check = kv.second;
+    meta::TableFilesSchema table_files_to_update;
+    for (auto& segment_files : segment_files_list) {
+        table_files_to_update.insert(table_files_to_update.end(), segment_files.begin(), segment_files.end());
+    }
+    status = meta_->UpdateTableFilesRowCount(table_files_to_update);
 
-        segment::DeletedDocsPtr deleted_docs = std::make_shared<segment::DeletedDocs>();
+    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files_to_check);
 
-        auto time2 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff1 = time2 - time1;
-        ENGINE_LOG_DEBUG << "Loading uids and deleted docs took " << diff1.count() << " s";
+    if (!status.ok()) {
+        std::string err_msg = "Failed to apply deletes: " + status.ToString();
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
 
-        std::sort(ids_to_check.begin(), ids_to_check.end());
+    doc_ids_to_delete_.clear();
 
-        auto time3 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff2 = time3 - time2;
-        ENGINE_LOG_DEBUG << "Sorting " << ids_to_check.size() << " ids took " << diff2.count() << " s";
+    auto end_total = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff1 = end_total - time1;
+    ENGINE_LOG_DEBUG << "Update deletes to meta in table " << table_id_ << " in " << diff1.count() << " s";
+    std::chrono::duration<double> diff_total = end_total - start_total;
+    ENGINE_LOG_DEBUG << "Finished applying deletes in table " << table_id_ << " in " << diff_total.count() << " s";
 
-        size_t delete_count = 0;
-        auto find_diff = std::chrono::duration<double>::zero();
-        auto set_diff = std::chrono::duration<double>::zero();
+    return Status::OK();
+}
 
-        for (size_t i = 0; i < uids.size(); ++i) {
-            auto find_start = std::chrono::high_resolution_clock::now();
+Status
+MemTable::ApplyDeletesToSegment(const meta::TableFileSchema& table_file,
+                                const std::vector<segment::doc_id_t>& ids_to_check,
+                                meta::TableFilesSchema& segment_files) {
+    ENGINE_LOG_DEBUG << "Applying deletes in segment: " << table_file.segment_id_;
 
-            auto found = std::binary_search(ids_to_check.begin(), ids_to_check.end(), uids[i]);
+    auto time1 = std::chrono::high_resolution_clock::now();
 
-            auto find_end = std::chrono::high_resolution_clock::now();
-            find_diff += (find_end - find_start);
+    std::string segment_dir;
+    utils::GetParentPath(table_file.location_, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
 
-            if (found) {
-                auto set_start = std::chrono::high_resolution_clock::now();
+    // Get all index that contains blacklist in cache, the graph of a raw segment is cached for the segment
+    std::vector<std::string> cache_keys;
+    for (auto& file : segment_files) {
+        cache_keys.push_back(file.location_);
+    }
+    cache_keys.push_back(segment::VectorIndex::CacheKey(segment_dir));
+
+    std::vector<VecIndexPtr> indexes;
+    std::vector<faiss::ConcurrentBitsetPtr> blacklists;
+    for (auto& cache_key : cache_keys) {
+        auto index = std::static_pointer_cast<VecIndex>(cache::CpuCacheMgr::GetInstance()->GetIndex(cache_key));
+        faiss::ConcurrentBitsetPtr blacklist = nullptr;
+        if (index != nullptr) {
+            index->GetBlacklist(blacklist);
+            if (blacklist != nullptr) {
+                indexes.emplace_back(index);
+                blacklists.emplace_back(blacklist);
+            }
+        }
+    }
 
-                delete_count++;
+    segment::IdIndexPtr id_index_ptr;
+    auto status = segment_reader.LoadIdIndex(id_index_ptr);
+    if (!status.ok()) {
+        return status;
+    }
+    // ids stay in the bloom filter after they are deleted, skip the offsets deleted before
+    segment::DeletedDocsPtr prev_deleted_docs;
+    status = segment_reader.LoadDeletedDocs(prev_deleted_docs);
+    if (!status.ok()) {
+        return status;
+    }
 
-                deleted_docs->AddDeletedDoc(i);
+    auto time2 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> load_diff = time2 - time1;
 
-                if (id_bloom_filter_ptr->Check(uids[i])) {
-                    id_bloom_filter_ptr->Remove(uids[i]);
-                }
+    // only the ids to delete are looked up, instead of scanning all uids of the segment
+    std::vector<segment::offset_t> offsets;
+    std::vector<segment::doc_id_t> found_uids;
+    id_index_ptr->Find(ids_to_check, offsets, found_uids);
 
-                for (auto& blacklist : blacklists) {
-                    if (!blacklist->test(i)) {
-                        blacklist->set(i);
-                    }
-                }
+    segment::DeletedDocsPtr deleted_docs = std::make_shared<segment::DeletedDocs>();
+    size_t delete_count = 0;
+    for (auto offset : offsets) {
+        if (prev_deleted_docs->IsDeleted(offset)) {
+            continue;
+        }
+        delete_count++;
+        deleted_docs->AddDeletedDoc(offset);
 
-                auto set_end = std::chrono::high_resolution_clock::now();
-                set_diff += (set_end - set_start);
+        for (auto& blacklist : blacklists) {
+            if (!blacklist->test(offset)) {
+                blacklist->set(offset);
             }
         }
+    }
 
-        ENGINE_LOG_DEBUG << "Finding " << ids_to_check.size() << " uids in " << uids.size() << " uids took "
-                         << find_diff.count() << " s in total";
-        ENGINE_LOG_DEBUG << "Setting deleted docs and bloom filter took " << set_diff.count() << " s in total";
-
-        auto time4 = std::chrono::high_resolution_clock::now();
-
-        for (auto i = 0; i < indexes.size(); ++i) {
-            indexes[i]->SetBlacklist(blacklists[i]);
-        }
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        indexes[i]->SetBlacklist(blacklists[i]);
+    }
 
-        //        start = std::chrono::high_resolution_clock::now();
+    auto time3 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> find_diff = time3 - time2;
 
-        segment::Segment tmp_segment;
+    if (delete_count > 0) {
         segment::SegmentWriter segment_writer(segment_dir);
         status = segment_writer.WriteDeletedDocs(deleted_docs);
         if (!status.ok()) {
-            break;
-        }
-
-        auto time5 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff4 = time5 - time4;
-        ENGINE_LOG_DEBUG << "Appended " << deleted_docs->GetSize()
-                         << " offsets to deleted docs in segment: " << table_file.segment_id_ << " in " << diff4.count()
-                         << " s";
-
-        //        start = std::chrono::high_resolution_clock::now();
-
-        status = segment_writer.WriteBloomFilter(id_bloom_filter_ptr);
-        if (!status.ok()) {
-            break;
-        }
-        auto time6 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff5 = time6 - time5;
-        ENGINE_LOG_DEBUG << "Updated bloom filter in segment: " << table_file.segment_id_ << " in " << diff5.count()
-                         << " s";
-
-        // Update table file row count
-        for (auto& file : segment_files) {
-            if (file.file_type_ == meta::TableFileSchema::RAW || file.file_type_ == meta::TableFileSchema::TO_INDEX ||
-                file.file_type_ == meta::TableFileSchema::INDEX || file.file_type_ == meta::TableFileSchema::BACKUP) {
-                file.row_count_ -= delete_count;
-                table_files_to_update.emplace_back(file);
-            }
+            return status;
         }
-        auto time7 = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> diff6 = time7 - time6;
-        diff6 = time6 - time5;
-        ENGINE_LOG_DEBUG << "Update table file row count in vector of segment: " << table_file.segment_id_ << " in "
-                         << diff6.count() << " s";
     }
 
-    auto time7 = std::chrono::high_resolution_clock::now();
-
-    status = meta_->UpdateTableFilesRowCount(table_files_to_update);
-
-    if (!status.ok()) {
-        std::string err_msg = "Failed to apply deletes: " + status.ToString();
-        ENGINE_LOG_ERROR << err_msg;
-        return Status(DB_ERROR, err_msg);
+    std::chrono::duration<double> write_diff = std::chrono::high_resolution_clock::now() - time3;
+    ENGINE_LOG_DEBUG << "Segment " << table_file.segment_id_ << ": loading took " << load_diff.count()
+                     << " s, finding " << ids_to_check.size() << " uids in " << id_index_ptr->Count() << " uids took "
+                     << find_diff.count() << " s, appending " << delete_count << " deleted docs took "
+                     << write_diff.count() << " s";
+
+    // Update table file row count, only files of the segment that hold its rows are kept for update
+    meta::TableFilesSchema files_to_update;
+    for (auto& file : segment_files) {
+        if (file.file_type_ == meta::TableFileSchema::RAW || file.file_type_ == meta::TableFileSchema::TO_INDEX ||
+            file.file_type_ == meta::TableFileSchema::INDEX || file.file_type_ == meta::TableFileSchema::BACKUP) {
+            file.row_count_ -= delete_count;
+            files_to_update.emplace_back(file);
+        }
     }
-
-    doc_ids_to_delete_.clear();
-
-    auto end_total = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> diff7 = end_total - time7;
-    ENGINE_LOG_DEBUG << "Update deletes to meta in table " << table_id_ << " in " << diff7.count() << " s";
-    std::chrono::duration<double> diff_total = end_total - start_total;
-    ENGINE_LOG_DEBUG << "Finished applying deletes in table " << table_id_ << " in " << diff_total.count() << " s";
-
-    OngoingFileChecker::GetInstance().UnmarkOngoingFiles(files_to_check);
+    segment_files.swap(files_to_update);
 
     return Status::OK();
 }
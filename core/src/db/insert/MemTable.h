@@ -73,6 +73,12 @@ class MemTable : public server::CacheConfigHandler {
     Status
     ApplyDeletes();
 
+    // apply the sorted ids that may exist in a segment, the row counts of the segment files are updated,
+    // and only the files holding rows of the segment are kept in segment_files
+    Status
+    ApplyDeletesToSegment(const meta::TableFileSchema& table_file, const std::vector<segment::doc_id_t>& ids_to_check,
+                          meta::TableFilesSchema& segment_files);
+
  private:
     const std::string table_id_;
 
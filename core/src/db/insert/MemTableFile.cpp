@@ -20,6 +20,7 @@
 #include "db/Constants.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/engine/IncrementalGraphMgr.h"
 #include "metrics/Metrics.h"
 #include "segment/SegmentReader.h"
 #include "utils/Log.h"
@@ -185,6 +186,7 @@ MemTableFile::Serialize(uint64_t wal_lsn) {
     //    table_file_schema_.row_count_ = execution_engine_->Count();
     table_file_schema_.file_size_ = segment_writer_ptr_->Size();
     table_file_schema_.row_count_ = segment_writer_ptr_->VectorCount();
+    server::Metrics::GetInstance().FlushWriteBytesTotalIncrement(table_file_schema_.file_size_);
 
     // if index type isn't IDMAP, set file type to TO_INDEX if file size exceed index_file_size
     // else set file type to RAW, no need to build index
@@ -215,6 +217,12 @@ MemTableFile::Serialize(uint64_t wal_lsn) {
         segment_writer_ptr_->Cache();
     }
 
+    // the graph of the segment is built and checkpointed in background, merges extend it instead of building
+    // it again
+    if (status.ok() && utils::IsIncrementalGraphFile(table_file_schema_)) {
+        IncrementalGraphMgr::GetInstance().Schedule(table_file_schema_);
+    }
+
     return status;
 }
 
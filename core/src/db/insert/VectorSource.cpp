@@ -23,6 +23,25 @@ namespace milvus {
 namespace engine {
 
 VectorSource::VectorSource(VectorsData vectors) : vectors_(std::move(vectors)) {
+    count_ = vectors_.vector_count_;
+    if (!vectors_.id_array_.empty()) {
+        ids_ = vectors_.id_array_.data();
+    }
+    if (!vectors_.float_data_.empty()) {
+        float_data_ = vectors_.float_data_.data();
+    } else if (!vectors_.binary_data_.empty()) {
+        binary_data_ = vectors_.binary_data_.data();
+    }
+    current_num_vectors_added = 0;
+}
+
+VectorSource::VectorSource(int64_t count, const IDNumber* vector_ids, const float* vectors)
+    : count_(count), ids_(vector_ids), float_data_(vectors) {
+    current_num_vectors_added = 0;
+}
+
+VectorSource::VectorSource(int64_t count, const IDNumber* vector_ids, const uint8_t* vectors)
+    : count_(count), ids_(vector_ids), binary_data_(vectors) {
     current_num_vectors_added = 0;
 }
 
@@ -30,54 +49,37 @@ Status
 VectorSource::Add(/*const ExecutionEnginePtr& execution_engine,*/ const segment::SegmentWriterPtr& segment_writer_ptr,
                   const meta::TableFileSchema& table_file_schema, const size_t& num_vectors_to_add,
                   size_t& num_vectors_added) {
-    uint64_t n = vectors_.vector_count_;
+    uint64_t n = count_;
     server::CollectAddMetrics metrics(n, table_file_schema.dimension_);
 
     num_vectors_added =
         current_num_vectors_added + num_vectors_to_add <= n ? num_vectors_to_add : n - current_num_vectors_added;
     IDNumbers vector_ids_to_add;
-    if (vectors_.id_array_.empty()) {
+    if (ids_ == nullptr) {
         SafeIDGenerator& id_generator = SafeIDGenerator::GetInstance();
         Status status = id_generator.GetNextIDNumbers(num_vectors_added, vector_ids_to_add);
         if (!status.ok()) {
             return status;
         }
     } else {
-        vector_ids_to_add.resize(num_vectors_added);
-        for (size_t pos = current_num_vectors_added; pos < current_num_vectors_added + num_vectors_added; pos++) {
-            vector_ids_to_add[pos - current_num_vectors_added] = vectors_.id_array_[pos];
-        }
+        vector_ids_to_add.assign(ids_ + current_num_vectors_added,
+                                 ids_ + current_num_vectors_added + num_vectors_added);
     }
 
+    // the vectors are copied into the segment buffer directly from the source
     Status status;
-    if (!vectors_.float_data_.empty()) {
-        /*
-        status = execution_engine->AddWithIds(
-            num_vectors_added, vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_,
-            vector_ids_to_add.data());
-        */
-        std::vector<uint8_t> vectors;
-        auto size = num_vectors_added * table_file_schema.dimension_ * sizeof(float);
-        vectors.resize(size);
-        memcpy(vectors.data(), vectors_.float_data_.data() + current_num_vectors_added * table_file_schema.dimension_,
-               size);
-        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, vectors, vector_ids_to_add);
-
-    } else if (!vectors_.binary_data_.empty()) {
-        /*
-        status = execution_engine->AddWithIds(
-            num_vectors_added,
-            vectors_.binary_data_.data() + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_),
-            vector_ids_to_add.data());
-        */
-        std::vector<uint8_t> vectors;
-        auto size = num_vectors_added * SingleVectorSize(table_file_schema.dimension_) * sizeof(uint8_t);
-        vectors.resize(size);
-        memcpy(
-            vectors.data(),
-            vectors_.binary_data_.data() + current_num_vectors_added * SingleVectorSize(table_file_schema.dimension_),
-            size);
-        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_, vectors, vector_ids_to_add);
+    size_t single_vector_size = SingleVectorSize(table_file_schema.dimension_);
+    const uint8_t* data = nullptr;
+    if (float_data_ != nullptr) {
+        data = reinterpret_cast<const uint8_t*>(float_data_);
+    } else if (binary_data_ != nullptr) {
+        data = binary_data_;
+    }
+    if (data != nullptr) {
+        status = segment_writer_ptr->AddVectors(table_file_schema.file_id_,
+                                                data + current_num_vectors_added * single_vector_size,
+                                                num_vectors_added * single_vector_size, vector_ids_to_add.data(),
+                                                vector_ids_to_add.size());
     }
 
     // Clear vector data
@@ -100,9 +102,9 @@ VectorSource::GetNumVectorsAdded() {
 
 size_t
 VectorSource::SingleVectorSize(uint16_t dimension) {
-    if (!vectors_.float_data_.empty()) {
+    if (float_data_ != nullptr) {
         return dimension * FLOAT_TYPE_SIZE;
-    } else if (!vectors_.binary_data_.empty()) {
+    } else if (binary_data_ != nullptr) {
         return dimension / 8;
     }
 
@@ -111,7 +113,7 @@ VectorSource::SingleVectorSize(uint16_t dimension) {
 
 bool
 VectorSource::AllAdded() {
-    return (current_num_vectors_added == vectors_.vector_count_);
+    return (current_num_vectors_added == count_);
 }
 
 IDNumbers
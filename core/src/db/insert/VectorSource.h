@@ -24,10 +24,16 @@ namespace engine {
 
 // TODO(zhiru): this class needs to be refactored once attributes are added
 
+// Vectors to be added into mem table files. A source created from VectorsData owns the vectors, a source created
+// from pointers only refers to the caller's buffers (e.g. a wal record), which must outlive it.
 class VectorSource {
  public:
     explicit VectorSource(VectorsData vectors);
 
+    VectorSource(int64_t count, const IDNumber* vector_ids, const float* vectors);
+
+    VectorSource(int64_t count, const IDNumber* vector_ids, const uint8_t* vectors);
+
     Status
     Add(/*const ExecutionEnginePtr& execution_engine,*/ const segment::SegmentWriterPtr& segment_writer_ptr,
         const meta::TableFileSchema& table_file_schema, const size_t& num_vectors_to_add, size_t& num_vectors_added);
@@ -48,6 +54,13 @@ class VectorSource {
     VectorsData vectors_;
     IDNumbers vector_ids_;
 
+    size_t count_ = 0;
+    // nullptr if ids are to be generated
+    const IDNumber* ids_ = nullptr;
+    // one of them is set
+    const float* float_data_ = nullptr;
+    const uint8_t* binary_data_ = nullptr;
+
     size_t current_num_vectors_added;
 };  // VectorSource
 
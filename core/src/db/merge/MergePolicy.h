@@ -0,0 +1,46 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/meta/MetaTypes.h"
+#include "utils/Status.h"
+
+#include <memory>
+#include <vector>
+
+namespace milvus {
+namespace engine {
+
+static const char* MERGE_POLICY_SIMPLE = "simple";
+static const char* MERGE_POLICY_TIERED = "tiered";
+
+using MergeFilesGroups = std::vector<meta::TableFilesSchema>;
+
+// Decides which files of a table are merged, and which segments are rewritten to drop their deleted vectors,
+// when the background merge runs.
+class MergePolicy {
+ public:
+    virtual ~MergePolicy() = default;
+
+    // pick from the raw files smaller than index_file_size, the files of a group are merged into one file
+    virtual Status
+    PickFilesToMerge(const meta::TableFilesSchema& files, MergeFilesGroups& groups) = 0;
+
+    // pick from the files of index_file_size or larger, the segments of the picked files are compacted
+    virtual Status
+    PickFilesToCompact(const meta::TableFilesSchema& files, meta::TableFilesSchema& picked) = 0;
+};
+
+using MergePolicyPtr = std::shared_ptr<MergePolicy>;
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,34 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/merge/MergePolicyFactory.h"
+#include "db/merge/SimpleMergePolicy.h"
+#include "db/merge/TieredMergePolicy.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+
+MergePolicyPtr
+MergePolicyFactory::Build(const DBOptions& options) {
+    if (options.merge_policy_ == MERGE_POLICY_TIERED) {
+        return std::make_shared<TieredMergePolicy>(options.merge_tier_factor_, options.merge_tier_factor_,
+                                                   options.merge_deleted_ratio_);
+    }
+
+    if (options.merge_policy_ != MERGE_POLICY_SIMPLE) {
+        ENGINE_LOG_WARNING << "Unknown merge policy " << options.merge_policy_ << ", use " << MERGE_POLICY_SIMPLE;
+    }
+    return std::make_shared<SimpleMergePolicy>(options.merge_trigger_number_);
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,33 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/merge/SimpleMergePolicy.h"
+
+namespace milvus {
+namespace engine {
+
+Status
+SimpleMergePolicy::PickFilesToMerge(const meta::TableFilesSchema& files, MergeFilesGroups& groups) {
+    groups.clear();
+    if (files.size() >= merge_trigger_number_) {
+        groups.push_back(files);
+    }
+    return Status::OK();
+}
+
+Status
+SimpleMergePolicy::PickFilesToCompact(const meta::TableFilesSchema& files, meta::TableFilesSchema& picked) {
+    picked.clear();
+    return Status::OK();
+}
+
+}  // namespace engine
+}  // namespace milvus
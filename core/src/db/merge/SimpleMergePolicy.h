@@ -0,0 +1,37 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/merge/MergePolicy.h"
+
+namespace milvus {
+namespace engine {
+
+// All raw files are merged in one group once there are merge_trigger_number of them, the merge stops when the
+// merged file reaches index_file_size. Segments are only compacted by an explicit compact.
+class SimpleMergePolicy : public MergePolicy {
+ public:
+    explicit SimpleMergePolicy(uint64_t merge_trigger_number) : merge_trigger_number_(merge_trigger_number) {
+    }
+
+    Status
+    PickFilesToMerge(const meta::TableFilesSchema& files, MergeFilesGroups& groups) override;
+
+    Status
+    PickFilesToCompact(const meta::TableFilesSchema& files, meta::TableFilesSchema& picked) override;
+
+ private:
+    uint64_t merge_trigger_number_;
+};
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,116 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/merge/TieredMergePolicy.h"
+#include "db/Utils.h"
+#include "segment/Types.h"
+
+#include <algorithm>
+#include <map>
+
+namespace milvus {
+namespace engine {
+
+TieredMergePolicy::TieredMergePolicy(uint64_t merge_factor, uint64_t size_ratio, double deleted_ratio)
+    : merge_factor_(std::max<uint64_t>(merge_factor, 2)),
+      size_ratio_(std::max<uint64_t>(size_ratio, 2)),
+      deleted_ratio_(deleted_ratio) {
+}
+
+Status
+TieredMergePolicy::PickFilesToMerge(const meta::TableFilesSchema& files, MergeFilesGroups& groups) {
+    groups.clear();
+
+    std::map<uint64_t, meta::TableFilesSchema> tiers;
+    for (auto& file : files) {
+        tiers[Tier(file)].push_back(file);
+    }
+
+    // the smallest files first, they are the cheapest to merge
+    for (auto iter = tiers.rbegin(); iter != tiers.rend(); ++iter) {
+        auto& tier_files = iter->second;
+        std::sort(tier_files.begin(), tier_files.end(),
+                  [](const meta::TableFileSchema& a, const meta::TableFileSchema& b) {
+                      return LiveSize(a) < LiveSize(b);
+                  });
+
+        meta::TableFilesSchema group;
+        uint64_t group_size = 0;
+        for (auto& file : tier_files) {
+            group.push_back(file);
+            group_size += LiveSize(file);
+            if (group.size() >= merge_factor_ || group_size >= static_cast<uint64_t>(file.index_file_size_)) {
+                groups.push_back(group);
+                group.clear();
+                group_size = 0;
+            }
+        }
+
+        // the rest of the tier waits for more files, unless it has too many deleted vectors
+        bool reclaim = std::any_of(group.begin(), group.end(), [&](const meta::TableFileSchema& file) {
+            return DeletedRatio(file) >= deleted_ratio_;
+        });
+        if (reclaim) {
+            groups.push_back(group);
+        }
+    }
+
+    return Status::OK();
+}
+
+Status
+TieredMergePolicy::PickFilesToCompact(const meta::TableFilesSchema& files, meta::TableFilesSchema& picked) {
+    picked.clear();
+    for (auto& file : files) {
+        if (DeletedRatio(file) >= deleted_ratio_) {
+            picked.push_back(file);
+        }
+    }
+
+    // the segments with most deleted vectors first
+    std::sort(picked.begin(), picked.end(), [](const meta::TableFileSchema& a, const meta::TableFileSchema& b) {
+        return DeletedRatio(a) > DeletedRatio(b);
+    });
+
+    return Status::OK();
+}
+
+uint64_t
+TieredMergePolicy::LiveSize(const meta::TableFileSchema& file) {
+    // file size is the size of vectors and uids, deletes reduce the row count but not the file size
+    uint64_t vector_size = utils::IsBinaryMetricType(file.metric_type_) ? file.dimension_ / 8
+                                                                          : file.dimension_ * sizeof(float);
+    uint64_t row_size = vector_size + sizeof(segment::doc_id_t);
+    return std::min<uint64_t>(file.row_count_ * row_size, file.file_size_);
+}
+
+double
+TieredMergePolicy::DeletedRatio(const meta::TableFileSchema& file) {
+    if (file.file_size_ == 0) {
+        return 0.0;
+    }
+    return 1.0 - static_cast<double>(LiveSize(file)) / file.file_size_;
+}
+
+uint64_t
+TieredMergePolicy::Tier(const meta::TableFileSchema& file) const {
+    uint64_t size = LiveSize(file);
+    uint64_t bound = file.index_file_size_ / size_ratio_;
+    uint64_t tier = 0;
+    while (size < bound && tier < MAX_TIER) {
+        bound /= size_ratio_;
+        ++tier;
+    }
+    return tier;
+}
+
+}  // namespace engine
+}  // namespace milvus
@@ -0,0 +1,55 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/merge/MergePolicy.h"
+
+namespace milvus {
+namespace engine {
+
+// Log-structured tiered merge. Raw files are put in tiers by their size without deleted vectors: tier 0 holds
+// the files of index_file_size / size_ratio or larger, tier 1 the files of index_file_size / size_ratio^2 or
+// larger, and so on. Files are only merged with files of the same tier, once merge_factor of them are there, so
+// a vector is rewritten about once per tier instead of at every merge. A file is merged earlier, or a large
+// segment is compacted, when the estimated deleted fraction of its vectors reaches deleted_ratio.
+class TieredMergePolicy : public MergePolicy {
+ public:
+    static constexpr uint64_t MAX_TIER = 8;
+
+    TieredMergePolicy(uint64_t merge_factor, uint64_t size_ratio, double deleted_ratio);
+
+    Status
+    PickFilesToMerge(const meta::TableFilesSchema& files, MergeFilesGroups& groups) override;
+
+    Status
+    PickFilesToCompact(const meta::TableFilesSchema& files, meta::TableFilesSchema& picked) override;
+
+    // size of the vectors not deleted, estimated from the row count
+    static uint64_t
+    LiveSize(const meta::TableFileSchema& file);
+
+    // estimated fraction of deleted vectors: the meta only has the row count and the file size, so this is the
+    // fraction of the file size not covered by the rows left, no deleted docs are read
+    static double
+    DeletedRatio(const meta::TableFileSchema& file);
+
+    uint64_t
+    Tier(const meta::TableFileSchema& file) const;
+
+ private:
+    uint64_t merge_factor_;
+    uint64_t size_ratio_;
+    double deleted_ratio_;
+};
+
+}  // namespace engine
+}  // namespace milvus
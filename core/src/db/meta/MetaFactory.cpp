@@ -11,6 +11,7 @@
 
 #include "db/meta/MetaFactory.h"
 #include "MySQLMetaImpl.h"
+#include "SnapshotMetaImpl.h"
 #include "SqliteMetaImpl.h"
 #include "db/Utils.h"
 #include "utils/Exception.h"
@@ -54,16 +55,23 @@ MetaFactory::Build(const DBMetaOptions& metaOptions, const int& mode) {
         throw InvalidArgumentException("Wrong URI format ");
     }
 
+    meta::MetaPtr meta;
     if (strcasecmp(uri_info.dialect_.c_str(), "mysql") == 0) {
         ENGINE_LOG_INFO << "Using MySQL";
-        return std::make_shared<meta::MySQLMetaImpl>(metaOptions, mode);
+        meta = std::make_shared<meta::MySQLMetaImpl>(metaOptions, mode);
     } else if (strcasecmp(uri_info.dialect_.c_str(), "sqlite") == 0) {
         ENGINE_LOG_INFO << "Using SQLite";
-        return std::make_shared<meta::SqliteMetaImpl>(metaOptions);
+        meta = std::make_shared<meta::SqliteMetaImpl>(metaOptions);
     } else {
         ENGINE_LOG_ERROR << "Invalid dialect in URI: dialect = " << uri_info.dialect_;
         throw InvalidArgumentException("URI dialect is not mysql / sqlite");
     }
+
+    if (metaOptions.snapshot_interval_ > 0) {
+        ENGINE_LOG_INFO << "Using meta snapshot, reconciled every " << metaOptions.snapshot_interval_ << " seconds";
+        meta = std::make_shared<meta::SnapshotMetaImpl>(meta, metaOptions);
+    }
+    return meta;
 }
 
 }  // namespace engine
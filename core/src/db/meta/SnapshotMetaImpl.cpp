@@ -0,0 +1,492 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "db/meta/SnapshotMetaImpl.h"
+
+#include <chrono>
+#include <set>
+#include <unordered_set>
+#include <utility>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+SnapshotMetaImpl::SnapshotMetaImpl(const MetaPtr& backend, const DBMetaOptions& options)
+    : backend_(backend), options_(options), snapshot_(std::make_shared<Snapshot>()) {
+    if (options_.snapshot_interval_ > 0) {
+        reconcile_thread_ = std::thread(&SnapshotMetaImpl::ReconcileTask, this);
+    }
+}
+
+SnapshotMetaImpl::~SnapshotMetaImpl() {
+    {
+        std::lock_guard<std::mutex> lock(reconcile_mutex_);
+        stopped_ = true;
+    }
+    reconcile_cv_.notify_all();
+    if (reconcile_thread_.joinable()) {
+        reconcile_thread_.join();
+    }
+}
+
+void
+SnapshotMetaImpl::Reconcile() {
+    auto snapshot = GetSnapshot();
+    for (auto& pair : snapshot->tables_) {
+        const std::string& table_id = pair.first;
+        TableEntryPtr entry;
+        auto status = LoadTable(table_id, BeginLoad(), entry);
+        if (!status.ok()) {
+            // the table is dropped or the backend fails, searches of the table ask the backend again
+            std::lock_guard<std::mutex> lock(snapshot_mutex_);
+            auto tables = GetSnapshot()->tables_;
+            tables.erase(table_id);
+            removed_versions_[table_id] = Install(std::move(tables));
+        }
+    }
+    ENGINE_LOG_DEBUG << "Reconciled meta snapshot of " << snapshot->tables_.size() << " tables, version "
+                     << SnapshotVersion();
+}
+
+uint64_t
+SnapshotMetaImpl::SnapshotVersion() {
+    return GetSnapshot()->version_;
+}
+
+Status
+SnapshotMetaImpl::CreateTable(TableSchema& table_schema) {
+    return backend_->CreateTable(table_schema);
+}
+
+Status
+SnapshotMetaImpl::DescribeTable(TableSchema& table_schema) {
+    auto snapshot = GetSnapshot();
+    auto iter = snapshot->tables_.find(table_schema.table_id_);
+    if (iter == snapshot->tables_.end()) {
+        return backend_->DescribeTable(table_schema);
+    }
+    table_schema = iter->second->schema_;
+    return Status::OK();
+}
+
+Status
+SnapshotMetaImpl::HasTable(const std::string& table_id, bool& has_or_not) {
+    return backend_->HasTable(table_id, has_or_not);
+}
+
+Status
+SnapshotMetaImpl::AllTables(std::vector<TableSchema>& table_schema_array) {
+    return backend_->AllTables(table_schema_array);
+}
+
+Status
+SnapshotMetaImpl::DropTable(const std::string& table_id) {
+    auto status = backend_->DropTable(table_id);
+    RefreshTable(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::DeleteTableFiles(const std::string& table_id) {
+    auto status = backend_->DeleteTableFiles(table_id);
+    RefreshTable(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::CreateTableFile(TableFileSchema& file_schema) {
+    auto status = backend_->CreateTableFile(file_schema);
+    if (file_schema.file_type_ == TableFileSchema::RAW || file_schema.file_type_ == TableFileSchema::TO_INDEX ||
+        file_schema.file_type_ == TableFileSchema::INDEX) {
+        RefreshTable(file_schema.table_id_);
+    }
+    return status;
+}
+
+Status
+SnapshotMetaImpl::GetTableFiles(const std::string& table_id, const std::vector<size_t>& ids,
+                                TableFilesSchema& table_files) {
+    return backend_->GetTableFiles(table_id, ids, table_files);
+}
+
+Status
+SnapshotMetaImpl::GetTableFilesBySegmentId(const std::string& segment_id, TableFilesSchema& table_files) {
+    return backend_->GetTableFilesBySegmentId(segment_id, table_files);
+}
+
+Status
+SnapshotMetaImpl::UpdateTableIndex(const std::string& table_id, const TableIndex& index) {
+    auto status = backend_->UpdateTableIndex(table_id, index);
+    RefreshTable(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFlag(const std::string& table_id, int64_t flag) {
+    auto status = backend_->UpdateTableFlag(table_id, flag);
+    if (status.ok()) {
+        UpdateSchema(table_id, [&](TableSchema& schema) { schema.flag_ = flag; });
+    }
+    return status;
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFlushLSN(const std::string& table_id, uint64_t flush_lsn) {
+    auto status = backend_->UpdateTableFlushLSN(table_id, flush_lsn);
+    if (status.ok()) {
+        UpdateSchema(table_id, [&](TableSchema& schema) { schema.flush_lsn_ = flush_lsn; });
+    }
+    return status;
+}
+
+Status
+SnapshotMetaImpl::GetTableFlushLSN(const std::string& table_id, uint64_t& flush_lsn) {
+    return backend_->GetTableFlushLSN(table_id, flush_lsn);
+}
+
+Status
+SnapshotMetaImpl::GetTableFilesByFlushLSN(uint64_t flush_lsn, TableFilesSchema& table_files) {
+    return backend_->GetTableFilesByFlushLSN(flush_lsn, table_files);
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFile(TableFileSchema& file_schema) {
+    auto status = backend_->UpdateTableFile(file_schema);
+    RefreshTable(file_schema.table_id_);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFilesToIndex(const std::string& table_id) {
+    auto status = backend_->UpdateTableFilesToIndex(table_id);
+    RefreshTable(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFiles(TableFilesSchema& files) {
+    auto status = backend_->UpdateTableFiles(files);
+    RefreshTables(files);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::UpdateTableFilesRowCount(TableFilesSchema& files) {
+    auto status = backend_->UpdateTableFilesRowCount(files);
+    RefreshTables(files);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::DescribeTableIndex(const std::string& table_id, TableIndex& index) {
+    return backend_->DescribeTableIndex(table_id, index);
+}
+
+Status
+SnapshotMetaImpl::DropTableIndex(const std::string& table_id) {
+    auto status = backend_->DropTableIndex(table_id);
+    RefreshTable(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::CreatePartition(const std::string& table_id, const std::string& partition_name,
+                                  const std::string& tag, uint64_t lsn) {
+    auto status = backend_->CreatePartition(table_id, partition_name, tag, lsn);
+    RefreshTable(table_id);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::DropPartition(const std::string& partition_name) {
+    auto status = backend_->DropPartition(partition_name);
+    RefreshTable(partition_name);
+    return status;
+}
+
+Status
+SnapshotMetaImpl::ShowPartitions(const std::string& table_id, std::vector<meta::TableSchema>& partition_schema_array) {
+    auto snapshot = GetSnapshot();
+    auto iter = snapshot->tables_.find(table_id);
+    if (iter == snapshot->tables_.end()) {
+        return backend_->ShowPartitions(table_id, partition_schema_array);
+    }
+    auto& partitions = iter->second->partitions_;
+    partition_schema_array.insert(partition_schema_array.end(), partitions.begin(), partitions.end());
+    return Status::OK();
+}
+
+Status
+SnapshotMetaImpl::GetPartitionName(const std::string& table_id, const std::string& tag, std::string& partition_name) {
+    return backend_->GetPartitionName(table_id, tag, partition_name);
+}
+
+Status
+SnapshotMetaImpl::FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids,
+                                TableFilesSchema& files) {
+    files.clear();
+
+    TableEntryPtr entry;
+    auto snapshot = GetSnapshot();
+    auto iter = snapshot->tables_.find(table_id);
+    if (iter != snapshot->tables_.end()) {
+        entry = iter->second;
+    } else {
+        auto status = LoadTable(table_id, BeginLoad(), entry);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    if (ids.empty()) {
+        files = entry->files_;
+        return Status::OK();
+    }
+    std::unordered_set<size_t> id_set(ids.begin(), ids.end());
+    for (auto& file : entry->files_) {
+        if (id_set.find(file.id_) != id_set.end()) {
+            files.push_back(file);
+        }
+    }
+    return Status::OK();
+}
+
+Status
+SnapshotMetaImpl::FilesToMerge(const std::string& table_id, TableFilesSchema& files) {
+    return backend_->FilesToMerge(table_id, files);
+}
+
+Status
+SnapshotMetaImpl::FilesToIndex(TableFilesSchema& files) {
+    return backend_->FilesToIndex(files);
+}
+
+Status
+SnapshotMetaImpl::FilesByType(const std::string& table_id, const std::vector<int>& file_types,
+                              TableFilesSchema& table_files) {
+    return backend_->FilesByType(table_id, file_types, table_files);
+}
+
+Status
+SnapshotMetaImpl::Size(uint64_t& result) {
+    return backend_->Size(result);
+}
+
+Status
+SnapshotMetaImpl::Archive() {
+    auto status = backend_->Archive();
+    if (!options_.archive_conf_.GetCriterias().empty()) {
+        RefreshAll();
+    }
+    return status;
+}
+
+Status
+SnapshotMetaImpl::CleanUpShadowFiles() {
+    // shadow files are never searched
+    return backend_->CleanUpShadowFiles();
+}
+
+Status
+SnapshotMetaImpl::CleanUpFilesWithTTL(uint64_t seconds) {
+    // only files and tables already removed from searches are cleaned
+    return backend_->CleanUpFilesWithTTL(seconds);
+}
+
+Status
+SnapshotMetaImpl::DropAll() {
+    auto status = backend_->DropAll();
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    clear_version_ = Install(std::unordered_map<std::string, TableEntryPtr>());
+    removed_versions_.clear();
+    return status;
+}
+
+Status
+SnapshotMetaImpl::Count(const std::string& table_id, uint64_t& result) {
+    return backend_->Count(table_id, result);
+}
+
+Status
+SnapshotMetaImpl::SetGlobalLastLSN(uint64_t lsn) {
+    return backend_->SetGlobalLastLSN(lsn);
+}
+
+Status
+SnapshotMetaImpl::GetGlobalLastLSN(uint64_t& lsn) {
+    return backend_->GetGlobalLastLSN(lsn);
+}
+
+SnapshotMetaImpl::SnapshotPtr
+SnapshotMetaImpl::GetSnapshot() const {
+    return std::atomic_load(&snapshot_);
+}
+
+Status
+SnapshotMetaImpl::LoadTable(const std::string& table_id, uint64_t since_version, TableEntryPtr& entry) {
+    auto loaded = std::make_shared<TableEntry>();
+    loaded->schema_.table_id_ = table_id;
+    auto status = backend_->DescribeTable(loaded->schema_);
+    if (status.ok()) {
+        status = backend_->ShowPartitions(table_id, loaded->partitions_);
+    }
+    if (status.ok()) {
+        status = backend_->FilesToSearch(table_id, std::vector<size_t>(), loaded->files_);
+    }
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    EndLoad(since_version);
+    if (!status.ok()) {
+        return status;
+    }
+    entry = loaded;
+
+    // a change of the table after the load started is not in the entry, the change installs its own
+    auto iter = removed_versions_.find(table_id);
+    if (clear_version_ > since_version || (iter != removed_versions_.end() && iter->second > since_version)) {
+        return Status::OK();
+    }
+    auto tables = GetSnapshot()->tables_;
+    tables[table_id] = entry;
+    Install(std::move(tables));
+    return Status::OK();
+}
+
+uint64_t
+SnapshotMetaImpl::BeginLoad() {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    uint64_t since_version = version_.load();
+    loading_versions_.insert(since_version);
+    return since_version;
+}
+
+void
+SnapshotMetaImpl::EndLoad(uint64_t since_version) {
+    auto iter = loading_versions_.find(since_version);
+    if (iter != loading_versions_.end()) {
+        loading_versions_.erase(iter);
+    }
+
+    // a removal only matters to the loads started before it, the loads to come start after every removal
+    for (auto removed = removed_versions_.begin(); removed != removed_versions_.end();) {
+        if (loading_versions_.empty() || removed->second <= *loading_versions_.begin()) {
+            removed = removed_versions_.erase(removed);
+        } else {
+            ++removed;
+        }
+    }
+}
+
+void
+SnapshotMetaImpl::RefreshTable(const std::string& table_id) {
+    std::set<std::string> table_ids = {table_id};
+    uint64_t since_version;
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        auto snapshot = GetSnapshot();
+
+        // the owner table lists its partitions
+        for (auto& pair : snapshot->tables_) {
+            for (auto& partition : pair.second->partitions_) {
+                if (partition.table_id_ == table_id) {
+                    table_ids.insert(pair.first);
+                }
+            }
+        }
+
+        // loads of the tables in flight must not install what they read before the change
+        auto tables = snapshot->tables_;
+        bool cached = false;
+        for (auto& id : table_ids) {
+            cached |= (tables.erase(id) > 0);
+        }
+        since_version = cached ? Install(std::move(tables)) : ++version_;
+        for (auto& id : table_ids) {
+            removed_versions_[id] = since_version;
+        }
+        if (!cached) {
+            return;
+        }
+        for (size_t i = 0; i < table_ids.size(); ++i) {
+            loading_versions_.insert(since_version);
+        }
+    }
+
+    // reload right away, searches keep reading the snapshot instead of the backend
+    for (auto& id : table_ids) {
+        TableEntryPtr entry;
+        LoadTable(id, since_version, entry);
+    }
+}
+
+void
+SnapshotMetaImpl::RefreshTables(const TableFilesSchema& files) {
+    std::set<std::string> table_ids;
+    for (auto& file : files) {
+        table_ids.insert(file.table_id_);
+    }
+    for (auto& table_id : table_ids) {
+        RefreshTable(table_id);
+    }
+}
+
+void
+SnapshotMetaImpl::RefreshAll() {
+    auto snapshot = GetSnapshot();
+    for (auto& pair : snapshot->tables_) {
+        RefreshTable(pair.first);
+    }
+}
+
+void
+SnapshotMetaImpl::UpdateSchema(const std::string& table_id, const std::function<void(TableSchema&)>& update) {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    auto tables = GetSnapshot()->tables_;
+    auto iter = tables.find(table_id);
+    if (iter == tables.end()) {
+        return;
+    }
+    auto entry = std::make_shared<TableEntry>(*iter->second);
+    update(entry->schema_);
+    iter->second = entry;
+    Install(std::move(tables));
+}
+
+uint64_t
+SnapshotMetaImpl::Install(std::unordered_map<std::string, TableEntryPtr>&& tables) {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->version_ = ++version_;
+    snapshot->tables_ = std::move(tables);
+    std::atomic_store(&snapshot_, SnapshotPtr(snapshot));
+    return snapshot->version_;
+}
+
+void
+SnapshotMetaImpl::ReconcileTask() {
+    std::unique_lock<std::mutex> lock(reconcile_mutex_);
+    while (!stopped_) {
+        reconcile_cv_.wait_for(lock, std::chrono::seconds(options_.snapshot_interval_), [&] { return stopped_; });
+        if (stopped_) {
+            break;
+        }
+        lock.unlock();
+        Reconcile();
+        lock.lock();
+    }
+}
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
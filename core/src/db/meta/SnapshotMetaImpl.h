@@ -0,0 +1,232 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Meta.h"
+#include "db/Options.h"
+
+namespace milvus {
+namespace engine {
+namespace meta {
+
+// Meta decorator keeping an in-memory snapshot of the searched tables: their schema, partitions and files to
+// search. Queries read DescribeTable, ShowPartitions and FilesToSearch from the snapshot without a round trip
+// to the backend and without lock. The snapshot is copy-on-write: every change builds a new version and swaps
+// it in. Changes made through this meta refresh the tables they touch, a background thread reconciles all
+// tables with the backend every options.snapshot_interval_ seconds to pick up changes made by other nodes.
+class SnapshotMetaImpl : public Meta {
+ public:
+    SnapshotMetaImpl(const MetaPtr& backend, const DBMetaOptions& options);
+    ~SnapshotMetaImpl();
+
+    // reload every table of the snapshot from the backend
+    void
+    Reconcile();
+
+    uint64_t
+    SnapshotVersion();
+
+    Status
+    CreateTable(TableSchema& table_schema) override;
+
+    Status
+    DescribeTable(TableSchema& table_schema) override;
+
+    Status
+    HasTable(const std::string& table_id, bool& has_or_not) override;
+
+    Status
+    AllTables(std::vector<TableSchema>& table_schema_array) override;
+
+    Status
+    DropTable(const std::string& table_id) override;
+
+    Status
+    DeleteTableFiles(const std::string& table_id) override;
+
+    Status
+    CreateTableFile(TableFileSchema& file_schema) override;
+
+    Status
+    GetTableFiles(const std::string& table_id, const std::vector<size_t>& ids, TableFilesSchema& table_files) override;
+
+    Status
+    GetTableFilesBySegmentId(const std::string& segment_id, TableFilesSchema& table_files) override;
+
+    Status
+    UpdateTableIndex(const std::string& table_id, const TableIndex& index) override;
+
+    Status
+    UpdateTableFlag(const std::string& table_id, int64_t flag) override;
+
+    Status
+    UpdateTableFlushLSN(const std::string& table_id, uint64_t flush_lsn) override;
+
+    Status
+    GetTableFlushLSN(const std::string& table_id, uint64_t& flush_lsn) override;
+
+    Status
+    GetTableFilesByFlushLSN(uint64_t flush_lsn, TableFilesSchema& table_files) override;
+
+    Status
+    UpdateTableFile(TableFileSchema& file_schema) override;
+
+    Status
+    UpdateTableFilesToIndex(const std::string& table_id) override;
+
+    Status
+    UpdateTableFiles(TableFilesSchema& files) override;
+
+    Status
+    UpdateTableFilesRowCount(TableFilesSchema& files) override;
+
+    Status
+    DescribeTableIndex(const std::string& table_id, TableIndex& index) override;
+
+    Status
+    DropTableIndex(const std::string& table_id) override;
+
+    Status
+    CreatePartition(const std::string& table_id, const std::string& partition_name, const std::string& tag,
+                    uint64_t lsn) override;
+
+    Status
+    DropPartition(const std::string& partition_name) override;
+
+    Status
+    ShowPartitions(const std::string& table_id, std::vector<meta::TableSchema>& partition_schema_array) override;
+
+    Status
+    GetPartitionName(const std::string& table_id, const std::string& tag, std::string& partition_name) override;
+
+    Status
+    FilesToSearch(const std::string& table_id, const std::vector<size_t>& ids, TableFilesSchema& files) override;
+
+    Status
+    FilesToMerge(const std::string& table_id, TableFilesSchema& files) override;
+
+    Status
+    FilesToIndex(TableFilesSchema&) override;
+
+    Status
+    FilesByType(const std::string& table_id, const std::vector<int>& file_types,
+                TableFilesSchema& table_files) override;
+
+    Status
+    Size(uint64_t& result) override;
+
+    Status
+    Archive() override;
+
+    Status
+    CleanUpShadowFiles() override;
+
+    Status
+    CleanUpFilesWithTTL(uint64_t seconds /*, CleanUpFilter* filter = nullptr*/) override;
+
+    Status
+    DropAll() override;
+
+    Status
+    Count(const std::string& table_id, uint64_t& result) override;
+
+    Status
+    SetGlobalLastLSN(uint64_t lsn) override;
+
+    Status
+    GetGlobalLastLSN(uint64_t& lsn) override;
+
+ private:
+    struct TableEntry {
+        TableSchema schema_;
+        std::vector<TableSchema> partitions_;
+        TableFilesSchema files_;
+    };
+    using TableEntryPtr = std::shared_ptr<const TableEntry>;
+
+    struct Snapshot {
+        uint64_t version_ = 0;
+        std::unordered_map<std::string, TableEntryPtr> tables_;
+    };
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    SnapshotPtr
+    GetSnapshot() const;
+
+    // register a load of a table starting at the current version and return the version
+    uint64_t
+    BeginLoad();
+
+    // unregister a load and drop the removals no load in flight needs, the caller must hold snapshot_mutex_
+    void
+    EndLoad(uint64_t since_version);
+
+    // read the table from the backend and put it into the snapshot, unless the table was refreshed or
+    // removed after 'since_version'; the load must be registered at 'since_version', it ends here
+    Status
+    LoadTable(const std::string& table_id, uint64_t since_version, TableEntryPtr& entry);
+
+    // remove the table from the snapshot and reload it, after a change of the table in the backend
+    void
+    RefreshTable(const std::string& table_id);
+
+    void
+    RefreshTables(const TableFilesSchema& files);
+
+    void
+    RefreshAll();
+
+    // apply 'update' to a copy of the schema of a table in the snapshot
+    void
+    UpdateSchema(const std::string& table_id, const std::function<void(TableSchema&)>& update);
+
+    // swap in a new version holding 'tables' and return the version, the caller must hold snapshot_mutex_
+    uint64_t
+    Install(std::unordered_map<std::string, TableEntryPtr>&& tables);
+
+    void
+    ReconcileTask();
+
+ private:
+    const MetaPtr backend_;
+    const DBMetaOptions options_;
+
+    SnapshotPtr snapshot_;
+    // serializes the writers of the snapshot, readers load it atomically
+    std::mutex snapshot_mutex_;
+    std::atomic<uint64_t> version_{0};
+    // version at which each table was last removed from the snapshot, kept while a load started before
+    std::unordered_map<std::string, uint64_t> removed_versions_;
+    // start versions of the loads in flight
+    std::multiset<uint64_t> loading_versions_;
+    uint64_t clear_version_ = 0;
+
+    std::thread reconcile_thread_;
+    std::mutex reconcile_mutex_;
+    std::condition_variable reconcile_cv_;
+    bool stopped_ = false;
+};
+
+}  // namespace meta
+}  // namespace engine
+}  // namespace milvus
@@ -36,8 +36,8 @@ ParserLsn(uint64_t lsn, uint32_t& file_no, uint32_t& offset) {
     offset = uint32_t(lsn & LSN_OFFSET_MASK);
 }
 
-MXLogBuffer::MXLogBuffer(const std::string& mxlog_path, const uint32_t buffer_size)
-    : mxlog_buffer_size_(buffer_size * UNIT_MB), mxlog_writer_(mxlog_path) {
+MXLogBuffer::MXLogBuffer(const std::string& mxlog_path, const uint32_t buffer_size, MXLogDurability durability)
+    : mxlog_buffer_size_(buffer_size * UNIT_MB), durability_(durability), mxlog_writer_(mxlog_path) {
 }
 
 MXLogBuffer::~MXLogBuffer() {
@@ -183,6 +183,15 @@ MXLogBuffer::SurplusSpace() {
     return mxlog_buffer_size_ - mxlog_buffer_writer_.buf_offset;
 }
 
+int
+MXLogBuffer::PrepareSync() {
+    if (!mxlog_writer_.Flush()) {
+        WAL_LOG_ERROR << "flush wal file error " << mxlog_buffer_writer_.file_no;
+        return -1;
+    }
+    return mxlog_writer_.DupDescriptor();
+}
+
 uint32_t
 MXLogBuffer::RecordSize(const MXLogRecord& record) {
     return SizeOfMXLogRecordHeader + (uint32_t)record.table_id.size() + (uint32_t)record.partition_tag.size() +
@@ -204,6 +213,12 @@ MXLogBuffer::Append(MXLogRecord& record) {
         mxlog_buffer_writer_.buf_offset = 0;
         lck.unlock();
 
+        // records of the old file are not covered by the syncs of new file
+        if (durability_ == MXLogDurability::Sync && !mxlog_writer_.Flush(true)) {
+            WAL_LOG_ERROR << "sync wal file error " << mxlog_buffer_writer_.file_no - 1;
+            return WAL_FILE_ERROR;
+        }
+
         // Reborn means close old wal file and open new wal file
         if (!mxlog_writer_.ReBorn(ToFileName(mxlog_buffer_writer_.file_no), "w")) {
             WAL_LOG_ERROR << "ReBorn wal file error " << mxlog_buffer_writer_.file_no;
@@ -245,7 +260,8 @@ MXLogBuffer::Append(MXLogRecord& record) {
         current_write_offset += record.data_size;
     }
 
-    bool write_rst = mxlog_writer_.Write(current_write_buf + mxlog_buffer_writer_.buf_offset, record_size);
+    bool write_rst = mxlog_writer_.Write(current_write_buf + mxlog_buffer_writer_.buf_offset, record_size,
+                                         durability_ == MXLogDurability::Flush);
     if (!write_rst) {
         WAL_LOG_ERROR << "write wal file error";
         return WAL_FILE_ERROR;
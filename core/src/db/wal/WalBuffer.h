@@ -52,7 +52,8 @@ using BufferPtr = std::shared_ptr<char>;
 
 class MXLogBuffer {
  public:
-    MXLogBuffer(const std::string& mxlog_path, const uint32_t buffer_size);
+    MXLogBuffer(const std::string& mxlog_path, const uint32_t buffer_size,
+                MXLogDurability durability = MXLogDurability::Flush);
     ~MXLogBuffer();
 
     bool
@@ -87,12 +88,18 @@ class MXLogBuffer {
     uint32_t
     SurplusSpace();
 
+    // write the appended records of current wal file into the OS, and return a new descriptor of the file
+    // so that they can be synced after new records are appended or the file is switched; -1 on error
+    int
+    PrepareSync();
+
  private:
     uint32_t
     RecordSize(const MXLogRecord& record);
 
  private:
     uint32_t mxlog_buffer_size_;  // from config
+    MXLogDurability durability_;  // from config
     BufferPtr buf_[2];
     std::mutex mutex_;
     uint32_t file_no_from_;
@@ -30,6 +30,16 @@ using TableMetaPtr = std::shared_ptr<std::unordered_map<std::string, TableSchema
 
 enum class MXLogType { InsertBinary, InsertVector, Delete, Update, Flush, None };
 
+// when a record is durable after insert/delete returns
+// None: records stay in the user space buffer until the file is switched or closed
+// Flush: every record is written into the OS, it survives a crash of milvus but not of the OS
+// Sync: records of concurrent requests are written and synced to disk together, one fdatasync per group
+enum class MXLogDurability { None, Flush, Sync };
+
+static const char* WAL_DURABILITY_NONE = "none";
+static const char* WAL_DURABILITY_FLUSH = "flush";
+static const char* WAL_DURABILITY_SYNC = "fsync";
+
 struct MXLogRecord {
     uint64_t lsn;
     MXLogType type;
@@ -45,6 +55,7 @@ struct MXLogConfiguration {
     bool recovery_error_ignore;
     uint32_t buffer_size;
     std::string mxlog_path;
+    MXLogDurability durability = MXLogDurability::Flush;
 };
 
 }  // namespace wal
@@ -62,15 +62,36 @@ MXLogFileHandler::Load(char* buf, uint32_t data_offset, uint32_t data_size) {
 }
 
 bool
-MXLogFileHandler::Write(char* buf, uint32_t data_size, bool is_sync) {
+MXLogFileHandler::Write(char* buf, uint32_t data_size, bool is_flush) {
     uint32_t written_size = 0;
     if (OpenFile() && data_size != 0) {
         written_size = fwrite(buf, 1, data_size, p_file_);
-        fflush(p_file_);
+        if (is_flush) {
+            fflush(p_file_);
+        }
     }
     return (written_size == data_size);
 }
 
+bool
+MXLogFileHandler::Flush(bool is_sync) {
+    if (p_file_ == nullptr) {
+        return true;
+    }
+    if (fflush(p_file_) != 0) {
+        return false;
+    }
+    return !is_sync || fdatasync(fileno(p_file_)) == 0;
+}
+
+int
+MXLogFileHandler::DupDescriptor() {
+    if (p_file_ == nullptr) {
+        return -1;
+    }
+    return dup(fileno(p_file_));
+}
+
 bool
 MXLogFileHandler::ReBorn(const std::string& file_name, const std::string& open_mode) {
     CloseFile();
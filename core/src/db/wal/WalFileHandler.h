@@ -36,8 +36,15 @@ class MXLogFileHandler {
     Load(char* buf, uint32_t data_offset);
     bool
     Load(char* buf, uint32_t data_offset, uint32_t data_size);
+    // the data stays in the user space buffer of the file unless is_flush
     bool
-    Write(char* buf, uint32_t data_size, bool is_sync = false);
+    Write(char* buf, uint32_t data_size, bool is_flush = true);
+    // write the user space buffer into the OS, and sync the file to disk if is_sync
+    bool
+    Flush(bool is_sync = false);
+    // a new descriptor of the opened file which stays valid after the file is closed, -1 if not opened
+    int
+    DupDescriptor();
     bool
     ReBorn(const std::string& file_name, const std::string& open_mode);
     uint32_t
@@ -17,6 +17,7 @@
 #include <memory>
 
 #include "config/Config.h"
+#include "metrics/Metrics.h"
 #include "utils/CommonUtil.h"
 #include "utils/Exception.h"
 #include "utils/Log.h"
@@ -32,6 +33,7 @@ WalManager::WalManager(const MXLogConfiguration& config) {
     mxlog_config_.recovery_error_ignore = config.recovery_error_ignore;
     mxlog_config_.buffer_size = config.buffer_size;
     mxlog_config_.mxlog_path = config.mxlog_path;
+    mxlog_config_.durability = config.durability;
 
     // check the path end with '/'
     if (mxlog_config_.mxlog_path.back() != '/') {
@@ -100,7 +102,8 @@ WalManager::Init(const meta::MetaPtr& meta) {
     }
 
     ErrorCode error_code = WAL_ERROR;
-    p_buffer_ = std::make_shared<MXLogBuffer>(mxlog_config_.mxlog_path, mxlog_config_.buffer_size);
+    p_buffer_ =
+        std::make_shared<MXLogBuffer>(mxlog_config_.mxlog_path, mxlog_config_.buffer_size, mxlog_config_.durability);
     if (p_buffer_ != nullptr) {
         if (p_buffer_->Init(recovery_start, applied_lsn)) {
             error_code = WAL_SUCCESS;
@@ -116,6 +119,7 @@ WalManager::Init(const meta::MetaPtr& meta) {
     mxlog_config_.buffer_size = p_buffer_->GetBufferSize();
 
     last_applied_lsn_ = applied_lsn;
+    synced_lsn_ = applied_lsn;
     return error_code;
 }
 
@@ -247,11 +251,14 @@ WalManager::Insert(const std::string& table_id, const std::string& partition_tag
     size_t unit_size = dim * sizeof(T) + sizeof(IDNumber);
     size_t head_size = SizeOfMXLogRecordHeader + table_id.length() + partition_tag.length();
 
+    server::CollectWalCommitMetrics metrics;
+
     MXLogRecord record;
     record.type = log_type;
     record.table_id = table_id;
     record.partition_tag = partition_tag;
 
+    std::unique_lock<std::mutex> append_lck(append_mutex_);
     uint64_t new_lsn = 0;
     for (size_t i = 0; i < vector_num; i += record.length) {
         size_t surplus_space = p_buffer_->SurplusSpace();
@@ -289,7 +296,10 @@ WalManager::Insert(const std::string& table_id, const std::string& partition_tag
 
     WAL_LOG_INFO << table_id << " insert in part " << partition_tag << " with lsn " << new_lsn;
 
-    return p_meta_handler_->SetMXLogInternalMeta(new_lsn);
+    bool meta_rst = p_meta_handler_->SetMXLogInternalMeta(new_lsn);
+    append_lck.unlock();
+
+    return WaitDurable(new_lsn) && meta_rst;
 }
 
 bool
@@ -303,11 +313,14 @@ WalManager::DeleteById(const std::string& table_id, const IDNumbers& vector_ids)
     size_t unit_size = sizeof(IDNumber);
     size_t head_size = SizeOfMXLogRecordHeader + table_id.length();
 
+    server::CollectWalCommitMetrics metrics;
+
     MXLogRecord record;
     record.type = MXLogType::Delete;
     record.table_id = table_id;
     record.partition_tag = "";
 
+    std::unique_lock<std::mutex> append_lck(append_mutex_);
     uint64_t new_lsn = 0;
     for (size_t i = 0; i < vector_num; i += record.length) {
         size_t surplus_space = p_buffer_->SurplusSpace();
@@ -341,7 +354,10 @@ WalManager::DeleteById(const std::string& table_id, const IDNumbers& vector_ids)
 
     WAL_LOG_INFO << table_id << " delete rows by id, lsn " << new_lsn;
 
-    return p_meta_handler_->SetMXLogInternalMeta(new_lsn);
+    bool meta_rst = p_meta_handler_->SetMXLogInternalMeta(new_lsn);
+    append_lck.unlock();
+
+    return WaitDurable(new_lsn) && meta_rst;
 }
 
 uint64_t
@@ -381,6 +397,52 @@ WalManager::Flush(const std::string& table_id) {
     return lsn;
 }
 
+bool
+WalManager::WaitDurable(uint64_t lsn) {
+    if (mxlog_config_.durability != MXLogDurability::Sync) {
+        return true;
+    }
+
+    std::unique_lock<std::mutex> sync_lck(sync_mutex_);
+    while (synced_lsn_ < lsn) {
+        if (syncing_) {
+            sync_cv_.wait(sync_lck);
+            continue;
+        }
+        syncing_ = true;
+        sync_lck.unlock();
+
+        // records appended by others while syncing are synced by the next group
+        uint64_t group_lsn = 0;
+        int fd = -1;
+        {
+            std::lock_guard<std::mutex> append_lck(append_mutex_);
+            group_lsn = last_applied_lsn_;
+            fd = p_buffer_->PrepareSync();
+        }
+
+        server::CollectWalSyncMetrics metrics;
+        bool sync_rst = (fd >= 0 && fdatasync(fd) == 0 && p_meta_handler_->Sync());
+        if (fd >= 0) {
+            close(fd);
+        }
+
+        sync_lck.lock();
+        syncing_ = false;
+        if (sync_rst && group_lsn > synced_lsn_) {
+            synced_lsn_ = group_lsn;
+        }
+        sync_cv_.notify_all();
+
+        if (!sync_rst) {
+            WAL_LOG_ERROR << "sync wal file error, lsn " << group_lsn;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void
 WalManager::RemoveOldFiles(uint64_t flushed_lsn) {
     if (p_buffer_ != nullptr) {
@@ -12,7 +12,9 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -116,6 +118,15 @@ class WalManager {
     WalManager
     operator=(WalManager&);
 
+    /*
+     * Group commit: wait until the records before lsn are synced to disk if durability is Sync;
+     * the first waiter syncs all records appended so far, the others wait for it and check again
+     * @param lsn: lsn of the last record
+     * @retval false if sync failed
+     */
+    bool
+    WaitDurable(uint64_t lsn);
+
     MXLogConfiguration mxlog_config_;
 
     MXLogBufferPtr p_buffer_;
@@ -129,6 +140,14 @@ class WalManager {
     std::map<std::string, TableLsn> tables_;
     std::atomic<uint64_t> last_applied_lsn_;
 
+    // serialize appending of records from concurrent requests
+    std::mutex append_mutex_;
+
+    std::mutex sync_mutex_;
+    std::condition_variable sync_cv_;
+    uint64_t synced_lsn_ = 0;
+    bool syncing_ = false;
+
     // if multi-thread call Flush(), use list
     struct FlushInfo {
         std::string table_id_;
@@ -11,6 +11,8 @@
 
 #include "db/wal/WalMetaHandler.h"
 
+#include <unistd.h>
+
 #include <cstring>
 
 namespace milvus {
@@ -65,6 +67,11 @@ MXLogMetaHandler::SetMXLogInternalMeta(uint64_t wal_lsn) {
     return false;
 }
 
+bool
+MXLogMetaHandler::Sync() {
+    return wal_meta_fp_ != nullptr && fdatasync(fileno(wal_meta_fp_)) == 0;
+}
+
 }  // namespace wal
 }  // namespace engine
 }  // namespace milvus
@@ -38,6 +38,10 @@ class MXLogMetaHandler {
     bool
     SetMXLogInternalMeta(uint64_t wal_lsn);
 
+    // sync the meta file to disk, the lsn is already written into the OS by SetMXLogInternalMeta
+    bool
+    Sync();
+
  private:
     FILE* wal_meta_fp_;
     uint64_t latest_wal_lsn_ = 0;
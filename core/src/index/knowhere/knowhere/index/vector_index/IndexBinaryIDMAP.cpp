@@ -113,7 +113,7 @@ BinaryIDMAP::GetRawVectors() {
     try {
         auto file_index = dynamic_cast<faiss::IndexBinaryIDMap*>(index_.get());
         auto flat_index = dynamic_cast<faiss::IndexBinaryFlat*>(file_index->index);
-        return flat_index->xb.data();
+        return flat_index->get_xb();
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
     }
@@ -151,6 +151,30 @@ BinaryIDMAP::AddWithoutId(const DatasetPtr& dataset, const Config& config) {
     index_->add_with_ids(rows, (uint8_t*)p_data, new_ids.data());
 }
 
+void
+BinaryIDMAP::AddWithoutIdNoCopy(const DatasetPtr& dataset, std::shared_ptr<void> data_holder) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    GETBINARYTENSOR(dataset)
+
+    auto id_index = dynamic_cast<faiss::IndexBinaryIDMap*>(index_.get());
+    auto flat_index = id_index ? dynamic_cast<faiss::IndexBinaryFlat*>(id_index->index) : nullptr;
+    if (flat_index == nullptr || id_index->ntotal != 0) {
+        KNOWHERE_THROW_MSG("index can't use external vectors");
+    }
+
+    flat_index->add_external(rows, (const uint8_t*)p_data);
+    id_index->id_map.resize(rows);
+    for (int64_t i = 0; i < rows; ++i) {
+        id_index->id_map[i] = i;
+    }
+    id_index->ntotal = rows;
+    data_holder_ = std::move(data_holder);
+}
+
 DatasetPtr
 BinaryIDMAP::GetVectorById(const DatasetPtr& dataset, const Config& config) {
     if (!index_) {
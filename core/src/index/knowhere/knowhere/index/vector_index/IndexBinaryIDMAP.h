@@ -45,6 +45,10 @@ class BinaryIDMAP : public VectorIndex, public FaissBaseBinaryIndex {
     void
     AddWithoutId(const DatasetPtr& dataset, const Config& config);
 
+    // search the vectors of dataset in place instead of copying them, data_holder keeps them valid
+    void
+    AddWithoutIdNoCopy(const DatasetPtr& dataset, std::shared_ptr<void> data_holder);
+
     void
     Train(const Config& config);
 
@@ -84,6 +88,7 @@ class BinaryIDMAP : public VectorIndex, public FaissBaseBinaryIndex {
 
  private:
     faiss::ConcurrentBitsetPtr bitset_ = nullptr;
+    std::shared_ptr<void> data_holder_ = nullptr;
 };
 
 using BinaryIDMAPPtr = std::shared_ptr<BinaryIDMAP>;
@@ -81,47 +81,17 @@ IndexHNSW::Search(const DatasetPtr& dataset, const Config& config) {
     }
     GETTENSOR(dataset)
 
-    size_t id_size = sizeof(int64_t) * config[meta::TOPK].get<int64_t>();
-    size_t dist_size = sizeof(float) * config[meta::TOPK].get<int64_t>();
-    auto p_id = (int64_t*)malloc(id_size * rows);
-    auto p_dist = (float*)malloc(dist_size * rows);
+    auto k = config[meta::TOPK].get<int64_t>();
+    auto ef = config[IndexParams::ef].get<int64_t>();
+    auto p_id = (int64_t*)malloc(sizeof(int64_t) * k * rows);
+    auto p_dist = (float*)malloc(sizeof(float) * k * rows);
 
-    index_->setEf(config[IndexParams::ef]);
+    index_->searchKnnBatch(rows, p_data, k, ef, p_dist, p_id, bitset_);
 
-    using P = std::pair<float, int64_t>;
-    auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
-#pragma omp parallel for
-    for (unsigned int i = 0; i < rows; ++i) {
-        std::vector<P> ret;
-        const float* single_query = p_data + i * Dimension();
-
-        // if (normalize) {
-        //     std::vector<float> norm_vector(Dimension());
-        //     normalize_vector((float*)(single_query), norm_vector.data(), Dimension());
-        //     ret = index_->searchKnn((float*)(norm_vector.data()), config[meta::TOPK].get<int64_t>(), compare);
-        // } else {
-        //     ret = index_->searchKnn((float*)single_query, config[meta::TOPK].get<int64_t>(), compare);
-        // }
-        ret = index_->searchKnn((float*)single_query, config[meta::TOPK].get<int64_t>(), compare);
-
-        while (ret.size() < config[meta::TOPK]) {
-            ret.push_back(std::make_pair(-1, -1));
-        }
-        std::vector<float> dist;
-        std::vector<int64_t> ids;
-
-        if (normalize) {
-            std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
-                           [](const std::pair<float, int64_t>& e) { return float(1 - e.first); });
-        } else {
-            std::transform(ret.begin(), ret.end(), std::back_inserter(dist),
-                           [](const std::pair<float, int64_t>& e) { return e.first; });
+    if (normalize) {
+        for (int64_t i = 0; i < k * rows; ++i) {
+            p_dist[i] = 1 - p_dist[i];
         }
-        std::transform(ret.begin(), ret.end(), std::back_inserter(ids),
-                       [](const std::pair<float, int64_t>& e) { return e.second; });
-
-        memcpy(p_dist + i * config[meta::TOPK].get<int64_t>(), dist.data(), dist_size);
-        memcpy(p_id + i * config[meta::TOPK].get<int64_t>(), ids.data(), id_size);
     }
 
     auto ret_ds = std::make_shared<Dataset>();
@@ -176,6 +146,16 @@ IndexHNSW::Add(const DatasetPtr& dataset, const Config& config) {
     //         }
     //     }
 
+    if (rows == 0) {
+        return;
+    }
+
+    // an index built earlier, or loaded from a checkpoint, grows to take the new vectors
+    size_t element_count = index_->cur_element_count + static_cast<size_t>(rows);
+    if (element_count > index_->max_elements_) {
+        index_->resizeIndex(element_count);
+    }
+
     index_->addPoint((void*)(p_data), p_ids[0]);
 #pragma omp parallel for
     for (int i = 1; i < rows; ++i) {
@@ -204,4 +184,14 @@ IndexHNSW::Dimension() {
     return (*(size_t*)index_->dist_func_param_);
 }
 
+void
+IndexHNSW::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
+    bitset_ = std::move(list);
+}
+
+void
+IndexHNSW::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
+    list = bitset_;
+}
+
 }  // namespace knowhere
@@ -14,6 +14,7 @@
 #include <memory>
 #include <mutex>
 
+#include "faiss/utils/ConcurrentBitset.h"
 #include "hnswlib/hnswlib.h"
 
 #include "knowhere/index/vector_index/VectorIndex.h"
@@ -55,10 +56,17 @@ class IndexHNSW : public VectorIndex {
     int64_t
     Dimension() override;
 
+    void
+    SetBlacklist(faiss::ConcurrentBitsetPtr list);
+
+    void
+    GetBlacklist(faiss::ConcurrentBitsetPtr& list);
+
  private:
     bool normalize = false;
     std::mutex mutex_;
     std::shared_ptr<hnswlib::HierarchicalNSW<float>> index_;
+    faiss::ConcurrentBitsetPtr bitset_ = nullptr;
 };
 
 }  // namespace knowhere
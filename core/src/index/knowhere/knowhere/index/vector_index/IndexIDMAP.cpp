@@ -112,6 +112,31 @@ IDMAP::AddWithoutId(const DatasetPtr& dataset, const Config& config) {
     index_->add_with_ids(rows, (float*)p_data, new_ids.data());
 }
 
+void
+IDMAP::AddWithoutIdNoCopy(const DatasetPtr& dataset, std::shared_ptr<void> data_holder) {
+    if (!index_) {
+        KNOWHERE_THROW_MSG("index not initialize");
+    }
+
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto rows = dataset->Get<int64_t>(meta::ROWS);
+    auto p_data = dataset->Get<const float*>(meta::TENSOR);
+
+    auto id_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
+    auto flat_index = id_index ? dynamic_cast<faiss::IndexFlat*>(id_index->index) : nullptr;
+    if (flat_index == nullptr || id_index->ntotal != 0) {
+        KNOWHERE_THROW_MSG("index can't use external vectors");
+    }
+
+    flat_index->add_external(rows, p_data);
+    id_index->id_map.resize(rows);
+    for (int64_t i = 0; i < rows; ++i) {
+        id_index->id_map[i] = i;
+    }
+    id_index->ntotal = rows;
+    data_holder_ = std::move(data_holder);
+}
+
 int64_t
 IDMAP::Count() {
     return index_->ntotal;
@@ -127,7 +152,7 @@ IDMAP::GetRawVectors() {
     try {
         auto file_index = dynamic_cast<faiss::IndexIDMap*>(index_.get());
         auto flat_index = dynamic_cast<faiss::IndexFlat*>(file_index->index);
-        return flat_index->xb.data();
+        return flat_index->get_xb();
     } catch (std::exception& e) {
         KNOWHERE_THROW_MSG(e.what());
     }
@@ -54,6 +54,10 @@ class IDMAP : public VectorIndex, public FaissBaseIndex {
     void
     AddWithoutId(const DatasetPtr& dataset, const Config& config);
 
+    // search the vectors of dataset in place instead of copying them, data_holder keeps them valid
+    void
+    AddWithoutIdNoCopy(const DatasetPtr& dataset, std::shared_ptr<void> data_holder);
+
     VectorIndexPtr
     CopyCpuToGpu(const int64_t& device_id, const Config& config);
 
@@ -87,6 +91,7 @@ class IDMAP : public VectorIndex, public FaissBaseIndex {
 
  private:
     faiss::ConcurrentBitsetPtr bitset_ = nullptr;
+    std::shared_ptr<void> data_holder_ = nullptr;
 };
 
 using IDMAPPtr = std::shared_ptr<IDMAP>;
@@ -49,6 +49,7 @@ IVF::Train(const DatasetPtr& dataset, const Config& config) {
     faiss::Index* coarse_quantizer = new faiss::IndexFlatL2(dim);
     auto index = std::make_shared<faiss::IndexIVFFlat>(coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(),
                                                        GetMetricType(config[Metric::TYPE].get<std::string>()));
+    UseSharedQuantizer(index.get());
     index->train(rows, (float*)p_data);
 
     // TODO(linxj): override here. train return model or not.
@@ -94,6 +95,7 @@ void
 IVF::Load(const BinarySet& index_binary) {
     std::lock_guard<std::mutex> lk(mutex_);
     LoadImpl(index_binary);
+    AttachSharedQuantizer();
 }
 
 DatasetPtr
@@ -148,6 +150,7 @@ IVF::set_index_model(IndexModelPtr model) {
 
     // Deep copy here.
     index_.reset(faiss::clone_index(rel_model->index_.get()));
+    AttachSharedQuantizer();
 }
 
 std::shared_ptr<faiss::IVFSearchParameters>
@@ -210,7 +213,15 @@ IVF::search_impl(int64_t n, const float* data, int64_t k, float* distances, int6
     auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
     ivf_index->nprobe = params->nprobe;
     stdclock::time_point before = stdclock::now();
-    ivf_index->search(n, (float*)data, k, distances, labels, bitset_);
+    if (shared_quantizer_ != nullptr && ivf_index->quantizer == shared_quantizer_->quantizer()) {
+        // the lists to probe are computed once for all the indexes sharing the quantizer
+        auto assignment = shared_quantizer_->Assign(n, data, params->nprobe);
+        ivf_index->invlists->prefetch_lists(assignment->lists.data(), n * params->nprobe);
+        ivf_index->search_preassigned(n, data, k, assignment->lists.data(), assignment->distances.data(), distances,
+                                      labels, false, nullptr, bitset_);
+    } else {
+        ivf_index->search(n, (float*)data, k, distances, labels, bitset_);
+    }
     stdclock::time_point after = stdclock::now();
     double search_cost = (std::chrono::duration<double, std::micro>(after - before)).count();
     KNOWHERE_LOG_DEBUG << "IVF search cost: " << search_cost
@@ -345,6 +356,69 @@ IVF::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
     list = bitset_;
 }
 
+void
+IVF::SetSharedQuantizer(const SharedQuantizerPtr& quantizer) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    shared_quantizer_ = quantizer;
+    AttachSharedQuantizer();
+}
+
+SharedQuantizerPtr
+IVF::GetSharedQuantizer() {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (ivf_index == nullptr || !ivf_index->is_trained) {
+        return nullptr;
+    }
+
+    if (shared_quantizer_ == nullptr || ivf_index->quantizer != shared_quantizer_->quantizer()) {
+        // the index hands its own quantizer over
+        std::shared_ptr<faiss::Index> quantizer;
+        if (ivf_index->own_fields) {
+            quantizer.reset(ivf_index->quantizer);
+            ivf_index->own_fields = false;
+        } else {
+            quantizer.reset(faiss::clone_index(ivf_index->quantizer));
+            ivf_index->quantizer = quantizer.get();
+        }
+        shared_quantizer_ = std::make_shared<SharedQuantizer>(quantizer);
+    }
+    return shared_quantizer_;
+}
+
+void
+IVF::UseSharedQuantizer(faiss::IndexIVF* index) {
+    auto quantizer = shared_quantizer_ == nullptr ? nullptr : shared_quantizer_->quantizer();
+    if (index == nullptr || quantizer == nullptr || !quantizer->is_trained || quantizer->d != index->d ||
+        quantizer->ntotal != static_cast<int64_t>(index->nlist) ||
+        quantizer->metric_type != index->quantizer->metric_type) {
+        return;
+    }
+
+    if (index->own_fields) {
+        delete index->quantizer;
+    }
+    index->quantizer = quantizer;
+    index->own_fields = false;
+}
+
+void
+IVF::AttachSharedQuantizer() {
+    auto ivf_index = dynamic_cast<faiss::IndexIVF*>(index_.get());
+    if (shared_quantizer_ == nullptr || ivf_index == nullptr) {
+        return;
+    }
+    if (ivf_index->quantizer == shared_quantizer_->quantizer() || !shared_quantizer_->Match(ivf_index->quantizer)) {
+        return;
+    }
+
+    if (ivf_index->own_fields) {
+        delete ivf_index->quantizer;
+    }
+    ivf_index->quantizer = shared_quantizer_->quantizer();
+    ivf_index->own_fields = false;
+}
+
 IVFIndexModel::IVFIndexModel(std::shared_ptr<faiss::Index> index) : FaissBaseIndex(std::move(index)) {
 }
 
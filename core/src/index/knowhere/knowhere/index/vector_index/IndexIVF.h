@@ -20,6 +20,7 @@
 #include "VectorIndex.h"
 #include "faiss/IndexIVF.h"
 #include "faiss/utils/ConcurrentBitset.h"
+#include "knowhere/index/vector_index/helpers/SharedQuantizer.h"
 
 namespace knowhere {
 
@@ -84,10 +85,23 @@ class IVF : public VectorIndex, public FaissBaseIndex {
     void
     GetBlacklist(faiss::ConcurrentBitsetPtr& list);
 
+    // share the coarse quantizer with the indexes of other segments: an index trained afterwards uses it
+    // instead of training its own, a trained index drops its own quantizer if the centroids are the same
+    void
+    SetSharedQuantizer(const SharedQuantizerPtr& quantizer);
+
+    // the coarse quantizer of the trained index, to be shared with other indexes
+    SharedQuantizerPtr
+    GetSharedQuantizer();
+
  protected:
     virtual std::shared_ptr<faiss::IVFSearchParameters>
     GenParams(const Config& config);
 
+    // make an untrained index use the shared quantizer, which is then not trained again
+    void
+    UseSharedQuantizer(faiss::IndexIVF* index);
+
     //    virtual VectorIndexPtr
     //    Clone_impl(const std::shared_ptr<faiss::Index>& index);
 
@@ -97,8 +111,14 @@ class IVF : public VectorIndex, public FaissBaseIndex {
  protected:
     std::mutex mutex_;
 
+ private:
+    // point the index to the shared quantizer if the centroids are the same, the caller must hold mutex_
+    void
+    AttachSharedQuantizer();
+
  private:
     faiss::ConcurrentBitsetPtr bitset_ = nullptr;
+    SharedQuantizerPtr shared_quantizer_ = nullptr;
 };
 
 using IVFIndexPtr = std::shared_ptr<IVF>;
@@ -37,6 +37,7 @@ IVFPQ::Train(const DatasetPtr& dataset, const Config& config) {
     auto index = std::make_shared<faiss::IndexIVFPQ>(coarse_quantizer, dim, config[IndexParams::nlist].get<int64_t>(),
                                                      config[IndexParams::m].get<int64_t>(),
                                                      config[IndexParams::nbits].get<int64_t>());
+    UseSharedQuantizer(index.get());
     index->train(rows, (float*)p_data);
 
     return std::make_shared<IVFIndexModel>(index);
@@ -38,6 +38,7 @@ IVFSQ::Train(const DatasetPtr& dataset, const Config& config) {
                << "SQ" << config[IndexParams::nbits];
     auto build_index =
         faiss::index_factory(dim, index_type.str().c_str(), GetMetricType(config[Metric::TYPE].get<std::string>()));
+    UseSharedQuantizer(dynamic_cast<faiss::IndexIVF*>(build_index));
     build_index->train(rows, (float*)p_data);
 
     std::shared_ptr<faiss::Index> ret_index;
@@ -0,0 +1,101 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "knowhere/index/vector_index/helpers/SharedQuantizer.h"
+
+#include <faiss/IndexFlat.h>
+
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+namespace knowhere {
+
+namespace {
+
+// a search of S segments uses the same queries S times, a few batches are searched at the same time
+constexpr size_t MAX_ASSIGNMENT_ENTRIES = 32;
+
+}  // namespace
+
+SharedQuantizer::SharedQuantizer(std::shared_ptr<faiss::Index> quantizer) : quantizer_(std::move(quantizer)) {
+}
+
+bool
+SharedQuantizer::Match(const faiss::Index* quantizer) const {
+    auto shared = dynamic_cast<const faiss::IndexFlat*>(quantizer_.get());
+    auto other = dynamic_cast<const faiss::IndexFlat*>(quantizer);
+    if (shared == nullptr || other == nullptr) {
+        return false;
+    }
+    if (shared->d != other->d || shared->ntotal != other->ntotal || shared->metric_type != other->metric_type ||
+        shared->xb.size() != other->xb.size()) {
+        return false;
+    }
+    return shared == other || memcmp(shared->xb.data(), other->xb.data(), shared->xb.size() * sizeof(float)) == 0;
+}
+
+SharedQuantizer::AssignmentPtr
+SharedQuantizer::Assign(int64_t n, const float* x, int64_t nprobe) {
+    size_t size = n * quantizer_->d;
+    std::string_view bytes(reinterpret_cast<const char*>(x), size * sizeof(float));
+    size_t hash = std::hash<std::string_view>()(bytes);
+
+    std::promise<AssignmentPtr> promise;
+    EntryPtr new_entry;
+    std::shared_future<AssignmentPtr> assignment;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto iter = entries_.begin(); iter != entries_.end(); ++iter) {
+            auto& entry = *iter;
+            if (entry->hash_ == hash && entry->n_ == n && entry->nprobe_ == nprobe &&
+                memcmp(entry->queries_.data(), x, size * sizeof(float)) == 0) {
+                assignment = entry->assignment_;
+                entries_.splice(entries_.begin(), entries_, iter);
+                break;
+            }
+        }
+
+        if (!assignment.valid()) {
+            new_entry = std::make_shared<Entry>();
+            new_entry->n_ = n;
+            new_entry->nprobe_ = nprobe;
+            new_entry->hash_ = hash;
+            new_entry->queries_.assign(x, x + size);
+            new_entry->assignment_ = promise.get_future().share();
+            entries_.push_front(new_entry);
+            if (entries_.size() > MAX_ASSIGNMENT_ENTRIES) {
+                entries_.pop_back();
+            }
+        }
+    }
+
+    if (new_entry == nullptr) {
+        return assignment.get();
+    }
+
+    try {
+        auto result = std::make_shared<Assignment>();
+        result->lists.resize(n * nprobe);
+        result->distances.resize(n * nprobe);
+        quantizer_->search(n, x, nprobe, result->distances.data(), result->lists.data());
+        promise.set_value(result);
+        return result;
+    } catch (...) {
+        // the waiters get the error too, the entry is dropped so that the next call computes again
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.remove(new_entry);
+        throw;
+    }
+}
+
+}  // namespace knowhere
@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <faiss/Index.h>
+
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace knowhere {
+
+// Coarse quantizer shared by the IVF indexes of several segments. The indexes point to the same centroids
+// instead of owning a copy, and the lists probed by a batch of queries are computed once for all of them.
+class SharedQuantizer {
+ public:
+    // the nearest lists of n queries, nprobe per query
+    struct Assignment {
+        std::vector<int64_t> lists;
+        std::vector<float> distances;
+    };
+    using AssignmentPtr = std::shared_ptr<const Assignment>;
+
+    explicit SharedQuantizer(std::shared_ptr<faiss::Index> quantizer);
+
+    faiss::Index*
+    quantizer() const {
+        return quantizer_.get();
+    }
+
+    // true if 'quantizer' is a flat quantizer with the same centroids and metric
+    bool
+    Match(const faiss::Index* quantizer) const;
+
+    // the nprobe nearest lists of the queries; the lists of recently assigned queries are reused, concurrent
+    // calls with the same queries wait for one computation
+    AssignmentPtr
+    Assign(int64_t n, const float* x, int64_t nprobe);
+
+ private:
+    struct Entry {
+        int64_t n_ = 0;
+        int64_t nprobe_ = 0;
+        size_t hash_ = 0;
+        std::vector<float> queries_;
+        std::shared_future<AssignmentPtr> assignment_;
+    };
+    using EntryPtr = std::shared_ptr<Entry>;
+
+ private:
+    std::shared_ptr<faiss::Index> quantizer_;
+
+    std::mutex mutex_;
+    // most recently used first
+    std::list<EntryPtr> entries_;
+};
+
+using SharedQuantizerPtr = std::shared_ptr<SharedQuantizer>;
+
+}  // namespace knowhere
@@ -29,12 +29,22 @@ IndexBinaryFlat::IndexBinaryFlat(idx_t d, MetricType metric)
     : IndexBinary(d, metric) {}
 
 void IndexBinaryFlat::add(idx_t n, const uint8_t *x) {
+  FAISS_THROW_IF_NOT_MSG(!xb_external,
+                         "cannot add to an index with external vectors");
   xb.insert(xb.end(), x, x + n * code_size);
   ntotal += n;
 }
 
+void IndexBinaryFlat::add_external(idx_t n, const uint8_t *x) {
+  FAISS_THROW_IF_NOT_MSG(ntotal == 0 && !xb_external,
+                         "external vectors need an empty index");
+  xb_external = x;
+  ntotal = n;
+}
+
 void IndexBinaryFlat::reset() {
   xb.clear();
+  xb_external = nullptr;
   ntotal = 0;
 }
 
@@ -56,7 +66,7 @@ void IndexBinaryFlat::search(idx_t n, const uint8_t *x, idx_t k,
                         size_t(nn), size_t(k), labels + s * k, D + s * k
                 };
 
-                jaccard_knn_hc(&res, x + s * code_size, xb.data(), ntotal, code_size,
+                jaccard_knn_hc(&res, x + s * code_size, get_xb(), ntotal, code_size,
                         /* ordered = */ true, bitset);
 
             } else {
@@ -82,10 +92,10 @@ void IndexBinaryFlat::search(idx_t n, const uint8_t *x, idx_t k,
                         size_t(nn), size_t(k), labels + s * k, distances + s * k
                 };
 
-                hammings_knn_hc(&res, x + s * code_size, xb.data(), ntotal, code_size,
+                hammings_knn_hc(&res, x + s * code_size, get_xb(), ntotal, code_size,
                         /* ordered = */ true, bitset);
             } else {
-                hammings_knn_mc(x + s * code_size, xb.data(), nn, ntotal, k, code_size,
+                hammings_knn_mc(x + s * code_size, get_xb(), nn, ntotal, k, code_size,
                                 distances + s * k, labels + s * k, bitset);
             }
         }
@@ -93,6 +103,8 @@ void IndexBinaryFlat::search(idx_t n, const uint8_t *x, idx_t k,
 }
 
 size_t IndexBinaryFlat::remove_ids(const IDSelector& sel) {
+  FAISS_THROW_IF_NOT_MSG(!xb_external,
+                         "cannot remove from an index with external vectors");
   idx_t j = 0;
   for (idx_t i = 0; i < ntotal; i++) {
     if (sel.is_member(i)) {
@@ -113,7 +125,7 @@ size_t IndexBinaryFlat::remove_ids(const IDSelector& sel) {
 }
 
 void IndexBinaryFlat::reconstruct(idx_t key, uint8_t *recons) const {
-  memcpy(recons, &(xb[code_size * key]), sizeof(*recons) * code_size);
+  memcpy(recons, get_xb() + code_size * key, sizeof(*recons) * code_size);
 }
 
 
@@ -22,6 +22,10 @@ struct IndexBinaryFlat : IndexBinary {
   /// database vectors, size ntotal * d / 8
   std::vector<uint8_t> xb;
 
+  /// external database vectors (eg. a memory-mapped file) used instead of
+  /// xb, not owned by the index, size ntotal * d / 8
+  const uint8_t* xb_external = nullptr;
+
   /** Select between using a heap or counting to select the k smallest values
    * when scanning inverted lists.
    */
@@ -33,6 +37,15 @@ struct IndexBinaryFlat : IndexBinary {
 
   IndexBinaryFlat(idx_t d, MetricType metric);
 
+  /// database vectors, either xb or the external ones
+  const uint8_t* get_xb() const {
+    return xb_external ? xb_external : xb.data();
+  }
+
+  /** use n external vectors as database without copying them, the buffer
+   * must outlive the index, which can't be added to anymore */
+  void add_external(idx_t n, const uint8_t *x);
+
   void add(idx_t n, const uint8_t *x) override;
 
   void reset() override;
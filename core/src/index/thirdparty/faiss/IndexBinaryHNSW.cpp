@@ -270,7 +270,7 @@ struct FlatHammingDis : DistanceComputer {
 
   explicit FlatHammingDis(const IndexBinaryFlat& storage)
       : code_size(storage.code_size),
-        b(storage.xb.data()),
+        b(storage.get_xb()),
         ndis(0),
         hc() {}
 
@@ -28,13 +28,23 @@ IndexFlat::IndexFlat (idx_t d, MetricType metric):
 
 
 void IndexFlat::add (idx_t n, const float *x) {
+    FAISS_THROW_IF_NOT_MSG (!xb_external,
+                            "cannot add to an index with external vectors");
     xb.insert(xb.end(), x, x + n * d);
     ntotal += n;
 }
 
+void IndexFlat::add_external (idx_t n, const float *x) {
+    FAISS_THROW_IF_NOT_MSG (ntotal == 0 && !xb_external,
+                            "external vectors need an empty index");
+    xb_external = x;
+    ntotal = n;
+}
+
 
 void IndexFlat::reset() {
     xb.clear();
+    xb_external = nullptr;
     ntotal = 0;
 }
 
@@ -46,19 +56,19 @@ void IndexFlat::search(idx_t n, const float* x, idx_t k, float* distances, idx_t
     if (metric_type == METRIC_INNER_PRODUCT) {
         float_minheap_array_t res = {
                 size_t(n), size_t(k), labels, distances};
-        knn_inner_product (x, xb.data(), d, n, ntotal, &res, bitset);
+        knn_inner_product (x, get_xb(), d, n, ntotal, &res, bitset);
     } else if (metric_type == METRIC_L2) {
         float_maxheap_array_t res = {
                 size_t(n), size_t(k), labels, distances};
-        knn_L2sqr (x, xb.data(), d, n, ntotal, &res, bitset);
+        knn_L2sqr (x, get_xb(), d, n, ntotal, &res, bitset);
     } else if (metric_type == METRIC_Jaccard) {
         float_maxheap_array_t res = {
                 size_t(n), size_t(k), labels, distances};
-        knn_jaccard (x, xb.data(), d, n, ntotal, &res, bitset);
+        knn_jaccard (x, get_xb(), d, n, ntotal, &res, bitset);
     } else {
         float_maxheap_array_t res = {
                 size_t(n), size_t(k), labels, distances};
-        knn_extra_metrics (x, xb.data(), d, n, ntotal,
+        knn_extra_metrics (x, get_xb(), d, n, ntotal,
                            metric_type, metric_arg,
                            &res, bitset);
     }
@@ -69,11 +79,11 @@ void IndexFlat::range_search (idx_t n, const float *x, float radius,
 {
     switch (metric_type) {
     case METRIC_INNER_PRODUCT:
-        range_search_inner_product (x, xb.data(), d, n, ntotal,
+        range_search_inner_product (x, get_xb(), d, n, ntotal,
                                     radius, result);
         break;
     case METRIC_L2:
-        range_search_L2sqr (x, xb.data(), d, n, ntotal, radius, result);
+        range_search_L2sqr (x, get_xb(), d, n, ntotal, radius, result);
         break;
     default:
         FAISS_THROW_MSG("metric type not supported");
@@ -92,12 +102,12 @@ void IndexFlat::compute_distance_subset (
         case METRIC_INNER_PRODUCT:
             fvec_inner_products_by_idx (
                  distances,
-                 x, xb.data(), labels, d, n, k);
+                 x, get_xb(), labels, d, n, k);
             break;
         case METRIC_L2:
             fvec_L2sqr_by_idx (
                  distances,
-                 x, xb.data(), labels, d, n, k);
+                 x, get_xb(), labels, d, n, k);
             break;
         default:
             FAISS_THROW_MSG("metric type not supported");
@@ -107,6 +117,8 @@ void IndexFlat::compute_distance_subset (
 
 size_t IndexFlat::remove_ids (const IDSelector & sel)
 {
+    FAISS_THROW_IF_NOT_MSG (!xb_external,
+                            "cannot remove from an index with external vectors");
     idx_t j = 0;
     for (idx_t i = 0; i < ntotal; i++) {
         if (sel.is_member (i)) {
@@ -150,7 +162,7 @@ struct FlatL2Dis : DistanceComputer {
         : d(storage.d),
           nb(storage.ntotal),
           q(q),
-          b(storage.xb.data()),
+          b(storage.get_xb()),
           ndis(0) {}
 
     void set_query(const float *x) override {
@@ -178,7 +190,7 @@ struct FlatIPDis : DistanceComputer {
         : d(storage.d),
           nb(storage.ntotal),
           q(q),
-          b(storage.xb.data()),
+          b(storage.get_xb()),
           ndis(0) {}
 
     void set_query(const float *x) override {
@@ -199,14 +211,14 @@ DistanceComputer * IndexFlat::get_distance_computer() const {
         return new FlatIPDis(*this);
     } else {
         return get_extra_distance_computer (d, metric_type, metric_arg,
-                                            ntotal, xb.data());
+                                            ntotal, get_xb());
     }
 }
 
 
 void IndexFlat::reconstruct (idx_t key, float * recons) const
 {
-    memcpy (recons, &(xb[key * d]), sizeof(*recons) * d);
+    memcpy (recons, get_xb() + key * d, sizeof(*recons) * d);
 }
 
 
@@ -251,7 +263,7 @@ void IndexFlatL2BaseShift::search (
 
     float_maxheap_array_t res = {
         size_t(n), size_t(k), labels, distances};
-    knn_L2sqr_base_shift (x, xb.data(), d, n, ntotal, &res, shift.data());
+    knn_L2sqr_base_shift (x, get_xb(), d, n, ntotal, &res, shift.data());
 }
 
 
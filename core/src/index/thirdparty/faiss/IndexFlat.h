@@ -22,8 +22,21 @@ struct IndexFlat: Index {
     /// database vectors, size ntotal * d
     std::vector<float> xb;
 
+    /// external database vectors (eg. a memory-mapped file) used instead
+    /// of xb, not owned by the index, size ntotal * d
+    const float* xb_external = nullptr;
+
     explicit IndexFlat (idx_t d, MetricType metric = METRIC_L2);
 
+    /// database vectors, either xb or the external ones
+    const float* get_xb() const {
+        return xb_external ? xb_external : xb.data();
+    }
+
+    /** use n external vectors as database without copying them, the
+     * buffer must outlive the index, which can't be added to anymore */
+    void add_external(idx_t n, const float* x);
+
     void add(idx_t n, const float* x) override;
 
     void reset() override;
@@ -85,7 +85,7 @@ GpuIndexBinaryFlat::copyFrom(const faiss::IndexBinaryFlat* index) {
 
   // The index could be empty
   if (index->ntotal > 0) {
-    data_->add(index->xb.data(),
+    data_->add(index->get_xb(),
                index->ntotal,
                resources_->getDefaultStream(config_.device));
   }
@@ -87,7 +87,7 @@ GpuIndexFlat::copyFrom(const faiss::IndexFlat* index) {
 
   // The index could be empty
   if (index->ntotal > 0) {
-    data_->add(index->xb.data(),
+    data_->add(index->get_xb(),
                index->ntotal,
                resources_->getDefaultStream(device_));
   }
@@ -95,7 +95,7 @@ GpuIndexFlat::copyFrom(const faiss::IndexFlat* index) {
   xb_.clear();
 
   if (config_.storeInCpu) {
-      xb_ = index->xb;
+      xb_.assign(index->get_xb(), index->get_xb() + index->ntotal * this->d);
   }
 }
 
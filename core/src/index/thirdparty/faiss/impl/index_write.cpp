@@ -321,7 +321,13 @@ void write_index (const Index *idx, IOWriter *f) {
               idxf->metric_type == METRIC_L2 ? "IxF2" : nullptr);
         WRITE1 (h);
         write_index_header (idx, f);
-        WRITEVECTOR (idxf->xb);
+        if (idxf->xb_external) {
+            size_t size = idxf->ntotal * idxf->d;
+            WRITEANDCHECK (&size, 1);
+            WRITEANDCHECK (idxf->xb_external, size);
+        } else {
+            WRITEVECTOR (idxf->xb);
+        }
     } else if(const IndexLSH * idxl = dynamic_cast<const IndexLSH *> (idx)) {
         uint32_t h = fourcc ("IxHe");
         WRITE1 (h);
@@ -537,7 +543,13 @@ void write_index_binary (const IndexBinary *idx, IOWriter *f) {
         uint32_t h = fourcc ("IBxF");
         WRITE1 (h);
         write_index_binary_header (idx, f);
-        WRITEVECTOR (idxf->xb);
+        if (idxf->xb_external) {
+            size_t size = idxf->ntotal * idxf->code_size;
+            WRITEANDCHECK (&size, 1);
+            WRITEANDCHECK (idxf->xb_external, size);
+        } else {
+            WRITEVECTOR (idxf->xb);
+        }
     } else if (const IndexBinaryIVF *ivf =
                dynamic_cast<const IndexBinaryIVF *> (idx)) {
         uint32_t h = fourcc ("IBwF");
@@ -17,29 +17,73 @@
 
 #include "ConcurrentBitset.h"
 
+#include <stdlib.h>
+
+#include <new>
+
 namespace faiss {
 
+namespace {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+}  // namespace
+
 ConcurrentBitset::ConcurrentBitset(id_type_t size) : size_(size) {
-    id_type_t bytes_count = (size >> 3) + 1;
-    // bitset_.resize(bytes_count, 0);
-    for (auto i = 0; i < bytes_count; ++i) {
-        bitset_.emplace_back(0);
+    static_assert(sizeof(std::atomic<word_t>) == sizeof(word_t), "atomic words must not carry a lock");
+
+    // one spare word as the byte array had one spare byte, rounded up to whole cache lines
+    const id_type_t words_per_line = CACHE_LINE_SIZE / sizeof(word_t);
+    word_count_ = ((size >> 6) + 1 + words_per_line - 1) / words_per_line * words_per_line;
+    void* memory = nullptr;
+    if (posix_memalign(&memory, CACHE_LINE_SIZE, word_count_ * sizeof(word_t)) != 0) {
+        throw std::bad_alloc();
+    }
+    words_ = static_cast<std::atomic<word_t>*>(memory);
+    for (id_type_t i = 0; i < word_count_; ++i) {
+        new (&words_[i]) std::atomic<word_t>(0);
     }
 }
 
+ConcurrentBitset::~ConcurrentBitset() {
+    free(words_);
+}
+
 bool
-ConcurrentBitset::test(id_type_t id) {
-    return bitset_[id >> 3].load() & (0x1 << (id & 0x7));
+ConcurrentBitset::test_range(id_type_t begin, id_type_t end) const {
+    for (id_type_t w = begin >> 6; w << 6 < end; w++) {
+        word_t bits = word(w);
+        id_type_t base = w << 6;
+        if (base < begin) {
+            bits &= FULL_WORD << (begin - base);
+        }
+        if (end - base < WORD_BITS) {
+            bits &= ~(FULL_WORD << (end - base));
+        }
+        if (bits != 0) {
+            return true;
+        }
+    }
+    return false;
 }
 
-void
-ConcurrentBitset::set(id_type_t id) {
-    bitset_[id >> 3].fetch_or(0x1 << (id & 0x7));
+ConcurrentBitset::id_type_t
+ConcurrentBitset::count() const {
+    id_type_t count = 0;
+    for (id_type_t w = 0; w < word_count_; w++) {
+        count += __builtin_popcountll(word(w));
+    }
+    return count;
 }
 
 void
-ConcurrentBitset::clear(id_type_t id) {
-    bitset_[id >> 3].fetch_and(~(0x1 << (id & 0x7)));
+ConcurrentBitset::merge(const ConcurrentBitset& other) {
+    for (id_type_t w = 0; w < word_count_ && w < other.word_count_; w++) {
+        word_t bits = other.word(w);
+        if (bits != 0) {
+            words_[w].fetch_or(bits, std::memory_order_relaxed);
+        }
+    }
 }
 
 }  // namespace faiss
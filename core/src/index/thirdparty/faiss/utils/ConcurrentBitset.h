@@ -18,35 +18,110 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
-#include <deque>
 
 namespace faiss {
 
+// Bitset of the deleted vectors, stored in 64-bit words in one cache-line aligned block. Bits are set and
+// cleared atomically, scan kernels read one word per 64 vectors and skip words where every vector is deleted.
 class ConcurrentBitset {
  public:
     using id_type_t = int64_t;
+    using word_t = uint64_t;
+
+    static constexpr id_type_t WORD_BITS = 64;
+    static constexpr word_t FULL_WORD = ~word_t(0);
 
     explicit ConcurrentBitset(id_type_t size);
 
-    //    ConcurrentBitset(const ConcurrentBitset&) = delete;
-    //    ConcurrentBitset&
-    //    operator=(const ConcurrentBitset&) = delete;
+    ~ConcurrentBitset();
+
+    ConcurrentBitset(const ConcurrentBitset&) = delete;
+    ConcurrentBitset&
+    operator=(const ConcurrentBitset&) = delete;
+
+    bool
+    test(id_type_t id) const {
+        return (words_[id >> 6].load(std::memory_order_relaxed) >> (id & 0x3f)) & 0x1;
+    }
+
+    void
+    set(id_type_t id) {
+        words_[id >> 6].fetch_or(word_t(1) << (id & 0x3f), std::memory_order_relaxed);
+    }
+
+    void
+    clear(id_type_t id) {
+        words_[id >> 6].fetch_and(~(word_t(1) << (id & 0x3f)), std::memory_order_relaxed);
+    }
+
+    id_type_t
+    size() const {
+        return size_;
+    }
 
+    // the bits of ids [index * 64, index * 64 + 64), words past the end read as zero
+    word_t
+    word(id_type_t index) const {
+        return index < word_count_ ? words_[index].load(std::memory_order_relaxed) : 0;
+    }
+
+    // true if any id of [begin, end) is set
     bool
-    test(id_type_t id);
+    test_range(id_type_t begin, id_type_t end) const;
+
+    // number of set ids
+    id_type_t
+    count() const;
 
+    // set every id set in 'other'
     void
-    set(id_type_t id);
+    merge(const ConcurrentBitset& other);
 
+    // call func(id) for every clear id of [begin, end), in increasing order
+    template <typename Func>
     void
-    clear(id_type_t id);
+    for_each_clear(id_type_t begin, id_type_t end, Func&& func) const {
+        for (id_type_t w = begin >> 6; w << 6 < end; w++) {
+            word_t clear_bits = ~word(w);
+            if (clear_bits == 0) {
+                continue;
+            }
+            id_type_t base = w << 6;
+            if (base < begin) {
+                clear_bits &= FULL_WORD << (begin - base);
+            }
+            if (end - base < WORD_BITS) {
+                clear_bits &= ~(FULL_WORD << (end - base));
+            }
+            while (clear_bits != 0) {
+                func(base + __builtin_ctzll(clear_bits));
+                clear_bits &= clear_bits - 1;
+            }
+        }
+    }
 
  private:
-    std::deque<std::atomic<unsigned char>> bitset_;
+    std::atomic<word_t>* words_ = nullptr;
+    id_type_t word_count_ = 0;
     id_type_t size_;
 };
 
 using ConcurrentBitsetPtr = std::shared_ptr<ConcurrentBitset>;
 
+// call func(id) for every id of [begin, end) not set in the bitset, every id if there is no bitset
+template <typename Func>
+inline void
+for_each_clear(const ConcurrentBitsetPtr& bitset, ConcurrentBitset::id_type_t begin, ConcurrentBitset::id_type_t end,
+               Func&& func) {
+    if (bitset) {
+        bitset->for_each_clear(begin, end, func);
+    } else {
+        for (auto id = begin; id < end; id++) {
+            func(id);
+        }
+    }
+}
+
 }  // namespace faiss
@@ -13,6 +13,7 @@
 #include <cassert>
 #include <cstring>
 #include <cmath>
+#include <vector>
 
 #include <omp.h>
 
@@ -144,6 +145,78 @@ void fvec_renorm_L2 (size_t d, size_t nx, float * __restrict x)
 
 
 
+struct IPDistance {
+    float operator()(const float * x, const float * y, size_t d) const {
+        return fvec_inner_product (x, y, d);
+    }
+};
+
+struct L2Distance {
+    float operator()(const float * x, const float * y, size_t d) const {
+        return fvec_L2sqr (x, y, d);
+    }
+};
+
+/* Database-parallel version of the sse kernels for a few queries: every
+   thread scans a slice of y into private heaps for all the queries, the
+   heaps of the threads are merged at the end. Splitting over the queries
+   would leave most threads idle when nx is smaller than the thread count. */
+template <class C, class Distance>
+static void knn_sse_database_parallel (const float * x,
+                        const float * y,
+                        size_t d, size_t nx, size_t ny,
+                        HeapArray<C> * res,
+                        ConcurrentBitsetPtr bitset,
+                        Distance distance)
+{
+    size_t k = res->k;
+    size_t nt = std::min(size_t(omp_get_max_threads()), ny / k);
+
+    std::vector<typename C::T> thread_val (nt * nx * k);
+    std::vector<typename C::TI> thread_ids (nt * nx * k);
+
+#pragma omp parallel for num_threads(nt)
+    for (size_t t = 0; t < nt; t++) {
+        size_t j0 = ny * t / nt;
+        size_t j1 = ny * (t + 1) / nt;
+        typename C::T * val = thread_val.data() + t * nx * k;
+        typename C::TI * ids = thread_ids.data() + t * nx * k;
+
+        for (size_t i = 0; i < nx; i++) {
+            heap_heapify<C> (k, val + i * k, ids + i * k);
+        }
+
+        // every database vector is read once for all the queries
+        auto scan = [&](size_t j) {
+            const float * y_j = y + j * d;
+            for (size_t i = 0; i < nx; i++) {
+                float dis = distance (x + i * d, y_j, d);
+                typename C::T * simi = val + i * k;
+                typename C::TI * idxi = ids + i * k;
+
+                if (C::cmp (simi[0], dis)) {
+                    heap_pop<C> (k, simi, idxi);
+                    heap_push<C> (k, simi, idxi, dis, j);
+                }
+            }
+        };
+        for_each_clear (bitset, j0, j1, scan);
+    }
+
+    // unfilled heap entries are neutral and never enter the result
+    for (size_t i = 0; i < nx; i++) {
+        typename C::T * simi = res->get_val(i);
+        typename C::TI * idxi = res->get_ids(i);
+        heap_heapify<C> (k, simi, idxi);
+        for (size_t t = 0; t < nt; t++) {
+            size_t offset = (t * nx + i) * k;
+            heap_addn<C> (k, simi, idxi, thread_val.data() + offset, thread_ids.data() + offset, k);
+        }
+        heap_reorder<C> (k, simi, idxi);
+    }
+    InterruptCallback::check ();
+}
+
 /* Find the nearest neighbors for nx queries in a set of ny vectors */
 static void knn_inner_product_sse (const float * x,
                         const float * y,
@@ -152,6 +225,11 @@ static void knn_inner_product_sse (const float * x,
                         ConcurrentBitsetPtr bitset = nullptr)
 {
     size_t k = res->k;
+    if (nx < distance_compute_db_parallel_threshold && omp_get_max_threads() > 1 && ny >= 2 * k) {
+        knn_sse_database_parallel (x, y, d, nx, ny, res, bitset, IPDistance());
+        return;
+    }
+
     size_t check_period = InterruptCallback::get_period_hint (ny * d);
 
     check_period *= omp_get_max_threads();
@@ -162,24 +240,22 @@ static void knn_inner_product_sse (const float * x,
 #pragma omp parallel for
         for (size_t i = i0; i < i1; i++) {
             const float * x_i = x + i * d;
-            const float * y_j = y;
 
             float * __restrict simi = res->get_val(i);
             int64_t * __restrict idxi = res->get_ids (i);
 
             minheap_heapify (k, simi, idxi);
 
-            for (size_t j = 0; j < ny; j++) {
-                if(!bitset || !bitset->test(j)){
-                    float ip = fvec_inner_product (x_i, y_j, d);
+            auto scan = [&](size_t j) {
+                float ip = fvec_inner_product (x_i, y + j * d, d);
 
-                    if (ip > simi[0]) {
-                        minheap_pop (k, simi, idxi);
-                        minheap_push (k, simi, idxi, ip, j);
-                    }
+                if (ip > simi[0]) {
+                    minheap_pop (k, simi, idxi);
+                    minheap_push (k, simi, idxi, ip, j);
                 }
-                y_j += d;
-            }
+            };
+            // one bitset word per 64 vectors, fully deleted words are skipped
+            for_each_clear (bitset, 0, ny, scan);
             minheap_reorder (k, simi, idxi);
         }
         InterruptCallback::check ();
@@ -195,6 +271,10 @@ static void knn_L2sqr_sse (
                 ConcurrentBitsetPtr bitset = nullptr)
 {
     size_t k = res->k;
+    if (nx < distance_compute_db_parallel_threshold && omp_get_max_threads() > 1 && ny >= 2 * k) {
+        knn_sse_database_parallel (x, y, d, nx, ny, res, bitset, L2Distance());
+        return;
+    }
 
     size_t check_period = InterruptCallback::get_period_hint (ny * d);
     check_period *= omp_get_max_threads();
@@ -205,23 +285,19 @@ static void knn_L2sqr_sse (
 #pragma omp parallel for
         for (size_t i = i0; i < i1; i++) {
             const float * x_i = x + i * d;
-            const float * y_j = y;
-            size_t j;
             float * simi = res->get_val(i);
             int64_t * idxi = res->get_ids (i);
 
             maxheap_heapify (k, simi, idxi);
-            for (j = 0; j < ny; j++) {
-                if(!bitset || !bitset->test(j)){
-                    float disij = fvec_L2sqr (x_i, y_j, d);
+            auto scan = [&](size_t j) {
+                float disij = fvec_L2sqr (x_i, y + j * d, d);
 
-                    if (disij < simi[0]) {
-                        maxheap_pop (k, simi, idxi);
-                        maxheap_push (k, simi, idxi, disij, j);
-                    }
+                if (disij < simi[0]) {
+                    maxheap_pop (k, simi, idxi);
+                    maxheap_push (k, simi, idxi, disij, j);
                 }
-                y_j += d;
-            }
+            };
+            for_each_clear (bitset, 0, ny, scan);
             maxheap_reorder (k, simi, idxi);
         }
         InterruptCallback::check ();
@@ -273,19 +349,16 @@ static void knn_inner_product_blas (
             for(size_t i = i0; i < i1; i++){
                 float * __restrict simi = res->get_val(i);
                 int64_t * __restrict idxi = res->get_ids (i);
-                const float *ip_line = ip_block + (i - i0) * (j1 - j0);
+                const float *ip_line = ip_block + (i - i0) * (j1 - j0) - j0;
 
-                for(size_t j = j0; j < j1; j++){
-                    if(!bitset || !bitset->test(j)){
-                        float dis = *ip_line;
+                for_each_clear (bitset, j0, j1, [&](size_t j) {
+                    float dis = ip_line[j];
 
-                        if(dis > simi[0]){
-                            minheap_pop(k, simi, idxi);
-                            minheap_push(k, simi, idxi, dis, j);
-                        }
+                    if(dis > simi[0]){
+                        minheap_pop(k, simi, idxi);
+                        minheap_push(k, simi, idxi, dis, j);
                     }
-                    ip_line++;
-                }
+                });
             }
         }
         InterruptCallback::check ();
@@ -344,26 +417,23 @@ static void knn_L2sqr_blas (const float * x,
             for (size_t i = i0; i < i1; i++) {
                 float * __restrict simi = res->get_val(i);
                 int64_t * __restrict idxi = res->get_ids (i);
-                const float *ip_line = ip_block + (i - i0) * (j1 - j0);
+                const float *ip_line = ip_block + (i - i0) * (j1 - j0) - j0;
 
-                for (size_t j = j0; j < j1; j++) {
-                    if(!bitset || !bitset->test(j)){
-                        float ip = *ip_line;
-                        float dis = x_norms[i] + y_norms[j] - 2 * ip;
+                for_each_clear (bitset, j0, j1, [&](size_t j) {
+                    float ip = ip_line[j];
+                    float dis = x_norms[i] + y_norms[j] - 2 * ip;
 
-                        // negative values can occur for identical vectors
-                        // due to roundoff errors
-                        if (dis < 0) dis = 0;
+                    // negative values can occur for identical vectors
+                    // due to roundoff errors
+                    if (dis < 0) dis = 0;
 
-                        dis = corr (dis, i, j);
+                    dis = corr (dis, i, j);
 
-                        if (dis < simi[0]) {
-                            maxheap_pop (k, simi, idxi);
-                            maxheap_push (k, simi, idxi, dis, j);
-                        }
+                    if (dis < simi[0]) {
+                        maxheap_pop (k, simi, idxi);
+                        maxheap_push (k, simi, idxi, dis, j);
                     }
-                    ip_line++;
-                }
+                });
             }
         }
         InterruptCallback::check ();
@@ -421,26 +491,23 @@ static void knn_jaccard_blas (const float * x,
             for (size_t i = i0; i < i1; i++) {
                 float * __restrict simi = res->get_val(i);
                 int64_t * __restrict idxi = res->get_ids (i);
-                const float *ip_line = ip_block + (i - i0) * (j1 - j0);
+                const float *ip_line = ip_block + (i - i0) * (j1 - j0) - j0;
 
-                for (size_t j = j0; j < j1; j++) {
-                    if(!bitset || !bitset->test(j)){
-                        float ip = *ip_line;
-                        float dis = 1.0 - ip / (x_norms[i] + y_norms[j] - ip);
+                for_each_clear (bitset, j0, j1, [&](size_t j) {
+                    float ip = ip_line[j];
+                    float dis = 1.0 - ip / (x_norms[i] + y_norms[j] - ip);
 
-                        // negative values can occur for identical vectors
-                        // due to roundoff errors
-                        if (dis < 0) dis = 0;
+                    // negative values can occur for identical vectors
+                    // due to roundoff errors
+                    if (dis < 0) dis = 0;
 
-                        dis = corr (dis, i, j);
+                    dis = corr (dis, i, j);
 
-                        if (dis < simi[0]) {
-                            maxheap_pop (k, simi, idxi);
-                            maxheap_push (k, simi, idxi, dis, j);
-                        }
+                    if (dis < simi[0]) {
+                        maxheap_pop (k, simi, idxi);
+                        maxheap_push (k, simi, idxi, dis, j);
                     }
-                    ip_line++;
-                }
+                });
             }
         }
         InterruptCallback::check ();
@@ -459,6 +526,7 @@ static void knn_jaccard_blas (const float * x,
  *******************************************************/
 
 int distance_compute_blas_threshold = 20;
+int distance_compute_db_parallel_threshold = 20;
 
 void knn_inner_product (const float * x,
         const float * y,
@@ -183,6 +183,10 @@ void pairwise_indexed_inner_product (
 // threshold on nx above which we switch to BLAS to compute distances
 extern int distance_compute_blas_threshold;
 
+// threshold on nx below which the sse kernels split the database vectors
+// among the threads instead of the queries
+extern int distance_compute_db_parallel_threshold;
+
 /** Return the k nearest neighors of each of the nx vectors x among the ny
  *  vector y, w.r.t to max inner product
  *
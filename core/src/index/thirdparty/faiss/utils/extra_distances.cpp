@@ -199,23 +199,18 @@ void knn_extra_metrics_template (
 #pragma omp parallel for
         for (size_t i = i0; i < i1; i++) {
             const float * x_i = x + i * d;
-            const float * y_j = y;
-            size_t j;
             float * simi = res->get_val(i);
             int64_t * idxi = res->get_ids (i);
 
             maxheap_heapify (k, simi, idxi);
-            for (j = 0; j < ny; j++) {
-                if(!bitset || !bitset->test(j)){
-                    float disij = vd (x_i, y_j);
-
-                    if (disij < simi[0]) {
-                        maxheap_pop (k, simi, idxi);
-                        maxheap_push (k, simi, idxi, disij, j);
-                    }
+            for_each_clear (bitset, 0, ny, [&](size_t j) {
+                float disij = vd (x_i, y + j * d);
+
+                if (disij < simi[0]) {
+                    maxheap_pop (k, simi, idxi);
+                    maxheap_push (k, simi, idxi, disij, j);
                 }
-                y_j += d;
-            }
+            });
             maxheap_reorder (k, simi, idxi);
         }
         InterruptCallback::check ();
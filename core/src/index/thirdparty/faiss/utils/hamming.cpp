@@ -286,20 +286,15 @@ void hammings_knn_hc (
       for (size_t i = 0; i < ha->nh; i++) {
         HammingComputer hc (bs1 + i * bytes_per_code, bytes_per_code);
 
-        const uint8_t * bs2_ = bs2 + j0 * bytes_per_code;
-        hamdis_t dis;
         hamdis_t * __restrict bh_val_ = ha->val + i * k;
         int64_t * __restrict bh_ids_ = ha->ids + i * k;
-        size_t j;
-        for (j = j0; j < j1; j++, bs2_+= bytes_per_code) {
-            if(!bitset || !bitset->test(j)){
-                dis = hc.hamming (bs2_);
-                if (dis < bh_val_[0]) {
-                    faiss::maxheap_pop<hamdis_t> (k, bh_val_, bh_ids_);
-                    faiss::maxheap_push<hamdis_t> (k, bh_val_, bh_ids_, dis, j);
-                }
+        for_each_clear (bitset, j0, j1, [&](size_t j) {
+            hamdis_t dis = hc.hamming (bs2 + j * bytes_per_code);
+            if (dis < bh_val_[0]) {
+                faiss::maxheap_pop<hamdis_t> (k, bh_val_, bh_ids_);
+                faiss::maxheap_push<hamdis_t> (k, bh_val_, bh_ids_, dis, j);
             }
-        }
+        });
       }
     }
     if (order) ha->reorder ();
@@ -339,11 +334,9 @@ void hammings_knn_mc (
     const size_t j1 = std::min(j0 + block_size, nb);
 #pragma omp parallel for
     for (size_t i = 0; i < na; ++i) {
-      for (size_t j = j0; j < j1; ++j) {
-          if(!bitset || !bitset->test(j)){
-              cs[i].update_counter(b + j * bytes_per_code, j);
-          }
-      }
+      for_each_clear (bitset, j0, j1, [&](size_t j) {
+          cs[i].update_counter(b + j * bytes_per_code, j);
+      });
     }
   }
 
@@ -390,22 +383,17 @@ void hammings_knn_hc_1 (
 #pragma omp parallel for
     for (size_t i = 0; i < ha->nh; i++) {
         const uint64_t bs1_ = bs1 [i];
-        const uint64_t * bs2_ = bs2;
-        hamdis_t dis;
         hamdis_t * bh_val_ = ha->val + i * k;
         hamdis_t bh_val_0 = bh_val_[0];
         int64_t * bh_ids_ = ha->ids + i * k;
-        size_t j;
-        for (j = 0; j < n2; j++, bs2_+= nwords) {
-            if(!bitset || !bitset->test(j)){
-                dis = popcount64 (bs1_ ^ *bs2_);
-                if (dis < bh_val_0) {
-                    faiss::maxheap_pop<hamdis_t> (k, bh_val_, bh_ids_);
-                    faiss::maxheap_push<hamdis_t> (k, bh_val_, bh_ids_, dis, j);
-                    bh_val_0 = bh_val_[0];
-                }
+        for_each_clear (bitset, 0, n2, [&](size_t j) {
+            hamdis_t dis = popcount64 (bs1_ ^ bs2[j * nwords]);
+            if (dis < bh_val_0) {
+                faiss::maxheap_pop<hamdis_t> (k, bh_val_, bh_ids_);
+                faiss::maxheap_push<hamdis_t> (k, bh_val_, bh_ids_, dis, j);
+                bh_val_0 = bh_val_[0];
             }
-        }
+        });
     }
     if (order) {
         ha->reorder ();
@@ -38,20 +38,15 @@ namespace faiss {
             for (size_t i = 0; i < ha->nh; i++) {
                 JaccardComputer hc (bs1 + i * bytes_per_code, bytes_per_code);
 
-                const uint8_t * bs2_ = bs2 + j0 * bytes_per_code;
-                tadis_t dis;
                 tadis_t * __restrict bh_val_ = ha->val + i * k;
                 int64_t * __restrict bh_ids_ = ha->ids + i * k;
-                size_t j;
-                for (j = j0; j < j1; j++, bs2_+= bytes_per_code) {
-                    if(!bitset || !bitset->test(j)){
-                        dis = hc.jaccard (bs2_);
-                        if (dis < bh_val_[0]) {
-                            faiss::maxheap_pop<tadis_t> (k, bh_val_, bh_ids_);
-                            faiss::maxheap_push<tadis_t> (k, bh_val_, bh_ids_, dis, j);
-                        }
+                for_each_clear (bitset, j0, j1, [&](size_t j) {
+                    tadis_t dis = hc.jaccard (bs2 + j * bytes_per_code);
+                    if (dis < bh_val_[0]) {
+                        faiss::maxheap_pop<tadis_t> (k, bh_val_, bh_ids_);
+                        faiss::maxheap_push<tadis_t> (k, bh_val_, bh_ids_, dis, j);
                     }
-                }
+                });
 
             }
         }
@@ -2,12 +2,14 @@
 
 #include "visited_list_pool.h"
 #include "hnswlib.h"
+#include <algorithm>
 #include <random>
 #include <stdlib.h>
 #include <unordered_set>
 #include <list>
 
 #include "knowhere/index/vector_index/helpers/FaissIO.h"
+#include "faiss/utils/ConcurrentBitset.h"
 
 namespace hnswlib {
     typedef unsigned int tableint;
@@ -250,9 +252,16 @@ namespace hnswlib {
             return top_candidates;
         }
 
+        // nodes marked deleted, or whose label is set in the bitset, are still expanded to navigate the graph
+        // but never enter the result
+        bool isFiltered(tableint internalId, faiss::ConcurrentBitset *bitset) const {
+            return isMarkedDeleted(internalId) || (bitset != nullptr && bitset->test(getExternalLabel(internalId)));
+        }
+
         template <bool has_deletions>
         std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst>
-        searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef) const {
+        searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef,
+                          faiss::ConcurrentBitset *bitset = nullptr) const {
             VisitedList *vl = visited_list_pool_->getFreeVisitedList();
             vl_type *visited_array = vl->mass;
             vl_type visited_array_tag = vl->curV;
@@ -261,7 +270,7 @@ namespace hnswlib {
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> candidate_set;
 
             dist_t lowerBound;
-            if (!has_deletions || !isMarkedDeleted(ep_id)) {
+            if (!has_deletions || !isFiltered(ep_id, bitset)) {
                 dist_t dist = fstdistfunc_(data_point, getDataByInternalId(ep_id), dist_func_param_);
                 lowerBound = dist;
                 top_candidates.emplace(dist, ep_id);
@@ -317,7 +326,7 @@ namespace hnswlib {
                                          _MM_HINT_T0);////////////////////////
 #endif
 
-                            if (!has_deletions || !isMarkedDeleted(candidate_id))
+                            if (!has_deletions || !isFiltered(candidate_id, bitset))
                                 top_candidates.emplace(dist, candidate_id);
 
                             if (top_candidates.size() > ef)
@@ -1084,6 +1093,12 @@ namespace hnswlib {
 
         std::priority_queue<std::pair<dist_t, labeltype >>
         searchKnn(const void *query_data, size_t k) const {
+            return searchKnn(query_data, k, faiss::ConcurrentBitsetPtr());
+        }
+
+        // labels set in the bitset are excluded from the result
+        std::priority_queue<std::pair<dist_t, labeltype >>
+        searchKnn(const void *query_data, size_t k, const faiss::ConcurrentBitsetPtr &bitset) const {
             std::priority_queue<std::pair<dist_t, labeltype >> result;
             if (cur_element_count == 0) return result;
 
@@ -1115,9 +1130,9 @@ namespace hnswlib {
             }
 
             std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates;
-            if (has_deletions_) {
+            if (has_deletions_ || bitset != nullptr) {
                 std::priority_queue<std::pair<dist_t, tableint>, std::vector<std::pair<dist_t, tableint>>, CompareByFirst> top_candidates1=searchBaseLayerST<true>(
-                        currObj, query_data, std::max(ef_, k));
+                        currObj, query_data, std::max(ef_, k), bitset.get());
                 top_candidates.swap(top_candidates1);
             }
             else{
@@ -1138,11 +1153,12 @@ namespace hnswlib {
 
         template <typename Comp>
         std::vector<std::pair<dist_t, labeltype>>
-        searchKnn(const void* query_data, size_t k, Comp comp) {
+        searchKnn(const void* query_data, size_t k, Comp comp,
+                  const faiss::ConcurrentBitsetPtr &bitset = faiss::ConcurrentBitsetPtr()) const {
             std::vector<std::pair<dist_t, labeltype>> result;
             if (cur_element_count == 0) return result;
 
-            auto ret = searchKnn(query_data, k);
+            auto ret = searchKnn(query_data, k, bitset);
 
             while (!ret.empty()) {
                 result.push_back(ret.top());
@@ -1154,6 +1170,186 @@ namespace hnswlib {
             return result;
         }
 
+        // the greedy descent of the upper layers, returns the entry point of the base layer
+        tableint searchUpperLayers(const void *query_data) const {
+            tableint currObj = enterpoint_node_;
+            dist_t curdist = fstdistfunc_(query_data, getDataByInternalId(enterpoint_node_), dist_func_param_);
+
+            for (int level = maxlevel_; level > 0; level--) {
+                bool changed = true;
+                while (changed) {
+                    changed = false;
+                    unsigned int *data = (unsigned int *) get_linklist(currObj, level);
+                    int size = getListCount(data);
+                    tableint *datal = (tableint *) (data + 1);
+#ifdef USE_SSE
+                    for (int i = 0; i < size; i++) {
+                        _mm_prefetch(getDataByInternalId(datal[i]), _MM_HINT_T0);
+                    }
+#endif
+                    for (int i = 0; i < size; i++) {
+                        tableint cand = datal[i];
+                        if (cand < 0 || cand > max_elements_)
+                            throw std::runtime_error("cand error");
+                        dist_t d = fstdistfunc_(query_data, getDataByInternalId(cand), dist_func_param_);
+
+                        if (d < curdist) {
+                            curdist = d;
+                            currObj = cand;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+            return currObj;
+        }
+
+        // the buffers of one search thread, kept across the queries of a batch
+        struct SearchScratch {
+            VisitedList *visited_list = nullptr;
+            std::vector<std::pair<dist_t, tableint>> top_candidates;
+            std::vector<std::pair<dist_t, tableint>> candidate_set;
+        };
+
+        // searchBaseLayerST on the heaps of the scratch, top_candidates is left as a max-heap of at most ef nodes
+        template <bool has_deletions>
+        void
+        searchBaseLayerST(tableint ep_id, const void *data_point, size_t ef, faiss::ConcurrentBitset *bitset,
+                          SearchScratch &scratch) const {
+            VisitedList *vl = scratch.visited_list;
+            vl->reset();
+            vl_type *visited_array = vl->mass;
+            vl_type visited_array_tag = vl->curV;
+
+            auto &top_candidates = scratch.top_candidates;
+            auto &candidate_set = scratch.candidate_set;
+            top_candidates.clear();
+            candidate_set.clear();
+            CompareByFirst comp;
+
+            dist_t lowerBound;
+            if (!has_deletions || !isFiltered(ep_id, bitset)) {
+                dist_t dist = fstdistfunc_(data_point, getDataByInternalId(ep_id), dist_func_param_);
+                lowerBound = dist;
+                top_candidates.emplace_back(dist, ep_id);
+                candidate_set.emplace_back(-dist, ep_id);
+            } else {
+                lowerBound = std::numeric_limits<dist_t>::max();
+                candidate_set.emplace_back(-lowerBound, ep_id);
+            }
+
+            visited_array[ep_id] = visited_array_tag;
+
+            while (!candidate_set.empty()) {
+                std::pair<dist_t, tableint> current_node_pair = candidate_set.front();
+                if ((-current_node_pair.first) > lowerBound) {
+                    break;
+                }
+                std::pop_heap(candidate_set.begin(), candidate_set.end(), comp);
+                candidate_set.pop_back();
+
+                tableint current_node_id = current_node_pair.second;
+                int *data = (int *) get_linklist0(current_node_id);
+                size_t size = getListCount((linklistsizeint*)data);
+
+#ifdef USE_SSE
+                // fetch the unvisited neighbors ahead of the distance computations
+                for (size_t j = 1; j <= size; j++) {
+                    int candidate_id = *(data + j);
+                    if (visited_array[candidate_id] != visited_array_tag) {
+                        _mm_prefetch(getDataByInternalId(candidate_id), _MM_HINT_T0);
+                    }
+                }
+#endif
+
+                for (size_t j = 1; j <= size; j++) {
+                    int candidate_id = *(data + j);
+                    if (visited_array[candidate_id] == visited_array_tag) {
+                        continue;
+                    }
+                    visited_array[candidate_id] = visited_array_tag;
+
+                    dist_t dist = fstdistfunc_(data_point, getDataByInternalId(candidate_id), dist_func_param_);
+                    if (top_candidates.size() < ef || lowerBound > dist) {
+                        candidate_set.emplace_back(-dist, candidate_id);
+                        std::push_heap(candidate_set.begin(), candidate_set.end(), comp);
+#ifdef USE_SSE
+                        _mm_prefetch(get_linklist0(candidate_set.front().second), _MM_HINT_T0);
+#endif
+
+                        if (!has_deletions || !isFiltered(candidate_id, bitset)) {
+                            top_candidates.emplace_back(dist, candidate_id);
+                            std::push_heap(top_candidates.begin(), top_candidates.end(), comp);
+                        }
+
+                        if (top_candidates.size() > ef) {
+                            std::pop_heap(top_candidates.begin(), top_candidates.end(), comp);
+                            top_candidates.pop_back();
+                        }
+
+                        if (!top_candidates.empty())
+                            lowerBound = top_candidates.front().first;
+                    }
+                }
+            }
+        }
+
+        // search nq queries stored one after another, the k nearest labels of each query are written sorted by
+        // distance into labels/distances (nq * k), padded with -1; labels set in the bitset are excluded.
+        // ef is given per call so that concurrent batches with different ef do not race on setEf
+        void
+        searchKnnBatch(size_t nq, const void *query_data, size_t k, size_t ef, dist_t *distances, int64_t *labels,
+                       const faiss::ConcurrentBitsetPtr &bitset = faiss::ConcurrentBitsetPtr()) const {
+            ef = std::max(ef, k);
+            bool filtered = has_deletions_ || bitset != nullptr;
+
+#pragma omp parallel
+            {
+                SearchScratch scratch;
+                scratch.visited_list = visited_list_pool_->getFreeVisitedList();
+                scratch.top_candidates.reserve(ef + 1);
+                scratch.candidate_set.reserve(ef * 2);
+
+#pragma omp for schedule(dynamic, 16)
+                for (int64_t i = 0; i < (int64_t)nq; i++) {
+                    const void *query = (const char *)query_data + i * data_size_;
+                    dist_t *query_distances = distances + i * k;
+                    int64_t *query_labels = labels + i * k;
+
+                    size_t count = 0;
+                    if (cur_element_count > 0) {
+                        tableint ep_id = searchUpperLayers(query);
+                        if (filtered) {
+                            searchBaseLayerST<true>(ep_id, query, ef, bitset.get(), scratch);
+                        } else {
+                            searchBaseLayerST<false>(ep_id, query, ef, nullptr, scratch);
+                        }
+
+                        auto &top_candidates = scratch.top_candidates;
+                        CompareByFirst comp;
+                        while (top_candidates.size() > k) {
+                            std::pop_heap(top_candidates.begin(), top_candidates.end(), comp);
+                            top_candidates.pop_back();
+                        }
+                        // the max-heap pops the farthest first
+                        count = top_candidates.size();
+                        for (size_t j = count; j > 0; j--) {
+                            std::pop_heap(top_candidates.begin(), top_candidates.end(), comp);
+                            query_distances[j - 1] = top_candidates.back().first;
+                            query_labels[j - 1] = getExternalLabel(top_candidates.back().second);
+                            top_candidates.pop_back();
+                        }
+                    }
+                    for (size_t j = count; j < k; j++) {
+                        query_distances[j] = -1;
+                        query_labels[j] = -1;
+                    }
+                }
+
+                visited_list_pool_->releaseVisitedList(scratch.visited_list);
+            }
+        }
+
     };
 
 }
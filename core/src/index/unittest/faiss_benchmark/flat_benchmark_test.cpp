@@ -0,0 +1,212 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <hdf5.h>
+#include <sys/time.h>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <faiss/IndexFlat.h>
+#include <faiss/utils/ConcurrentBitset.h>
+#include <faiss/utils/distances.h>
+
+/*****************************************************
+ * To run this test, please download the HDF5 from
+ *  https://support.hdfgroup.org/ftp/HDF5/releases/
+ * and install it to /usr/local/hdf5 .
+ *****************************************************/
+
+const char HDF5_POSTFIX[] = ".hdf5";
+const char HDF5_DATASET_TRAIN[] = "train";
+const char HDF5_DATASET_TEST[] = "test";
+
+double
+elapsed() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+void
+normalize(float* arr, size_t nq, size_t dim) {
+    for (size_t i = 0; i < nq; i++) {
+        double vecLen = 0.0, inv_vecLen = 0.0;
+        for (size_t j = 0; j < dim; j++) {
+            double val = arr[i * dim + j];
+            vecLen += val * val;
+        }
+        inv_vecLen = 1.0 / std::sqrt(vecLen);
+        for (size_t j = 0; j < dim; j++) {
+            arr[i * dim + j] = (float)(arr[i * dim + j] * inv_vecLen);
+        }
+    }
+}
+
+float*
+hdf5_read_float(const std::string& file_name, const std::string& dataset_name, size_t& d_out, size_t& n_out) {
+    hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    hid_t dataset = H5Dopen2(file, dataset_name.c_str(), H5P_DEFAULT);
+    hid_t datatype = H5Dget_type(dataset);
+    assert(H5Tget_class(datatype) == H5T_FLOAT || !"Illegal dataset class type");
+
+    hid_t dataspace = H5Dget_space(dataset);
+    hsize_t dims_out[2];
+    H5Sget_simple_extent_dims(dataspace, dims_out, NULL);
+    n_out = dims_out[0];
+    d_out = dims_out[1];
+
+    float* data_out = new float[dims_out[0] * dims_out[1]];
+    H5Dread(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data_out);
+
+    H5Tclose(datatype);
+    H5Dclose(dataset);
+    H5Sclose(dataspace);
+    H5Fclose(file);
+
+    return data_out;
+}
+
+bool
+parse_ann_test_name(const std::string& ann_test_name, size_t& dim, faiss::MetricType& metric_type) {
+    size_t pos1 = ann_test_name.find_first_of('-', 0);
+    if (pos1 == std::string::npos)
+        return false;
+    size_t pos2 = ann_test_name.find_first_of('-', pos1 + 1);
+    if (pos2 == std::string::npos)
+        return false;
+
+    dim = std::stoi(ann_test_name.substr(pos1 + 1, pos2 - pos1 - 1));
+    std::string metric_str = ann_test_name.substr(pos2 + 1);
+    if (metric_str == "angular") {
+        metric_type = faiss::METRIC_INNER_PRODUCT;
+    } else if (metric_str == "euclidean") {
+        metric_type = faiss::METRIC_L2;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+faiss::ConcurrentBitsetPtr
+CreateBitset(size_t size, int32_t percentage) {
+    faiss::ConcurrentBitsetPtr bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(size);
+    if (percentage != 0) {
+        int32_t step = 100 / percentage;
+        for (int64_t i = 0; i < size; i += step) {
+            bitset_ptr->set(i);
+        }
+    }
+    return bitset_ptr;
+}
+
+void
+test_flat_small_nq(const std::string& ann_test_name, const std::vector<size_t>& nqs,
+                   const std::vector<int32_t>& percentages, size_t k, size_t search_loops) {
+    double t0 = elapsed();
+
+    size_t dim;
+    faiss::MetricType metric_type;
+    if (!parse_ann_test_name(ann_test_name, dim, metric_type)) {
+        printf("Invalid ann test name: %s\n", ann_test_name.c_str());
+        return;
+    }
+
+    const std::string ann_file_name = ann_test_name + HDF5_POSTFIX;
+    size_t d, nb, nq;
+    printf("[%.3f s] Loading HDF5 file: %s\n", elapsed() - t0, ann_file_name.c_str());
+    float* xb = hdf5_read_float(ann_file_name, HDF5_DATASET_TRAIN, d, nb);
+    assert(d == dim || !"dataset does not have correct dimension");
+    float* xq = hdf5_read_float(ann_file_name, HDF5_DATASET_TEST, d, nq);
+    assert(d == dim || !"query does not have same dimension as train set");
+    if (metric_type == faiss::METRIC_INNER_PRODUCT) {
+        normalize(xb, nb, dim);
+        normalize(xq, nq, dim);
+    }
+
+    // an IDMAP index or a raw segment is searched as a flat index
+    faiss::IndexFlat flat_index(dim, metric_type);
+    flat_index.add(nb, xb);
+
+    const int db_parallel_threshold = faiss::distance_compute_db_parallel_threshold;
+    for (auto percentage : percentages) {
+        auto bitset = CreateBitset(nb, percentage);
+
+        printf("\n%s | IDMAP | nb = %ld, k = %ld, deleted = %d%%\n", ann_test_name.c_str(), nb, k, percentage);
+        printf("================================================================================\n");
+        for (auto t_nq : nqs) {
+            t_nq = std::min(t_nq, nq);
+            std::vector<faiss::Index::idx_t> ids(t_nq * k), db_ids(t_nq * k);
+            std::vector<float> dis(t_nq * k), db_dis(t_nq * k);
+
+            // threshold 0 splits the queries among the threads, as before the database-parallel kernels
+            faiss::distance_compute_db_parallel_threshold = 0;
+            double t_start = elapsed();
+            for (size_t loop = 0; loop < search_loops; loop++) {
+                flat_index.search(t_nq, xq, k, dis.data(), ids.data(), bitset);
+            }
+            double t_query = (elapsed() - t_start) / search_loops;
+
+            faiss::distance_compute_db_parallel_threshold = db_parallel_threshold;
+            t_start = elapsed();
+            for (size_t loop = 0; loop < search_loops; loop++) {
+                flat_index.search(t_nq, xq, k, db_dis.data(), db_ids.data(), bitset);
+            }
+            double t_db = (elapsed() - t_start) / search_loops;
+
+            // both scan all the vectors left after deletion, only the order of equal distances may differ
+            size_t diff = 0, deleted_hit = 0;
+            for (size_t i = 0; i < t_nq * k; i++) {
+                diff += (dis[i] != db_dis[i]) ? 1 : 0;
+                deleted_hit += (db_ids[i] >= 0 && bitset->test(db_ids[i])) ? 1 : 0;
+            }
+            EXPECT_EQ(diff, 0);
+            EXPECT_EQ(deleted_hit, 0);
+
+            printf("nq = %3ld, query-parallel = %.4fs, database-parallel = %.4fs, speedup = %.2f\n", t_nq, t_query,
+                   t_db, t_query / t_db);
+        }
+        printf("================================================================================\n");
+    }
+
+    delete[] xb;
+    delete[] xq;
+}
+
+/************************************************************************************
+ * https://github.com/erikbern/ann-benchmarks
+ *
+ * SMALL_NQ_BENCHMARK: brute-force search of a few queries with the database vectors
+ * split among the threads, against the queries split among the threads
+ *************************************************************************************/
+
+TEST(FLATTEST, SMALL_NQ_BENCHMARK) {
+    const std::vector<size_t> param_nqs = {1, 4, 16, 64};
+    const std::vector<int32_t> param_percentages = {0, 10};
+    const int32_t SEARCH_LOOPS = 5;
+
+    test_flat_small_nq("sift-128-euclidean", param_nqs, param_percentages, 10, SEARCH_LOOPS);
+    test_flat_small_nq("glove-200-angular", param_nqs, param_percentages, 10, SEARCH_LOOPS);
+}
@@ -0,0 +1,316 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <hdf5.h>
+#include <sys/time.h>
+#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <faiss/IndexFlat.h>
+#include <faiss/utils/ConcurrentBitset.h>
+
+#include "hnswlib/hnswlib.h"
+
+/*****************************************************
+ * To run this test, please download the HDF5 from
+ *  https://support.hdfgroup.org/ftp/HDF5/releases/
+ * and install it to /usr/local/hdf5 .
+ *****************************************************/
+
+const char HDF5_POSTFIX[] = ".hdf5";
+const char HDF5_DATASET_TRAIN[] = "train";
+const char HDF5_DATASET_TEST[] = "test";
+
+double
+elapsed() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+void
+normalize(float* arr, size_t nq, size_t dim) {
+    for (size_t i = 0; i < nq; i++) {
+        double vecLen = 0.0, inv_vecLen = 0.0;
+        for (size_t j = 0; j < dim; j++) {
+            double val = arr[i * dim + j];
+            vecLen += val * val;
+        }
+        inv_vecLen = 1.0 / std::sqrt(vecLen);
+        for (size_t j = 0; j < dim; j++) {
+            arr[i * dim + j] = (float)(arr[i * dim + j] * inv_vecLen);
+        }
+    }
+}
+
+float*
+hdf5_read_float(const std::string& file_name, const std::string& dataset_name, size_t& d_out, size_t& n_out) {
+    hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    hid_t dataset = H5Dopen2(file, dataset_name.c_str(), H5P_DEFAULT);
+    hid_t datatype = H5Dget_type(dataset);
+    assert(H5Tget_class(datatype) == H5T_FLOAT || !"Illegal dataset class type");
+
+    hid_t dataspace = H5Dget_space(dataset);
+    hsize_t dims_out[2];
+    H5Sget_simple_extent_dims(dataspace, dims_out, NULL);
+    n_out = dims_out[0];
+    d_out = dims_out[1];
+
+    float* data_out = new float[dims_out[0] * dims_out[1]];
+    H5Dread(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, data_out);
+
+    H5Tclose(datatype);
+    H5Dclose(dataset);
+    H5Sclose(dataspace);
+    H5Fclose(file);
+
+    return data_out;
+}
+
+bool
+parse_ann_test_name(const std::string& ann_test_name, size_t& dim, faiss::MetricType& metric_type) {
+    size_t pos1 = ann_test_name.find_first_of('-', 0);
+    if (pos1 == std::string::npos)
+        return false;
+    size_t pos2 = ann_test_name.find_first_of('-', pos1 + 1);
+    if (pos2 == std::string::npos)
+        return false;
+
+    dim = std::stoi(ann_test_name.substr(pos1 + 1, pos2 - pos1 - 1));
+    std::string metric_str = ann_test_name.substr(pos2 + 1);
+    if (metric_str == "angular") {
+        metric_type = faiss::METRIC_INNER_PRODUCT;
+    } else if (metric_str == "euclidean") {
+        metric_type = faiss::METRIC_L2;
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+faiss::ConcurrentBitsetPtr
+CreateBitset(size_t size, int32_t percentage) {
+    faiss::ConcurrentBitsetPtr bitset_ptr = std::make_shared<faiss::ConcurrentBitset>(size);
+    if (percentage != 0) {
+        int32_t step = 100 / percentage;
+        for (int64_t i = 0; i < size; i += step) {
+            bitset_ptr->set(i);
+        }
+    }
+    return bitset_ptr;
+}
+
+std::shared_ptr<hnswlib::HierarchicalNSW<float>>
+load_hnsw_index(const std::string& ann_test_name, size_t M, size_t ef_construction, faiss::MetricType& metric_type,
+                size_t& dim, float*& xb, size_t& nb, float*& xq, size_t& nq) {
+    double t0 = elapsed();
+
+    if (!parse_ann_test_name(ann_test_name, dim, metric_type)) {
+        printf("Invalid ann test name: %s\n", ann_test_name.c_str());
+        return nullptr;
+    }
+
+    const std::string ann_file_name = ann_test_name + HDF5_POSTFIX;
+    size_t d;
+    printf("[%.3f s] Loading HDF5 file: %s\n", elapsed() - t0, ann_file_name.c_str());
+    xb = hdf5_read_float(ann_file_name, HDF5_DATASET_TRAIN, d, nb);
+    assert(d == dim || !"dataset does not have correct dimension");
+    xq = hdf5_read_float(ann_file_name, HDF5_DATASET_TEST, d, nq);
+    assert(d == dim || !"query does not have same dimension as train set");
+    if (metric_type == faiss::METRIC_INNER_PRODUCT) {
+        normalize(xb, nb, dim);
+        normalize(xq, nq, dim);
+    }
+
+    // the index takes the ownership of the space
+    hnswlib::SpaceInterface<float>* space;
+    if (metric_type == faiss::METRIC_INNER_PRODUCT) {
+        space = new hnswlib::InnerProductSpace(dim);
+    } else {
+        space = new hnswlib::L2Space(dim);
+    }
+
+    // the labels are the offsets of the vectors, as in a segment
+    printf("[%.3f s] Building HNSW index M=%ld efConstruction=%ld on %ld vectors\n", elapsed() - t0, M,
+           ef_construction, nb);
+    auto index = std::make_shared<hnswlib::HierarchicalNSW<float>>(space, nb, M, ef_construction);
+    index->addPoint(xb, 0);
+#pragma omp parallel for
+    for (size_t i = 1; i < nb; i++) {
+        index->addPoint(xb + i * dim, i);
+    }
+    printf("[%.3f s] Index built\n", elapsed() - t0);
+
+    return index;
+}
+
+void
+test_hnsw_bitset(const std::string& ann_test_name, size_t M, size_t ef_construction, const std::vector<size_t>& efs,
+                 const std::vector<int32_t>& percentages, size_t k, size_t search_loops) {
+    size_t dim, nb, nq;
+    faiss::MetricType metric_type;
+    float *xb, *xq;
+    auto index = load_hnsw_index(ann_test_name, M, ef_construction, metric_type, dim, xb, nb, xq, nq);
+    if (index == nullptr) {
+        return;
+    }
+
+    faiss::IndexFlat flat_index(dim, metric_type);
+    flat_index.add(nb, xb);
+
+    using P = std::pair<float, hnswlib::labeltype>;
+    auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
+
+    std::vector<faiss::Index::idx_t> gt(nq * k);
+    std::vector<float> gt_dis(nq * k);
+    for (auto percentage : percentages) {
+        auto bitset = CreateBitset(nb, percentage);
+
+        // the ground truth of the vectors left after deletion
+        flat_index.search(nq, xq, k, gt_dis.data(), gt.data(), bitset);
+
+        printf("\n%s | HNSW M=%ld | nq = %ld, k = %ld, deleted = %d%%\n", ann_test_name.c_str(), M, nq, k,
+               percentage);
+        printf("================================================================================\n");
+        for (auto ef : efs) {
+            index->setEf(ef);
+
+            size_t hit = 0, deleted_hit = 0;
+            double t_start = elapsed();
+            for (size_t loop = 0; loop < search_loops; loop++) {
+                for (size_t i = 0; i < nq; i++) {
+                    auto ret = index->searchKnn(xq + i * dim, k, compare, bitset);
+                    if (loop > 0) {
+                        continue;
+                    }
+                    std::set<faiss::Index::idx_t> ground(gt.begin() + i * k, gt.begin() + (i + 1) * k);
+                    for (auto& pair : ret) {
+                        hit += ground.count(pair.second);
+                        deleted_hit += bitset->test(pair.second) ? 1 : 0;
+                    }
+                }
+            }
+            double t_end = elapsed();
+
+            EXPECT_EQ(deleted_hit, 0);
+            printf("ef = %4ld, elapse = %.4fs, QPS = %.1f, R@%ld = %.4f\n", ef, (t_end - t_start) / search_loops,
+                   nq * search_loops / (t_end - t_start), k, hit / float(nq * k));
+        }
+        printf("================================================================================\n");
+    }
+
+    delete[] xb;
+    delete[] xq;
+}
+
+void
+test_hnsw_batch(const std::string& ann_test_name, size_t M, size_t ef_construction, size_t ef,
+                const std::vector<size_t>& nqs, size_t k, size_t search_loops) {
+    size_t dim, nb, nq;
+    faiss::MetricType metric_type;
+    float *xb, *xq;
+    auto index = load_hnsw_index(ann_test_name, M, ef_construction, metric_type, dim, xb, nb, xq, nq);
+    if (index == nullptr) {
+        return;
+    }
+    index->setEf(ef);
+
+    using P = std::pair<float, hnswlib::labeltype>;
+    auto compare = [](const P& v1, const P& v2) { return v1.first < v2.first; };
+
+    printf("\n%s | HNSW M=%ld | k = %ld, ef = %ld\n", ann_test_name.c_str(), M, k, ef);
+    printf("================================================================================\n");
+    for (auto t_nq : nqs) {
+        t_nq = std::min(t_nq, nq);
+        std::vector<int64_t> ids(t_nq * k), batch_ids(t_nq * k);
+        std::vector<float> dis(t_nq * k), batch_dis(t_nq * k);
+
+        // one searchKnn per query, the results are copied through temporary vectors
+        double t_start = elapsed();
+        for (size_t loop = 0; loop < search_loops; loop++) {
+#pragma omp parallel for
+            for (size_t i = 0; i < t_nq; i++) {
+                auto ret = index->searchKnn(xq + i * dim, k, compare);
+                while (ret.size() < k) {
+                    ret.push_back(std::make_pair(-1, -1));
+                }
+                std::vector<float> query_dis;
+                std::vector<int64_t> query_ids;
+                for (auto& pair : ret) {
+                    query_dis.push_back(pair.first);
+                    query_ids.push_back(pair.second);
+                }
+                memcpy(dis.data() + i * k, query_dis.data(), k * sizeof(float));
+                memcpy(ids.data() + i * k, query_ids.data(), k * sizeof(int64_t));
+            }
+        }
+        double t_single = (elapsed() - t_start) / search_loops;
+
+        t_start = elapsed();
+        for (size_t loop = 0; loop < search_loops; loop++) {
+            index->searchKnnBatch(t_nq, xq, k, ef, batch_dis.data(), batch_ids.data());
+        }
+        double t_batch = (elapsed() - t_start) / search_loops;
+
+        // both walk the same graph, only the order of equal distances may differ
+        size_t diff = 0;
+        for (size_t i = 0; i < t_nq * k; i++) {
+            diff += (dis[i] != batch_dis[i]) ? 1 : 0;
+        }
+        EXPECT_EQ(diff, 0);
+
+        printf("nq = %5ld, single QPS = %.1f, batch QPS = %.1f, speedup = %.2f\n", t_nq, t_nq / t_single,
+               t_nq / t_batch, t_single / t_batch);
+    }
+    printf("================================================================================\n");
+
+    delete[] xb;
+    delete[] xq;
+}
+
+/************************************************************************************
+ * https://github.com/erikbern/ann-benchmarks
+ *
+ * BITSET_BENCHMARK: recall and QPS of HNSW search with 1%, 10% and 50% of the vectors
+ * deleted, deleted vectors still route the graph search but are never returned
+ * BATCH_BENCHMARK: throughput of searchKnnBatch against one searchKnn per query
+ *************************************************************************************/
+
+TEST(HNSWTEST, BITSET_BENCHMARK) {
+    const std::vector<size_t> param_efs = {64, 128, 256};
+    const std::vector<int32_t> param_percentages = {0, 1, 10, 50};
+    const int32_t SEARCH_LOOPS = 1;
+
+    test_hnsw_bitset("sift-128-euclidean", 16, 200, param_efs, param_percentages, 10, SEARCH_LOOPS);
+}
+
+TEST(HNSWTEST, BATCH_BENCHMARK) {
+    const std::vector<size_t> param_nqs = {1, 10, 100, 1000, 10000};
+    const int32_t SEARCH_LOOPS = 5;
+
+    test_hnsw_batch("sift-128-euclidean", 16, 200, 128, param_nqs, 10, SEARCH_LOOPS);
+}
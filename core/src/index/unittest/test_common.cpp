@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <faiss/utils/ConcurrentBitset.h>
+#include <vector>
 #include "knowhere/common/Dataset.h"
 #include "knowhere/common/Timer.h"
 #include "knowhere/knowhere/common/Exception.h"
@@ -43,3 +45,48 @@ TEST(COMMON_TEST, time_recoder) {
     double span = recoder.ElapseFromBegin("get time");
     ASSERT_GE(span, 1.0);
 }
+
+TEST(COMMON_TEST, concurrent_bitset) {
+    const int64_t size = 1000;
+    faiss::ConcurrentBitset bitset(size);
+    ASSERT_EQ(bitset.size(), size);
+    ASSERT_EQ(bitset.count(), 0);
+    ASSERT_FALSE(bitset.test_range(0, size));
+
+    // a full word [64, 128) and a few ids around it
+    for (int64_t i = 64; i < 128; i++) {
+        bitset.set(i);
+    }
+    bitset.set(3);
+    bitset.set(130);
+    bitset.set(size - 1);
+    ASSERT_TRUE(bitset.test(3));
+    ASSERT_FALSE(bitset.test(4));
+    ASSERT_EQ(bitset.word(1), faiss::ConcurrentBitset::FULL_WORD);
+    ASSERT_EQ(bitset.count(), 67);
+    ASSERT_TRUE(bitset.test_range(100, 101));
+    ASSERT_FALSE(bitset.test_range(4, 64));
+    ASSERT_FALSE(bitset.test_range(131, size - 1));
+    ASSERT_TRUE(bitset.test_range(131, size));
+
+    std::vector<int64_t> clear_ids;
+    bitset.for_each_clear(60, 135, [&](int64_t id) { clear_ids.push_back(id); });
+    ASSERT_EQ(clear_ids, std::vector<int64_t>({60, 61, 62, 63, 128, 129, 131, 132, 133, 134}));
+
+    int64_t clear_count = 0;
+    faiss::for_each_clear(nullptr, 0, size, [&](int64_t) { clear_count++; });
+    ASSERT_EQ(clear_count, size);
+
+    auto other = std::make_shared<faiss::ConcurrentBitset>(size);
+    other->set(4);
+    other->set(3);
+    bitset.merge(*other);
+    ASSERT_TRUE(bitset.test(4));
+    ASSERT_EQ(bitset.count(), 68);
+
+    bitset.clear(4);
+    ASSERT_FALSE(bitset.test(4));
+    clear_count = 0;
+    faiss::for_each_clear(other, 0, size, [&](int64_t) { clear_count++; });
+    ASSERT_EQ(clear_count, size - 2);
+}
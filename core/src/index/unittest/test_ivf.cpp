@@ -218,6 +218,59 @@ TEST_P(IVFTest, ivf_serialize) {
     }
 }
 
+TEST_P(IVFTest, shared_quantizer_test) {
+    if (index_type.find("GPU") != std::string::npos || index_type.find("Hybrid") != std::string::npos) {
+        return;
+    }
+
+    auto AssertEqual = [&](knowhere::DatasetPtr p1, knowhere::DatasetPtr p2) {
+        auto ids_p1 = p1->Get<int64_t*>(knowhere::meta::IDS);
+        auto ids_p2 = p2->Get<int64_t*>(knowhere::meta::IDS);
+        for (int i = 0; i < nq * k; ++i) {
+            EXPECT_EQ(ids_p2[i], ids_p1[i]);
+        }
+    };
+
+    // untrained index has no quantizer to share
+    ASSERT_EQ(index_->GetSharedQuantizer(), nullptr);
+
+    auto model = index_->Train(base_dataset, conf);
+    index_->set_index_model(model);
+    index_->Add(base_dataset, conf);
+    auto result = index_->Search(query_dataset, conf);
+    AssertAnns(result, nq, k);
+
+    auto quantizer = index_->GetSharedQuantizer();
+    ASSERT_NE(quantizer, nullptr);
+    ASSERT_EQ(quantizer->quantizer()->ntotal, conf[knowhere::IndexParams::nlist].get<int64_t>());
+    ASSERT_EQ(index_->GetSharedQuantizer(), quantizer);
+
+    // search through the shared quantizer, twice to reuse the assigned lists
+    AssertEqual(result, index_->Search(query_dataset, conf));
+    AssertEqual(result, index_->Search(query_dataset, conf));
+
+    // another segment trained with the shared quantizer
+    auto index = IndexFactory(index_type);
+    index->SetSharedQuantizer(quantizer);
+    auto model2 = index->Train(base_dataset, conf);
+    index->set_index_model(model2);
+    index->Add(base_dataset, conf);
+    ASSERT_EQ(index->GetSharedQuantizer(), quantizer);
+    auto result2 = index->Search(query_dataset, conf);
+    AssertAnns(result2, nq, k);
+    if (index_type == "IVF") {
+        AssertEqual(result, result2);
+    }
+
+    // a loaded index with the same centroids drops its own quantizer
+    auto binaryset = index->Serialize();
+    auto index3 = IndexFactory(index_type);
+    index3->SetSharedQuantizer(quantizer);
+    index3->Load(binaryset);
+    ASSERT_EQ(index3->GetSharedQuantizer(), quantizer);
+    AssertEqual(result2, index3->Search(query_dataset, conf));
+}
+
 // TODO(linxj): deprecated
 #ifdef MILVUS_GPU_VERSION
 TEST_P(IVFTest, clone_test) {
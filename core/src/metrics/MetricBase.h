@@ -59,6 +59,10 @@ class MetricsBase {
     CpuCacheUsageGaugeSet(double value) {
     }
 
+    virtual void
+    CpuCacheHitRatioGaugeSet(const std::string& policy, double value) {
+    }
+
     virtual void
     GpuCacheUsageGaugeSet() {
     }
@@ -91,6 +95,26 @@ class MetricsBase {
     SearchIndexDataDurationSecondsHistogramObserve(double value) {
     }
 
+    virtual void
+    WalCommitDurationHistogramObserve(double value) {
+    }
+
+    virtual void
+    WalSyncDurationHistogramObserve(double value) {
+    }
+
+    virtual void
+    SearchBatchSizeHistogramObserve(double value) {
+    }
+
+    virtual void
+    FlushWriteBytesTotalIncrement(double value) {
+    }
+
+    virtual void
+    MergeWriteBytesTotalIncrement(double value) {
+    }
+
     virtual void
     SearchRawDataDurationSecondsHistogramObserve(double value) {
     }
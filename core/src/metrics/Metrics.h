@@ -115,6 +115,30 @@ class CollectMergeFilesMetrics : CollectMetricsBase {
     }
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CollectWalCommitMetrics : CollectMetricsBase {
+ public:
+    CollectWalCommitMetrics() {
+    }
+
+    ~CollectWalCommitMetrics() {
+        auto total_time = TimeFromBegine();
+        server::Metrics::GetInstance().WalCommitDurationHistogramObserve(total_time);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CollectWalSyncMetrics : CollectMetricsBase {
+ public:
+    CollectWalSyncMetrics() {
+    }
+
+    ~CollectWalSyncMetrics() {
+        auto total_time = TimeFromBegine();
+        server::Metrics::GetInstance().WalSyncDurationHistogramObserve(total_time);
+    }
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class CollectBuildIndexMetrics : CollectMetricsBase {
  public:
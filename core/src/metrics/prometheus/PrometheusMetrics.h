@@ -101,6 +101,13 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    CpuCacheHitRatioGaugeSet(const std::string& policy, double value) override {
+        if (startup_) {
+            cpu_cache_hit_ratio_.Add({{"policy", policy}}).Set(value);
+        }
+    }
+
     void
     GpuCacheUsageGaugeSet() override;
 
@@ -153,6 +160,52 @@ class PrometheusMetrics : public MetricsBase {
         }
     }
 
+    void
+    WalCommitDurationHistogramObserve(double value) override {
+        if (startup_) {
+            wal_commit_duration_histogram_.Observe(value);
+        }
+    }
+
+    void
+    WalSyncDurationHistogramObserve(double value) override {
+        if (startup_) {
+            wal_sync_duration_histogram_.Observe(value);
+        }
+    }
+
+    void
+    SearchBatchSizeHistogramObserve(double value) override {
+        if (startup_) {
+            search_batch_size_histogram_.Observe(value);
+        }
+    }
+
+    void
+    FlushWriteBytesTotalIncrement(double value) override {
+        if (startup_) {
+            flush_write_bytes_total_.Increment(value);
+            WriteAmplificationGaugeUpdate();
+        }
+    }
+
+    void
+    MergeWriteBytesTotalIncrement(double value) override {
+        if (startup_) {
+            merge_write_bytes_total_.Increment(value);
+            WriteAmplificationGaugeUpdate();
+        }
+    }
+
+    // bytes written by flush and merge for every byte flushed
+    void
+    WriteAmplificationGaugeUpdate() {
+        double flushed = flush_write_bytes_total_.Value();
+        if (flushed > 0) {
+            write_amplification_gauge_.Set((flushed + merge_write_bytes_total_.Value()) / flushed);
+        }
+    }
+
     void
     SearchIndexDataDurationSecondsHistogramObserve(double value) override {
         if (startup_) {
@@ -460,6 +513,38 @@ class PrometheusMetrics : public MetricsBase {
     prometheus::Histogram& search_raw_data_duration_seconds_histogram_ =
         search_data_duration_seconds_.Add({{"type", "raw"}}, BucketBoundaries{1e5, 2e5, 4e5, 6e5, 8e5});
 
+    // record time of appending records into wal until they are durable, and time of syncing wal files
+    prometheus::Family<prometheus::Histogram>& wal_duration_ = prometheus::BuildHistogram()
+                                                                   .Name("wal_duration_microseconds")
+                                                                   .Help("histograms of wal commit and sync time")
+                                                                   .Register(*registry_);
+    prometheus::Histogram& wal_commit_duration_histogram_ =
+        wal_duration_.Add({{"type", "commit"}}, BucketBoundaries{1e2, 5e2, 1e3, 5e3, 1e4, 5e4, 1e5, 5e5});
+    prometheus::Histogram& wal_sync_duration_histogram_ =
+        wal_duration_.Add({{"type", "sync"}}, BucketBoundaries{1e2, 5e2, 1e3, 5e3, 1e4, 5e4, 1e5, 5e5});
+
+    // record number of query vectors of combined searches
+    prometheus::Family<prometheus::Histogram>& search_batch_size_ = prometheus::BuildHistogram()
+                                                                        .Name("search_batch_size")
+                                                                        .Help("histogram of nq of combined searches")
+                                                                        .Register(*registry_);
+    prometheus::Histogram& search_batch_size_histogram_ =
+        search_batch_size_.Add({}, BucketBoundaries{1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024});
+
+    // record bytes of segments written by flush and by merge or compact
+    prometheus::Family<prometheus::Counter>& segment_write_bytes_ = prometheus::BuildCounter()
+                                                                        .Name("segment_write_bytes_total")
+                                                                        .Help("total bytes of segments written")
+                                                                        .Register(*registry_);
+    prometheus::Counter& flush_write_bytes_total_ = segment_write_bytes_.Add({{"type", "flush"}});
+    prometheus::Counter& merge_write_bytes_total_ = segment_write_bytes_.Add({{"type", "merge"}});
+
+    prometheus::Family<prometheus::Gauge>& write_amplification_ = prometheus::BuildGauge()
+                                                                       .Name("write_amplification")
+                                                                       .Help("segment bytes written per byte flushed")
+                                                                       .Register(*registry_);
+    prometheus::Gauge& write_amplification_gauge_ = write_amplification_.Add({});
+
     ////all form Cache.cpp
     // record cache usage, when insert/erase/clear/free
 
@@ -548,6 +633,12 @@ class PrometheusMetrics : public MetricsBase {
         prometheus::BuildGauge().Name("cache_usage_bytes").Help("current cache usage by bytes").Register(*registry_);
     prometheus::Gauge& cpu_cache_usage_gauge_ = cpu_cache_usage_.Add({});
 
+    // record CPU cache hit ratio of the configured eviction policy
+    prometheus::Family<prometheus::Gauge>& cpu_cache_hit_ratio_ = prometheus::BuildGauge()
+                                                                      .Name("cache_hit_ratio")
+                                                                      .Help("cpu cache hit ratio by eviction policy")
+                                                                      .Register(*registry_);
+
     // record GPU cache usage and %
     prometheus::Family<prometheus::Gauge>& gpu_cache_usage_ = prometheus::BuildGauge()
                                                                   .Name("gpu_cache_usage_bytes")
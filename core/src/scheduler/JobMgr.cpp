@@ -14,7 +14,9 @@
 #include <src/db/Utils.h>
 #include <src/segment/SegmentReader.h>
 
+#include <algorithm>
 #include <limits>
+#include <string>
 #include <utility>
 
 #include "SchedInst.h"
@@ -80,7 +82,6 @@ JobMgr::worker_function() {
 
         auto tasks = build_task(job);
 
-        // TODO(zhiru): if the job is search by ids, pass any task where the ids don't exist
         auto search_job = std::dynamic_pointer_cast<SearchJob>(job);
         if (search_job != nullptr) {
             scheduler::ResultIds ids(search_job->nq() * search_job->topk(), -1);
@@ -91,34 +92,7 @@ JobMgr::worker_function() {
 
             if (search_job->vectors().float_data_.empty() && search_job->vectors().binary_data_.empty() &&
                 !search_job->vectors().id_array_.empty()) {
-                for (auto task = tasks.begin(); task != tasks.end();) {
-                    auto search_task = std::static_pointer_cast<XSearchTask>(*task);
-                    auto location = search_task->GetLocation();
-
-                    // Load bloom filter
-                    std::string segment_dir;
-                    engine::utils::GetParentPath(location, segment_dir);
-                    segment::SegmentReader segment_reader(segment_dir);
-                    segment::IdBloomFilterPtr id_bloom_filter_ptr;
-                    segment_reader.LoadBloomFilter(id_bloom_filter_ptr);
-
-                    // Check if the id is present.
-                    bool pass = true;
-                    for (auto& id : search_job->vectors().id_array_) {
-                        if (id_bloom_filter_ptr->Check(id)) {
-                            pass = false;
-                            break;
-                        }
-                    }
-
-                    if (pass) {
-                        //                        std::cout << search_task->GetIndexId() << std::endl;
-                        search_job->SearchDone(search_task->GetIndexId());
-                        task = tasks.erase(task);
-                    } else {
-                        task++;
-                    }
-                }
+                prune_search_by_id(search_job, tasks);
             }
         }
 
@@ -145,6 +119,65 @@ JobMgr::worker_function() {
     }
 }
 
+void
+JobMgr::prune_search_by_id(const SearchJobPtr& search_job, std::vector<TaskPtr>& tasks) {
+    // the bloom filters and id indexes are cached, so the segments are checked inline
+    auto& id_array = search_job->vectors().id_array_;
+    size_t count = 0;
+    for (auto& task : tasks) {
+        auto search_task = std::static_pointer_cast<XSearchTask>(task);
+        if (contains_ids(search_task->GetLocation(), id_array)) {
+            tasks[count++] = task;
+        } else {
+            search_job->SearchDone(search_task->GetIndexId());
+        }
+    }
+    tasks.resize(count);
+}
+
+bool
+JobMgr::contains_ids(const std::string& location, const std::vector<int64_t>& id_array) {
+    std::string segment_dir;
+    engine::utils::GetParentPath(location, segment_dir);
+    segment::SegmentReader segment_reader(segment_dir);
+
+    // a segment that can't be checked is searched
+    segment::IdBloomFilterPtr id_bloom_filter_ptr;
+    if (!segment_reader.LoadBloomFilter(id_bloom_filter_ptr).ok()) {
+        return true;
+    }
+    std::vector<segment::doc_id_t> maybe_exist;
+    for (auto& id : id_array) {
+        if (id_bloom_filter_ptr->Check(id)) {
+            maybe_exist.push_back(id);
+        }
+    }
+    if (maybe_exist.empty()) {
+        return false;
+    }
+
+    // rule out the false positives of the bloom filter, and the ids deleted from the segment: deleted ids
+    // stay in the bloom filter and the id index
+    segment::IdIndexPtr id_index_ptr;
+    if (!segment_reader.LoadIdIndex(id_index_ptr).ok()) {
+        return true;
+    }
+    segment::DeletedDocsPtr deleted_docs_ptr;
+    segment::offset_t offset;
+    for (auto& id : maybe_exist) {
+        if (!id_index_ptr->Find(id, offset)) {
+            continue;
+        }
+        if (deleted_docs_ptr == nullptr && !segment_reader.LoadDeletedDocs(deleted_docs_ptr).ok()) {
+            return true;
+        }
+        if (!deleted_docs_ptr->IsDeleted(offset)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::vector<TaskPtr>
 JobMgr::build_task(const JobPtr& job) {
     return TaskCreator::Create(job);
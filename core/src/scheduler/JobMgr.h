@@ -24,6 +24,7 @@
 #include "ResourceMgr.h"
 #include "interface/interfaces.h"
 #include "job/Job.h"
+#include "job/SearchJob.h"
 #include "task/Task.h"
 
 namespace milvus {
@@ -53,6 +54,14 @@ class JobMgr : public interface::dumpable {
     static std::vector<TaskPtr>
     build_task(const JobPtr& job);
 
+    // finish the tasks of a search by id job whose segments don't hold any of the ids, and remove them
+    static void
+    prune_search_by_id(const SearchJobPtr& search_job, std::vector<TaskPtr>& tasks);
+
+    // false if the segment of the index file holds none of the ids, or only deleted ones
+    static bool
+    contains_ids(const std::string& location, const std::vector<int64_t>& id_array);
+
  public:
     static void
     calculate_path(const ResourceMgrPtr& res_mgr, const TaskPtr& task);
@@ -40,17 +40,22 @@ std::mutex BuildMgrInst::mutex_;
 
 void
 load_simple_config() {
+    server::Config& config = server::Config::GetInstance();
+
     // create and connect
     ResMgrInst::GetInstance()->Add(ResourceFactory::Create("disk", "DISK", 0, false));
 
     auto io = Connection("io", 500);
-    ResMgrInst::GetInstance()->Add(ResourceFactory::Create("cpu", "CPU", 0));
+    int64_t search_worker_num = 1;
+    config.GetEngineConfigSearchWorkerNum(search_worker_num);
+    auto cpu = ResourceFactory::Create("cpu", "CPU", 0);
+    cpu->SetWorkerNum(search_worker_num);
+    ResMgrInst::GetInstance()->Add(std::move(cpu));
     ResMgrInst::GetInstance()->Connect("disk", "cpu", io);
 
 // get resources
 #ifdef MILVUS_GPU_VERSION
     bool enable_gpu = false;
-    server::Config& config = server::Config::GetInstance();
     config.GetGpuResourceConfigEnable(enable_gpu);
     if (enable_gpu) {
         std::vector<int64_t> gpu_ids;
@@ -160,14 +160,17 @@ TaskTable::PickToLoad(uint64_t limit) {
             break;
         if (index % table_.capacity() == table_.rear())
             break;
+        auto state = table_[index]->state;
         if (not cross && table_[index]->IsFinish()) {
             table_.set_front(index);
-        } else if (table_[index]->state == TaskTableItemState::LOADED) {
+        } else if (state == TaskTableItemState::LOADING || state == TaskTableItemState::LOADED) {
+            // a task being loaded by another loader must not be skipped by set_front
             cross = true;
             ++loaded_count;
-            if (loaded_count > 2)
+            if (loaded_count > max_loaded_)
                 return std::vector<uint64_t>();
-        } else if (table_[index]->state == TaskTableItemState::START) {
+        } else if (state == TaskTableItemState::START) {
+            cross = true;
             auto task = table_[index]->task;
 
             // if task is a build index task, limit it
@@ -177,9 +180,10 @@ TaskTable::PickToLoad(uint64_t limit) {
                     continue;
                 }
             }
-            cross = true;
             indexes.push_back(index);
             ++pick_count;
+        } else if (not table_[index]->IsFinish()) {
+            cross = true;
         }
     }
     rc.ElapseFromBegin("PickToLoad ");
@@ -246,12 +250,16 @@ TaskTable::PickToExecute(uint64_t limit) {
             break;
         }
 
+        auto state = table_[index]->state;
         if (not cross && table_[index]->IsFinish()) {
             table_.set_front(index);
-        } else if (table_[index]->state == TaskTableItemState::LOADED) {
+        } else if (state == TaskTableItemState::LOADED) {
             cross = true;
             indexes.push_back(index);
             ++pick_count;
+        } else if (not table_[index]->IsFinish()) {
+            // executing in another executor, or not loaded yet
+            cross = true;
         }
     }
     rc.ElapseFromBegin("PickToExecute ");
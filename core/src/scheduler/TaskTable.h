@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -122,6 +123,15 @@ class TaskTable : public interface::dumpable {
     std::vector<uint64_t>
     PickToLoad(uint64_t limit);
 
+    /*
+     * Tasks loading or loaded but not executed yet keep their files in memory,
+     * nothing more is picked to load once there are more than max_loaded of them;
+     */
+    inline void
+    SetMaxLoaded(uint64_t max_loaded) {
+        max_loaded_ = max_loaded;
+    }
+
     std::vector<uint64_t>
     PickToExecute(uint64_t limit);
 
@@ -214,6 +224,7 @@ class TaskTable : public interface::dumpable {
     std::uint64_t id_ = 0;
     CircleQueue<TaskTableItemPtr> table_;
     std::function<void(void)> subscriber_ = nullptr;
+    std::atomic<uint64_t> max_loaded_{2};
 
     // cache last finish avoid Pick task from begin always
     // pick from (last_finish_ + 1)
@@ -11,11 +11,112 @@
 
 #include "scheduler/job/SearchJob.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>
+
 #include "utils/Log.h"
+#include "utils/TimeRecorder.h"
 
 namespace milvus {
 namespace scheduler {
 
+namespace {
+
+// below nq * k * result count of this, results are merged by the waiting thread only
+constexpr size_t PARALLEL_REDUCE_THRESHOLD = 10000;
+// min number of queries merged by a thread
+constexpr size_t PARALLEL_REDUCE_BATCH = 8;
+// task results kept before they are merged into one, bounds the memory of a job fanning out to many index files
+constexpr size_t REDUCE_RESULT_BATCH = 16;
+
+void
+ParallelReduce(const std::function<void(size_t, size_t)>& reduce_function, size_t max_index) {
+    size_t thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    size_t reduce_batch = std::max(PARALLEL_REDUCE_BATCH, max_index / thread_count + 1);
+
+    std::vector<std::thread> thread_array;
+    size_t from_index = reduce_batch;
+    while (from_index < max_index) {
+        size_t to_index = std::min(from_index + reduce_batch, max_index);
+        thread_array.emplace_back(reduce_function, from_index, to_index);
+        from_index = to_index;
+    }
+
+    // the calling thread takes the first batch
+    reduce_function(0, std::min(reduce_batch, max_index));
+    for (auto& thread : thread_array) {
+        thread.join();
+    }
+}
+
+// k-way merge of the results of every query into the k results per query of ids/distances,
+// queries without enough results are padded with -1
+void
+MergeResults(const std::vector<const TaskResult*>& results, size_t nq, size_t k, bool ascending, bool parallel,
+             ResultIds& ids, ResultDistances& distances) {
+    ids.assign(nq * k, -1);
+    distances.assign(nq * k, std::numeric_limits<float>::max());
+
+    // distance -- ascending reduce, similarity -- descending reduce; ties go to the earlier result
+    // cursor: (result index, position in the query's results)
+    using Cursor = std::pair<size_t, size_t>;
+    auto reduce_function = [&](size_t from, size_t to) {
+        std::vector<Cursor> heap;
+        heap.reserve(results.size());
+        for (size_t i = from; i < to; ++i) {
+            auto distance = [&](const Cursor& c) {
+                return results[c.first]->distances_[i * results[c.first]->stride_ + c.second];
+            };
+            auto valid = [&](const Cursor& c) {
+                auto& result = *results[c.first];
+                // invalid ids are always at the tail of a sorted result
+                return c.second < result.k_ && result.ids_[i * result.stride_ + c.second] != -1;
+            };
+            // std heap keeps the "largest" element at front, so it's ordered reversely
+            auto worse = [&](const Cursor& a, const Cursor& b) {
+                float da = distance(a), db = distance(b);
+                if (da != db) {
+                    return ascending ? da > db : da < db;
+                }
+                return a.first > b.first;
+            };
+
+            heap.clear();
+            for (size_t r = 0; r < results.size(); ++r) {
+                if (valid(Cursor(r, 0))) {
+                    heap.emplace_back(r, 0);
+                }
+            }
+            std::make_heap(heap.begin(), heap.end(), worse);
+
+            for (size_t j = 0; j < k && !heap.empty(); ++j) {
+                std::pop_heap(heap.begin(), heap.end(), worse);
+                Cursor& best = heap.back();
+                auto& result = *results[best.first];
+                ids[i * k + j] = result.ids_[i * result.stride_ + best.second];
+                distances[i * k + j] = result.distances_[i * result.stride_ + best.second];
+
+                ++best.second;
+                if (valid(best)) {
+                    std::push_heap(heap.begin(), heap.end(), worse);
+                } else {
+                    heap.pop_back();
+                }
+            }
+        }
+    };
+
+    if (parallel && nq > 1 && nq * k * results.size() >= PARALLEL_REDUCE_THRESHOLD) {
+        ParallelReduce(reduce_function, nq);
+    } else {
+        reduce_function(0, nq);
+    }
+}
+
+}  // namespace
+
 SearchJob::SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, const milvus::json& extra_params,
                      const engine::VectorsData& vectors)
     : Job(JobType::SEARCH), context_(context), topk_(topk), extra_params_(extra_params), vectors_(vectors) {
@@ -36,9 +137,13 @@ SearchJob::AddIndexFile(const TableFileSchemaPtr& index_file) {
 
 void
 SearchJob::WaitResult() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    cv_.wait(lock, [this] { return index_files_.empty(); });
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return index_files_.empty(); });
+    }
     SERVER_LOG_DEBUG << "SearchJob " << id() << " all done";
+
+    ReduceResult();
 }
 
 void
@@ -52,6 +157,64 @@ SearchJob::SearchDone(size_t index_id) {
     SERVER_LOG_DEBUG << "SearchJob " << id() << " finish index file: " << index_id;
 }
 
+void
+SearchJob::AddResult(size_t index_id, TaskResult&& result) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (index_files_.find(index_id) == index_files_.end()) {
+            return;
+        }
+    }
+    if (result.ids_.empty() || result.k_ == 0) {
+        return;
+    }
+
+    std::vector<TaskResult> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(reduce_mutex_);
+            pending_results_.emplace_back(std::move(result));
+            if (pending_results_.size() < REDUCE_RESULT_BATCH) {
+                return;
+            }
+            batch.swap(pending_results_);
+        }
+
+        // merge the batch out of the lock, the merged result is added back as the result of a task
+        std::vector<const TaskResult*> results;
+        for (auto& task_result : batch) {
+            results.push_back(&task_result);
+        }
+        result = TaskResult();
+        result.k_ = topk_;
+        result.stride_ = topk_;
+        result.ascending_ = batch.front().ascending_;
+        MergeResults(results, vectors_.vector_count_, topk_, result.ascending_, false, result.ids_,
+                     result.distances_);
+        batch.clear();
+    }
+}
+
+void
+SearchJob::ReduceResult() {
+    std::vector<const TaskResult*> results;
+    for (auto& result : pending_results_) {
+        results.push_back(&result);
+    }
+    if (results.empty()) {
+        // keep the initialized result set
+        return;
+    }
+
+    TimeRecorder rc("SearchJob " + std::to_string(id()) + " reduce topk");
+
+    MergeResults(results, vectors_.vector_count_, topk_, results.front()->ascending_, true, result_ids_,
+                 result_distances_);
+    pending_results_.clear();
+
+    rc.ElapseFromBegin("merged " + std::to_string(results.size()) + " results");
+}
+
 ResultIds&
 SearchJob::GetResultIds() {
     return result_ids_;
@@ -38,6 +38,15 @@ using Id2IndexMap = std::unordered_map<size_t, TableFileSchemaPtr>;
 using ResultIds = engine::ResultIds;
 using ResultDistances = engine::ResultDistances;
 
+// topk result of a search task, query i has k_ results starting at ids_[i * stride_]
+struct TaskResult {
+    ResultIds ids_;
+    ResultDistances distances_;
+    size_t k_ = 0;
+    size_t stride_ = 0;
+    bool ascending_ = true;
+};
+
 class SearchJob : public Job {
  public:
     SearchJob(const std::shared_ptr<server::Context>& context, uint64_t topk, const milvus::json& extra_params,
@@ -47,12 +56,18 @@ class SearchJob : public Job {
     bool
     AddIndexFile(const TableFileSchemaPtr& index_file);
 
+    // wait until all index files are searched, then merge their results
     void
     WaitResult();
 
     void
     SearchDone(size_t index_id);
 
+    // add the result of an index file, results are merged in batches as they come so that only a few of them
+    // are kept until WaitResult
+    void
+    AddResult(size_t index_id, TaskResult&& result);
+
     ResultIds&
     GetResultIds();
 
@@ -65,6 +80,11 @@ class SearchJob : public Job {
     json
     Dump() const override;
 
+ private:
+    // k-way merge of the results not merged yet
+    void
+    ReduceResult();
+
  public:
     const std::shared_ptr<server::Context>&
     GetContext() const;
@@ -108,6 +128,9 @@ class SearchJob : public Job {
     const engine::VectorsData& vectors_;
 
     Id2IndexMap index_files_;
+    // task results and merged batches of them, not merged into the result set yet
+    std::vector<TaskResult> pending_results_;
+    std::mutex reduce_mutex_;
     // TODO: column-base better ?
     ResultIds result_ids_;
     ResultDistances result_distances_;
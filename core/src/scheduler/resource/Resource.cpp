@@ -13,6 +13,7 @@
 #include "scheduler/SchedInst.h"
 #include "scheduler/Utils.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -53,12 +54,23 @@ Resource::Resource(std::string name, ResourceType type, uint64_t device_id, bool
     });
 }
 
+void
+Resource::SetWorkerNum(uint64_t num) {
+    worker_num_ = std::max<uint64_t>(num, 1);
+    // keep two loaded tasks per executor, as a single executor always did
+    task_table_.SetMaxLoaded(2 * worker_num_);
+}
+
 void
 Resource::Start() {
     running_ = true;
-    loader_thread_ = std::thread(&Resource::loader_function, this);
+    for (uint64_t i = 0; i < worker_num_; ++i) {
+        loader_threads_.emplace_back(&Resource::loader_function, this);
+    }
     if (enable_executor_) {
-        executor_thread_ = std::thread(&Resource::executor_function, this);
+        for (uint64_t i = 0; i < worker_num_; ++i) {
+            executor_threads_.emplace_back(&Resource::executor_function, this, i);
+        }
     }
 }
 
@@ -66,10 +78,16 @@ void
 Resource::Stop() {
     running_ = false;
     WakeupLoader();
-    loader_thread_.join();
+    for (auto& thread : loader_threads_) {
+        thread.join();
+    }
+    loader_threads_.clear();
     if (enable_executor_) {
         WakeupExecutor();
-        executor_thread_.join();
+        for (auto& thread : executor_threads_) {
+            thread.join();
+        }
+        executor_threads_.clear();
     }
 }
 
@@ -77,18 +95,18 @@ void
 Resource::WakeupLoader() {
     {
         std::lock_guard<std::mutex> lock(load_mutex_);
-        load_flag_ = true;
+        ++load_seq_;
     }
-    load_cv_.notify_one();
+    load_cv_.notify_all();
 }
 
 void
 Resource::WakeupExecutor() {
     {
         std::lock_guard<std::mutex> lock(exec_mutex_);
-        exec_flag_ = true;
+        ++exec_seq_;
     }
-    exec_cv_.notify_one();
+    exec_cv_.notify_all();
 }
 
 json
@@ -98,8 +116,9 @@ Resource::Dump() const {
         {"name", name_},
         {"type", ToString(type_)},
         {"task_average_cost", TaskAvgCost()},
-        {"task_total_cost", total_cost_},
-        {"total_tasks", total_task_},
+        {"task_total_cost", total_cost_.load()},
+        {"total_tasks", total_task_.load()},
+        {"worker_num", worker_num_},
         {"running", running_},
         {"enable_executor", enable_executor_},
     };
@@ -153,10 +172,11 @@ Resource::pick_task_execute() {
 
 void
 Resource::loader_function() {
+    uint64_t seen_seq = 0;
     while (running_) {
         std::unique_lock<std::mutex> lock(load_mutex_);
-        load_cv_.wait(lock, [&] { return load_flag_; });
-        load_flag_ = false;
+        load_cv_.wait(lock, [&] { return load_seq_ != seen_seq; });
+        seen_seq = load_seq_;
         lock.unlock();
         while (true) {
             auto task_item = pick_task_load();
@@ -182,15 +202,16 @@ Resource::loader_function() {
 }
 
 void
-Resource::executor_function() {
-    if (subscriber_) {
+Resource::executor_function(uint64_t worker_id) {
+    if (worker_id == 0 && subscriber_) {
         auto event = std::make_shared<StartUpEvent>(shared_from_this());
         subscriber_(std::static_pointer_cast<Event>(event));
     }
+    uint64_t seen_seq = 0;
     while (running_) {
         std::unique_lock<std::mutex> lock(exec_mutex_);
-        exec_cv_.wait(lock, [&] { return exec_flag_; });
-        exec_flag_ = false;
+        exec_cv_.wait(lock, [&] { return exec_seq_ != seen_seq; });
+        seen_seq = exec_seq_;
         lock.unlock();
         while (true) {
             auto task_item = pick_task_execute();
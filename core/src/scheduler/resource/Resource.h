@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -54,6 +55,14 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
     void
     Stop();
 
+    /*
+     * Set number of loader threads and executor threads, called before Start;
+     * Workers pick tasks from the same task table, an idle worker takes any task not taken by others,
+     * and loaders load files of next tasks while executors are searching;
+     */
+    void
+    SetWorkerNum(uint64_t num);
+
     /*
      * wake up loader;
      */
@@ -90,6 +99,11 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
         return device_id_;
     }
 
+    inline uint64_t
+    worker_num() const {
+        return worker_num_;
+    }
+
     TaskTable&
     task_table() {
         return task_table_;
@@ -156,16 +170,16 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
 
  private:
     /*
-     * Only called by load thread;
+     * Only called by load threads;
      */
     void
     loader_function();
 
     /*
-     * Only called by worker thread;
+     * Only called by worker threads;
      */
     void
-    executor_function();
+    executor_function(uint64_t worker_id);
 
  protected:
     uint64_t device_id_;
@@ -176,18 +190,20 @@ class Resource : public Node, public std::enable_shared_from_this<Resource> {
 
     TaskTable task_table_;
 
-    uint64_t total_cost_ = 0;
-    uint64_t total_task_ = 0;
+    std::atomic<uint64_t> total_cost_{0};
+    std::atomic<uint64_t> total_task_{0};
 
     std::function<void(EventPtr)> subscriber_ = nullptr;
 
     bool running_ = false;
     bool enable_executor_ = true;
-    std::thread loader_thread_;
-    std::thread executor_thread_;
+    uint64_t worker_num_ = 1;
+    std::vector<std::thread> loader_threads_;
+    std::vector<std::thread> executor_threads_;
 
-    bool load_flag_ = false;
-    bool exec_flag_ = false;
+    // bumped by every wakeup, so that all waiting workers see it
+    uint64_t load_seq_ = 0;
+    uint64_t exec_seq_ = 0;
     std::mutex load_mutex_;
     std::mutex exec_mutex_;
     std::condition_variable load_cv_;
@@ -32,52 +32,6 @@
 namespace milvus {
 namespace scheduler {
 
-static constexpr size_t PARALLEL_REDUCE_THRESHOLD = 10000;
-static constexpr size_t PARALLEL_REDUCE_BATCH = 1000;
-
-// TODO(wxyu): remove unused code
-// bool
-// NeedParallelReduce(uint64_t nq, uint64_t topk) {
-//    server::ServerConfig &config = server::ServerConfig::GetInstance();
-//    server::ConfigNode &db_config = config.GetConfig(server::CONFIG_DB);
-//    bool need_parallel = db_config.GetBoolValue(server::CONFIG_DB_PARALLEL_REDUCE, false);
-//    if (!need_parallel) {
-//        return false;
-//    }
-//
-//    return nq * topk >= PARALLEL_REDUCE_THRESHOLD;
-//}
-//
-// void
-// ParallelReduce(std::function<void(size_t, size_t)> &reduce_function, size_t max_index) {
-//    size_t reduce_batch = PARALLEL_REDUCE_BATCH;
-//
-//    auto thread_count = std::thread::hardware_concurrency() - 1; //not all core do this work
-//    if (thread_count > 0) {
-//        reduce_batch = max_index / thread_count + 1;
-//    }
-//    ENGINE_LOG_DEBUG << "use " << thread_count <<
-//                     " thread parallelly do reduce, each thread process " << reduce_batch << " vectors";
-//
-//    std::vector<std::shared_ptr<std::thread> > thread_array;
-//    size_t from_index = 0;
-//    while (from_index < max_index) {
-//        size_t to_index = from_index + reduce_batch;
-//        if (to_index > max_index) {
-//            to_index = max_index;
-//        }
-//
-//        auto reduce_thread = std::make_shared<std::thread>(reduce_function, from_index, to_index);
-//        thread_array.push_back(reduce_thread);
-//
-//        from_index = to_index;
-//    }
-//
-//    for (auto &thread_ptr : thread_array) {
-//        thread_ptr->join();
-//    }
-//}
-
 void
 CollectFileMetrics(int file_type, size_t file_size) {
     server::MetricsBase& inst = server::Metrics::GetInstance();
@@ -109,7 +63,10 @@ XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, TableF
         }
 
         EngineType engine_type;
-        if (file->file_type_ == TableFileSchema::FILE_TYPE::RAW ||
+        bool incremental_graph = engine::utils::IsIncrementalGraphFile(*file);
+        if (incremental_graph) {
+            engine_type = EngineType::HNSW;
+        } else if (file->file_type_ == TableFileSchema::FILE_TYPE::RAW ||
             file->file_type_ == TableFileSchema::FILE_TYPE::TO_INDEX ||
             file->file_type_ == TableFileSchema::FILE_TYPE::BACKUP) {
             engine_type = engine::utils::IsBinaryMetricType(file->metric_type_) ? EngineType::FAISS_BIN_IDMAP
@@ -123,7 +80,7 @@ XSearchTask::XSearchTask(const std::shared_ptr<server::Context>& context, TableF
             json_params = milvus::json::parse(file_->index_params_);
         }
         index_engine_ = EngineFactory::Build(file_->dimension_, file_->location_, engine_type,
-                                             (MetricType)file_->metric_type_, json_params);
+                                             (MetricType)file_->metric_type_, json_params, incremental_graph);
     }
 }
 
@@ -270,22 +227,16 @@ XSearchTask::Execute() {
                 ENGINE_LOG_WARNING << "Searching in an empty file. file location = " << file_->location_;
             }
 
-            {
-                std::unique_lock<std::mutex> lock(search_job->mutex());
-
-                if (search_job->GetResultIds().size() > spec_k) {
-                    if (search_job->GetResultIds().front() == -1) {
-                        // initialized results set
-                        search_job->GetResultIds().resize(spec_k * nq);
-                        search_job->GetResultDistances().resize(spec_k * nq);
-                    }
-                }
-
-                XSearchTask::MergeTopkToResultSet(output_ids, output_distance, spec_k, nq, topk, ascending_reduce,
-                                                  search_job->GetResultIds(), search_job->GetResultDistances());
-            }
+            // results are merged once all index files are searched
+            TaskResult result;
+            result.ids_.swap(output_ids);
+            result.distances_.swap(output_distance);
+            result.k_ = spec_k;
+            result.stride_ = topk;
+            result.ascending_ = ascending_reduce;
+            search_job->AddResult(index_id_, std::move(result));
 
-            span = rc.RecordSection(hdr + ", reduce topk");
+            span = rc.RecordSection(hdr + ", collect topk");
             //            search_job->AccumReduceCost(span);
         } catch (std::exception& ex) {
             ENGINE_LOG_ERROR << "SearchTask encounter exception: " << ex.what();
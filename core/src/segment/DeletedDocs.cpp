@@ -17,22 +17,48 @@
 
 #include "segment/DeletedDocs.h"
 
+#include <utility>
+
 namespace milvus {
 namespace segment {
 
-DeletedDocs::DeletedDocs(const std::vector<offset_t>& deleted_doc_offsets) : deleted_doc_offsets_(deleted_doc_offsets) {
+DeletedDocs::DeletedDocs(const std::vector<offset_t>& deleted_doc_offsets) {
+    for (auto offset : deleted_doc_offsets) {
+        deleted_doc_offsets_.Add(offset);
+    }
+}
+
+DeletedDocs::DeletedDocs(RoaringBitmap deleted_doc_offsets) : deleted_doc_offsets_(std::move(deleted_doc_offsets)) {
 }
 
 void
 DeletedDocs::AddDeletedDoc(offset_t offset) {
-    deleted_doc_offsets_.emplace_back(offset);
+    deleted_doc_offsets_.Add(offset);
 }
 
-const std::vector<offset_t>&
+bool
+DeletedDocs::IsDeleted(offset_t offset) const {
+    return offset >= 0 && deleted_doc_offsets_.Contains(offset);
+}
+
+std::vector<offset_t>
 DeletedDocs::GetDeletedDocs() const {
+    std::vector<offset_t> offsets;
+    offsets.reserve(deleted_doc_offsets_.Cardinality());
+    deleted_doc_offsets_.ForEach([&](uint32_t offset) { offsets.push_back(offset); });
+    return offsets;
+}
+
+const RoaringBitmap&
+DeletedDocs::GetBitmap() const {
     return deleted_doc_offsets_;
 }
 
+void
+DeletedDocs::Merge(const DeletedDocs& other) {
+    deleted_doc_offsets_.Union(other.deleted_doc_offsets_);
+}
+
 // const std::string&
 // DeletedDocs::GetName() const {
 //    return name_;
@@ -40,7 +66,17 @@ DeletedDocs::GetDeletedDocs() const {
 
 size_t
 DeletedDocs::GetSize() const {
-    return deleted_doc_offsets_.size();
+    return deleted_doc_offsets_.Cardinality();
+}
+
+void
+DeletedDocs::GetBitset(int64_t count, faiss::ConcurrentBitsetPtr& bitset) const {
+    bitset = std::make_shared<faiss::ConcurrentBitset>(count);
+    deleted_doc_offsets_.ForEach([&](uint32_t offset) {
+        if (offset < count) {
+            bitset->set(offset);
+        }
+    });
 }
 
 }  // namespace segment
@@ -17,26 +17,45 @@
 
 #pragma once
 
+#include <faiss/utils/ConcurrentBitset.h>
+
 #include <memory>
 #include <vector>
 
+#include "segment/RoaringBitmap.h"
+
 namespace milvus {
 namespace segment {
 
 using offset_t = int32_t;
 
+// Offsets of the deleted docs of a segment, kept in a compressed bitmap so that membership tests
+// are O(1) and deletes of several batches can be merged cheaply.
 class DeletedDocs {
  public:
     explicit DeletedDocs(const std::vector<offset_t>& deleted_doc_offsets);
 
+    explicit DeletedDocs(RoaringBitmap deleted_doc_offsets);
+
     DeletedDocs() = default;
 
     void
     AddDeletedDoc(offset_t offset);
 
-    const std::vector<offset_t>&
+    bool
+    IsDeleted(offset_t offset) const;
+
+    // deleted offsets in ascending order
+    std::vector<offset_t>
     GetDeletedDocs() const;
 
+    const RoaringBitmap&
+    GetBitmap() const;
+
+    // add the deleted docs of other to this
+    void
+    Merge(const DeletedDocs& other);
+
     //    // TODO
     //    const std::string&
     //    GetName() const;
@@ -44,8 +63,9 @@ class DeletedDocs {
     size_t
     GetSize() const;
 
-    //    void
-    //    GetBitset(faiss::ConcurrentBitsetPtr& bitset);
+    // search blacklist of a segment with 'count' docs, filled from the set bits of the bitmap only
+    void
+    GetBitset(int64_t count, faiss::ConcurrentBitsetPtr& bitset) const;
 
     // No copy and move
     DeletedDocs(const DeletedDocs&) = delete;
@@ -57,8 +77,7 @@ class DeletedDocs {
     operator=(DeletedDocs&&) = delete;
 
  private:
-    std::vector<offset_t> deleted_doc_offsets_;
-    //    faiss::ConcurrentBitsetPtr bitset_;
+    RoaringBitmap deleted_doc_offsets_;
     //    const std::string name_ = "deleted_docs";
 };
 
@@ -16,57 +16,115 @@
 // under the License.
 
 #include "segment/IdBloomFilter.h"
-#include "utils/Log.h"
-#include "utils/Status.h"
 
-#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 
 namespace milvus {
 namespace segment {
 
-IdBloomFilter::IdBloomFilter(scaling_bloom_t* bloom_filter) : bloom_filter_(bloom_filter) {
+namespace {
+
+constexpr size_t CHECK_BATCH = 16;
+
+// odd constants from the split block bloom filter of parquet, each selects the bit of one word
+constexpr uint32_t SALTS[IdBloomFilter::BLOCK_WORDS] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                        0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+inline uint64_t
+HashId(doc_id_t uid) {
+    uint64_t h = static_cast<uint64_t>(uid);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
 }
 
-IdBloomFilter::~IdBloomFilter() {
-    const std::lock_guard<std::mutex> lock(mutex_);
-    if (bloom_filter_) {
-        free_scaling_bloom(bloom_filter_);
+inline void
+MakeMasks(uint64_t hash, uint64_t* masks) {
+    uint32_t key = static_cast<uint32_t>(hash);
+    for (size_t i = 0; i < IdBloomFilter::BLOCK_WORDS; ++i) {
+        masks[i] = 1ULL << ((key * SALTS[i]) >> 26);
+    }
+}
+
+}  // namespace
+
+IdBloomFilter::IdBloomFilter(size_t capacity) : capacity_(capacity) {
+    block_count_ = (capacity * FILTER_BITS_PER_ID + BLOCK_BITS - 1) / BLOCK_BITS;
+    if (block_count_ == 0) {
+        block_count_ = 1;
+    }
+
+    // blocks are aligned to cache lines
+    size_t num_bytes = block_count_ * BLOCK_WORDS * sizeof(uint64_t);
+    words_ = static_cast<uint64_t*>(aligned_alloc(BLOCK_WORDS * sizeof(uint64_t), num_bytes));
+    if (words_ == nullptr) {
+        throw std::bad_alloc();
     }
+    memset(words_, 0, num_bytes);
 }
 
-scaling_bloom_t*
-IdBloomFilter::GetBloomFilter() {
-    const std::lock_guard<std::mutex> lock(mutex_);
-    return bloom_filter_;
+IdBloomFilter::~IdBloomFilter() {
+    free(words_);
 }
 
 bool
-IdBloomFilter::Check(doc_id_t uid) {
-    std::string s = std::to_string(uid);
-    const std::lock_guard<std::mutex> lock(mutex_);
-    return scaling_bloom_check(bloom_filter_, s.c_str(), s.size());
+IdBloomFilter::Check(doc_id_t uid) const {
+    uint64_t hash = HashId(uid);
+    uint64_t masks[BLOCK_WORDS];
+    MakeMasks(hash, masks);
+
+    const uint64_t* block = BlockOf(hash);
+    uint64_t missing = 0;
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+        missing |= ~__atomic_load_n(block + i, __ATOMIC_RELAXED) & masks[i];
+    }
+    return missing == 0;
 }
 
-Status
-IdBloomFilter::Add(doc_id_t uid) {
-    std::string s = std::to_string(uid);
-    const std::lock_guard<std::mutex> lock(mutex_);
-    if (scaling_bloom_add(bloom_filter_, s.c_str(), s.size(), uid) == -1) {
-        // Counter overflow does not affect bloom filter's normal functionality
-        ENGINE_LOG_WARNING << "Warning adding id=" << s << " to bloom filter: 4 bit counter Overflow";
-        // return Status(DB_BLOOM_FILTER_ERROR, "Bloom filter error: 4 bit counter Overflow");
+void
+IdBloomFilter::CheckMany(const doc_id_t* uids, size_t n, std::vector<uint64_t>& bitmap) const {
+    bitmap.assign((n + 63) / 64, 0);
+
+    // hash a batch of ids and prefetch their blocks before probing, so that the cache misses overlap
+    uint64_t hashes[CHECK_BATCH];
+    for (size_t begin = 0; begin < n; begin += CHECK_BATCH) {
+        size_t end = std::min(n, begin + CHECK_BATCH);
+        for (size_t i = begin; i < end; ++i) {
+            hashes[i - begin] = HashId(uids[i]);
+            __builtin_prefetch(BlockOf(hashes[i - begin]));
+        }
+
+        for (size_t i = begin; i < end; ++i) {
+            uint64_t masks[BLOCK_WORDS];
+            MakeMasks(hashes[i - begin], masks);
+
+            const uint64_t* block = BlockOf(hashes[i - begin]);
+            uint64_t missing = 0;
+            for (size_t j = 0; j < BLOCK_WORDS; ++j) {
+                missing |= ~__atomic_load_n(block + j, __ATOMIC_RELAXED) & masks[j];
+            }
+            if (missing == 0) {
+                bitmap[i >> 6] |= 1ULL << (i & 63);
+            }
+        }
     }
-    return Status::OK();
 }
 
 Status
-IdBloomFilter::Remove(doc_id_t uid) {
-    std::string s = std::to_string(uid);
-    const std::lock_guard<std::mutex> lock(mutex_);
-    if (scaling_bloom_remove(bloom_filter_, s.c_str(), s.size(), uid) == -1) {
-        // Should never go in here, but just to be safe
-        ENGINE_LOG_WARNING << "Warning removing id=" << s << " in bloom filter: Decrementing zero in counter";
-        // return Status(DB_BLOOM_FILTER_ERROR, "Error removing in bloom filter: Decrementing zero in counter");
+IdBloomFilter::Add(doc_id_t uid) {
+    uint64_t hash = HashId(uid);
+    uint64_t masks[BLOCK_WORDS];
+    MakeMasks(hash, masks);
+
+    uint64_t* block = BlockOf(hash);
+    for (size_t i = 0; i < BLOCK_WORDS; ++i) {
+        __atomic_fetch_or(block + i, masks[i], __ATOMIC_RELAXED);
     }
     return Status::OK();
 }
@@ -76,9 +134,14 @@ IdBloomFilter::Remove(doc_id_t uid) {
 //    return name_;
 //}
 
-size_t
+int64_t
 IdBloomFilter::Size() {
-    return bloom_filter_->num_bytes;
+    return block_count_ * BLOCK_WORDS * sizeof(uint64_t);
+}
+
+std::string
+IdBloomFilter::CacheKey(const std::string& segment_dir) {
+    return segment_dir + "/bloom_filter";
 }
 
 }  // namespace segment
@@ -17,10 +17,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <mutex>
+#include <string>
+#include <vector>
 
-#include "dablooms/dablooms.h"
+#include "cache/DataObj.h"
 #include "utils/Status.h"
 
 namespace milvus {
@@ -28,26 +30,60 @@ namespace segment {
 
 using doc_id_t = int64_t;
 
-class IdBloomFilter {
+// Blocked bloom filter of integer ids. Every id sets BITS_PER_ID bits in one cache-line-sized block,
+// one bit in each word of the block, so that a check touches a single cache line and the word probes
+// can be vectorized. Bits are set and tested with atomic operations, concurrent checks and adds don't
+// need a lock. Ids can't be removed, deleted ids are filtered by the deleted docs of the segment.
+class IdBloomFilter : public cache::DataObj {
  public:
-    explicit IdBloomFilter(scaling_bloom_t* bloom_filter);
+    static constexpr size_t BLOCK_WORDS = 8;
+    static constexpr size_t BLOCK_BITS = BLOCK_WORDS * 64;
+    static constexpr size_t BITS_PER_ID = BLOCK_WORDS;
+    // about 1% false positive rate
+    static constexpr size_t FILTER_BITS_PER_ID = 12;
 
-    ~IdBloomFilter();
+    // capacity: expected number of ids
+    explicit IdBloomFilter(size_t capacity);
 
-    scaling_bloom_t*
-    GetBloomFilter();
+    ~IdBloomFilter();
 
     bool
-    Check(doc_id_t uid);
+    Check(doc_id_t uid) const;
+
+    // set bit i of 'bitmap' if uids[i] may exist
+    void
+    CheckMany(const doc_id_t* uids, size_t n, std::vector<uint64_t>& bitmap) const;
 
     Status
     Add(doc_id_t uid);
 
-    Status
-    Remove(doc_id_t uid);
+    size_t
+    Capacity() const {
+        return capacity_;
+    }
 
     size_t
-    Size();
+    BlockCount() const {
+        return block_count_;
+    }
+
+    // raw filter bits, BlockCount() * BLOCK_WORDS words
+    uint64_t*
+    Data() {
+        return words_;
+    }
+
+    const uint64_t*
+    Data() const {
+        return words_;
+    }
+
+    int64_t
+    Size() override;
+
+    // key of the bloom filter of a segment in the id cache
+    static std::string
+    CacheKey(const std::string& segment_dir);
 
     //    const std::string&
     //    GetName() const;
@@ -62,9 +98,17 @@ class IdBloomFilter {
     operator=(IdBloomFilter&&) = delete;
 
  private:
-    scaling_bloom_t* bloom_filter_;
+    uint64_t*
+    BlockOf(uint64_t hash) const {
+        // map the high 32 bits of the hash to [0, block_count_) without division
+        return words_ + ((hash >> 32) * block_count_ >> 32) * BLOCK_WORDS;
+    }
+
+ private:
+    size_t capacity_;
+    size_t block_count_;
+    uint64_t* words_;
     //    const std::string name_ = "bloom_filter";
-    std::mutex mutex_;
 };
 
 using IdBloomFilterPtr = std::shared_ptr<IdBloomFilter>;
@@ -0,0 +1,95 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/IdIndex.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace milvus {
+namespace segment {
+
+IdIndex::IdIndex(const std::vector<doc_id_t>& uids) {
+    if (std::is_sorted(uids.begin(), uids.end())) {
+        sorted_uids_ = uids;
+        return;
+    }
+
+    offsets_.resize(uids.size());
+    std::iota(offsets_.begin(), offsets_.end(), 0);
+    std::stable_sort(offsets_.begin(), offsets_.end(), [&](offset_t a, offset_t b) { return uids[a] < uids[b]; });
+
+    sorted_uids_.resize(uids.size());
+    for (size_t i = 0; i < offsets_.size(); ++i) {
+        sorted_uids_[i] = uids[offsets_[i]];
+    }
+}
+
+IdIndex::IdIndex(std::vector<doc_id_t>&& sorted_uids, std::vector<offset_t>&& offsets)
+    : sorted_uids_(std::move(sorted_uids)), offsets_(std::move(offsets)) {
+}
+
+bool
+IdIndex::Find(doc_id_t uid, offset_t& offset) const {
+    auto it = std::lower_bound(sorted_uids_.begin(), sorted_uids_.end(), uid);
+    if (it == sorted_uids_.end() || *it != uid) {
+        return false;
+    }
+    offset = OffsetAt(it - sorted_uids_.begin());
+    return true;
+}
+
+void
+IdIndex::Find(const std::vector<doc_id_t>& uids, std::vector<offset_t>& offsets,
+              std::vector<doc_id_t>& found_uids) const {
+    // both lists are sorted, they are merged in one pass; the cursor gallops ahead with doubling steps
+    // before a binary search, so a short list costs O(m * log(n / m)) instead of a full scan
+    auto end = sorted_uids_.end();
+    auto begin = sorted_uids_.begin();
+    for (auto uid : uids) {
+        size_t step = 1;
+        auto low = begin;
+        while (static_cast<size_t>(end - low) > step && *(low + step) < uid) {
+            low += step;
+            step <<= 1;
+        }
+        auto high = static_cast<size_t>(end - low) > step ? low + step + 1 : end;
+        begin = std::lower_bound(low, high, uid);
+        for (; begin != end && *begin == uid; ++begin) {
+            offsets.push_back(OffsetAt(begin - sorted_uids_.begin()));
+            found_uids.push_back(uid);
+        }
+        if (begin == end) {
+            break;
+        }
+    }
+}
+
+// the key is also the path of the id index file
+std::string
+IdIndex::CacheKey(const std::string& segment_dir) {
+    return segment_dir + "/id_index";
+}
+
+int64_t
+IdIndex::Size() {
+    return sorted_uids_.size() * sizeof(doc_id_t) + offsets_.size() * sizeof(offset_t);
+}
+
+}  // namespace segment
+}  // namespace milvus
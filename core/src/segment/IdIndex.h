@@ -18,13 +18,79 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
-#include "AttrIndex.h"
+#include "cache/DataObj.h"
+#include "segment/DeletedDocs.h"
+#include "segment/Vectors.h"
 
 namespace milvus {
 namespace segment {
 
-class IdIndex : public AttrIndex {};
+// Maps the uids of a segment to their offsets. The uids are kept sorted with their offsets in a parallel
+// array, and the offset array is dropped when the uids were inserted in ascending order, which is the
+// case for generated ids.
+class IdIndex : public cache::DataObj {
+ public:
+    IdIndex() = default;
+
+    // build from the uids of a segment, in offset order
+    explicit IdIndex(const std::vector<doc_id_t>& uids);
+
+    // offsets is empty if the i-th sorted uid is at offset i
+    IdIndex(std::vector<doc_id_t>&& sorted_uids, std::vector<offset_t>&& offsets);
+
+    // find the first offset of uid, return false if the uid doesn't exist
+    bool
+    Find(doc_id_t uid, offset_t& offset) const;
+
+    // append the offsets of all occurrences of the sorted 'uids' to 'offsets', with the matching uids
+    // appended to 'found_uids'
+    void
+    Find(const std::vector<doc_id_t>& uids, std::vector<offset_t>& offsets, std::vector<doc_id_t>& found_uids) const;
+
+    size_t
+    Count() const {
+        return sorted_uids_.size();
+    }
+
+    const std::vector<doc_id_t>&
+    GetSortedUids() const {
+        return sorted_uids_;
+    }
+
+    const std::vector<offset_t>&
+    GetOffsets() const {
+        return offsets_;
+    }
+
+    int64_t
+    Size() override;
+
+    // key of the id index of a segment in the id cache
+    static std::string
+    CacheKey(const std::string& segment_dir);
+
+    // No copy and move
+    IdIndex(const IdIndex&) = delete;
+    IdIndex(IdIndex&&) = delete;
+
+    IdIndex&
+    operator=(const IdIndex&) = delete;
+    IdIndex&
+    operator=(IdIndex&&) = delete;
+
+ private:
+    offset_t
+    OffsetAt(size_t pos) const {
+        return offsets_.empty() ? static_cast<offset_t>(pos) : offsets_[pos];
+    }
+
+ private:
+    std::vector<doc_id_t> sorted_uids_;
+    std::vector<offset_t> offsets_;
+};
 
 using IdIndexPtr = std::shared_ptr<IdIndex>;
 
@@ -0,0 +1,50 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/MappedVectors.h"
+
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstring>
+
+#include "utils/Log.h"
+
+namespace milvus {
+namespace segment {
+
+MappedVectors::MappedVectors(void* addr, size_t length, size_t data_offset, size_t data_size)
+    : addr_(addr), length_(length), data_offset_(data_offset), data_size_(data_size) {
+}
+
+MappedVectors::~MappedVectors() {
+    if (addr_ != nullptr && munmap(addr_, length_) == -1) {
+        ENGINE_LOG_ERROR << "Failed to unmap raw vectors, error: " << std::strerror(errno);
+    }
+}
+
+const uint8_t*
+MappedVectors::GetData() const {
+    return static_cast<const uint8_t*>(addr_) + data_offset_;
+}
+
+size_t
+MappedVectors::GetDataSize() const {
+    return data_size_;
+}
+
+}  // namespace segment
+}  // namespace milvus
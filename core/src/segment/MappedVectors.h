@@ -0,0 +1,62 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace milvus {
+namespace segment {
+
+// Raw vectors file of a segment mapped into memory, read only.
+// The file is unmapped when the object is destroyed, so whoever searches the data must hold it.
+class MappedVectors {
+ public:
+    // addr/length: the whole mapping, data_offset: where the vectors begin in the mapping
+    MappedVectors(void* addr, size_t length, size_t data_offset, size_t data_size);
+
+    ~MappedVectors();
+
+    const uint8_t*
+    GetData() const;
+
+    // unit: BYTE
+    size_t
+    GetDataSize() const;
+
+    // No copy and move
+    MappedVectors(const MappedVectors&) = delete;
+    MappedVectors(MappedVectors&&) = delete;
+
+    MappedVectors&
+    operator=(const MappedVectors&) = delete;
+    MappedVectors&
+    operator=(MappedVectors&&) = delete;
+
+ private:
+    void* addr_;
+    size_t length_;
+    size_t data_offset_;
+    size_t data_size_;
+};
+
+using MappedVectorsPtr = std::shared_ptr<MappedVectors>;
+
+}  // namespace segment
+}  // namespace milvus
@@ -0,0 +1,320 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "segment/RoaringBitmap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+namespace milvus {
+namespace segment {
+
+namespace {
+
+constexpr uint16_t ARRAY_CONTAINER = 0;
+constexpr uint16_t BITMAP_CONTAINER = 1;
+
+template <typename T>
+void
+AppendValue(std::vector<uint8_t>& buffer, const T& value) {
+    auto ptr = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+}
+
+template <typename T>
+bool
+ReadValue(const uint8_t*& data, const uint8_t* end, T& value) {
+    if (end - data < static_cast<int64_t>(sizeof(T))) {
+        return false;
+    }
+    memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return true;
+}
+
+}  // namespace
+
+bool
+RoaringBitmap::Container::Add(uint16_t low) {
+    if (IsBitmap()) {
+        uint64_t mask = 1ULL << (low & 63);
+        uint64_t& word = bitmap_[low >> 6];
+        if (word & mask) {
+            return false;
+        }
+        word |= mask;
+        ++cardinality_;
+        return true;
+    }
+
+    auto it = std::lower_bound(array_.begin(), array_.end(), low);
+    if (it != array_.end() && *it == low) {
+        return false;
+    }
+    array_.insert(it, low);
+    ++cardinality_;
+    if (cardinality_ > ARRAY_MAX_SIZE) {
+        ToBitmap();
+    }
+    return true;
+}
+
+bool
+RoaringBitmap::Container::Contains(uint16_t low) const {
+    if (IsBitmap()) {
+        return (bitmap_[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(array_.begin(), array_.end(), low);
+}
+
+void
+RoaringBitmap::Container::ToBitmap() {
+    bitmap_.assign(BITMAP_WORDS, 0);
+    for (auto low : array_) {
+        bitmap_[low >> 6] |= 1ULL << (low & 63);
+    }
+    std::vector<uint16_t>().swap(array_);
+}
+
+void
+RoaringBitmap::Container::Union(const Container& other) {
+    if (!IsBitmap() && !other.IsBitmap() && cardinality_ + other.cardinality_ <= ARRAY_MAX_SIZE) {
+        std::vector<uint16_t> merged;
+        merged.reserve(cardinality_ + other.cardinality_);
+        std::set_union(array_.begin(), array_.end(), other.array_.begin(), other.array_.end(),
+                       std::back_inserter(merged));
+        array_.swap(merged);
+        cardinality_ = array_.size();
+        return;
+    }
+
+    if (!IsBitmap()) {
+        ToBitmap();
+    }
+    if (other.IsBitmap()) {
+        for (uint32_t i = 0; i < BITMAP_WORDS; ++i) {
+            bitmap_[i] |= other.bitmap_[i];
+        }
+    } else {
+        for (auto low : other.array_) {
+            bitmap_[low >> 6] |= 1ULL << (low & 63);
+        }
+    }
+
+    cardinality_ = 0;
+    for (auto word : bitmap_) {
+        cardinality_ += __builtin_popcountll(word);
+    }
+}
+
+RoaringBitmap::Container*
+RoaringBitmap::FindContainer(uint16_t key) {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& container, uint16_t k) { return container.key_ < k; });
+    if (it == containers_.end() || it->key_ != key) {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+const RoaringBitmap::Container*
+RoaringBitmap::FindContainer(uint16_t key) const {
+    return const_cast<RoaringBitmap*>(this)->FindContainer(key);
+}
+
+void
+RoaringBitmap::Add(uint32_t value) {
+    uint16_t key = value >> 16;
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& container, uint16_t k) { return container.key_ < k; });
+    if (it == containers_.end() || it->key_ != key) {
+        Container container;
+        container.key_ = key;
+        it = containers_.insert(it, std::move(container));
+    }
+    it->Add(value & 0xFFFF);
+}
+
+bool
+RoaringBitmap::Contains(uint32_t value) const {
+    auto container = FindContainer(value >> 16);
+    return container != nullptr && container->Contains(value & 0xFFFF);
+}
+
+uint64_t
+RoaringBitmap::Cardinality() const {
+    uint64_t cardinality = 0;
+    for (auto& container : containers_) {
+        cardinality += container.cardinality_;
+    }
+    return cardinality;
+}
+
+void
+RoaringBitmap::Union(const RoaringBitmap& other) {
+    std::vector<Container> merged;
+    merged.reserve(containers_.size() + other.containers_.size());
+
+    auto it = containers_.begin();
+    auto other_it = other.containers_.begin();
+    while (it != containers_.end() || other_it != other.containers_.end()) {
+        if (other_it == other.containers_.end() || (it != containers_.end() && it->key_ < other_it->key_)) {
+            merged.emplace_back(std::move(*it++));
+        } else if (it == containers_.end() || other_it->key_ < it->key_) {
+            merged.emplace_back(*other_it++);
+        } else {
+            it->Union(*other_it++);
+            merged.emplace_back(std::move(*it++));
+        }
+    }
+    containers_.swap(merged);
+}
+
+void
+RoaringBitmap::ForEach(const std::function<void(uint32_t)>& func) const {
+    for (auto& container : containers_) {
+        uint32_t high = static_cast<uint32_t>(container.key_) << 16;
+        if (container.IsBitmap()) {
+            for (uint32_t i = 0; i < BITMAP_WORDS; ++i) {
+                uint64_t word = container.bitmap_[i];
+                while (word != 0) {
+                    uint32_t bit = __builtin_ctzll(word);
+                    func(high | (i << 6) | bit);
+                    word &= word - 1;
+                }
+            }
+        } else {
+            for (auto low : container.array_) {
+                func(high | low);
+            }
+        }
+    }
+}
+
+void
+RoaringBitmap::Serialize(std::vector<uint8_t>& buffer) const {
+    buffer.clear();
+    buffer.reserve(sizeof(uint32_t) + Size());
+    AppendValue(buffer, static_cast<uint32_t>(containers_.size()));
+    for (auto& container : containers_) {
+        AppendValue(buffer, container.key_);
+        AppendValue(buffer, container.IsBitmap() ? BITMAP_CONTAINER : ARRAY_CONTAINER);
+        AppendValue(buffer, container.cardinality_);
+        auto payload = container.IsBitmap() ? reinterpret_cast<const uint8_t*>(container.bitmap_.data())
+                                            : reinterpret_cast<const uint8_t*>(container.array_.data());
+        size_t payload_size = container.IsBitmap() ? BITMAP_WORDS * sizeof(uint64_t)
+                                                   : container.array_.size() * sizeof(uint16_t);
+        buffer.insert(buffer.end(), payload, payload + payload_size);
+    }
+}
+
+bool
+RoaringBitmap::Deserialize(const uint8_t* data, size_t size) {
+    containers_.clear();
+
+    const uint8_t* end = data + size;
+    uint32_t container_count;
+    if (!ReadValue(data, end, container_count)) {
+        return false;
+    }
+
+    std::vector<Container> containers;
+    for (uint32_t i = 0; i < container_count; ++i) {
+        Container container;
+        uint16_t type;
+        if (!ReadValue(data, end, container.key_) || !ReadValue(data, end, type) ||
+            !ReadValue(data, end, container.cardinality_)) {
+            return false;
+        }
+        if (!containers.empty() && containers.back().key_ >= container.key_) {
+            return false;
+        }
+
+        // the stored cardinality must match the decoded values, a torn or corrupted file doesn't decode
+        if (type == BITMAP_CONTAINER) {
+            size_t payload_size = BITMAP_WORDS * sizeof(uint64_t);
+            if (static_cast<size_t>(end - data) < payload_size) {
+                return false;
+            }
+            container.bitmap_.resize(BITMAP_WORDS);
+            memcpy(container.bitmap_.data(), data, payload_size);
+            data += payload_size;
+            uint32_t cardinality = 0;
+            for (auto word : container.bitmap_) {
+                cardinality += __builtin_popcountll(word);
+            }
+            if (cardinality != container.cardinality_) {
+                return false;
+            }
+        } else if (type == ARRAY_CONTAINER && container.cardinality_ > 0 && container.cardinality_ <= ARRAY_MAX_SIZE) {
+            size_t payload_size = container.cardinality_ * sizeof(uint16_t);
+            if (static_cast<size_t>(end - data) < payload_size) {
+                return false;
+            }
+            container.array_.resize(container.cardinality_);
+            memcpy(container.array_.data(), data, payload_size);
+            data += payload_size;
+            if (std::adjacent_find(container.array_.begin(), container.array_.end(), std::greater_equal<uint16_t>()) !=
+                container.array_.end()) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+        containers.emplace_back(std::move(container));
+    }
+    if (data != end) {
+        return false;
+    }
+
+    containers_.swap(containers);
+    return true;
+}
+
+uint32_t
+RoaringBitmap::Maximum() const {
+    if (containers_.empty()) {
+        return 0;
+    }
+    auto& container = containers_.back();
+    uint32_t high = static_cast<uint32_t>(container.key_) << 16;
+    if (!container.IsBitmap()) {
+        return high | container.array_.back();
+    }
+    for (int32_t w = BITMAP_WORDS - 1; w >= 0; --w) {
+        if (container.bitmap_[w] != 0) {
+            return high | (w * 64 + 63 - __builtin_clzll(container.bitmap_[w]));
+        }
+    }
+    return high;
+}
+
+size_t
+RoaringBitmap::Size() const {
+    size_t size = 0;
+    for (auto& container : containers_) {
+        size += sizeof(uint16_t) * 2 + sizeof(uint32_t);
+        size += container.IsBitmap() ? BITMAP_WORDS * sizeof(uint64_t) : container.array_.size() * sizeof(uint16_t);
+    }
+    return size;
+}
+
+}  // namespace segment
+}  // namespace milvus
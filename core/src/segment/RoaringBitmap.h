@@ -0,0 +1,117 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace milvus {
+namespace segment {
+
+// Compressed bitmap of 32-bit values in the style of Roaring: values are partitioned by their high
+// 16 bits, and the low 16 bits of each partition are kept in a sorted array while it is sparse, or in
+// a 65536-bit bitmap once it holds more than ARRAY_MAX_SIZE values.
+class RoaringBitmap {
+ public:
+    static constexpr uint32_t ARRAY_MAX_SIZE = 4096;
+    static constexpr uint32_t BITMAP_WORDS = 1024;
+
+    RoaringBitmap() = default;
+
+    void
+    Add(uint32_t value);
+
+    bool
+    Contains(uint32_t value) const;
+
+    // number of values in the bitmap
+    uint64_t
+    Cardinality() const;
+
+    // largest value in the bitmap, 0 if it is empty
+    uint32_t
+    Maximum() const;
+
+    bool
+    Empty() const {
+        return containers_.empty();
+    }
+
+    void
+    Clear() {
+        containers_.clear();
+    }
+
+    // add all values of 'other' to this bitmap
+    void
+    Union(const RoaringBitmap& other);
+
+    // visit all values in ascending order
+    void
+    ForEach(const std::function<void(uint32_t)>& func) const;
+
+    void
+    Serialize(std::vector<uint8_t>& buffer) const;
+
+    // return false if the buffer is not a valid serialized bitmap
+    bool
+    Deserialize(const uint8_t* data, size_t size);
+
+    // bytes used by the containers
+    size_t
+    Size() const;
+
+ private:
+    struct Container {
+        uint16_t key_ = 0;
+        uint32_t cardinality_ = 0;
+        std::vector<uint16_t> array_;
+        std::vector<uint64_t> bitmap_;
+
+        bool
+        IsBitmap() const {
+            return !bitmap_.empty();
+        }
+
+        bool
+        Add(uint16_t low);
+
+        bool
+        Contains(uint16_t low) const;
+
+        void
+        ToBitmap();
+
+        void
+        Union(const Container& other);
+    };
+
+    Container*
+    FindContainer(uint16_t key);
+
+    const Container*
+    FindContainer(uint16_t key) const;
+
+ private:
+    // sorted by key
+    std::vector<Container> containers_;
+};
+
+}  // namespace segment
+}  // namespace milvus
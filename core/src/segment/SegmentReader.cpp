@@ -17,9 +17,11 @@
 
 #include "segment/SegmentReader.h"
 
+#include <boost/filesystem.hpp>
 #include <memory>
 
 #include "Vectors.h"
+#include "cache/IdCacheMgr.h"
 #include "codecs/default/DefaultCodec.h"
 #include "storage/disk/DiskIOReader.h"
 #include "storage/disk/DiskIOWriter.h"
@@ -54,6 +56,16 @@ SegmentReader::Load() {
     } catch (std::exception& e) {
         return Status(DB_ERROR, e.what());
     }
+
+    // the deleted docs are offsets of the segment
+    auto& deleted_docs = segment_ptr_->deleted_docs_ptr_->GetBitmap();
+    size_t count = segment_ptr_->vectors_ptr_->GetUids().size();
+    if (deleted_docs.Cardinality() > count || (!deleted_docs.Empty() && deleted_docs.Maximum() >= count)) {
+        std::string err_msg = "Deleted docs don't match the " + std::to_string(count) + " docs of segment " +
+                              fs_ptr_->operation_ptr_->GetDirectory();
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
     return Status::OK();
 }
 
@@ -71,6 +83,25 @@ SegmentReader::LoadVectors(off_t offset, size_t num_bytes, std::vector<uint8_t>&
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadVectorsMapped(MappedVectorsPtr& mapped_vectors) {
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorsFormat()->read_vectors_mapped(fs_ptr_, mapped_vectors);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to map raw vectors: " + std::string(e.what());
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    if (mapped_vectors == nullptr) {
+        std::string err_msg = "No raw vectors file to map";
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentReader::LoadUids(std::vector<doc_id_t>& uids) {
     codec::DefaultCodec default_codec;
@@ -93,6 +124,14 @@ SegmentReader::GetSegment(SegmentPtr& segment_ptr) {
 
 Status
 SegmentReader::LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
+    // the bloom filter of a segment never changes, deleted ids are filtered by the deleted docs
+    std::string cache_key = IdBloomFilter::CacheKey(fs_ptr_->operation_ptr_->GetDirectory());
+    id_bloom_filter_ptr =
+        std::static_pointer_cast<IdBloomFilter>(cache::IdCacheMgr::GetInstance()->GetItem(cache_key));
+    if (id_bloom_filter_ptr != nullptr) {
+        return Status::OK();
+    }
+
     codec::DefaultCodec default_codec;
     try {
         fs_ptr_->operation_ptr_->CreateDirectory();
@@ -102,6 +141,8 @@ SegmentReader::LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr) {
         ENGINE_LOG_ERROR << err_msg;
         return Status(DB_ERROR, err_msg);
     }
+
+    cache::IdCacheMgr::GetInstance()->InsertItem(cache_key, id_bloom_filter_ptr);
     return Status::OK();
 }
 
@@ -119,5 +160,56 @@ SegmentReader::LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr) {
     return Status::OK();
 }
 
+Status
+SegmentReader::LoadIdIndex(segment::IdIndexPtr& id_index_ptr) {
+    std::string cache_key = IdIndex::CacheKey(fs_ptr_->operation_ptr_->GetDirectory());
+    id_index_ptr = std::static_pointer_cast<IdIndex>(cache::IdCacheMgr::GetInstance()->GetItem(cache_key));
+    if (id_index_ptr != nullptr) {
+        return Status::OK();
+    }
+
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        if (boost::filesystem::exists(cache_key)) {
+            default_codec.GetIdIndexFormat()->read(fs_ptr_, id_index_ptr);
+        } else {
+            std::vector<doc_id_t> uids;
+            default_codec.GetVectorsFormat()->read_uids(fs_ptr_, uids);
+            id_index_ptr = std::make_shared<IdIndex>(uids);
+        }
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load id index: " + std::string(e.what());
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+
+    cache::IdCacheMgr::GetInstance()->InsertItem(cache_key, id_index_ptr);
+    return Status::OK();
+}
+
+Status
+SegmentReader::LoadVectorsIndex(segment::VectorIndexPtr& vector_index_ptr) {
+    vector_index_ptr = nullptr;
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        if (default_codec.GetVectorsIndexFormat()->exists(fs_ptr_)) {
+            default_codec.GetVectorsIndexFormat()->read(fs_ptr_, vector_index_ptr);
+        }
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to load vectors index: " + std::string(e.what());
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(DB_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
+bool
+SegmentReader::HasVectorsIndex() {
+    codec::DefaultCodec default_codec;
+    return default_codec.GetVectorsIndexFormat()->exists(fs_ptr_);
+}
+
 }  // namespace segment
 }  // namespace milvus
@@ -21,7 +21,9 @@
 #include <string>
 #include <vector>
 
+#include "segment/MappedVectors.h"
 #include "segment/Types.h"
+#include "segment/VectorIndex.h"
 #include "storage/FSHandler.h"
 #include "utils/Status.h"
 
@@ -45,12 +47,28 @@ class SegmentReader {
     Status
     LoadUids(std::vector<doc_id_t>& uids);
 
+    // map raw vectors into memory, they are read from page cache on access
+    Status
+    LoadVectorsMapped(MappedVectorsPtr& mapped_vectors);
+
     Status
     LoadBloomFilter(segment::IdBloomFilterPtr& id_bloom_filter_ptr);
 
     Status
     LoadDeletedDocs(segment::DeletedDocsPtr& deleted_docs_ptr);
 
+    // the id index is shared through IdCacheMgr (cache_config.id_cache_capacity), it is built from the uids
+    // for segments written without one
+    Status
+    LoadIdIndex(segment::IdIndexPtr& id_index_ptr);
+
+    // vector_index_ptr is nullptr if the segment has no checkpoint of its vector index
+    Status
+    LoadVectorsIndex(segment::VectorIndexPtr& vector_index_ptr);
+
+    bool
+    HasVectorsIndex();
+
     Status
     GetSegment(SegmentPtr& segment_ptr);
 
@@ -19,6 +19,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "SegmentReader.h"
 #include "Vectors.h"
@@ -31,6 +33,13 @@
 namespace milvus {
 namespace segment {
 
+namespace {
+
+// bytes of vectors copied at a time by merge
+constexpr size_t MERGE_CHUNK_SIZE = 64 * 1024 * 1024;
+
+}  // namespace
+
 SegmentWriter::SegmentWriter(const std::string& directory) {
     storage::IOReaderPtr reader_ptr = std::make_shared<storage::DiskIOReader>();
     storage::IOWriterPtr writer_ptr = std::make_shared<storage::DiskIOWriter>();
@@ -42,8 +51,14 @@ SegmentWriter::SegmentWriter(const std::string& directory) {
 Status
 SegmentWriter::AddVectors(const std::string& name, const std::vector<uint8_t>& data,
                           const std::vector<doc_id_t>& uids) {
-    segment_ptr_->vectors_ptr_->AddData(data);
-    segment_ptr_->vectors_ptr_->AddUids(uids);
+    return AddVectors(name, data.data(), data.size(), uids.data(), uids.size());
+}
+
+Status
+SegmentWriter::AddVectors(const std::string& name, const uint8_t* data, size_t size, const doc_id_t* uids,
+                          size_t count) {
+    segment_ptr_->vectors_ptr_->AddData(data, size);
+    segment_ptr_->vectors_ptr_->AddUids(uids, count);
     segment_ptr_->vectors_ptr_->SetName(name);
 
     return Status::OK();
@@ -64,14 +79,28 @@ SegmentWriter::Serialize() {
 
     start = std::chrono::high_resolution_clock::now();
 
-    status = WriteVectors();
+    // merged vectors are already written
+    if (!merged_) {
+        status = WriteVectors();
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
+    end = std::chrono::high_resolution_clock::now();
+    diff = end - start;
+    ENGINE_LOG_DEBUG << "Writing vectors and uids took " << diff.count() << " s in total";
+
+    start = std::chrono::high_resolution_clock::now();
+
+    status = WriteIdIndex();
     if (!status.ok()) {
         return status;
     }
 
     end = std::chrono::high_resolution_clock::now();
     diff = end - start;
-    ENGINE_LOG_DEBUG << "Writing vectors and uids took " << diff.count() << " s in total";
+    ENGINE_LOG_DEBUG << "Writing id index took " << diff.count() << " s in total";
 
     start = std::chrono::high_resolution_clock::now();
 
@@ -107,7 +136,8 @@ SegmentWriter::WriteBloomFilter() {
 
         auto start = std::chrono::high_resolution_clock::now();
 
-        default_codec.GetIdBloomFilterFormat()->create(fs_ptr_, segment_ptr_->id_bloom_filter_ptr_);
+        auto& uids = segment_ptr_->vectors_ptr_->GetUids();
+        default_codec.GetIdBloomFilterFormat()->create(fs_ptr_, uids.size(), segment_ptr_->id_bloom_filter_ptr_);
 
         auto end = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> diff = end - start;
@@ -115,7 +145,6 @@ SegmentWriter::WriteBloomFilter() {
 
         start = std::chrono::high_resolution_clock::now();
 
-        auto& uids = segment_ptr_->vectors_ptr_->GetUids();
         for (auto& uid : uids) {
             segment_ptr_->id_bloom_filter_ptr_->Add(uid);
         }
@@ -154,6 +183,21 @@ SegmentWriter::WriteDeletedDocs() {
     return Status::OK();
 }
 
+Status
+SegmentWriter::WriteIdIndex() {
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        segment_ptr_->id_index_ptr_ = std::make_shared<IdIndex>(segment_ptr_->vectors_ptr_->GetUids());
+        default_codec.GetIdIndexFormat()->write(fs_ptr_, segment_ptr_->id_index_ptr_);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write id index: " + std::string(e.what());
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentWriter::WriteDeletedDocs(const DeletedDocsPtr& deleted_docs) {
     codec::DefaultCodec default_codec;
@@ -182,6 +226,20 @@ SegmentWriter::WriteBloomFilter(const IdBloomFilterPtr& id_bloom_filter_ptr) {
     return Status::OK();
 }
 
+Status
+SegmentWriter::WriteVectorsIndex(const VectorIndexPtr& vector_index_ptr) {
+    codec::DefaultCodec default_codec;
+    try {
+        fs_ptr_->operation_ptr_->CreateDirectory();
+        default_codec.GetVectorsIndexFormat()->write(fs_ptr_, vector_index_ptr);
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to write vectors index: " + std::string(e.what());
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
+    return Status::OK();
+}
+
 Status
 SegmentWriter::Cache() {
     // TODO(zhiru)
@@ -204,40 +262,79 @@ SegmentWriter::Merge(const std::string& dir_to_merge, const std::string& name) {
 
     auto start = std::chrono::high_resolution_clock::now();
 
+    // the vectors to merge are mapped, not loaded, and copied to the merged segment chunk by chunk,
+    // so the memory used is one chunk and the uids whatever the size of the segments
     SegmentReader segment_reader_to_merge(dir_to_merge);
-    bool in_cache;
-    auto status = segment_reader_to_merge.LoadCache(in_cache);
-    if (!in_cache) {
-        status = segment_reader_to_merge.Load();
-        if (!status.ok()) {
-            std::string msg = "Failed to load segment from " + dir_to_merge;
-            ENGINE_LOG_ERROR << msg;
-            return Status(DB_ERROR, msg);
-        }
+    std::vector<doc_id_t> uids;
+    DeletedDocsPtr deleted_docs_ptr;
+    MappedVectorsPtr mapped_vectors;
+    auto status = segment_reader_to_merge.LoadUids(uids);
+    if (status.ok() && !uids.empty()) {
+        status = segment_reader_to_merge.LoadDeletedDocs(deleted_docs_ptr);
+    }
+    if (status.ok() && !uids.empty()) {
+        status = segment_reader_to_merge.LoadVectorsMapped(mapped_vectors);
+    }
+    if (status.ok() && !uids.empty() && mapped_vectors->GetDataSize() % uids.size() != 0) {
+        status = Status(DB_ERROR, "Raw vectors don't match " + std::to_string(uids.size()) + " uids");
+    }
+    if (!status.ok()) {
+        std::string msg = "Failed to load segment from " + dir_to_merge;
+        ENGINE_LOG_ERROR << msg;
+        return Status(DB_ERROR, msg);
     }
-    SegmentPtr segment_to_merge;
-    segment_reader_to_merge.GetSegment(segment_to_merge);
-    auto& uids = segment_to_merge->vectors_ptr_->GetUids();
 
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> diff = end - start;
-    ENGINE_LOG_DEBUG << "Loading segment took " << diff.count() << " s";
-
-    if (segment_to_merge->deleted_docs_ptr_ != nullptr) {
-        auto offsets_to_delete = segment_to_merge->deleted_docs_ptr_->GetDeletedDocs();
-
-        // Erase from raw data
-        segment_to_merge->vectors_ptr_->Erase(offsets_to_delete);
-    }
+    ENGINE_LOG_DEBUG << "Loading uids and deleted docs took " << diff.count() << " s";
 
     start = std::chrono::high_resolution_clock::now();
 
-    AddVectors(name, segment_to_merge->vectors_ptr_->GetData(), segment_to_merge->vectors_ptr_->GetUids());
+    codec::DefaultCodec default_codec;
+    try {
+        if (!merged_) {
+            // create the files of the merged segment, vectors are appended to them
+            fs_ptr_->operation_ptr_->CreateDirectory();
+            auto vectors_ptr = std::make_shared<Vectors>();
+            vectors_ptr->SetName(name);
+            default_codec.GetVectorsFormat()->write(fs_ptr_, vectors_ptr);
+            segment_ptr_->vectors_ptr_->SetName(name);
+            merged_ = true;
+        }
+
+        if (!uids.empty()) {
+            size_t code_length = mapped_vectors->GetDataSize() / uids.size();
+            size_t chunk_count = std::max<size_t>(MERGE_CHUNK_SIZE / std::max<size_t>(code_length, 1), 1);
+            const uint8_t* data = mapped_vectors->GetData();
+
+            std::vector<uint8_t> chunk_data;
+            std::vector<doc_id_t> chunk_uids;
+            chunk_data.reserve(std::min(chunk_count, uids.size()) * code_length);
+            chunk_uids.reserve(std::min(chunk_count, uids.size()));
+            for (size_t i = 0; i < uids.size(); ++i) {
+                if (deleted_docs_ptr == nullptr || !deleted_docs_ptr->IsDeleted(i)) {
+                    chunk_data.insert(chunk_data.end(), data + i * code_length, data + (i + 1) * code_length);
+                    chunk_uids.push_back(uids[i]);
+                }
+                if (chunk_uids.size() == chunk_count || (i + 1 == uids.size() && !chunk_uids.empty())) {
+                    default_codec.GetVectorsFormat()->append(fs_ptr_, name, chunk_data.data(), chunk_data.size(),
+                                                             chunk_uids.data(), chunk_uids.size());
+                    segment_ptr_->vectors_ptr_->AddUids(chunk_uids);
+                    merged_size_ += chunk_data.size();
+                    chunk_data.clear();
+                    chunk_uids.clear();
+                }
+            }
+        }
+    } catch (std::exception& e) {
+        std::string err_msg = "Failed to merge vectors: " + std::string(e.what());
+        ENGINE_LOG_ERROR << err_msg;
+        return Status(SERVER_WRITE_ERROR, err_msg);
+    }
 
     end = std::chrono::high_resolution_clock::now();
     diff = end - start;
-    ENGINE_LOG_DEBUG << "Adding " << segment_to_merge->vectors_ptr_->GetCount() << " vectors and uids took "
-                     << diff.count() << " s";
+    ENGINE_LOG_DEBUG << "Merging " << uids.size() << " vectors and uids took " << diff.count() << " s";
 
     ENGINE_LOG_DEBUG << "Merging completed from " << dir_to_merge << " to " << fs_ptr_->operation_ptr_->GetDirectory();
 
@@ -247,7 +344,7 @@ SegmentWriter::Merge(const std::string& dir_to_merge, const std::string& name) {
 size_t
 SegmentWriter::Size() {
     // TODO(zhiru): switch to actual directory size
-    size_t ret = segment_ptr_->vectors_ptr_->Size();
+    size_t ret = segment_ptr_->vectors_ptr_->Size() + merged_size_;
     /*
     if (segment_ptr_->id_bloom_filter_ptr_) {
         ret += segment_ptr_->id_bloom_filter_ptr_->Size();
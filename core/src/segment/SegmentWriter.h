@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "segment/Types.h"
+#include "segment/VectorIndex.h"
 #include "storage/FSHandler.h"
 #include "utils/Status.h"
 
@@ -35,12 +36,20 @@ class SegmentWriter {
     Status
     AddVectors(const std::string& name, const std::vector<uint8_t>& data, const std::vector<doc_id_t>& uids);
 
+    // append 'count' vectors of 'size' bytes in total, copied from the caller's buffers
+    Status
+    AddVectors(const std::string& name, const uint8_t* data, size_t size, const doc_id_t* uids, size_t count);
+
     Status
     WriteBloomFilter(const IdBloomFilterPtr& bloom_filter_ptr);
 
     Status
     WriteDeletedDocs(const DeletedDocsPtr& deleted_docs);
 
+    // checkpoint of the vector index of the segment, it replaces an earlier checkpoint
+    Status
+    WriteVectorsIndex(const VectorIndexPtr& vector_index_ptr);
+
     Status
     Serialize();
 
@@ -50,6 +59,8 @@ class SegmentWriter {
     Status
     GetSegment(SegmentPtr& segment_ptr);
 
+    // append the vectors of another segment except the deleted ones, they are written to the files of this segment
+    // right away, Serialize() writes the rest; not to be used with AddVectors on the same writer
     Status
     Merge(const std::string& segment_dir_to_merge, const std::string& name);
 
@@ -69,9 +80,16 @@ class SegmentWriter {
     Status
     WriteDeletedDocs();
 
+    Status
+    WriteIdIndex();
+
  private:
     storage::FSHandlerPtr fs_ptr_;
     SegmentPtr segment_ptr_;
+
+    // vectors of the merged segments are in the files, only their uids are kept in segment_ptr_
+    bool merged_ = false;
+    size_t merged_size_ = 0;
 };
 
 using SegmentWriterPtr = std::shared_ptr<SegmentWriter>;
@@ -21,6 +21,7 @@
 
 #include "segment/DeletedDocs.h"
 #include "segment/IdBloomFilter.h"
+#include "segment/IdIndex.h"
 #include "segment/Vectors.h"
 
 namespace milvus {
@@ -32,6 +33,7 @@ struct Segment {
     VectorsPtr vectors_ptr_ = std::make_shared<Vectors>();
     DeletedDocsPtr deleted_docs_ptr_ = nullptr;
     IdBloomFilterPtr id_bloom_filter_ptr_ = nullptr;
+    IdIndexPtr id_index_ptr_ = nullptr;
 };
 
 using SegmentPtr = std::shared_ptr<Segment>;
@@ -15,40 +15,24 @@
 // specific language governing permissions and limitations
 // under the License.
 
-#pragma once
-
-#include <gtest/gtest.h>
-
-#define CAPACITY 1000000
-#define ERROR_RATE .05
-
-static const char* bloom_file = "/tmp/bloom_file.bin";
-
-struct stats {
-    int true_positives;
-    int true_negatives;
-    int false_positives;
-    int false_negatives;
-};
-
-enum {
-    TEST_PASS,
-    TEST_WARN,
-    TEST_FAIL,
-};
-
-class DabloomsTest : public ::testing::Test {
-protected:
-    void
-    SetUp() override;
-    void
-    TearDown() override;
-
-    static void
-    bloom_score(int positive,
-                int should_positive,
-                struct stats *stats);
-
-    static int
-    print_results(struct stats *stats);
-};
\ No newline at end of file
+#include "segment/VectorIndex.h"
+
+namespace milvus {
+namespace segment {
+
+int64_t
+VectorIndex::Size() const {
+    int64_t size = 0;
+    for (auto& pair : binary_set_.binary_map_) {
+        size += pair.second->size;
+    }
+    return size;
+}
+
+std::string
+VectorIndex::CacheKey(const std::string& segment_dir) {
+    return segment_dir + "/vectors_index";
+}
+
+}  // namespace segment
+}  // namespace milvus
@@ -18,18 +18,31 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <utility>
 
-#include "index/knowhere/knowhere/index/Index.h"
+#include "knowhere/common/BinarySet.h"
 
 namespace milvus {
 namespace segment {
 
+// serialized vector index of a segment, a checkpoint of an index that grows with the segment
 class VectorIndex {
  public:
-    explicit VectorIndex(knowhere::IndexPtr index_ptr);
+    explicit VectorIndex(knowhere::BinarySet binary_set) : binary_set_(std::move(binary_set)) {
+    }
 
-    void
-    Get(knowhere::IndexPtr& index_ptr);
+    const knowhere::BinarySet&
+    GetBinarySet() const {
+        return binary_set_;
+    }
+
+    int64_t
+    Size() const;
+
+    // key of the vector index of a segment in the cpu cache
+    static std::string
+    CacheKey(const std::string& segment_dir);
 
     // No copy and move
     VectorIndex(const VectorIndex&) = delete;
@@ -41,7 +54,7 @@ class VectorIndex {
     operator=(VectorIndex&&) = delete;
 
  private:
-    knowhere::IndexPtr index_ptr_;
+    knowhere::BinarySet binary_set_;
 };
 
 using VectorIndexPtr = std::shared_ptr<VectorIndex>;
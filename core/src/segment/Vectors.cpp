@@ -32,16 +32,25 @@ Vectors::Vectors(std::vector<uint8_t> data, std::vector<doc_id_t> uids, const st
     : data_(std::move(data)), uids_(std::move(uids)), name_(name) {
 }
 
+// no exact reserve before appending, it would reallocate the whole buffer on every insert
 void
 Vectors::AddData(const std::vector<uint8_t>& data) {
-    data_.reserve(data_.size() + data.size());
-    data_.insert(data_.end(), std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
+    AddData(data.data(), data.size());
+}
+
+void
+Vectors::AddData(const uint8_t* data, size_t size) {
+    data_.insert(data_.end(), data, data + size);
 }
 
 void
 Vectors::AddUids(const std::vector<doc_id_t>& uids) {
-    uids_.reserve(uids_.size() + uids.size());
-    uids_.insert(uids_.end(), std::make_move_iterator(uids.begin()), std::make_move_iterator(uids.end()));
+    AddUids(uids.data(), uids.size());
+}
+
+void
+Vectors::AddUids(const doc_id_t* uids, size_t count) {
+    uids_.insert(uids_.end(), uids, uids + count);
 }
 
 void
@@ -35,9 +35,15 @@ class Vectors {
     void
     AddData(const std::vector<uint8_t>& data);
 
+    void
+    AddData(const uint8_t* data, size_t size);
+
     void
     AddUids(const std::vector<doc_id_t>& uids);
 
+    void
+    AddUids(const doc_id_t* uids, size_t count);
+
     void
     SetName(const std::string& name);
 
@@ -44,6 +44,26 @@ DBWrapper::StartService() {
         return s;
     }
 
+    s = config.GetDBConfigMergePolicy(opt.merge_policy_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
+    int64_t merge_io_rate_limit;
+    s = config.GetDBConfigMergeIORateLimit(merge_io_rate_limit);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+    opt.merge_io_rate_limit_ = merge_io_rate_limit * engine::ONE_MB;
+
+    s = config.GetDBConfigMetaSnapshotInterval(opt.meta_.snapshot_interval_);
+    if (!s.ok()) {
+        std::cerr << s.ToString() << std::endl;
+        return s;
+    }
+
     std::string path;
     s = config.GetStorageConfigPrimaryPath(path);
     if (!s.ok()) {
@@ -111,6 +131,13 @@ DBWrapper::StartService() {
             kill(0, SIGUSR1);
         }
 
+        s = config.GetWalConfigDurability(opt.durability_);
+        if (!s.ok()) {
+            std::cerr << "ERROR! Failed to get durability configuration." << std::endl;
+            std::cerr << s.ToString() << std::endl;
+            kill(0, SIGUSR1);
+        }
+
         s = config.GetWalConfigWalPath(opt.mxlog_path_);
         if (!s.ok()) {
             std::cerr << "ERROR! Failed to get mxlog_path configuration." << std::endl;
@@ -10,17 +10,25 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "server/delivery/RequestScheduler.h"
+#include "config/Config.h"
 #include "utils/Log.h"
 
 #include <fiu-local.h>
 #include <unistd.h>
+#include <algorithm>
 #include <utility>
 
 namespace milvus {
 namespace server {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-RequestScheduler::RequestScheduler() : stopped_(false) {
+namespace {
+constexpr int64_t DDL_DML_GROUP_PRIORITY = 2;
+constexpr int64_t INFO_GROUP_PRIORITY = 1;
+constexpr int64_t DQL_GROUP_PRIORITY = 0;
+}  // namespace
+
+RequestScheduler::RequestScheduler() : stopped_(true) {
     Start();
 }
 
@@ -44,37 +52,49 @@ RequestScheduler::ExecRequest(BaseRequestPtr& request_ptr) {
 
 void
 RequestScheduler::Start() {
+    std::lock_guard<std::mutex> lock(queue_mtx_);
     if (!stopped_) {
         return;
     }
 
+    Config& config = Config::GetInstance();
+    worker_num_ = 8;
+    config.GetServerConfigRequestWorkerNum(worker_num_);
+    dql_max_in_flight_ = 6;
+    config.GetServerConfigDqlMaxInFlight(dql_max_in_flight_);
+    dql_max_in_flight_ = std::min(dql_max_in_flight_, worker_num_);
+    dql_max_queue_ = 1024;
+    config.GetServerConfigDqlMaxQueue(dql_max_queue_);
+
+    for (int64_t i = 0; i < worker_num_; ++i) {
+        execute_threads_.push_back(std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this));
+    }
     stopped_ = false;
+    SERVER_LOG_INFO << "Scheduler started with " << worker_num_ << " workers";
 }
 
 void
 RequestScheduler::Stop() {
-    if (stopped_ && request_groups_.empty() && execute_threads_.empty()) {
-        return;
-    }
-
-    SERVER_LOG_INFO << "Scheduler gonna stop...";
     {
         std::lock_guard<std::mutex> lock(queue_mtx_);
-        for (auto& iter : request_groups_) {
-            if (iter.second != nullptr) {
-                iter.second->Put(nullptr);
-            }
+        if (stopped_) {
+            return;
         }
+        stopped_ = true;
     }
 
+    SERVER_LOG_INFO << "Scheduler gonna stop...";
+    // workers exit after all waiting requests are executed
+    queue_cv_.notify_all();
     for (auto& iter : execute_threads_) {
         if (iter == nullptr)
             continue;
         iter->join();
     }
+
+    std::lock_guard<std::mutex> lock(queue_mtx_);
     request_groups_.clear();
     execute_threads_.clear();
-    stopped_ = true;
     SERVER_LOG_INFO << "Scheduler stopped";
 }
 
@@ -89,6 +109,7 @@ RequestScheduler::ExecuteRequest(const BaseRequestPtr& request_ptr) {
 
     if (!status.ok()) {
         SERVER_LOG_ERROR << "Put request to queue failed with code: " << status.ToString();
+        request_ptr->Reject(status);
         return status;
     }
 
@@ -99,15 +120,18 @@ RequestScheduler::ExecuteRequest(const BaseRequestPtr& request_ptr) {
 }
 
 void
-RequestScheduler::TakeToExecute(RequestQueuePtr request_queue) {
-    if (request_queue == nullptr) {
-        return;
-    }
-
+RequestScheduler::TakeToExecute() {
     while (true) {
-        BaseRequestPtr request = request_queue->Take();
+        BaseRequestPtr request;
+        RequestGroupPtr group;
+        {
+            std::unique_lock<std::mutex> lock(queue_mtx_);
+            queue_cv_.wait(lock, [&] {
+                request = PickRequest(group);
+                return request != nullptr || (stopped_ && queued_num_ == 0);
+            });
+        }
         if (request == nullptr) {
-            SERVER_LOG_ERROR << "Take null from request queue, stop thread";
             break;  // stop the thread
         }
 
@@ -122,32 +146,95 @@ RequestScheduler::TakeToExecute(RequestQueuePtr request_queue) {
         } catch (std::exception& ex) {
             SERVER_LOG_ERROR << "Request failed to execute: " << ex.what();
         }
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mtx_);
+            --group->in_flight_;
+        }
+        // the next request of this group may be runnable now
+        queue_cv_.notify_one();
     }
 }
 
 Status
 RequestScheduler::PutToQueue(const BaseRequestPtr& request_ptr) {
     std::lock_guard<std::mutex> lock(queue_mtx_);
+    if (stopped_) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Request scheduler is stopped");
+    }
 
     std::string group_name = request_ptr->RequestGroup();
-    if (request_groups_.count(group_name) > 0) {
-        request_groups_[group_name]->Put(request_ptr);
+    RequestGroupPtr group;
+    auto iter = request_groups_.find(group_name);
+    if (iter != request_groups_.end()) {
+        group = iter->second;
     } else {
-        RequestQueuePtr queue = std::make_shared<RequestQueue>();
-        queue->Put(request_ptr);
-        request_groups_.insert(std::make_pair(group_name, queue));
-        fiu_do_on("RequestScheduler.PutToQueue.null_queue", queue = nullptr);
-
-        // start a thread
-        ThreadPtr thread = std::make_shared<std::thread>(&RequestScheduler::TakeToExecute, this, queue);
+        group = CreateGroup(group_name);
+        request_groups_.insert(std::make_pair(group_name, group));
+    }
 
-        fiu_do_on("RequestScheduler.PutToQueue.push_null_thread", execute_threads_.push_back(nullptr));
-        execute_threads_.push_back(thread);
-        SERVER_LOG_INFO << "Create new thread for request group: " << group_name;
+    // admission control, reject instead of letting the waiting time grow without limit
+    if (group->max_queue_ > 0 && static_cast<int64_t>(group->queue_.size()) >= group->max_queue_) {
+        std::string msg = "Too many requests waiting in group " + group_name + ", limit is " +
+                          std::to_string(group->max_queue_) + ", please retry later";
+        return Status(SERVER_REQUEST_QUEUE_FULL, msg);
     }
 
+    group->queue_.push(std::make_pair(++request_seq_, request_ptr));
+    ++queued_num_;
+    queue_cv_.notify_one();
+
     return Status::OK();
 }
 
+RequestGroupPtr
+RequestScheduler::CreateGroup(const std::string& group_name) {
+    auto group = std::make_shared<RequestGroup>();
+    group->name_ = group_name;
+    if (group_name == DDL_DML_REQUEST_GROUP) {
+        // executed one by one to keep the order of table changes and inserts
+        group->priority_ = DDL_DML_GROUP_PRIORITY;
+        group->max_in_flight_ = 1;
+    } else if (group_name == INFO_REQUEST_GROUP) {
+        group->priority_ = INFO_GROUP_PRIORITY;
+        group->max_in_flight_ = worker_num_;
+    } else if (group_name == DQL_REQUEST_GROUP) {
+        group->priority_ = DQL_GROUP_PRIORITY;
+        group->max_in_flight_ = dql_max_in_flight_;
+        group->max_queue_ = dql_max_queue_;
+    }
+
+    SERVER_LOG_INFO << "Create request group: " << group_name << ", priority: " << group->priority_
+                    << ", max in flight: " << group->max_in_flight_ << ", max queue: " << group->max_queue_;
+    return group;
+}
+
+BaseRequestPtr
+RequestScheduler::PickRequest(RequestGroupPtr& group) {
+    RequestGroupPtr picked;
+    for (auto& iter : request_groups_) {
+        auto& candidate = iter.second;
+        if (candidate->queue_.empty() || candidate->in_flight_ >= candidate->max_in_flight_) {
+            continue;
+        }
+        // higher priority first, the earlier request among groups of the same priority
+        if (picked == nullptr || candidate->priority_ > picked->priority_ ||
+            (candidate->priority_ == picked->priority_ &&
+             candidate->queue_.front().first < picked->queue_.front().first)) {
+            picked = candidate;
+        }
+    }
+    if (picked == nullptr) {
+        return nullptr;
+    }
+
+    BaseRequestPtr request = picked->queue_.front().second;
+    picked->queue_.pop();
+    ++picked->in_flight_;
+    --queued_num_;
+    group = picked;
+    return request;
+}
+
 }  // namespace server
 }  // namespace milvus
@@ -12,22 +12,41 @@
 #pragma once
 
 #include "server/delivery/request/BaseRequest.h"
-#include "utils/BlockingQueue.h"
 #include "utils/Status.h"
 
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <queue>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace milvus {
 namespace server {
 
-using RequestQueue = BlockingQueue<BaseRequestPtr>;
-using RequestQueuePtr = std::shared_ptr<RequestQueue>;
 using ThreadPtr = std::shared_ptr<std::thread>;
 
+// Requests waiting for a worker, grouped by BaseRequest::RequestGroup().
+// A group never runs more than max_in_flight_ requests at the same time, a group with max_in_flight_ 1
+// executes its requests one by one in arrival order. When workers are scarce, the runnable group with the
+// highest priority_ is served first, and requests arriving at a group already holding max_queue_ waiting
+// requests are rejected, 0 means no limit.
+struct RequestGroup {
+    std::string name_;
+    int64_t priority_ = 0;
+    int64_t max_in_flight_ = 1;
+    int64_t max_queue_ = 0;
+
+    int64_t in_flight_ = 0;
+    // (arrival sequence, request)
+    std::queue<std::pair<uint64_t, BaseRequestPtr>> queue_;
+};
+
+using RequestGroupPtr = std::shared_ptr<RequestGroup>;
+
 class RequestScheduler {
  public:
     static RequestScheduler&
@@ -54,17 +73,30 @@ class RequestScheduler {
     virtual ~RequestScheduler();
 
     void
-    TakeToExecute(RequestQueuePtr request_queue);
+    TakeToExecute();
 
     Status
     PutToQueue(const BaseRequestPtr& request_ptr);
 
+    RequestGroupPtr
+    CreateGroup(const std::string& group_name);
+
+    // the next request to execute, the caller must hold queue_mtx_
+    BaseRequestPtr
+    PickRequest(RequestGroupPtr& group);
+
  private:
     mutable std::mutex queue_mtx_;
+    std::condition_variable queue_cv_;
 
-    std::map<std::string, RequestQueuePtr> request_groups_;
+    std::map<std::string, RequestGroupPtr> request_groups_;
+    uint64_t request_seq_ = 0;
+    int64_t queued_num_ = 0;
 
     std::vector<ThreadPtr> execute_threads_;
+    int64_t worker_num_ = 0;
+    int64_t dql_max_in_flight_ = 0;
+    int64_t dql_max_queue_ = 0;
 
     bool stopped_;
 };
@@ -0,0 +1,123 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "server/delivery/SearchBatcher.h"
+#include "config/Config.h"
+#include "metrics/Metrics.h"
+#include "utils/Log.h"
+
+#include <chrono>
+#include <exception>
+#include <string>
+
+namespace milvus {
+namespace server {
+
+Status
+SearchBatcher::Search(const std::string& key, int64_t topk, const engine::VectorsData& vectors,
+                      const QueryFunc& query, engine::ResultIds& result_ids,
+                      engine::ResultDistances& result_distances) {
+    Config& config = Config::GetInstance();
+    int64_t max_nq = 64, max_wait = 0;
+    config.GetEngineConfigSearchBatchMaxNq(max_nq);
+    config.GetEngineConfigSearchBatchMaxWait(max_wait);
+
+    uint64_t nq = vectors.vector_count_;
+    if (max_wait <= 0 || nq >= static_cast<uint64_t>(max_nq)) {
+        return query(vectors, result_ids, result_distances);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // join a batch of the same key if it has room for the vectors
+    auto iter = open_batches_.find(key);
+    if (iter != open_batches_.end() && iter->second->vectors_.vector_count_ + nq <= static_cast<uint64_t>(max_nq)) {
+        BatchPtr batch = iter->second;
+        uint64_t offset = batch->vectors_.vector_count_;
+        auto& batch_vectors = batch->vectors_;
+        batch_vectors.float_data_.insert(batch_vectors.float_data_.end(), vectors.float_data_.begin(),
+                                         vectors.float_data_.end());
+        batch_vectors.binary_data_.insert(batch_vectors.binary_data_.end(), vectors.binary_data_.begin(),
+                                          vectors.binary_data_.end());
+        batch_vectors.vector_count_ += nq;
+        batch->search_count_++;
+        if (batch_vectors.vector_count_ >= static_cast<uint64_t>(max_nq)) {
+            open_batches_.erase(iter);
+            batch_full_.notify_all();
+        }
+
+        batch_done_.wait(lock, [&] { return batch->done_; });
+        if (!batch->status_.ok()) {
+            return batch->status_;
+        }
+        CopyResult(batch, offset, nq, topk, result_ids, result_distances);
+        return Status::OK();
+    }
+
+    // start a new batch, a full batch of the key is replaced
+    BatchPtr batch = std::make_shared<Batch>();
+    batch->vectors_ = vectors;
+    open_batches_[key] = batch;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(max_wait);
+    batch_full_.wait_until(lock, deadline,
+                           [&] { return batch->vectors_.vector_count_ >= static_cast<uint64_t>(max_nq); });
+    iter = open_batches_.find(key);
+    if (iter != open_batches_.end() && iter->second == batch) {
+        open_batches_.erase(iter);
+    }
+    lock.unlock();
+
+    // no search joins the batch any more, its vectors can be read without lock
+    if (batch->search_count_ > 1) {
+        SERVER_LOG_DEBUG << "Combine " << batch->search_count_ << " searches, nq = " << batch->vectors_.vector_count_;
+    }
+    server::Metrics::GetInstance().SearchBatchSizeHistogramObserve(batch->vectors_.vector_count_);
+    Status status;
+    try {
+        status = query(batch->vectors_, batch->result_ids_, batch->result_distances_);
+    } catch (std::exception& ex) {
+        // the searches joined to the batch wait for its status, they must be woken up in any case
+        status = Status(SERVER_UNEXPECTED_ERROR, std::string("Batched search failed: ") + ex.what());
+        SERVER_LOG_ERROR << status.message();
+    }
+
+    lock.lock();
+    batch->status_ = status;
+    batch->done_ = true;
+    batch_done_.notify_all();
+    lock.unlock();
+
+    if (!status.ok()) {
+        return status;
+    }
+    CopyResult(batch, 0, nq, topk, result_ids, result_distances);
+    return Status::OK();
+}
+
+void
+SearchBatcher::CopyResult(const BatchPtr& batch, uint64_t offset, uint64_t nq, int64_t topk,
+                          engine::ResultIds& result_ids, engine::ResultDistances& result_distances) {
+    // the result of an empty table is empty
+    if (batch->result_ids_.empty()) {
+        result_ids.clear();
+        result_distances.clear();
+        return;
+    }
+
+    auto begin = offset * topk;
+    auto end = (offset + nq) * topk;
+    result_ids.assign(batch->result_ids_.begin() + begin, batch->result_ids_.begin() + end);
+    result_distances.assign(batch->result_distances_.begin() + begin, batch->result_distances_.begin() + end);
+}
+
+}  // namespace server
+}  // namespace milvus
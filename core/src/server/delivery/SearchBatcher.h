@@ -0,0 +1,76 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include "db/Types.h"
+#include "utils/Status.h"
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace milvus {
+namespace server {
+
+// Combines searches executed at the same time with the same table, partitions, topk and parameters into one
+// search, the index files are then loaded and scanned once for all of them and the engine works on a larger nq.
+// The first search of a batch waits up to engine_config.search_batch_max_wait milliseconds for others to join,
+// until the batch holds engine_config.search_batch_max_nq query vectors, then executes the query for all.
+class SearchBatcher {
+ public:
+    using QueryFunc = std::function<Status(const engine::VectorsData& vectors, engine::ResultIds& result_ids,
+                                           engine::ResultDistances& result_distances)>;
+
+    static SearchBatcher&
+    GetInstance() {
+        static SearchBatcher batcher;
+        return batcher;
+    }
+
+    // searches with the same key are combined, the key must cover everything that changes the result except
+    // the query vectors; the query of the first search of a batch is executed with the vectors of all searches
+    Status
+    Search(const std::string& key, int64_t topk, const engine::VectorsData& vectors, const QueryFunc& query,
+           engine::ResultIds& result_ids, engine::ResultDistances& result_distances);
+
+ private:
+    struct Batch {
+        engine::VectorsData vectors_;
+        uint64_t search_count_ = 1;
+
+        bool done_ = false;
+        Status status_;
+        engine::ResultIds result_ids_;
+        engine::ResultDistances result_distances_;
+    };
+
+    using BatchPtr = std::shared_ptr<Batch>;
+
+    SearchBatcher() = default;
+
+    static void
+    CopyResult(const BatchPtr& batch, uint64_t offset, uint64_t nq, int64_t topk, engine::ResultIds& result_ids,
+               engine::ResultDistances& result_distances);
+
+ private:
+    std::mutex mutex_;
+    // batches still accepting searches
+    std::map<std::string, BatchPtr> open_batches_;
+    std::condition_variable batch_full_;
+    std::condition_variable batch_done_;
+};
+
+}  // namespace server
+}  // namespace milvus
@@ -33,10 +33,19 @@ BaseRequest::Execute() {
 
 void
 BaseRequest::Done() {
-    done_ = true;
+    {
+        std::lock_guard<std::mutex> lock(finish_mtx_);
+        done_ = true;
+    }
     finish_cond_.notify_all();
 }
 
+void
+BaseRequest::Reject(const Status& status) {
+    status_ = status;
+    Done();
+}
+
 Status
 BaseRequest::SetStatus(ErrorCode error_code, const std::string& error_msg) {
     status_ = Status(error_code, error_msg);
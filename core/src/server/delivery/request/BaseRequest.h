@@ -129,6 +129,10 @@ class BaseRequest {
     void
     Done();
 
+    // finish the request without executing it, e.g. when the scheduler can't accept it
+    void
+    Reject(const Status& status);
+
     Status
     WaitToFinish();
 
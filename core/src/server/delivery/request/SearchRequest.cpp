@@ -12,6 +12,7 @@
 #include "server/delivery/request/SearchRequest.h"
 #include "db/Utils.h"
 #include "server/DBWrapper.h"
+#include "server/delivery/SearchBatcher.h"
 #include "utils/CommonUtil.h"
 #include "utils/Log.h"
 #include "utils/TimeRecorder.h"
@@ -151,8 +152,18 @@ SearchRequest::OnExecute() {
                 return status;
             }
 
-            status = DBWrapper::DB()->Query(context_, table_name_, partition_list_, (size_t)topk_, extra_params_,
-                                            vectors_data_, result_ids, result_distances);
+            // concurrent searches with the same table, partitions, topk and parameters may be combined
+            std::string batch_key = table_name_ + "|" + std::to_string(topk_) + "|" + extra_params_.dump();
+            for (auto& tag : partition_list_) {
+                batch_key += "|" + tag;
+            }
+            auto query = [&](const engine::VectorsData& vectors, engine::ResultIds& ids,
+                             engine::ResultDistances& distances) {
+                return DBWrapper::DB()->Query(context_, table_name_, partition_list_, (size_t)topk_, extra_params_,
+                                              vectors, ids, distances);
+            };
+            status = SearchBatcher::GetInstance().Search(batch_key, topk_, vectors_data_, query, result_ids,
+                                                         result_distances);
         } else {
             status = DBWrapper::DB()->QueryByFileID(context_, table_name_, file_id_list_, (size_t)topk_, extra_params_,
                                                     vectors_data_, result_ids, result_distances);
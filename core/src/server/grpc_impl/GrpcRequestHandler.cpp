@@ -78,27 +78,24 @@ CopyRowRecords(const google::protobuf::RepeatedPtrField<::milvus::grpc::RowRecor
         binary_data_size += record.binary_data().size();
     }
 
-    std::vector<float> float_array(float_data_size, 0.0f);
-    std::vector<uint8_t> binary_array(binary_data_size, 0);
-    int64_t float_offset = 0, binary_offset = 0;
+    // the arrays are filled by appending, so that the large buffers are written once instead of being zeroed first
+    std::vector<float> float_array;
+    std::vector<uint8_t> binary_array;
     if (float_data_size > 0) {
+        float_array.reserve(float_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&float_array[float_offset], record.float_data().data(), record.float_data_size() * sizeof(float));
-            float_offset += record.float_data_size();
+            float_array.insert(float_array.end(), record.float_data().begin(), record.float_data().end());
         }
     } else if (binary_data_size > 0) {
+        binary_array.reserve(binary_data_size);
         for (auto& record : grpc_records) {
-            memcpy(&binary_array[binary_offset], record.binary_data().data(), record.binary_data().size());
-            binary_offset += record.binary_data().size();
+            auto& binary_data = record.binary_data();
+            binary_array.insert(binary_array.end(), binary_data.begin(), binary_data.end());
         }
     }
 
     // step 2: copy id array
-    std::vector<int64_t> id_array;
-    if (grpc_id_array.size() > 0) {
-        id_array.resize(grpc_id_array.size());
-        memcpy(id_array.data(), grpc_id_array.data(), grpc_id_array.size() * sizeof(int64_t));
-    }
+    std::vector<int64_t> id_array(grpc_id_array.begin(), grpc_id_array.end());
 
     // step 3: contruct vectors
     vectors.vector_count_ = grpc_records.size();
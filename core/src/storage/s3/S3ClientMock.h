@@ -9,7 +9,9 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include <aws/core/Aws.h>
@@ -22,6 +24,7 @@
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
 
 namespace milvus {
@@ -30,7 +33,7 @@ namespace storage {
 /*
  * This is a class that represents a S3 Client which is used to mimic the put/get operations of a actual s3 client.
  * During a put object, the body of the request is stored as well as the metadata of the request. This data is then
- * populated into a get object result when a get operation is called.
+ * populated into a get object result when a get operation is called, a ranged get returns the requested bytes only.
  */
 class S3ClientMock : public Aws::S3::S3Client {
  public:
@@ -54,7 +57,7 @@ class S3ClientMock : public Aws::S3::S3Client {
     PutObject(const Aws::S3::Model::PutObjectRequest& request) const override {
         Aws::String key = request.GetKey();
         std::shared_ptr<Aws::IOStream> body = request.GetBody();
-        aws_map_[key] = body;
+        aws_map_[key] = Aws::String((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
 
         Aws::S3::Model::PutObjectResult result;
         return Aws::S3::Model::PutObjectOutcome(std::move(result));
@@ -66,10 +69,20 @@ class S3ClientMock : public Aws::S3::S3Client {
         Aws::Utils::Stream::ResponseStream resp_stream(factory);
 
         try {
-            std::shared_ptr<Aws::IOStream> body = aws_map_.at(request.GetKey());
-            Aws::String body_str((Aws::IStreamBufIterator(*body)), Aws::IStreamBufIterator());
-
-            resp_stream.GetUnderlyingStream().write(body_str.c_str(), body_str.length());
+            const Aws::String& body_str = aws_map_.at(request.GetKey());
+            size_t begin = 0, end = body_str.length();
+            if (request.RangeHasBeenSet()) {
+                // "bytes=first-last", both inclusive
+                std::string range = request.GetRange().c_str();
+                auto dash = range.find('-');
+                begin = std::stoull(range.substr(6, dash - 6));
+                end = std::min<size_t>(end, std::stoull(range.substr(dash + 1)) + 1);
+                if (begin >= end) {
+                    return Aws::S3::Model::GetObjectOutcome();
+                }
+            }
+
+            resp_stream.GetUnderlyingStream().write(body_str.c_str() + begin, end - begin);
             resp_stream.GetUnderlyingStream().flush();
             Aws::AmazonWebServiceResult<Aws::Utils::Stream::ResponseStream> awsStream(
                 std::move(resp_stream), Aws::Http::HeaderValueCollection());
@@ -81,6 +94,18 @@ class S3ClientMock : public Aws::S3::S3Client {
         }
     }
 
+    Aws::S3::Model::HeadObjectOutcome
+    HeadObject(const Aws::S3::Model::HeadObjectRequest& request) const override {
+        auto it = aws_map_.find(request.GetKey());
+        if (it == aws_map_.end()) {
+            return Aws::S3::Model::HeadObjectOutcome();
+        }
+
+        Aws::S3::Model::HeadObjectResult result;
+        result.SetContentLength(it->second.length());
+        return Aws::S3::Model::HeadObjectOutcome(std::move(result));
+    }
+
     Aws::S3::Model::ListObjectsOutcome
     ListObjects(const Aws::S3::Model::ListObjectsRequest& request) const override {
         /* TODO: add object key list into ListObjectsOutcome */
@@ -98,7 +123,7 @@ class S3ClientMock : public Aws::S3::S3Client {
         return result;
     }
 
-    mutable Aws::Map<Aws::String, std::shared_ptr<Aws::IOStream>> aws_map_;
+    mutable Aws::Map<Aws::String, Aws::String> aws_map_;
 };
 
 }  // namespace storage
@@ -14,17 +14,22 @@
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
 #include <fiu-local.h>
+#include <algorithm>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "config/Config.h"
 #include "storage/s3/S3ClientMock.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "storage/s3/S3DiskCache.h"
 #include "utils/Error.h"
 #include "utils/Log.h"
 
@@ -48,6 +53,17 @@ S3ClientWrapper::StartService() {
     CONFIG_CHECK(config.GetStorageConfigS3SecretKey(s3_secret_key_));
     CONFIG_CHECK(config.GetStorageConfigS3Bucket(s3_bucket_));
 
+    int64_t read_chunk_size, read_thread_num, disk_cache_capacity;
+    std::string primary_path;
+    CONFIG_CHECK(config.GetStorageConfigS3ReadChunkSize(read_chunk_size));
+    CONFIG_CHECK(config.GetStorageConfigS3ReadThreadNum(read_thread_num));
+    CONFIG_CHECK(config.GetStorageConfigS3DiskCacheCapacity(disk_cache_capacity));
+    CONFIG_CHECK(config.GetStorageConfigPrimaryPath(primary_path));
+    read_chunk_size_ = read_chunk_size * 1024 * 1024;
+    read_thread_num_ = read_thread_num;
+    read_pool_ = std::make_shared<ThreadPool>(read_thread_num_);
+    S3DiskCache::GetInstance().Init(primary_path + "/s3_cache", disk_cache_capacity * 1024 * 1024 * 1024);
+
     Aws::InitAPI(options_);
 
     Aws::Client::ClientConfiguration cfg;
@@ -75,6 +91,7 @@ S3ClientWrapper::StopService() {
     if (client_ptr_ != nullptr) {
         client_ptr_ = nullptr;
     }
+    read_pool_ = nullptr;
     Aws::ShutdownAPI(options_);
 }
 
@@ -141,6 +158,7 @@ S3ClientWrapper::PutObjectFile(const std::string& object_name, const std::string
         return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
     }
 
+    S3DiskCache::GetInstance().Erase(object_name);
     STORAGE_LOG_DEBUG << "PutObjectFile '" << file_path << "' successfully!";
     return Status::OK();
 }
@@ -163,6 +181,7 @@ S3ClientWrapper::PutObjectStr(const std::string& object_name, const std::string&
         return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
     }
 
+    S3DiskCache::GetInstance().Erase(object_name);
     STORAGE_LOG_DEBUG << "PutObjectStr successfully!";
     return Status::OK();
 }
@@ -213,6 +232,114 @@ S3ClientWrapper::GetObjectStr(const std::string& object_name, std::string& conte
     return Status::OK();
 }
 
+Status
+S3ClientWrapper::GetObjectLength(const std::string& object_name, size_t& length) {
+    Aws::S3::Model::HeadObjectRequest request;
+    request.WithBucket(s3_bucket_).WithKey(object_name);
+
+    auto outcome = client_ptr_->HeadObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectLength.outcome.fail", outcome = Aws::S3::Model::HeadObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: HeadObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    length = outcome.GetResult().GetContentLength();
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectRange(const std::string& object_name, size_t offset, size_t size, void* buffer) {
+    if (size == 0) {
+        return Status::OK();
+    }
+
+    Aws::S3::Model::GetObjectRequest request;
+    std::string range = "bytes=" + std::to_string(offset) + "-" + std::to_string(offset + size - 1);
+    request.WithBucket(s3_bucket_).WithKey(object_name).WithRange(range);
+
+    auto outcome = client_ptr_->GetObject(request);
+
+    fiu_do_on("S3ClientWrapper.GetObjectRange.outcome.fail", outcome = Aws::S3::Model::GetObjectOutcome());
+    if (!outcome.IsSuccess()) {
+        auto err = outcome.GetError();
+        STORAGE_LOG_ERROR << "ERROR: GetObject: " << err.GetExceptionName() << ": " << err.GetMessage();
+        return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
+    }
+
+    auto& retrieved_range = outcome.GetResultWithOwnership().GetBody();
+    retrieved_range.read(static_cast<char*>(buffer), size);
+    if (static_cast<size_t>(retrieved_range.gcount()) != size) {
+        std::string str = "Object '" + object_name + "' returned " + std::to_string(retrieved_range.gcount()) +
+                          " bytes for " + range;
+        STORAGE_LOG_ERROR << "ERROR: " << str;
+        return Status(SERVER_UNEXPECTED_ERROR, str);
+    }
+
+    return Status::OK();
+}
+
+Status
+S3ClientWrapper::GetObjectRangeParallel(const std::string& object_name, size_t offset, size_t size, void* buffer) {
+    if (read_pool_ == nullptr || size <= read_chunk_size_) {
+        return GetObjectRange(object_name, offset, size, buffer);
+    }
+
+    std::vector<std::future<Status>> results;
+    for (size_t begin = 0; begin < size; begin += read_chunk_size_) {
+        size_t chunk_size = std::min(read_chunk_size_, size - begin);
+        results.emplace_back(read_pool_->enqueue(&S3ClientWrapper::GetObjectRange, this, object_name,
+                                                 offset + begin, chunk_size, static_cast<char*>(buffer) + begin));
+    }
+
+    Status status;
+    for (auto& result : results) {
+        auto chunk_status = result.get();
+        if (status.ok() && !chunk_status.ok()) {
+            status = chunk_status;
+        }
+    }
+    return status;
+}
+
+Status
+S3ClientWrapper::GetObjectFileByRange(const std::string& object_name, const std::string& file_path) {
+    size_t length = 0;
+    Status stat = GetObjectLength(object_name, length);
+    if (!stat.ok()) {
+        return stat;
+    }
+
+    std::ofstream output_file(file_path, std::ios::binary | std::ios::trunc);
+    if (!output_file.is_open()) {
+        std::string str = "File '" + file_path + "' can't be created!";
+        STORAGE_LOG_ERROR << "ERROR: " << str;
+        return Status(SERVER_CANNOT_CREATE_FILE, str);
+    }
+
+    // each round fetches one chunk per read thread
+    std::vector<char> buffer(std::min(length, read_chunk_size_ * read_thread_num_));
+    for (size_t offset = 0; offset < length; offset += buffer.size()) {
+        size_t size = std::min(buffer.size(), length - offset);
+        stat = GetObjectRangeParallel(object_name, offset, size, buffer.data());
+        if (!stat.ok()) {
+            return stat;
+        }
+        output_file.write(buffer.data(), size);
+    }
+    output_file.close();
+    if (output_file.fail()) {
+        std::string str = "Failed to write file '" + file_path + "'";
+        STORAGE_LOG_ERROR << "ERROR: " << str;
+        return Status(SERVER_WRITE_ERROR, str);
+    }
+
+    STORAGE_LOG_DEBUG << "GetObjectFileByRange '" << file_path << "' successfully!";
+    return Status::OK();
+}
+
 Status
 S3ClientWrapper::ListObjects(std::vector<std::string>& object_list, const std::string& marker) {
     Aws::S3::Model::ListObjectsRequest request;
@@ -259,6 +386,7 @@ S3ClientWrapper::DeleteObject(const std::string& object_name) {
         return Status(SERVER_UNEXPECTED_ERROR, err.GetMessage());
     }
 
+    S3DiskCache::GetInstance().Erase(object_name);
     STORAGE_LOG_DEBUG << "DeleteObject '" << object_name << "' successfully!";
     return Status::OK();
 }
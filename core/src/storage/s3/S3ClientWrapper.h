@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "utils/Status.h"
+#include "utils/ThreadPool.h"
 
 namespace milvus {
 namespace storage {
@@ -48,12 +49,29 @@ class S3ClientWrapper {
     Status
     GetObjectStr(const std::string& object_key, std::string& content);
     Status
+    GetObjectLength(const std::string& object_key, size_t& length);
+    // ranged GET of [offset, offset + size) into buffer
+    Status
+    GetObjectRange(const std::string& object_key, size_t offset, size_t size, void* buffer);
+    // split a range into chunks fetched in parallel
+    Status
+    GetObjectRangeParallel(const std::string& object_key, size_t offset, size_t size, void* buffer);
+    // download an object by parallel ranged GETs, only a few chunks are kept in memory
+    Status
+    GetObjectFileByRange(const std::string& object_key, const std::string& file_path);
+    Status
     ListObjects(std::vector<std::string>& object_list, const std::string& marker = "");
     Status
     DeleteObject(const std::string& object_key);
     Status
     DeleteObjects(const std::string& marker);
 
+    // unit: BYTE
+    size_t
+    read_chunk_size() const {
+        return read_chunk_size_;
+    }
+
  private:
     std::shared_ptr<Aws::S3::S3Client> client_ptr_;
     Aws::SDKOptions options_;
@@ -63,6 +81,10 @@ class S3ClientWrapper {
     std::string s3_access_key_;
     std::string s3_secret_key_;
     std::string s3_bucket_;
+
+    size_t read_chunk_size_ = 8 * 1024 * 1024;
+    size_t read_thread_num_ = 1;
+    std::shared_ptr<ThreadPool> read_pool_;
 };
 
 }  // namespace storage
@@ -0,0 +1,270 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#include "storage/s3/S3DiskCache.h"
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <vector>
+
+#include "utils/Error.h"
+#include "utils/Log.h"
+
+namespace milvus {
+namespace storage {
+
+namespace {
+
+const char* DATA_EXTENSION = ".data";
+const char* META_EXTENSION = ".meta";
+const char* TEMP_EXTENSION = ".tmp";
+
+constexpr size_t CHECKSUM_BLOCK_SIZE = 1024 * 1024;
+
+// object keys are paths, they are flattened into file names: '_' is written as "__" and '/' as "_s"
+std::string
+EscapeKey(const std::string& key) {
+    std::string name;
+    name.reserve(key.size() + 8);
+    for (auto c : key) {
+        if (c == '_') {
+            name += "__";
+        } else if (c == '/') {
+            name += "_s";
+        } else {
+            name += c;
+        }
+    }
+    return name;
+}
+
+}  // namespace
+
+void
+S3DiskCache::Init(const std::string& directory, int64_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    usage_ = 0;
+    directory_ = directory;
+    capacity_ = capacity;
+    if (capacity_ <= 0) {
+        return;
+    }
+
+    boost::system::error_code err;
+    boost::filesystem::create_directories(directory_, err);
+    if (err) {
+        STORAGE_LOG_ERROR << "Failed to create s3 disk cache directory " << directory_ << ": " << err.message();
+        capacity_ = 0;
+        return;
+    }
+
+    // restore the files of an earlier run, their checksums are verified when they are used
+    std::vector<boost::filesystem::path> stale_files;
+    boost::filesystem::directory_iterator it_end;
+    for (boost::filesystem::directory_iterator it(directory_); it != it_end; ++it) {
+        auto path = it->path();
+        if (path.extension().string() == TEMP_EXTENSION) {
+            stale_files.push_back(path);
+            continue;
+        }
+        if (path.extension().string() != META_EXTENSION) {
+            continue;
+        }
+
+        Entry entry;
+        std::string key;
+        std::ifstream meta_file(path.string());
+        meta_file >> entry.size_ >> entry.checksum_;
+        meta_file.get();
+        std::getline(meta_file, key);
+
+        boost::filesystem::path data_path = FilePath(key);
+        if (!meta_file.fail() && !key.empty() && data_path.parent_path() == path.parent_path() &&
+            data_path.stem() == path.stem() && boost::filesystem::exists(data_path) &&
+            static_cast<int64_t>(boost::filesystem::file_size(data_path)) == entry.size_) {
+            entries_.put(key, entry);
+            usage_ += entry.size_;
+        } else {
+            stale_files.push_back(path);
+            stale_files.push_back(data_path);
+        }
+    }
+    for (auto& path : stale_files) {
+        boost::filesystem::remove(path, err);
+    }
+
+    FreeSpace();
+    STORAGE_LOG_INFO << "S3 disk cache " << directory_ << " restored " << entries_.size() << " files, " << usage_
+                     << " bytes";
+}
+
+void
+S3DiskCache::set_capacity(int64_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    FreeSpace();
+}
+
+Status
+S3DiskCache::Fetch(const std::string& key, const FillFunc& fill, std::string& file_path) {
+    file_path = FilePath(key);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    fill_cv_.wait(lock, [&] { return filling_keys_.find(key) == filling_keys_.end(); });
+
+    Entry entry;
+    bool restored = false;
+    if (entries_.exists(key)) {
+        entry = entries_.get(key);
+        if (entry.verified_) {
+            return Status::OK();
+        }
+        restored = true;
+    }
+    filling_keys_.insert(key);
+    lock.unlock();
+
+    int64_t size = 0;
+    uint32_t checksum = 0;
+    Status status;
+    bool verified = false;
+    if (restored) {
+        status = ComputeChecksum(file_path, size, checksum);
+        verified = status.ok() && size == entry.size_ && checksum == entry.checksum_;
+        if (!verified) {
+            STORAGE_LOG_WARNING << "Checksum mismatch of s3 disk cache file " << file_path << ", download it again";
+        }
+    }
+
+    if (!verified) {
+        // download into a temp file, the file becomes visible with its checksum only when it is complete
+        std::string temp_path = file_path + TEMP_EXTENSION;
+        status = fill(temp_path);
+        if (status.ok()) {
+            status = ComputeChecksum(temp_path, size, checksum);
+        }
+        if (status.ok()) {
+            std::ofstream meta_file(directory_ + "/" + EscapeKey(key) + META_EXTENSION, std::ios::trunc);
+            meta_file << size << " " << checksum << "\n" << key << "\n";
+            meta_file.close();
+            if (meta_file.fail()) {
+                status = Status(SERVER_WRITE_ERROR, "Failed to write s3 disk cache meta of " + key);
+            }
+        }
+        boost::system::error_code err;
+        if (status.ok()) {
+            boost::filesystem::rename(temp_path, file_path, err);
+            if (err) {
+                status = Status(SERVER_WRITE_ERROR, "Failed to move s3 disk cache file " + temp_path);
+            }
+        }
+        boost::filesystem::remove(temp_path, err);
+    }
+
+    lock.lock();
+    filling_keys_.erase(key);
+    fill_cv_.notify_all();
+
+    if (restored) {
+        usage_ -= entry.size_;
+        entries_.erase(key);
+    }
+    if (!status.ok()) {
+        RemoveFiles(key);
+        return status;
+    }
+
+    entry.size_ = size;
+    entry.checksum_ = checksum;
+    entry.verified_ = true;
+    entries_.put(key, entry);
+    usage_ += size;
+    FreeSpace();
+
+    if (!entries_.exists(key)) {
+        return Status(SERVER_UNEXPECTED_ERROR, key + " is larger than the s3 disk cache");
+    }
+    return Status::OK();
+}
+
+void
+S3DiskCache::Erase(const std::string& key) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    fill_cv_.wait(lock, [&] { return filling_keys_.find(key) == filling_keys_.end(); });
+    if (entries_.exists(key)) {
+        usage_ -= entries_.peek(key).size_;
+        entries_.erase(key);
+        RemoveFiles(key);
+    }
+}
+
+void
+S3DiskCache::Clear() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    fill_cv_.wait(lock, [&] { return filling_keys_.empty(); });
+    while (entries_.size() > 0) {
+        std::string key = entries_.rbegin()->first;
+        entries_.erase(key);
+        RemoveFiles(key);
+    }
+    usage_ = 0;
+}
+
+std::string
+S3DiskCache::FilePath(const std::string& key) const {
+    return directory_ + "/" + EscapeKey(key) + DATA_EXTENSION;
+}
+
+void
+S3DiskCache::RemoveFiles(const std::string& key) {
+    // readers keep reading a removed file through their open descriptor
+    boost::system::error_code err;
+    boost::filesystem::remove(FilePath(key), err);
+    boost::filesystem::remove(directory_ + "/" + EscapeKey(key) + META_EXTENSION, err);
+}
+
+void
+S3DiskCache::FreeSpace() {
+    while (usage_ > capacity_ && entries_.size() > 0) {
+        std::string key = entries_.rbegin()->first;
+        STORAGE_LOG_DEBUG << "Evict " << key << " from s3 disk cache";
+        usage_ -= entries_.rbegin()->second.size_;
+        entries_.erase(key);
+        RemoveFiles(key);
+    }
+}
+
+Status
+S3DiskCache::ComputeChecksum(const std::string& file_path, int64_t& size, uint32_t& checksum) {
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file.is_open()) {
+        return Status(SERVER_FILE_NOT_FOUND, "Failed to open " + file_path);
+    }
+
+    boost::crc_32_type crc;
+    std::vector<char> block(CHECKSUM_BLOCK_SIZE);
+    size = 0;
+    while (file) {
+        file.read(block.data(), block.size());
+        crc.process_bytes(block.data(), file.gcount());
+        size += file.gcount();
+    }
+    if (file.bad()) {
+        return Status(SERVER_UNEXPECTED_ERROR, "Failed to read " + file_path);
+    }
+    checksum = crc.checksum();
+    return Status::OK();
+}
+
+}  // namespace storage
+}  // namespace milvus
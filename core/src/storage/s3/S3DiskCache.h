@@ -0,0 +1,111 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "cache/LRU.h"
+#include "utils/Status.h"
+
+namespace milvus {
+namespace storage {
+
+// Local disk tier of the objects read from S3, below the cpu cache: an index evicted from the cpu cache
+// is loaded again from local disk instead of object storage. Files are evicted in LRU order when their
+// total size exceeds the capacity. Every file has a checksum, files left by an earlier run are verified
+// before their first use.
+class S3DiskCache {
+ public:
+    // download the object into file_path
+    using FillFunc = std::function<Status(const std::string& file_path)>;
+
+    static S3DiskCache&
+    GetInstance() {
+        static S3DiskCache cache;
+        return cache;
+    }
+
+    // keep the files in 'directory', capacity 0 disables the cache; the files of an earlier run are restored
+    void
+    Init(const std::string& directory, int64_t capacity);
+
+    bool
+    Enabled() const {
+        return capacity_ > 0;
+    }
+
+    int64_t
+    usage() const {
+        return usage_;
+    }
+
+    int64_t
+    capacity() const {
+        return capacity_;
+    }
+
+    void
+    set_capacity(int64_t capacity);
+
+    // get the local file of an object, 'fill' downloads it on a miss; concurrent misses of the same
+    // object wait for one download
+    Status
+    Fetch(const std::string& key, const FillFunc& fill, std::string& file_path);
+
+    // drop the local file of an object when the object is overwritten or deleted
+    void
+    Erase(const std::string& key);
+
+    void
+    Clear();
+
+ private:
+    struct Entry {
+        int64_t size_ = 0;
+        uint32_t checksum_ = 0;
+        bool verified_ = false;
+    };
+
+    S3DiskCache() : entries_(SIZE_MAX) {
+    }
+
+    std::string
+    FilePath(const std::string& key) const;
+
+    void
+    RemoveFiles(const std::string& key);
+
+    // evict least recently used files until usage is within capacity, the caller must hold the lock
+    void
+    FreeSpace();
+
+    static Status
+    ComputeChecksum(const std::string& file_path, int64_t& size, uint32_t& checksum);
+
+ private:
+    std::string directory_;
+    int64_t capacity_ = 0;
+    int64_t usage_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable fill_cv_;
+    cache::LRU<std::string, Entry> entries_;
+    std::set<std::string> filling_keys_;
+};
+
+}  // namespace storage
+}  // namespace milvus
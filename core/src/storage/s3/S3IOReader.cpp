@@ -10,7 +10,14 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "storage/s3/S3IOReader.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "storage/s3/S3ClientWrapper.h"
+#include "storage/s3/S3DiskCache.h"
+#include "utils/Exception.h"
+#include "utils/Log.h"
 
 namespace milvus {
 namespace storage {
@@ -19,12 +26,73 @@ void
 S3IOReader::open(const std::string& name) {
     name_ = name;
     pos_ = 0;
-    S3ClientWrapper::GetInstance().GetObjectStr(name_, buffer_);
+    length_ = 0;
+    buffer_.clear();
+    buffer_offset_ = 0;
+    local_reader_ = nullptr;
+
+    auto& wrapper = S3ClientWrapper::GetInstance();
+    auto& disk_cache = S3DiskCache::GetInstance();
+    if (disk_cache.Enabled()) {
+        std::string file_path;
+        auto fill = [&](const std::string& path) { return wrapper.GetObjectFileByRange(name_, path); };
+        if (disk_cache.Fetch(name_, fill, file_path).ok()) {
+            local_reader_ = std::make_shared<DiskIOReader>();
+            local_reader_->open(file_path);
+            if (local_reader_->fs_.is_open()) {
+                length_ = local_reader_->length();
+                return;
+            }
+            // evicted before it was opened, read from s3
+            local_reader_ = nullptr;
+        }
+    }
+
+    if (!wrapper.GetObjectLength(name_, length_).ok()) {
+        length_ = 0;
+    }
 }
 
 void
 S3IOReader::read(void* ptr, size_t size) {
-    memcpy(ptr, buffer_.data() + pos_, size);
+    if (local_reader_ != nullptr) {
+        local_reader_->seekg(pos_);
+        local_reader_->read(ptr, size);
+        pos_ += size;
+        return;
+    }
+
+    if (pos_ + size > length_) {
+        std::string err_msg = "Read out of range of " + name_ + ": " + std::to_string(pos_) + " + " +
+                              std::to_string(size) + " > " + std::to_string(length_);
+        STORAGE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+
+    auto& wrapper = S3ClientWrapper::GetInstance();
+    Status status;
+    if (pos_ >= buffer_offset_ && pos_ + size <= buffer_offset_ + buffer_.size()) {
+        memcpy(ptr, buffer_.data() + pos_ - buffer_offset_, size);
+    } else if (size >= wrapper.read_chunk_size()) {
+        status = wrapper.GetObjectRangeParallel(name_, pos_, size, ptr);
+    } else {
+        // small reads of headers are served from one chunk read ahead
+        buffer_.resize(std::min(wrapper.read_chunk_size(), length_ - pos_));
+        buffer_offset_ = pos_;
+        status = wrapper.GetObjectRange(name_, buffer_offset_, buffer_.size(), &buffer_[0]);
+        if (status.ok()) {
+            memcpy(ptr, buffer_.data(), size);
+        } else {
+            buffer_.clear();
+        }
+    }
+
+    if (!status.ok()) {
+        std::string err_msg = "Failed to read " + name_ + ": " + status.message();
+        STORAGE_LOG_ERROR << err_msg;
+        throw Exception(SERVER_UNEXPECTED_ERROR, err_msg);
+    }
+    pos_ += size;
 }
 
 void
@@ -34,11 +102,16 @@ S3IOReader::seekg(size_t pos) {
 
 size_t
 S3IOReader::length() {
-    return buffer_.length();
+    return length_;
 }
 
 void
 S3IOReader::close() {
+    if (local_reader_ != nullptr) {
+        local_reader_->close();
+        local_reader_ = nullptr;
+    }
+    std::string().swap(buffer_);
 }
 
 }  // namespace storage
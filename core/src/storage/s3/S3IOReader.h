@@ -11,12 +11,17 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include "storage/IOReader.h"
+#include "storage/disk/DiskIOReader.h"
 
 namespace milvus {
 namespace storage {
 
+// Reads an object by ranged GETs instead of downloading it as a whole: small reads are served from a
+// read-ahead buffer of one chunk, large reads are fetched in parallel chunks straight into the caller's
+// memory. With the s3 disk cache enabled, the object is read from its local copy.
 class S3IOReader : public IOReader {
  public:
     S3IOReader() = default;
@@ -48,8 +53,14 @@ class S3IOReader : public IOReader {
 
  public:
     std::string name_;
+    size_t pos_ = 0;
+    size_t length_ = 0;
+
+    // read-ahead buffer holding [buffer_offset_, buffer_offset_ + buffer_.size()) of the object
     std::string buffer_;
-    size_t pos_;
+    size_t buffer_offset_ = 0;
+
+    std::shared_ptr<DiskIOReader> local_reader_;
 };
 
 }  // namespace storage
@@ -287,5 +287,23 @@ BinBFIndex::AddWithoutIds(const int64_t& nb, const uint8_t* xb, const Config& cf
     std::static_pointer_cast<knowhere::BinaryIDMAP>(index_)->AddWithoutId(ret_ds, cfg);
     return Status::OK();
 }
+
+Status
+BinBFIndex::AddWithoutIdsNoCopy(const int64_t& nb, const uint8_t* xb, std::shared_ptr<void> data_holder) {
+    try {
+        auto ret_ds = std::make_shared<knowhere::Dataset>();
+        ret_ds->Set(knowhere::meta::ROWS, nb);
+        ret_ds->Set(knowhere::meta::DIM, dim);
+        ret_ds->Set(knowhere::meta::TENSOR, xb);
+        std::static_pointer_cast<knowhere::BinaryIDMAP>(index_)->AddWithoutIdNoCopy(ret_ds, std::move(data_holder));
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
 }  // namespace engine
 }  // namespace milvus
@@ -78,6 +78,10 @@ class BinBFIndex : public BinVecImpl {
 
     Status
     AddWithoutIds(const int64_t& nb, const uint8_t* xb, const Config& cfg);
+
+    // xb is searched in place, data_holder keeps it valid
+    Status
+    AddWithoutIdsNoCopy(const int64_t& nb, const uint8_t* xb, std::shared_ptr<void> data_holder);
 };
 
 }  // namespace engine
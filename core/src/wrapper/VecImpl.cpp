@@ -14,6 +14,7 @@
 #include "DataTransfer.h"
 #include "knowhere/adapter/VectorAdapter.h"
 #include "knowhere/common/Exception.h"
+#include "knowhere/index/vector_index/IndexHNSW.h"
 #include "knowhere/index/vector_index/IndexIDMAP.h"
 #include "utils/Log.h"
 #include "wrapper/WrapperException.h"
@@ -289,6 +290,8 @@ VecIndexImpl::SetBlacklist(faiss::ConcurrentBitsetPtr list) {
         raw_index->SetBlacklist(list);
     } else if (auto raw_index = std::dynamic_pointer_cast<knowhere::IDMAP>(index_)) {
         raw_index->SetBlacklist(list);
+    } else if (auto raw_index = std::dynamic_pointer_cast<knowhere::IndexHNSW>(index_)) {
+        raw_index->SetBlacklist(list);
     }
     return Status::OK();
 }
@@ -299,10 +302,28 @@ VecIndexImpl::GetBlacklist(faiss::ConcurrentBitsetPtr& list) {
         raw_index->GetBlacklist(list);
     } else if (auto raw_index = std::dynamic_pointer_cast<knowhere::IDMAP>(index_)) {
         raw_index->GetBlacklist(list);
+    } else if (auto raw_index = std::dynamic_pointer_cast<knowhere::IndexHNSW>(index_)) {
+        raw_index->GetBlacklist(list);
     }
     return Status::OK();
 }
 
+Status
+VecIndexImpl::SetSharedQuantizer(const knowhere::SharedQuantizerPtr& quantizer) {
+    if (auto raw_index = std::dynamic_pointer_cast<knowhere::IVF>(index_)) {
+        raw_index->SetSharedQuantizer(quantizer);
+    }
+    return Status::OK();
+}
+
+knowhere::SharedQuantizerPtr
+VecIndexImpl::GetSharedQuantizer() {
+    if (auto raw_index = std::dynamic_pointer_cast<knowhere::IVF>(index_)) {
+        return raw_index->GetSharedQuantizer();
+    }
+    return nullptr;
+}
+
 Status
 VecIndexImpl::SetUids(std::vector<segment::doc_id_t>& uids) {
     index_->SetUids(uids);
@@ -375,5 +396,22 @@ BFIndex::AddWithoutIds(const int64_t& nb, const float* xb, const Config& cfg) {
     return Status::OK();
 }
 
+Status
+BFIndex::AddWithoutIdsNoCopy(const int64_t& nb, const float* xb, std::shared_ptr<void> data_holder) {
+    try {
+        auto ret_ds = std::make_shared<knowhere::Dataset>();
+        ret_ds->Set(knowhere::meta::ROWS, nb);
+        ret_ds->Set(knowhere::meta::TENSOR, xb);
+        std::static_pointer_cast<knowhere::IDMAP>(index_)->AddWithoutIdNoCopy(ret_ds, std::move(data_holder));
+    } catch (knowhere::KnowhereException& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_UNEXPECTED_ERROR, e.what());
+    } catch (std::exception& e) {
+        WRAPPER_LOG_ERROR << e.what();
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+    return Status::OK();
+}
+
 }  // namespace engine
 }  // namespace milvus
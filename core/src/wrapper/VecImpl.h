@@ -76,6 +76,12 @@ class VecIndexImpl : public VecIndex {
     Status
     GetBlacklist(faiss::ConcurrentBitsetPtr& list) override;
 
+    Status
+    SetSharedQuantizer(const knowhere::SharedQuantizerPtr& quantizer) override;
+
+    knowhere::SharedQuantizerPtr
+    GetSharedQuantizer() override;
+
     Status
     SetUids(std::vector<segment::doc_id_t>& uids) override;
 
@@ -111,6 +117,10 @@ class BFIndex : public VecIndexImpl {
 
     Status
     AddWithoutIds(const int64_t& nb, const float* xb, const Config& cfg);
+
+    // xb is searched in place, data_holder keeps it valid
+    Status
+    AddWithoutIdsNoCopy(const int64_t& nb, const float* xb, std::shared_ptr<void> data_holder);
 };
 
 class ToIndexData : public cache::DataObj {
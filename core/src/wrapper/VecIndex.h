@@ -23,6 +23,7 @@
 #include "knowhere/common/BinarySet.h"
 #include "knowhere/common/Config.h"
 #include "knowhere/index/vector_index/Quantizer.h"
+#include "knowhere/index/vector_index/helpers/SharedQuantizer.h"
 #include "segment/Types.h"
 #include "utils/Log.h"
 #include "utils/Status.h"
@@ -191,6 +192,18 @@ class VecIndex : public cache::DataObj {
         return Status::OK();
     }
 
+    // share the coarse quantizer of an IVF index with the indexes of other segments
+    virtual Status
+    SetSharedQuantizer(const knowhere::SharedQuantizerPtr& quantizer) {
+        return Status::OK();
+    }
+
+    // the coarse quantizer of a trained IVF index, nullptr for other indexes
+    virtual knowhere::SharedQuantizerPtr
+    GetSharedQuantizer() {
+        return nullptr;
+    }
+
     virtual Status
     SetUids(std::vector<segment::doc_id_t>& uids) {
         ENGINE_LOG_ERROR << "SetUIDArray not support";
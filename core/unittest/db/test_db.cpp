@@ -1227,6 +1227,73 @@ TEST_F(DBTest2, GET_VECTOR_BY_ID_TEST) {
     }
 }
 
+TEST_F(DBTest2, MMAP_SEARCH_TEST) {
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+
+    milvus::engine::meta::TableSchema table_info = BuildTableSchema();
+    auto stat = db_->CreateTable(table_info);
+    ASSERT_TRUE(stat.ok());
+
+    uint64_t nb = 1000;
+    milvus::engine::VectorsData xb;
+    BuildVectors(nb, 0, xb);
+
+    stat = db_->InsertVectors(TABLE_NAME, "", xb);
+    ASSERT_TRUE(stat.ok());
+
+    // every 10th vector is deleted, the mapped vectors are searched with the same blacklist
+    milvus::engine::IDNumbers ids_to_delete;
+    for (uint64_t i = 0; i < nb; i += 10) {
+        ids_to_delete.push_back(xb.id_array_[i]);
+    }
+    stat = db_->DeleteVectors(TABLE_NAME, ids_to_delete);
+    ASSERT_TRUE(stat.ok());
+
+    stat = db_->Flush(TABLE_NAME);
+    ASSERT_TRUE(stat.ok());
+
+    int64_t nq = 5;
+    milvus::engine::VectorsData xq;
+    xq.vector_count_ = nq;
+    xq.float_data_.assign(xb.float_data_.begin() + TABLE_DIM, xb.float_data_.begin() + (nq + 1) * TABLE_DIM);
+
+    int64_t topk = 10;
+    milvus::json json_params = {{"nprobe", 10}};
+    std::vector<std::string> tags;
+    auto query = [&](bool use_mmap, milvus::engine::ResultIds& result_ids,
+                     milvus::engine::ResultDistances& result_distances) {
+        milvus::cache::CpuCacheMgr::GetInstance()->ClearCache();
+        ASSERT_TRUE(config.SetEngineConfigUseMmap(use_mmap ? "true" : "false").ok());
+        auto status =
+            db_->Query(dummy_context_, TABLE_NAME, tags, topk, json_params, xq, result_ids, result_distances);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(result_ids.size(), nq * topk);
+    };
+
+    milvus::engine::ResultIds result_ids, expected_ids;
+    milvus::engine::ResultDistances result_distances, expected_distances;
+    query(false, expected_ids, expected_distances);
+    query(true, result_ids, result_distances);
+
+    ASSERT_EQ(result_ids, expected_ids);
+    ASSERT_EQ(result_distances.size(), expected_distances.size());
+    for (size_t i = 0; i < result_distances.size(); ++i) {
+        ASSERT_FLOAT_EQ(result_distances[i], expected_distances[i]);
+    }
+    for (int64_t i = 0; i < nq; ++i) {
+        ASSERT_EQ(result_ids[i * topk], xb.id_array_[i + 1]);
+        for (int64_t k = 0; k < topk; ++k) {
+            ASSERT_NE(result_ids[i * topk + k] % 10, 0);
+        }
+    }
+
+    // the mapped segment is charged to the cache for its whole data
+    int64_t cache_usage = milvus::cache::CpuCacheMgr::GetInstance()->CacheUsage();
+    ASSERT_GE(cache_usage, static_cast<int64_t>(nb * TABLE_DIM * sizeof(float)));
+
+    config.SetEngineConfigUseMmap("false");
+}
+
 TEST_F(DBTest2, GET_VECTOR_IDS_TEST) {
     milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
     auto stat = db_->CreateTable(table_schema);
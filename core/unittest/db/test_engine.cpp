@@ -15,6 +15,10 @@
 
 #include "db/engine/EngineFactory.h"
 #include "db/engine/ExecutionEngineImpl.h"
+#include "db/engine/IncrementalGraphMgr.h"
+#include "segment/SegmentReader.h"
+#include "segment/SegmentWriter.h"
+#include "segment/VectorIndex.h"
 #include "db/utils.h"
 #include <fiu-local.h>
 #include <fiu-control.h>
@@ -278,3 +282,80 @@ TEST_F(EngineTest, ENGINE_IMPL_THROW_EXCEPTION_TEST) {
 
     fiu_disable("vecIndex.throw_read_exception");
 }
+
+TEST_F(EngineTest, ENGINE_IMPL_INCREMENTAL_GRAPH_TEST) {
+    std::string test_dir = "/tmp/milvus_test/incremental_graph_test";
+    boost::filesystem::remove_all(test_dir);
+
+    // segment b holds the vectors of segment a followed by as many new ones
+    std::vector<float> data(2 * ROW_COUNT * DIMENSION);
+    std::vector<milvus::segment::doc_id_t> uids(2 * ROW_COUNT);
+    for (int64_t i = 0; i < 2 * ROW_COUNT; i++) {
+        uids[i] = 100000 + i;
+        for (uint16_t k = 0; k < DIMENSION; k++) {
+            data[i * DIMENSION + k] = drand48();
+        }
+    }
+    auto write_segment = [&](const std::string& segment_dir, int64_t count) {
+        std::vector<uint8_t> bytes((uint8_t*)data.data(), (uint8_t*)(data.data() + count * DIMENSION));
+        std::vector<milvus::segment::doc_id_t> segment_uids(uids.begin(), uids.begin() + count);
+        milvus::segment::SegmentWriter segment_writer(segment_dir);
+        ASSERT_TRUE(segment_writer.AddVectors("graph", bytes, segment_uids).ok());
+        ASSERT_TRUE(segment_writer.Serialize().ok());
+    };
+
+    milvus::json index_params = {{"M", 16}, {"efConstruction", 100}};
+    auto search_self = [&](const milvus::engine::ExecutionEnginePtr& engine_ptr, int64_t offset) {
+        float distance;
+        int64_t label;
+        milvus::json search_params = {{"ef", 64}};
+        auto status = engine_ptr->Search(1, data.data() + offset * DIMENSION, 1, search_params, &distance, &label);
+        ASSERT_TRUE(status.ok());
+        ASSERT_EQ(label, uids[offset]);
+    };
+
+    // a segment without checkpoint is searched by brute force, its graph is built in background
+    std::string segment_a = test_dir + "/a";
+    write_segment(segment_a, ROW_COUNT);
+    auto& graph_mgr = milvus::engine::IncrementalGraphMgr::GetInstance();
+    graph_mgr.BuildScheduled(false);
+    auto engine_a = milvus::engine::EngineFactory::Build(DIMENSION, segment_a + "/raw",
+                                                         milvus::engine::EngineType::HNSW,
+                                                         milvus::engine::MetricType::L2, index_params, true);
+    ASSERT_TRUE(engine_a->Load(false).ok());
+    ASSERT_EQ(engine_a->Count(), ROW_COUNT);
+    ASSERT_FALSE(milvus::segment::SegmentReader(segment_a).HasVectorsIndex());
+    ASSERT_EQ(graph_mgr.ScheduledCount(), 1);
+    search_self(engine_a, 10);
+
+    graph_mgr.BuildScheduled(false);
+    ASSERT_EQ(graph_mgr.ScheduledCount(), 0);
+    ASSERT_TRUE(milvus::segment::SegmentReader(segment_a).HasVectorsIndex());
+
+    // the graph is loaded from the checkpoint
+    engine_a = milvus::engine::EngineFactory::Build(DIMENSION, segment_a + "/raw", milvus::engine::EngineType::HNSW,
+                                                    milvus::engine::MetricType::L2, index_params, true);
+    ASSERT_TRUE(engine_a->Load(false).ok());
+    ASSERT_EQ(engine_a->Count(), ROW_COUNT);
+    ASSERT_EQ(graph_mgr.ScheduledCount(), 0);
+    search_self(engine_a, 10);
+
+    // the checkpoint of segment a is extended by the new vectors of segment b
+    std::string segment_b = test_dir + "/b";
+    write_segment(segment_b, 2 * ROW_COUNT);
+    auto engine_b = std::make_shared<milvus::engine::ExecutionEngineImpl>(
+        DIMENSION, segment_b + "/raw", milvus::engine::EngineType::HNSW, milvus::engine::MetricType::L2,
+        index_params, true);
+    ASSERT_TRUE(engine_b->BuildGraph(segment_a, false).ok());
+    ASSERT_EQ(engine_b->Count(), 2 * ROW_COUNT);
+    search_self(engine_b, 10);
+    search_self(engine_b, ROW_COUNT + 10);
+
+    milvus::segment::SegmentReader segment_reader_b(segment_b);
+    milvus::segment::VectorIndexPtr checkpoint;
+    ASSERT_TRUE(segment_reader_b.LoadVectorsIndex(checkpoint).ok());
+    ASSERT_NE(checkpoint, nullptr);
+    ASSERT_GT(checkpoint->Size(), 0);
+
+    boost::filesystem::remove_all(test_dir);
+}
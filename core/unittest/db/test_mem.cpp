@@ -109,6 +109,49 @@ TEST_F(MemManagerTest, VECTOR_SOURCE_TEST) {
     ASSERT_EQ(vectors.id_array_.size(), 100);
 }
 
+TEST_F(MemManagerTest, VECTOR_SOURCE_BUFFER_TEST) {
+    milvus::engine::meta::TableSchema table_schema = BuildTableSchema();
+    auto status = impl_->CreateTable(table_schema);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFileSchema table_file_schema;
+    table_file_schema.table_id_ = GetTableName();
+    status = impl_->CreateTableFile(table_file_schema);
+    ASSERT_TRUE(status.ok());
+
+    int64_t n = 100;
+    milvus::engine::VectorsData vectors;
+    BuildVectors(n, vectors);
+    milvus::engine::IDNumbers ids;
+    for (int64_t i = 0; i < n; i++) {
+        ids.push_back(i * 2);
+    }
+
+    // the source refers to the buffers of the caller
+    milvus::engine::VectorSource source(n, ids.data(), vectors.float_data_.data());
+
+    std::string directory;
+    milvus::engine::utils::GetParentPath(table_file_schema.location_, directory);
+    auto segment_writer_ptr = std::make_shared<milvus::segment::SegmentWriter>(directory);
+
+    size_t num_vectors_added;
+    status = source.Add(segment_writer_ptr, table_file_schema, 30, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 30);
+    status = source.Add(segment_writer_ptr, table_file_schema, 100, num_vectors_added);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(num_vectors_added, 70);
+    ASSERT_TRUE(source.AllAdded());
+    ASSERT_EQ(source.GetVectorIds(), ids);
+
+    milvus::segment::SegmentPtr segment_ptr;
+    segment_writer_ptr->GetSegment(segment_ptr);
+    auto& data = segment_ptr->vectors_ptr_->GetData();
+    ASSERT_EQ(data.size(), vectors.float_data_.size() * sizeof(float));
+    ASSERT_EQ(memcmp(data.data(), vectors.float_data_.data(), data.size()), 0);
+    ASSERT_EQ(segment_ptr->vectors_ptr_->GetUids(), ids);
+}
+
 TEST_F(MemManagerTest, MEM_TABLE_FILE_TEST) {
     auto options = GetOptions();
     fiu_init(0);
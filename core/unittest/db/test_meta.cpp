@@ -12,6 +12,7 @@
 #include "db/Constants.h"
 #include "db/Utils.h"
 #include "db/meta/MetaConsts.h"
+#include "db/meta/SnapshotMetaImpl.h"
 #include "db/meta/SqliteMetaImpl.h"
 #include "db/utils.h"
 
@@ -740,3 +741,88 @@ TEST_F(MetaTest, LSN_TEST) {
     status = impl_->GetGlobalLastLSN(temp_lsb);
     ASSERT_EQ(temp_lsb, lsn);
 }
+
+TEST_F(MetaTest, SNAPSHOT_TEST) {
+    auto table_id = "snapshot_test_table";
+    auto options = GetOptions();
+    auto snapshot = std::make_shared<milvus::engine::meta::SnapshotMetaImpl>(impl_, options.meta_);
+
+    milvus::engine::meta::TableSchema table;
+    table.table_id_ = table_id;
+    table.dimension_ = 256;
+    auto status = snapshot->CreateTable(table);
+    ASSERT_TRUE(status.ok());
+
+    milvus::engine::meta::TableFileSchema file_1;
+    file_1.table_id_ = table_id;
+    file_1.file_type_ = milvus::engine::meta::TableFileSchema::RAW;
+    status = snapshot->CreateTableFile(file_1);
+    ASSERT_TRUE(status.ok());
+
+    // the first search loads the table, the next ones read the snapshot
+    std::vector<size_t> ids;
+    milvus::engine::meta::TableFilesSchema files;
+    status = snapshot->FilesToSearch(table_id, ids, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 1UL);
+    ASSERT_EQ(files[0].dimension_, 256);
+    auto version = snapshot->SnapshotVersion();
+    ASSERT_GT(version, 0UL);
+
+    status = snapshot->FilesToSearch(table_id, ids, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 1UL);
+    milvus::engine::meta::TableSchema describe;
+    describe.table_id_ = table_id;
+    status = snapshot->DescribeTable(describe);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(describe.dimension_, 256);
+    ASSERT_EQ(snapshot->SnapshotVersion(), version);
+
+    // changes made through the snapshot meta are visible right away
+    milvus::engine::meta::TableFileSchema file_2;
+    file_2.table_id_ = table_id;
+    file_2.file_type_ = milvus::engine::meta::TableFileSchema::NEW;
+    status = snapshot->CreateTableFile(file_2);
+    ASSERT_TRUE(status.ok());
+    file_2.file_type_ = milvus::engine::meta::TableFileSchema::INDEX;
+    status = snapshot->UpdateTableFile(file_2);
+    ASSERT_TRUE(status.ok());
+    ASSERT_GT(snapshot->SnapshotVersion(), version);
+
+    status = snapshot->FilesToSearch(table_id, ids, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 2UL);
+    ids = {file_2.id_};
+    status = snapshot->FilesToSearch(table_id, ids, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 1UL);
+    ASSERT_EQ(files[0].file_id_, file_2.file_id_);
+    ids.clear();
+
+    status = snapshot->CreatePartition(table_id, "", "snapshot_tag", 0);
+    ASSERT_TRUE(status.ok());
+    std::vector<milvus::engine::meta::TableSchema> partitions;
+    status = snapshot->ShowPartitions(table_id, partitions);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(partitions.size(), 1UL);
+
+    // changes made by others, directly in the backend, are visible after reconciliation
+    file_1.file_type_ = milvus::engine::meta::TableFileSchema::TO_DELETE;
+    status = impl_->UpdateTableFile(file_1);
+    ASSERT_TRUE(status.ok());
+    status = snapshot->FilesToSearch(table_id, ids, files);
+    ASSERT_EQ(files.size(), 2UL);
+
+    snapshot->Reconcile();
+    status = snapshot->FilesToSearch(table_id, ids, files);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(files.size(), 1UL);
+
+    status = snapshot->DropTable(table_id);
+    ASSERT_TRUE(status.ok());
+    status = snapshot->DescribeTable(describe);
+    ASSERT_FALSE(status.ok());
+    status = snapshot->FilesToSearch(table_id, ids, files);
+    ASSERT_FALSE(status.ok());
+}
@@ -12,16 +12,29 @@
 #include <gtest/gtest.h>
 
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <set>
 #include <thread>
 #include <vector>
 
+#include "cache/IdCacheMgr.h"
 #include "db/IDGenerator.h"
 #include "db/IndexFailedChecker.h"
 #include "db/OngoingFileChecker.h"
 #include "db/Options.h"
 #include "db/Utils.h"
 #include "db/engine/EngineFactory.h"
+#include "db/merge/SimpleMergePolicy.h"
+#include "db/merge/TieredMergePolicy.h"
 #include "db/meta/SqliteMetaImpl.h"
+#include "segment/DeletedDocs.h"
+#include "segment/IdBloomFilter.h"
+#include "segment/IdIndex.h"
+#include "segment/SegmentReader.h"
+#include "segment/SegmentWriter.h"
+#include "segment/VectorIndex.h"
 #include "utils/Exception.h"
 #include "utils/Status.h"
 
@@ -249,3 +262,442 @@ TEST(DBMiscTest, IDGENERATOR_TEST) {
 
     ASSERT_EQ(ids.size(), unique_ids.size());
 }
+
+TEST(DBMiscTest, DELETED_DOCS_TEST) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int32_t> dis(0, 300000);
+    std::set<int32_t> expected;
+    milvus::segment::DeletedDocs deleted_docs, other_docs;
+    for (int32_t i = 0; i < 20000; ++i) {
+        int32_t offset = dis(gen);
+        expected.insert(offset);
+        if (i % 2 == 0) {
+            deleted_docs.AddDeletedDoc(offset);
+        } else {
+            other_docs.AddDeletedDoc(offset);
+        }
+    }
+    // a dense range is stored in a bitmap container
+    for (int32_t i = 70000; i < 80000; ++i) {
+        expected.insert(i);
+        deleted_docs.AddDeletedDoc(i);
+    }
+
+    deleted_docs.Merge(other_docs);
+    ASSERT_EQ(deleted_docs.GetSize(), expected.size());
+    auto offsets = deleted_docs.GetDeletedDocs();
+    ASSERT_TRUE(std::equal(offsets.begin(), offsets.end(), expected.begin()));
+
+    std::vector<uint8_t> buffer;
+    deleted_docs.GetBitmap().Serialize(buffer);
+    ASSERT_LT(buffer.size(), expected.size() * sizeof(milvus::segment::offset_t));
+    milvus::segment::RoaringBitmap bitmap;
+    ASSERT_TRUE(bitmap.Deserialize(buffer.data(), buffer.size()));
+    ASSERT_EQ(bitmap.Cardinality(), expected.size());
+    ASSERT_FALSE(bitmap.Deserialize(buffer.data(), buffer.size() - 1));
+    ASSERT_EQ(bitmap.Maximum(), static_cast<uint32_t>(*expected.rbegin()));
+
+    // the stored cardinality of the first container doesn't match its values
+    auto corrupted = buffer;
+    uint32_t cardinality;
+    size_t cardinality_pos = sizeof(uint32_t) + 2 * sizeof(uint16_t);
+    memcpy(&cardinality, corrupted.data() + cardinality_pos, sizeof(uint32_t));
+    cardinality += 1;
+    memcpy(corrupted.data() + cardinality_pos, &cardinality, sizeof(uint32_t));
+    ASSERT_FALSE(bitmap.Deserialize(corrupted.data(), corrupted.size()));
+
+    faiss::ConcurrentBitsetPtr bitset;
+    deleted_docs.GetBitset(300001, bitset);
+    for (int32_t i = 0; i <= 300000; ++i) {
+        bool deleted = expected.find(i) != expected.end();
+        ASSERT_EQ(deleted_docs.IsDeleted(i), deleted);
+        ASSERT_EQ(bitset->test(i), deleted);
+    }
+}
+
+TEST(DBMiscTest, ID_INDEX_TEST) {
+    // generated ids are already sorted, no offset array is kept
+    std::vector<milvus::segment::doc_id_t> sorted_uids = {1, 3, 5, 7, 9};
+    milvus::segment::IdIndex sorted_index(sorted_uids);
+    ASSERT_TRUE(sorted_index.GetOffsets().empty());
+    milvus::segment::offset_t offset;
+    ASSERT_TRUE(sorted_index.Find(7, offset));
+    ASSERT_EQ(offset, 3);
+    ASSERT_FALSE(sorted_index.Find(4, offset));
+
+    std::vector<milvus::segment::doc_id_t> uids = {50, 10, 40, 10, 30, 20};
+    milvus::segment::IdIndex index(uids);
+    ASSERT_EQ(index.Count(), uids.size());
+    for (size_t i = 0; i < uids.size(); ++i) {
+        ASSERT_TRUE(index.Find(uids[i], offset));
+        ASSERT_EQ(uids[offset], uids[i]);
+    }
+    ASSERT_TRUE(index.Find(10, offset));
+    ASSERT_EQ(offset, 1);
+    ASSERT_FALSE(index.Find(60, offset));
+
+    std::vector<milvus::segment::doc_id_t> ids_to_find = {0, 10, 25, 50, 70};
+    std::vector<milvus::segment::offset_t> offsets;
+    std::vector<milvus::segment::doc_id_t> found_uids;
+    index.Find(ids_to_find, offsets, found_uids);
+    ASSERT_EQ(offsets, std::vector<milvus::segment::offset_t>({1, 3, 0}));
+    ASSERT_EQ(found_uids, std::vector<milvus::segment::doc_id_t>({10, 10, 50}));
+
+    // sparse and dense lookups in a large index
+    std::vector<milvus::segment::doc_id_t> large_uids;
+    for (int64_t i = 0; i < 100000; ++i) {
+        large_uids.push_back(i * 2);
+    }
+    milvus::segment::IdIndex large_index(large_uids);
+    for (int64_t stride : {1, 7, 5003}) {
+        ids_to_find.clear();
+        offsets.clear();
+        found_uids.clear();
+        for (int64_t id = 0; id < 200010; id += stride) {
+            ids_to_find.push_back(id);
+        }
+        large_index.Find(ids_to_find, offsets, found_uids);
+        std::vector<milvus::segment::offset_t> expected;
+        for (auto id : ids_to_find) {
+            if (id % 2 == 0 && id < 200000) {
+                expected.push_back(id / 2);
+            }
+        }
+        ASSERT_EQ(offsets, expected);
+    }
+}
+
+TEST(DBMiscTest, DELETED_DOCS_FORMAT_TEST) {
+    std::string segment_dir = "/tmp/milvus_test/deleted_docs_format_test";
+    boost::filesystem::remove_all(segment_dir);
+    boost::filesystem::create_directories(segment_dir);
+
+    milvus::segment::SegmentWriter segment_writer(segment_dir);
+    milvus::segment::SegmentReader segment_reader(segment_dir);
+    ASSERT_TRUE(segment_writer.WriteDeletedDocs(std::make_shared<milvus::segment::DeletedDocs>()).ok());
+
+    // delta sequence numbers never restart after a fold, so a reader of an older base file can't take the
+    // deltas written after the fold for the deltas of its base
+    const std::string delta_prefix = "deleted_docs.delta_";
+    int64_t last_seq = -1;
+    auto check_delta_seqs = [&]() {
+        int64_t max_seq = -1;
+        boost::filesystem::directory_iterator it_end;
+        for (boost::filesystem::directory_iterator it(segment_dir); it != it_end; ++it) {
+            auto name = it->path().filename().string();
+            if (name.compare(0, delta_prefix.size(), delta_prefix) == 0) {
+                max_seq = std::max<int64_t>(max_seq, std::stoll(name.substr(delta_prefix.size())));
+            }
+        }
+        if (max_seq >= 0) {
+            ASSERT_GT(max_seq, last_seq);
+            last_seq = max_seq;
+        }
+    };
+
+    // every write appends a delta file, they are folded into the base file when there are too many
+    std::set<milvus::segment::offset_t> expected;
+    for (int32_t batch = 0; batch < 40; ++batch) {
+        auto deleted_docs = std::make_shared<milvus::segment::DeletedDocs>();
+        for (int32_t i = 0; i < 100; ++i) {
+            deleted_docs->AddDeletedDoc(batch * 50 + i);
+            expected.insert(batch * 50 + i);
+        }
+        ASSERT_TRUE(segment_writer.WriteDeletedDocs(deleted_docs).ok());
+
+        milvus::segment::DeletedDocsPtr deleted_docs_read;
+        ASSERT_TRUE(segment_reader.LoadDeletedDocs(deleted_docs_read).ok());
+        auto offsets = deleted_docs_read->GetDeletedDocs();
+        ASSERT_EQ(offsets.size(), expected.size());
+        ASSERT_TRUE(std::equal(offsets.begin(), offsets.end(), expected.begin()));
+        check_delta_seqs();
+    }
+    ASSERT_GT(last_seq, 16);
+
+    size_t file_count = std::distance(boost::filesystem::directory_iterator(segment_dir),
+                                      boost::filesystem::directory_iterator());
+    ASSERT_LT(file_count, 20);
+    boost::filesystem::remove_all(segment_dir);
+}
+
+TEST(DBMiscTest, VECTORS_INDEX_FORMAT_TEST) {
+    std::string segment_dir = "/tmp/milvus_test/vectors_index_format_test";
+    boost::filesystem::remove_all(segment_dir);
+    boost::filesystem::create_directories(segment_dir);
+
+    milvus::segment::SegmentWriter segment_writer(segment_dir);
+    milvus::segment::SegmentReader segment_reader(segment_dir);
+    milvus::segment::VectorIndexPtr vector_index;
+    ASSERT_TRUE(segment_reader.LoadVectorsIndex(vector_index).ok());
+    ASSERT_EQ(vector_index, nullptr);
+    ASSERT_FALSE(segment_reader.HasVectorsIndex());
+
+    auto make_binary = [](int64_t size, uint8_t value) {
+        std::shared_ptr<uint8_t> data(new uint8_t[size], std::default_delete<uint8_t[]>());
+        std::fill(data.get(), data.get() + size, value);
+        return data;
+    };
+
+    // a checkpoint replaces the previous one
+    for (int64_t round = 1; round <= 2; ++round) {
+        knowhere::BinarySet binary_set;
+        binary_set.Append("HNSW", make_binary(round * 1000, round), round * 1000);
+        binary_set.Append("EMPTY", make_binary(1, 0), 0);
+        ASSERT_TRUE(segment_writer.WriteVectorsIndex(std::make_shared<milvus::segment::VectorIndex>(binary_set)).ok());
+
+        ASSERT_TRUE(segment_reader.LoadVectorsIndex(vector_index).ok());
+        ASSERT_NE(vector_index, nullptr);
+        ASSERT_EQ(vector_index->Size(), round * 1000);
+        auto& binary_map = vector_index->GetBinarySet().binary_map_;
+        ASSERT_EQ(binary_map.size(), 2);
+        ASSERT_EQ(binary_map.at("EMPTY")->size, 0);
+        auto binary = binary_map.at("HNSW");
+        ASSERT_EQ(binary->size, round * 1000);
+        ASSERT_TRUE(std::all_of(binary->data.get(), binary->data.get() + binary->size,
+                                [&](uint8_t value) { return value == round; }));
+    }
+    ASSERT_TRUE(segment_reader.HasVectorsIndex());
+
+    // a truncated or corrupted checkpoint is rejected before anything is allocated from its lengths
+    std::string index_file = segment_dir + "/vectors_index";
+    auto file_size = boost::filesystem::file_size(index_file);
+    boost::filesystem::resize_file(index_file, file_size - 1);
+    ASSERT_FALSE(segment_reader.LoadVectorsIndex(vector_index).ok());
+    boost::filesystem::resize_file(index_file, file_size + 1);
+    ASSERT_FALSE(segment_reader.LoadVectorsIndex(vector_index).ok());
+    {
+        size_t binary_count = SIZE_MAX / 2;
+        std::fstream index_stream(index_file, std::ios::in | std::ios::out | std::ios::binary);
+        index_stream.write(reinterpret_cast<const char*>(&binary_count), sizeof(binary_count));
+    }
+    ASSERT_FALSE(segment_reader.LoadVectorsIndex(vector_index).ok());
+
+    boost::filesystem::remove_all(segment_dir);
+}
+
+TEST(DBMiscTest, SEGMENT_MERGE_TEST) {
+    std::string test_dir = "/tmp/milvus_test/segment_merge_test";
+    boost::filesystem::remove_all(test_dir);
+    boost::filesystem::create_directories(test_dir);
+
+    // 3 segments of 1000 vectors of 16 bytes, every 3rd vector of the second segment is deleted
+    const int64_t segment_count = 3, vector_count = 1000, code_length = 16;
+    std::vector<uint8_t> expected_data;
+    std::vector<milvus::segment::doc_id_t> expected_uids;
+    for (int64_t s = 0; s < segment_count; ++s) {
+        std::string segment_dir = test_dir + "/" + std::to_string(s);
+        std::vector<uint8_t> data(vector_count * code_length);
+        std::vector<milvus::segment::doc_id_t> uids(vector_count);
+        auto deleted_docs = std::make_shared<milvus::segment::DeletedDocs>();
+        for (int64_t i = 0; i < vector_count; ++i) {
+            uids[i] = s * vector_count + i;
+            std::fill(data.begin() + i * code_length, data.begin() + (i + 1) * code_length, uids[i] % 251);
+            if (s == 1 && i % 3 == 0) {
+                deleted_docs->AddDeletedDoc(i);
+                continue;
+            }
+            expected_uids.push_back(uids[i]);
+            expected_data.insert(expected_data.end(), data.begin() + i * code_length,
+                                 data.begin() + (i + 1) * code_length);
+        }
+
+        milvus::segment::SegmentWriter segment_writer(segment_dir);
+        ASSERT_TRUE(segment_writer.AddVectors("segment", data, uids).ok());
+        ASSERT_TRUE(segment_writer.Serialize().ok());
+        ASSERT_TRUE(segment_writer.WriteDeletedDocs(deleted_docs).ok());
+    }
+
+    std::string merged_dir = test_dir + "/merged";
+    milvus::segment::SegmentWriter merged_writer(merged_dir);
+    ASSERT_FALSE(merged_writer.Merge(merged_dir, "merged").ok());
+    for (int64_t s = 0; s < segment_count; ++s) {
+        ASSERT_TRUE(merged_writer.Merge(test_dir + "/" + std::to_string(s), "merged").ok());
+    }
+    ASSERT_EQ(merged_writer.VectorCount(), expected_uids.size());
+    ASSERT_EQ(merged_writer.Size(), expected_data.size() + expected_uids.size() * sizeof(int64_t));
+    ASSERT_TRUE(merged_writer.Serialize().ok());
+
+    milvus::segment::SegmentReader merged_reader(merged_dir);
+    ASSERT_TRUE(merged_reader.Load().ok());
+    milvus::segment::SegmentPtr merged_segment;
+    merged_reader.GetSegment(merged_segment);
+    ASSERT_EQ(merged_segment->vectors_ptr_->GetName(), "merged");
+    ASSERT_EQ(merged_segment->vectors_ptr_->GetUids(), expected_uids);
+    ASSERT_EQ(merged_segment->vectors_ptr_->GetData(), expected_data);
+    ASSERT_EQ(merged_segment->deleted_docs_ptr_->GetSize(), 0);
+
+    milvus::segment::IdBloomFilterPtr bloom_filter;
+    ASSERT_TRUE(merged_reader.LoadBloomFilter(bloom_filter).ok());
+    for (auto uid : expected_uids) {
+        ASSERT_TRUE(bloom_filter->Check(uid));
+    }
+
+    // a raw vectors file recording more bytes than it holds is rejected instead of being truncated
+    std::string corrupted_dir = test_dir + "/0";
+    milvus::segment::SegmentReader corrupted_reader(corrupted_dir);
+    milvus::segment::MappedVectorsPtr mapped_vectors;
+    ASSERT_TRUE(corrupted_reader.LoadVectorsMapped(mapped_vectors).ok());
+    ASSERT_EQ(mapped_vectors->GetDataSize(), vector_count * code_length);
+    {
+        size_t num_bytes = vector_count * code_length + 1;
+        std::fstream rv_file(corrupted_dir + "/segment.rv", std::ios::in | std::ios::out | std::ios::binary);
+        rv_file.write(reinterpret_cast<const char*>(&num_bytes), sizeof(num_bytes));
+    }
+    mapped_vectors = nullptr;
+    ASSERT_FALSE(corrupted_reader.LoadVectorsMapped(mapped_vectors).ok());
+    milvus::segment::SegmentWriter corrupted_writer(test_dir + "/corrupted");
+    ASSERT_FALSE(corrupted_writer.Merge(corrupted_dir, "corrupted").ok());
+
+    boost::filesystem::remove_all(test_dir);
+}
+
+TEST(DBMiscTest, ID_BLOOM_FILTER_TEST) {
+    const int64_t id_count = 100000;
+    milvus::segment::IdBloomFilter bloom_filter(id_count);
+    for (int64_t i = 0; i < id_count; ++i) {
+        bloom_filter.Add(i * 7);
+    }
+
+    std::vector<milvus::segment::doc_id_t> ids;
+    for (int64_t i = 0; i < 2 * id_count; ++i) {
+        ids.push_back(i * 7 + (i < id_count ? 0 : 3));
+    }
+    std::vector<uint64_t> bitmap;
+    bloom_filter.CheckMany(ids.data(), ids.size(), bitmap);
+
+    int64_t false_positives = 0;
+    for (int64_t i = 0; i < 2 * id_count; ++i) {
+        bool maybe_exist = bitmap[i >> 6] & (1ULL << (i & 63));
+        ASSERT_EQ(maybe_exist, bloom_filter.Check(ids[i]));
+        if (i < id_count) {
+            ASSERT_TRUE(maybe_exist);
+        } else if (maybe_exist) {
+            ++false_positives;
+        }
+    }
+    ASSERT_LT(false_positives, id_count * 0.03);
+}
+
+TEST(DBMiscTest, ID_CACHE_TEST) {
+    milvus::engine::DBMetaOptions options;
+    options.path_ = "/tmp/milvus_test/id_cache_test";
+    boost::filesystem::remove_all(options.path_);
+
+    milvus::engine::meta::TableFileSchema file;
+    file.table_id_ = "table";
+    file.segment_id_ = "segment";
+    file.file_id_ = "file";
+    std::string segment_dir = options.path_ + "/tables/table/segment";
+
+    const int64_t vector_count = 1000, code_length = 16;
+    std::vector<uint8_t> data(vector_count * code_length, 1);
+    std::vector<milvus::segment::doc_id_t> uids(vector_count);
+    for (int64_t i = 0; i < vector_count; ++i) {
+        uids[i] = i * 3;
+    }
+    milvus::segment::SegmentWriter segment_writer(segment_dir);
+    ASSERT_TRUE(segment_writer.AddVectors("segment", data, uids).ok());
+    ASSERT_TRUE(segment_writer.Serialize().ok());
+
+    // the second load is served by the id cache
+    auto id_cache = milvus::cache::IdCacheMgr::GetInstance();
+    milvus::segment::SegmentReader segment_reader(segment_dir);
+    milvus::segment::IdBloomFilterPtr bloom_filter_1, bloom_filter_2;
+    ASSERT_TRUE(segment_reader.LoadBloomFilter(bloom_filter_1).ok());
+    ASSERT_TRUE(id_cache->ItemExists(milvus::segment::IdBloomFilter::CacheKey(segment_dir)));
+    ASSERT_TRUE(segment_reader.LoadBloomFilter(bloom_filter_2).ok());
+    ASSERT_EQ(bloom_filter_1, bloom_filter_2);
+    ASSERT_TRUE(bloom_filter_2->Check(uids[10]));
+
+    milvus::segment::IdIndexPtr id_index_1, id_index_2;
+    ASSERT_TRUE(segment_reader.LoadIdIndex(id_index_1).ok());
+    ASSERT_TRUE(id_cache->ItemExists(milvus::segment::IdIndex::CacheKey(segment_dir)));
+    ASSERT_TRUE(segment_reader.LoadIdIndex(id_index_2).ok());
+    ASSERT_EQ(id_index_1, id_index_2);
+
+    // deleting the segment drops its cached items
+    ASSERT_TRUE(milvus::engine::utils::DeleteSegment(options, file).ok());
+    ASSERT_FALSE(boost::filesystem::exists(segment_dir));
+    ASSERT_FALSE(id_cache->ItemExists(milvus::segment::IdBloomFilter::CacheKey(segment_dir)));
+    ASSERT_FALSE(id_cache->ItemExists(milvus::segment::IdIndex::CacheKey(segment_dir)));
+
+    boost::filesystem::remove_all(options.path_);
+}
+
+namespace {
+
+milvus::engine::meta::TableFileSchema
+CreateMergeFile(const std::string& file_id, size_t row_count, size_t deleted_count, int64_t index_file_size) {
+    // dimension 16 of float, each row is 72 bytes with its uid
+    milvus::engine::meta::TableFileSchema file;
+    file.file_id_ = file_id;
+    file.dimension_ = 16;
+    file.row_count_ = row_count - deleted_count;
+    file.file_size_ = row_count * 72;
+    file.index_file_size_ = index_file_size;
+    return file;
+}
+
+}  // namespace
+
+TEST(DBMiscTest, MERGE_POLICY_TEST) {
+    const int64_t index_file_size = 72 * 4096;
+    milvus::engine::MergeFilesGroups groups;
+    milvus::engine::meta::TableFilesSchema picked;
+
+    milvus::engine::meta::TableFilesSchema files;
+    files.push_back(CreateMergeFile("a", 1000, 0, index_file_size));
+    files.push_back(CreateMergeFile("b", 64, 0, index_file_size));
+    files.push_back(CreateMergeFile("c", 80, 0, index_file_size));
+    files.push_back(CreateMergeFile("d", 100, 0, index_file_size));
+
+    // simple policy merges all files once there are enough
+    milvus::engine::SimpleMergePolicy simple_policy(2);
+    ASSERT_TRUE(simple_policy.PickFilesToMerge(files, groups).ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_EQ(groups[0].size(), files.size());
+    ASSERT_TRUE(simple_policy.PickFilesToMerge({files[0]}, groups).ok());
+    ASSERT_TRUE(groups.empty());
+    ASSERT_TRUE(simple_policy.PickFilesToCompact(files, picked).ok());
+    ASSERT_TRUE(picked.empty());
+
+    // tiered policy: 1000 rows are in tier 1, the others in tier 2
+    milvus::engine::TieredMergePolicy tiered_policy(4, 4, 0.5);
+    ASSERT_EQ(tiered_policy.Tier(files[0]), 1);
+    ASSERT_EQ(tiered_policy.Tier(files[1]), 2);
+    ASSERT_EQ(tiered_policy.Tier(CreateMergeFile("e", 4096, 0, index_file_size)), 0);
+    ASSERT_EQ(tiered_policy.Tier(CreateMergeFile("f", 1, 1, index_file_size)),
+              milvus::engine::TieredMergePolicy::MAX_TIER);
+
+    // 3 files in tier 2 are not enough to merge
+    ASSERT_TRUE(tiered_policy.PickFilesToMerge(files, groups).ok());
+    ASSERT_TRUE(groups.empty());
+
+    // the 4th file of tier 2 triggers a merge of tier 2 only
+    files.push_back(CreateMergeFile("g", 70, 0, index_file_size));
+    ASSERT_TRUE(tiered_policy.PickFilesToMerge(files, groups).ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_EQ(groups[0].size(), 4);
+    for (auto& file : groups[0]) {
+        ASSERT_NE(file.file_id_, "a");
+    }
+
+    // a file of mostly deleted vectors is merged with the rest of its tier
+    files.resize(2);
+    files.push_back(CreateMergeFile("h", 4000, 3000, index_file_size));
+    ASSERT_DOUBLE_EQ(milvus::engine::TieredMergePolicy::DeletedRatio(files.back()), 0.75);
+    ASSERT_EQ(tiered_policy.Tier(files.back()), 1);
+    ASSERT_TRUE(tiered_policy.PickFilesToMerge(files, groups).ok());
+    ASSERT_EQ(groups.size(), 1);
+    ASSERT_EQ(groups[0].size(), 2);
+
+    // a large segment is compacted when half of its vectors are deleted
+    milvus::engine::meta::TableFilesSchema large_files;
+    large_files.push_back(CreateMergeFile("i", 8192, 1000, index_file_size));
+    large_files.push_back(CreateMergeFile("j", 8192, 6000, index_file_size));
+    large_files.push_back(CreateMergeFile("k", 8192, 4096, index_file_size));
+    ASSERT_TRUE(tiered_policy.PickFilesToCompact(large_files, picked).ok());
+    ASSERT_EQ(picked.size(), 2);
+    ASSERT_EQ(picked[0].file_id_, "j");
+    ASSERT_EQ(picked[1].file_id_, "k");
+}
@@ -15,7 +15,9 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <atomic>
 #include <fstream>
+#include <set>
 #include <sstream>
 #include <thread>
 
@@ -637,6 +639,82 @@ TEST(WalTest, MANAGER_TEST) {
     ASSERT_TRUE(record.table_id.empty());
 }
 
+TEST(WalTest, MANAGER_GROUP_COMMIT_TEST) {
+    MakeEmptyTestPath();
+
+    milvus::engine::DBMetaOptions opt = {WAL_GTEST_PATH};
+    milvus::engine::meta::MetaPtr meta = std::make_shared<milvus::engine::meta::TestWalMeta>(opt);
+
+    milvus::engine::wal::MXLogConfiguration wal_config;
+    wal_config.mxlog_path = WAL_GTEST_PATH;
+    wal_config.buffer_size = 64;
+    wal_config.recovery_error_ignore = true;
+    wal_config.durability = milvus::engine::wal::MXLogDurability::Sync;
+
+    std::shared_ptr<milvus::engine::wal::WalManager> manager =
+        std::make_shared<milvus::engine::wal::WalManager>(wal_config);
+    ASSERT_EQ(manager->Init(meta), milvus::WAL_SUCCESS);
+
+    // small buffer, so that wal files are switched while inserting
+    manager->mxlog_config_.buffer_size = 16 * 1024;
+    manager->p_buffer_->mxlog_buffer_size_ = 16 * 1024;
+
+    std::string table_id = "table1";
+    manager->CreateTable(table_id);
+
+    const int64_t THREAD_COUNT = 8;
+    const int64_t INSERT_COUNT = 50;
+    const int64_t VECTOR_COUNT = 10;
+    const int64_t DIM = 16;
+    std::vector<std::thread> threads;
+    std::atomic<int64_t> failed(0);
+    for (int64_t t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int64_t i = 0; i < INSERT_COUNT; ++i) {
+                std::vector<int64_t> ids;
+                for (int64_t j = 0; j < VECTOR_COUNT; ++j) {
+                    ids.push_back((t * INSERT_COUNT + i) * VECTOR_COUNT + j);
+                }
+                std::vector<float> data(VECTOR_COUNT * DIM, (float)t);
+                if (i % 5 == 4) {
+                    if (!manager->DeleteById(table_id, ids)) {
+                        ++failed;
+                    }
+                } else if (!manager->Insert(table_id, "", ids, data)) {
+                    ++failed;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(failed, 0);
+
+    // every request is synced before it returns
+    ASSERT_GE(manager->synced_lsn_, manager->last_applied_lsn_);
+
+    // records of all requests can be read back
+    std::set<int64_t> inserted, deleted;
+    milvus::engine::wal::MXLogRecord record;
+    while (true) {
+        ASSERT_EQ(manager->GetNextRecord(record), milvus::WAL_SUCCESS);
+        if (record.type == milvus::engine::wal::MXLogType::None) {
+            break;
+        }
+        ASSERT_EQ(record.table_id, table_id);
+        for (uint32_t i = 0; i < record.length; ++i) {
+            if (record.type == milvus::engine::wal::MXLogType::InsertVector) {
+                inserted.insert(record.ids[i]);
+            } else {
+                deleted.insert(record.ids[i]);
+            }
+        }
+    }
+    ASSERT_EQ(inserted.size() + deleted.size(), THREAD_COUNT * INSERT_COUNT * VECTOR_COUNT);
+    ASSERT_EQ(deleted.size(), THREAD_COUNT * INSERT_COUNT / 5 * VECTOR_COUNT);
+}
+
 #if 0
 TEST(WalTest, LargeScaleRecords) {
     std::string data_path = "/home/zilliz/workspace/data/";
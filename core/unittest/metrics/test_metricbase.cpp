@@ -25,6 +25,7 @@ TEST(MetricbaseTest, METRICBASE_TEST) {
     instance.IndexFileSizeHistogramObserve(1.0);
     instance.BuildIndexDurationSecondsHistogramObserve(1.0);
     instance.CpuCacheUsageGaugeSet(1.0);
+    instance.CpuCacheHitRatioGaugeSet("lru", 0.5);
     instance.GpuCacheUsageGaugeSet();
     instance.MetaAccessTotalIncrement();
     instance.MetaAccessDurationSecondsHistogramObserve(1.0);
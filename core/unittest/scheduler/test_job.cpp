@@ -11,6 +11,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 #include "scheduler/job/Job.h"
 #include "scheduler/job/BuildIndexJob.h"
 #include "scheduler/job/DeleteJob.h"
@@ -41,5 +44,73 @@ TEST(JobTest, TestJob) {
     search_ptr->AddIndexFile(nullptr);
 }
 
+TEST(JobTest, SearchJobReduceTest) {
+    const size_t NQ = 50;
+    const size_t TOPK = 10;
+    const size_t FILE_COUNT = 30;
+
+    for (bool ascending : {true, false}) {
+        engine::VectorsData vectors;
+        vectors.vector_count_ = NQ;
+        auto search_job = std::make_shared<SearchJob>(nullptr, TOPK, milvus::json(), vectors);
+        for (size_t f = 0; f < FILE_COUNT; ++f) {
+            auto file = std::make_shared<engine::meta::TableFileSchema>();
+            file->id_ = f;
+            ASSERT_TRUE(search_job->AddIndexFile(file));
+        }
+
+        // every file returns k results per query, k is less than topk for some files; there are more files than
+        // the results kept before they are merged, so some are merged as they are added
+        std::default_random_engine e(42);
+        std::uniform_real_distribution<float> dist(0.0f, 100.0f);
+        std::vector<std::vector<std::pair<float, int64_t>>> expected(NQ);
+        for (size_t f = 0; f < FILE_COUNT; ++f) {
+            TaskResult result;
+            result.k_ = (f % 3 == 0) ? TOPK / 2 : TOPK;
+            result.stride_ = TOPK;
+            result.ascending_ = ascending;
+            result.ids_.resize(NQ * TOPK, -1);
+            result.distances_.resize(NQ * TOPK, std::numeric_limits<float>::max());
+            for (size_t i = 0; i < NQ; ++i) {
+                std::vector<float> distances(result.k_);
+                for (auto& d : distances) {
+                    d = dist(e);
+                }
+                if (ascending) {
+                    std::sort(distances.begin(), distances.end());
+                } else {
+                    std::sort(distances.begin(), distances.end(), std::greater<float>());
+                }
+                for (size_t j = 0; j < result.k_; ++j) {
+                    int64_t id = f * 1000000 + i * 1000 + j;
+                    result.ids_[i * TOPK + j] = id;
+                    result.distances_[i * TOPK + j] = distances[j];
+                    expected[i].emplace_back(distances[j], id);
+                }
+            }
+            search_job->AddResult(f, std::move(result));
+            search_job->SearchDone(f);
+        }
+        search_job->WaitResult();
+
+        auto& ids = search_job->GetResultIds();
+        auto& distances = search_job->GetResultDistances();
+        ASSERT_EQ(ids.size(), NQ * TOPK);
+        ASSERT_EQ(distances.size(), NQ * TOPK);
+        for (size_t i = 0; i < NQ; ++i) {
+            auto& row = expected[i];
+            if (ascending) {
+                std::sort(row.begin(), row.end());
+            } else {
+                std::sort(row.begin(), row.end(), std::greater<std::pair<float, int64_t>>());
+            }
+            for (size_t j = 0; j < TOPK; ++j) {
+                ASSERT_EQ(distances[i * TOPK + j], row[j].first);
+                ASSERT_EQ(ids[i * TOPK + j], row[j].second);
+            }
+        }
+    }
+}
+
 }  // namespace scheduler
 }  // namespace milvus
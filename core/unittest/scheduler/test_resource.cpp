@@ -274,6 +274,58 @@ TEST_F(ResourceAdvanceTest, TEST_RESOURCE_TEST) {
     ASSERT_EQ(null_resource, nullptr);
 }
 
+TEST(ResourceWorkerTest, MULTI_WORKER_TEST) {
+    const uint64_t WORKER_NUM = 4;
+    const uint64_t NUM = 64;
+    auto resource = std::make_shared<TestResource>("test", 0, true);
+    resource->SetWorkerNum(WORKER_NUM);
+    ASSERT_EQ(resource->worker_num(), WORKER_NUM);
+
+    uint64_t finish_count = 0;
+    std::mutex finish_mutex;
+    std::condition_variable finish_cv;
+    ResourceWPtr weak_resource = resource;
+    resource->RegisterSubscriber([&](EventPtr event) {
+        auto res = weak_resource.lock();
+        if (event->Type() == EventType::LOAD_COMPLETED) {
+            res->WakeupExecutor();
+        } else if (event->Type() == EventType::FINISH_TASK) {
+            {
+                std::lock_guard<std::mutex> lock(finish_mutex);
+                ++finish_count;
+            }
+            finish_cv.notify_one();
+            res->WakeupLoader();
+        }
+    });
+    resource->Start();
+
+    std::vector<std::shared_ptr<TestTask>> tasks;
+    TableFileSchemaPtr dummy = nullptr;
+    for (uint64_t i = 0; i < NUM; ++i) {
+        auto label = std::make_shared<SpecResLabel>(resource);
+        auto task = std::make_shared<TestTask>(std::make_shared<server::Context>("dummy_request_id"), dummy, label);
+        std::vector<std::string> path{resource->name()};
+        task->path() = Path(path, 0);
+        tasks.push_back(task);
+        resource->task_table().Put(task);
+    }
+    resource->WakeupLoader();
+
+    {
+        std::unique_lock<std::mutex> lock(finish_mutex);
+        finish_cv.wait(lock, [&] { return finish_count == NUM; });
+    }
+    resource->Stop();
+
+    // every task is loaded and executed exactly once by one of the workers
+    for (uint64_t i = 0; i < NUM; ++i) {
+        ASSERT_EQ(tasks[i]->load_count_, 1);
+        ASSERT_EQ(tasks[i]->exec_count_, 1);
+    }
+    ASSERT_EQ(resource->TotalTasks(), NUM);
+}
+
 TEST(Connection_Test, CONNECTION_TEST) {
     std::string connection_name = "cpu";
     uint64_t speed = 982;
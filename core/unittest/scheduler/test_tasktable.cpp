@@ -255,6 +255,46 @@ TEST_F(TaskTableBaseTest, PICK_TO_LOAD_CACHE) {
     ASSERT_EQ(indexes[0] % empty_table_.capacity(), 2);
 }
 
+TEST_F(TaskTableBaseTest, PICK_TO_LOAD_MAX_LOADED) {
+    const size_t NUM_TASKS = 10;
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+        empty_table_.Put(task1_);
+    }
+    empty_table_[0]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    empty_table_[1]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    empty_table_[2]->state = milvus::scheduler::TaskTableItemState::LOADING;
+
+    // tasks loading count as loaded
+    auto indexes = empty_table_.PickToLoad(1);
+    ASSERT_TRUE(indexes.empty());
+
+    empty_table_.SetMaxLoaded(4);
+    indexes = empty_table_.PickToLoad(1);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 3);
+}
+
+TEST_F(TaskTableBaseTest, PICK_NOT_SKIP_LOADING) {
+    const size_t NUM_TASKS = 10;
+    for (size_t i = 0; i < NUM_TASKS; ++i) {
+        empty_table_.Put(task1_);
+    }
+    empty_table_[0]->state = milvus::scheduler::TaskTableItemState::LOADING;
+    empty_table_[1]->state = milvus::scheduler::TaskTableItemState::EXECUTED;
+    empty_table_[2]->state = milvus::scheduler::TaskTableItemState::LOADED;
+
+    auto indexes = empty_table_.PickToExecute(1);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 2);
+
+    // the task still loading is picked once loaded
+    empty_table_[0]->state = milvus::scheduler::TaskTableItemState::LOADED;
+    empty_table_[2]->state = milvus::scheduler::TaskTableItemState::EXECUTED;
+    indexes = empty_table_.PickToExecute(1);
+    ASSERT_EQ(indexes.size(), 1);
+    ASSERT_EQ(indexes[0] % empty_table_.capacity(), 0);
+}
+
 TEST_F(TaskTableBaseTest, PICK_TO_EXECUTE) {
     const size_t NUM_TASKS = 10;
     for (size_t i = 0; i < NUM_TASKS; ++i) {
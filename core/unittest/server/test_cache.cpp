@@ -13,11 +13,17 @@
 #include <fiu-control.h>
 #include <fiu-local.h>
 #include "utils/Error.h"
+#include "utils/TimeRecorder.h"
 #include "wrapper/VecIndex.h"
 
 #include "cache/CpuCacheMgr.h"
 #include "cache/GpuCacheMgr.h"
 
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
 namespace {
 
 class InvalidCacheMgr : public milvus::cache::CacheMgr<milvus::cache::DataObjPtr> {
@@ -33,6 +39,20 @@ class LessItemCacheMgr : public milvus::cache::CacheMgr<milvus::cache::DataObjPt
     }
 };
 
+class MockDataObj : public milvus::cache::DataObj {
+ public:
+    explicit MockDataObj(int64_t size) : size_(size) {
+    }
+
+    int64_t
+    Size() override {
+        return size_;
+    }
+
+ private:
+    int64_t size_;
+};
+
 class MockVecIndex : public milvus::engine::VecIndex {
  public:
     MockVecIndex(int64_t dim, int64_t total) : dimension_(dim), ntotal_(total) {
@@ -270,3 +290,195 @@ TEST(CacheTest, PARTIAL_LRU_TEST) {
 
     ASSERT_ANY_THROW(lru.get(-1));
 }
+
+TEST(CacheTest, SHARDED_CACHE_TEST) {
+    constexpr int64_t ITEM_SIZE = 1024;
+    constexpr int64_t ITEM_COUNT = 100;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 16, 1UL << 32, 8);
+    ASSERT_EQ(cache.shard_num(), 8);
+
+    for (int64_t i = 0; i < ITEM_COUNT; i++) {
+        cache.insert("index_" + std::to_string(i), std::make_shared<MockDataObj>(ITEM_SIZE));
+        ASSERT_LE(cache.usage(), cache.capacity());
+    }
+    ASSERT_EQ(cache.usage(), cache.size() * ITEM_SIZE);
+
+    // the capacity budget is global, eviction still follows the least recently used order across shards
+    ASSERT_EQ(cache.get("index_0"), nullptr);
+    ASSERT_NE(cache.get("index_" + std::to_string(ITEM_COUNT - 1)), nullptr);
+
+    cache.erase("index_" + std::to_string(ITEM_COUNT - 1));
+    ASSERT_FALSE(cache.exists("index_" + std::to_string(ITEM_COUNT - 1)));
+    ASSERT_EQ(cache.usage(), cache.size() * ITEM_SIZE);
+
+    cache.clear();
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.usage(), 0);
+}
+
+TEST(CacheTest, SET_CAPACITY_TEST) {
+    constexpr int64_t UNIT = 1024;
+    // above capacity * freemem_percent, so that any eviction would show
+    constexpr int64_t ITEM_COUNT = 95;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(UNIT * 100, 1UL << 32, 4);
+    for (int64_t i = 0; i < ITEM_COUNT; i++) {
+        cache.insert("index_" + std::to_string(i), std::make_shared<MockDataObj>(UNIT));
+    }
+    ASSERT_EQ(cache.size(), ITEM_COUNT);
+
+    // the entries that fit are kept when the capacity is set again or raised
+    cache.set_capacity(UNIT * 100);
+    ASSERT_EQ(cache.size(), ITEM_COUNT);
+    cache.set_capacity(UNIT * 200);
+    ASSERT_EQ(cache.size(), ITEM_COUNT);
+    ASSERT_EQ(cache.usage(), ITEM_COUNT * UNIT);
+
+    // a capacity below the usage evicts
+    cache.set_capacity(UNIT * 30);
+    ASSERT_LE(cache.usage(), cache.capacity());
+    ASSERT_TRUE(cache.exists("index_" + std::to_string(ITEM_COUNT - 1)));
+}
+
+TEST(CacheTest, SCAN_RESISTANT_POLICY_TEST) {
+    constexpr int64_t ITEM_SIZE = 1024;
+    constexpr int64_t HOT_COUNT = 8;
+    constexpr int64_t SCAN_COUNT = 200;
+
+    auto run = [&](milvus::cache::CachePolicyType policy, int64_t& hot_survived, uint64_t& hit, uint64_t& miss) {
+        milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * 20, 1UL << 32, 1, policy);
+        auto access = [&](const std::string& key) {
+            if (cache.get(key) == nullptr) {
+                cache.insert(key, std::make_shared<MockDataObj>(ITEM_SIZE));
+            }
+        };
+
+        // hot items are accessed repeatedly, mixed with some items accessed once
+        int64_t cold = 0;
+        for (int64_t round = 0; round < 5; round++) {
+            for (int64_t i = 0; i < HOT_COUNT; i++) {
+                access("hot_" + std::to_string(i));
+            }
+            for (int64_t i = 0; i < 10; i++) {
+                access("cold_" + std::to_string(cold++));
+            }
+        }
+
+        // one-off scan of much more items than the cache can hold
+        for (int64_t i = 0; i < SCAN_COUNT; i++) {
+            access("scan_" + std::to_string(i));
+            ASSERT_LE(cache.usage(), cache.capacity());
+        }
+        ASSERT_EQ(cache.usage(), cache.size() * ITEM_SIZE);
+
+        hot_survived = 0;
+        for (int64_t i = 0; i < HOT_COUNT; i++) {
+            hot_survived += cache.exists("hot_" + std::to_string(i)) ? 1 : 0;
+        }
+        hit = cache.hit_count();
+        miss = cache.miss_count();
+    };
+
+    int64_t hot_survived;
+    uint64_t hit, miss;
+    run(milvus::cache::CachePolicyType::LRU, hot_survived, hit, miss);
+    ASSERT_EQ(hot_survived, 0);
+    ASSERT_EQ(hit + miss, 5 * (HOT_COUNT + 10) + SCAN_COUNT);
+
+    run(milvus::cache::CachePolicyType::TWO_QUEUE, hot_survived, hit, miss);
+    ASSERT_EQ(hot_survived, HOT_COUNT);
+    ASSERT_EQ(hit + miss, 5 * (HOT_COUNT + 10) + SCAN_COUNT);
+
+    run(milvus::cache::CachePolicyType::W_TINY_LFU, hot_survived, hit, miss);
+    ASSERT_EQ(hot_survived, HOT_COUNT);
+    ASSERT_EQ(hit + miss, 5 * (HOT_COUNT + 10) + SCAN_COUNT);
+    ASSERT_EQ(hit, 4 * HOT_COUNT);
+}
+
+TEST(CacheTest, SIZE_CLASS_EVICTION_TEST) {
+    constexpr int64_t UNIT = 1024;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(UNIT * 100, 1UL << 32, 1);
+
+    cache.insert("big", std::make_shared<MockDataObj>(UNIT * 40));
+    for (int64_t i = 0; i < 60; i++) {
+        cache.insert("small_" + std::to_string(i), std::make_shared<MockDataObj>(UNIT));
+    }
+    ASSERT_EQ(cache.usage(), cache.capacity());
+
+    // the oldest item is much bigger than the memory to be freed, smaller items go first
+    cache.insert("small_60", std::make_shared<MockDataObj>(UNIT));
+    ASSERT_LE(cache.usage(), cache.capacity() * cache.freemem_percent());
+    ASSERT_TRUE(cache.exists("big"));
+    ASSERT_FALSE(cache.exists("small_0"));
+    ASSERT_TRUE(cache.exists("small_60"));
+
+    // an item of the same size class is freed for a big insert
+    cache.insert("big_2", std::make_shared<MockDataObj>(UNIT * 50));
+    ASSERT_LE(cache.usage(), cache.capacity() * cache.freemem_percent());
+    ASSERT_FALSE(cache.exists("big"));
+    ASSERT_TRUE(cache.exists("big_2"));
+}
+
+TEST(CacheTest, BACKGROUND_RECLAIM_TEST) {
+    constexpr int64_t UNIT = 1024;
+    milvus::cache::Cache<milvus::cache::DataObjPtr> cache(UNIT * 100, 1UL << 32, 4);
+    cache.set_high_watermark(0.9);
+
+    auto wait_for_reclaim = [&]() {
+        for (int i = 0; i < 500 && cache.usage() > cache.capacity() * cache.high_watermark(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    };
+
+    // inserting threads only free memory beyond the capacity, the rest is freed in background
+    for (int64_t i = 0; i < 200; i++) {
+        cache.insert("index_" + std::to_string(i), std::make_shared<MockDataObj>(UNIT));
+        ASSERT_LE(cache.usage(), cache.capacity());
+    }
+    wait_for_reclaim();
+    ASSERT_LE(cache.usage(), cache.capacity() * cache.high_watermark());
+    ASSERT_EQ(cache.usage(), cache.size() * UNIT);
+    ASSERT_TRUE(cache.exists("index_199"));
+
+    // an item larger than the capacity is kept until the next insert
+    cache.insert("huge", std::make_shared<MockDataObj>(UNIT * 200));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(cache.exists("huge"));
+    ASSERT_EQ(cache.size(), 1);
+}
+
+TEST(CacheTest, SHARDED_CACHE_BENCHMARK_TEST) {
+    constexpr int64_t ITEM_SIZE = 1024;
+    constexpr int64_t KEY_COUNT = 512;
+    constexpr int64_t TOTAL_OPS = 1 << 16;
+
+    for (uint64_t shard_num : {1, 16}) {
+        for (int64_t thread_num : {1, 2, 4, 8, 16, 32, 64}) {
+            milvus::cache::Cache<milvus::cache::DataObjPtr> cache(ITEM_SIZE * KEY_COUNT / 2, 1UL << 32, shard_num);
+            auto worker = [&](int64_t seed) {
+                int64_t ops = TOTAL_OPS / thread_num;
+                for (int64_t i = 0; i < ops; ++i) {
+                    std::string key = "index_" + std::to_string((i * 31 + seed) % KEY_COUNT);
+                    if (i % 10 == 0) {
+                        cache.insert(key, std::make_shared<MockDataObj>(ITEM_SIZE));
+                    } else {
+                        cache.get(key);
+                    }
+                }
+            };
+
+            milvus::TimeRecorder rc("shards: " + std::to_string(shard_num) + ", threads: " +
+                                    std::to_string(thread_num));
+            std::vector<std::thread> threads;
+            for (int64_t t = 0; t < thread_num; ++t) {
+                threads.emplace_back(worker, t);
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            rc.ElapseFromBegin(std::to_string(TOTAL_OPS) + " ops");
+
+            ASSERT_LE(cache.usage(), cache.capacity());
+            ASSERT_EQ(cache.usage(), cache.size() * ITEM_SIZE);
+        }
+    }
+}
@@ -158,6 +158,21 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetServerConfigWebPort(str_val).ok());
     ASSERT_TRUE(str_val == web_port);
 
+    int64_t request_worker_num = 16;
+    ASSERT_TRUE(config.SetServerConfigRequestWorkerNum(std::to_string(request_worker_num)).ok());
+    ASSERT_TRUE(config.GetServerConfigRequestWorkerNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == request_worker_num);
+
+    int64_t dql_max_in_flight = 12;
+    ASSERT_TRUE(config.SetServerConfigDqlMaxInFlight(std::to_string(dql_max_in_flight)).ok());
+    ASSERT_TRUE(config.GetServerConfigDqlMaxInFlight(int64_val).ok());
+    ASSERT_TRUE(int64_val == dql_max_in_flight);
+
+    int64_t dql_max_queue = 0;
+    ASSERT_TRUE(config.SetServerConfigDqlMaxQueue(std::to_string(dql_max_queue)).ok());
+    ASSERT_TRUE(config.GetServerConfigDqlMaxQueue(int64_val).ok());
+    ASSERT_TRUE(int64_val == dql_max_queue);
+
     std::string server_mode = "cluster_readonly";
     ASSERT_TRUE(config.SetServerConfigDeployMode(server_mode).ok());
     ASSERT_TRUE(config.GetServerConfigDeployMode(str_val).ok());
@@ -189,6 +204,21 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetDBConfigAutoFlushInterval(int64_val).ok());
     ASSERT_TRUE(int64_val == db_auto_flush_interval);
 
+    std::string db_merge_policy = "tiered";
+    ASSERT_TRUE(config.SetDBConfigMergePolicy(db_merge_policy).ok());
+    ASSERT_TRUE(config.GetDBConfigMergePolicy(str_val).ok());
+    ASSERT_TRUE(str_val == db_merge_policy);
+
+    int64_t db_merge_io_rate_limit = 100;
+    ASSERT_TRUE(config.SetDBConfigMergeIORateLimit(std::to_string(db_merge_io_rate_limit)).ok());
+    ASSERT_TRUE(config.GetDBConfigMergeIORateLimit(int64_val).ok());
+    ASSERT_TRUE(int64_val == db_merge_io_rate_limit);
+
+    int64_t db_meta_snapshot_interval = 5;
+    ASSERT_TRUE(config.SetDBConfigMetaSnapshotInterval(std::to_string(db_meta_snapshot_interval)).ok());
+    ASSERT_TRUE(config.GetDBConfigMetaSnapshotInterval(int64_val).ok());
+    ASSERT_TRUE(int64_val == db_meta_snapshot_interval);
+
     /* storage config */
     std::string storage_primary_path = "/home/zilliz";
     ASSERT_TRUE(config.SetStorageConfigPrimaryPath(storage_primary_path).ok());
@@ -230,6 +260,21 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetStorageConfigS3Bucket(str_val).ok());
     ASSERT_TRUE(str_val == storage_s3_bucket);
 
+    int64_t storage_s3_read_chunk_size = 16;
+    ASSERT_TRUE(config.SetStorageConfigS3ReadChunkSize(std::to_string(storage_s3_read_chunk_size)).ok());
+    ASSERT_TRUE(config.GetStorageConfigS3ReadChunkSize(int64_val).ok());
+    ASSERT_TRUE(int64_val == storage_s3_read_chunk_size);
+
+    int64_t storage_s3_read_thread_num = 4;
+    ASSERT_TRUE(config.SetStorageConfigS3ReadThreadNum(std::to_string(storage_s3_read_thread_num)).ok());
+    ASSERT_TRUE(config.GetStorageConfigS3ReadThreadNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == storage_s3_read_thread_num);
+
+    int64_t storage_s3_disk_cache_capacity = 100;
+    ASSERT_TRUE(config.SetStorageConfigS3DiskCacheCapacity(std::to_string(storage_s3_disk_cache_capacity)).ok());
+    ASSERT_TRUE(config.GetStorageConfigS3DiskCacheCapacity(int64_val).ok());
+    ASSERT_TRUE(int64_val == storage_s3_disk_cache_capacity);
+
     /* metric config */
     bool metric_enable_monitor = false;
     ASSERT_TRUE(config.SetMetricConfigEnableMonitor(std::to_string(metric_enable_monitor)).ok());
@@ -267,6 +312,26 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetCacheConfigCacheInsertData(bool_val).ok());
     ASSERT_TRUE(bool_val == cache_insert_data);
 
+    int64_t cache_cpu_cache_shard_num = 8;
+    ASSERT_TRUE(config.SetCacheConfigCpuCacheShardNum(std::to_string(cache_cpu_cache_shard_num)).ok());
+    ASSERT_TRUE(config.GetCacheConfigCpuCacheShardNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == cache_cpu_cache_shard_num);
+
+    std::string cache_cpu_cache_policy = "tinylfu";
+    ASSERT_TRUE(config.SetCacheConfigCpuCachePolicy(cache_cpu_cache_policy).ok());
+    ASSERT_TRUE(config.GetCacheConfigCpuCachePolicy(str_val).ok());
+    ASSERT_TRUE(str_val == cache_cpu_cache_policy);
+
+    float cache_cpu_cache_watermark = 0.9;
+    ASSERT_TRUE(config.SetCacheConfigCpuCacheWatermark(std::to_string(cache_cpu_cache_watermark)).ok());
+    ASSERT_TRUE(config.GetCacheConfigCpuCacheWatermark(float_val).ok());
+    ASSERT_TRUE(float_val == cache_cpu_cache_watermark);
+
+    int64_t cache_id_cache_capacity = 2;
+    ASSERT_TRUE(config.SetCacheConfigIdCacheCapacity(std::to_string(cache_id_cache_capacity)).ok());
+    ASSERT_TRUE(config.GetCacheConfigIdCacheCapacity(int64_val).ok());
+    ASSERT_TRUE(int64_val == cache_id_cache_capacity);
+
     /* engine config */
     int64_t engine_use_blas_threshold = 50;
     ASSERT_TRUE(config.SetEngineConfigUseBlasThreshold(std::to_string(engine_use_blas_threshold)).ok());
@@ -283,6 +348,36 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetEngineConfigUseAVX512(bool_val).ok());
     ASSERT_TRUE(bool_val == engine_use_avx512);
 
+    bool engine_use_mmap = true;
+    ASSERT_TRUE(config.SetEngineConfigUseMmap(std::to_string(engine_use_mmap)).ok());
+    ASSERT_TRUE(config.GetEngineConfigUseMmap(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_use_mmap);
+
+    int64_t engine_search_worker_num = 1;
+    ASSERT_TRUE(config.SetEngineConfigSearchWorkerNum(std::to_string(engine_search_worker_num)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchWorkerNum(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_worker_num);
+
+    int64_t engine_search_batch_max_nq = 128;
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchMaxNq(std::to_string(engine_search_batch_max_nq)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchBatchMaxNq(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_batch_max_nq);
+
+    int64_t engine_search_batch_max_wait = 5;
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchMaxWait(std::to_string(engine_search_batch_max_wait)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSearchBatchMaxWait(int64_val).ok());
+    ASSERT_TRUE(int64_val == engine_search_batch_max_wait);
+
+    bool engine_incremental_hnsw = true;
+    ASSERT_TRUE(config.SetEngineConfigIncrementalHnsw(std::to_string(engine_incremental_hnsw)).ok());
+    ASSERT_TRUE(config.GetEngineConfigIncrementalHnsw(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_incremental_hnsw);
+
+    bool engine_shared_ivf_quantizer = true;
+    ASSERT_TRUE(config.SetEngineConfigSharedIvfQuantizer(std::to_string(engine_shared_ivf_quantizer)).ok());
+    ASSERT_TRUE(config.GetEngineConfigSharedIvfQuantizer(bool_val).ok());
+    ASSERT_TRUE(bool_val == engine_shared_ivf_quantizer);
+
 #ifdef MILVUS_GPU_VERSION
     int64_t engine_gpu_search_threshold = 800;
     ASSERT_TRUE(config.SetEngineConfigGpuSearchThreshold(std::to_string(engine_gpu_search_threshold)).ok());
@@ -346,6 +441,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_TEST) {
     ASSERT_TRUE(config.GetWalConfigBufferSize(int64_val).ok());
     ASSERT_TRUE(int64_val == wal_buffer_size);
 
+    std::string wal_durability = "fsync";
+    ASSERT_TRUE(config.SetWalConfigDurability(wal_durability).ok());
+    ASSERT_TRUE(config.GetWalConfigDurability(str_val).ok());
+    ASSERT_TRUE(str_val == wal_durability);
+
     std::string wal_path = "/tmp/aaa/wal";
     ASSERT_TRUE(config.SetWalConfigWalPath(wal_path).ok());
     ASSERT_TRUE(config.GetWalConfigWalPath(str_val).ok());
@@ -563,6 +663,12 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetServerConfigWebPort("99999").ok());
     ASSERT_FALSE(config.SetServerConfigWebPort("-1").ok());
 
+    ASSERT_FALSE(config.SetServerConfigRequestWorkerNum("0").ok());
+    ASSERT_FALSE(config.SetServerConfigRequestWorkerNum("1000").ok());
+    ASSERT_FALSE(config.SetServerConfigDqlMaxInFlight("a").ok());
+    ASSERT_FALSE(config.SetServerConfigDqlMaxInFlight("0").ok());
+    ASSERT_FALSE(config.SetServerConfigDqlMaxQueue("-1").ok());
+
     ASSERT_FALSE(config.SetServerConfigDeployMode("cluster").ok());
 
     ASSERT_FALSE(config.SetServerConfigTimeZone("GM").ok());
@@ -580,6 +686,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetDBConfigAutoFlushInterval("0.1").ok());
 
+    ASSERT_FALSE(config.SetDBConfigMergePolicy("leveled").ok());
+
+    ASSERT_FALSE(config.SetDBConfigMergeIORateLimit("-1").ok());
+    ASSERT_FALSE(config.SetDBConfigMetaSnapshotInterval("1s").ok());
+
     /* storage config */
     ASSERT_FALSE(config.SetStorageConfigPrimaryPath("").ok());
 
@@ -598,6 +709,14 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetStorageConfigS3Bucket("").ok());
 
+    ASSERT_FALSE(config.SetStorageConfigS3ReadChunkSize("0").ok());
+    ASSERT_FALSE(config.SetStorageConfigS3ReadChunkSize("2048").ok());
+
+    ASSERT_FALSE(config.SetStorageConfigS3ReadThreadNum("0").ok());
+    ASSERT_FALSE(config.SetStorageConfigS3ReadThreadNum("100").ok());
+
+    ASSERT_FALSE(config.SetStorageConfigS3DiskCacheCapacity("-1").ok());
+
     /* metric config */
     ASSERT_FALSE(config.SetMetricConfigEnableMonitor("Y").ok());
 
@@ -622,6 +741,20 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetCacheConfigCacheInsertData("N").ok());
 
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheShardNum("a").ok());
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheShardNum("0").ok());
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheShardNum("1024").ok());
+
+    ASSERT_FALSE(config.SetCacheConfigCpuCachePolicy("lfu").ok());
+    ASSERT_FALSE(config.SetCacheConfigCpuCachePolicy("").ok());
+
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheWatermark("a").ok());
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheWatermark("0.0").ok());
+    ASSERT_FALSE(config.SetCacheConfigCpuCacheWatermark("1.1").ok());
+
+    ASSERT_FALSE(config.SetCacheConfigIdCacheCapacity("a").ok());
+    ASSERT_FALSE(config.SetCacheConfigIdCacheCapacity("0").ok());
+
     /* engine config */
     ASSERT_FALSE(config.SetEngineConfigUseBlasThreshold("0xff").ok());
 
@@ -631,6 +764,17 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
 
     ASSERT_FALSE(config.SetEngineConfigUseAVX512("N").ok());
 
+    ASSERT_FALSE(config.SetEngineConfigUseMmap("N").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchWorkerNum("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchWorkerNum("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchWorkerNum("10000").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchMaxNq("0").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchMaxNq("100000").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchMaxWait("a").ok());
+    ASSERT_FALSE(config.SetEngineConfigSearchBatchMaxWait("100000").ok());
+    ASSERT_FALSE(config.SetEngineConfigIncrementalHnsw("N").ok());
+    ASSERT_FALSE(config.SetEngineConfigSharedIvfQuantizer("N").ok());
+
 #ifdef MILVUS_GPU_VERSION
     ASSERT_FALSE(config.SetEngineConfigGpuSearchThreshold("-1").ok());
 #endif
@@ -660,6 +804,7 @@ TEST_F(ConfigTest, SERVER_CONFIG_INVALID_TEST) {
     ASSERT_FALSE(config.SetWalConfigWalPath("").ok());
     ASSERT_FALSE(config.SetWalConfigBufferSize("-1").ok());
     ASSERT_FALSE(config.SetWalConfigBufferSize("a").ok());
+    ASSERT_FALSE(config.SetWalConfigDurability("abc").ok());
 }
 
 TEST_F(ConfigTest, SERVER_CONFIG_TEST) {
@@ -711,6 +856,21 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_time_zone_fail");
 
+    fiu_enable("check_config_request_worker_num_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_request_worker_num_fail");
+
+    fiu_enable("check_config_dql_max_in_flight_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_dql_max_in_flight_fail");
+
+    fiu_enable("check_config_dql_max_queue_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_dql_max_queue_fail");
+
     /* db config */
     fiu_enable("check_config_primary_path_fail", 1, NULL, 0);
     s = config.ValidateConfig();
@@ -765,6 +925,26 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_cache_insert_data_fail");
 
+    fiu_enable("check_config_cpu_cache_shard_num_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_cpu_cache_shard_num_fail");
+
+    fiu_enable("check_config_cpu_cache_policy_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_cpu_cache_policy_fail");
+
+    fiu_enable("check_config_cpu_cache_watermark_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_cpu_cache_watermark_fail");
+
+    fiu_enable("check_config_id_cache_capacity_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_id_cache_capacity_fail");
+
     /* engine config */
     fiu_enable("check_config_use_blas_threshold_fail", 1, NULL, 0);
     s = config.ValidateConfig();
@@ -776,6 +956,36 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_omp_thread_num_fail");
 
+    fiu_enable("check_config_use_mmap_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_use_mmap_fail");
+
+    fiu_enable("check_config_search_worker_num_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_search_worker_num_fail");
+
+    fiu_enable("check_config_search_batch_max_nq_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_search_batch_max_nq_fail");
+
+    fiu_enable("check_config_search_batch_max_wait_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_search_batch_max_wait_fail");
+
+    fiu_enable("check_config_incremental_hnsw_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_incremental_hnsw_fail");
+
+    fiu_enable("check_config_shared_ivf_quantizer_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_shared_ivf_quantizer_fail");
+
 #ifdef MILVUS_GPU_VERSION
     fiu_enable("check_config_gpu_search_threshold_fail", 1, NULL, 0);
     s = config.ValidateConfig();
@@ -896,6 +1106,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_VALID_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_wal_buffer_size_fail");
 
+    fiu_enable("check_config_wal_durability_fail", 1, NULL, 0);
+    s = config.ValidateConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_wal_durability_fail");
+
     fiu_enable("check_wal_path_fail", 1, NULL, 0);
     s = config.ValidateConfig();
     ASSERT_FALSE(s.ok());
@@ -934,6 +1149,21 @@ TEST_F(ConfigTest, SERVER_CONFIG_RESET_DEFAULT_CONFIG_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_time_zone_fail");
 
+    fiu_enable("check_config_request_worker_num_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_request_worker_num_fail");
+
+    fiu_enable("check_config_dql_max_in_flight_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_dql_max_in_flight_fail");
+
+    fiu_enable("check_config_dql_max_queue_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_dql_max_queue_fail");
+
     /* db config */
     fiu_enable("check_config_primary_path_fail", 1, NULL, 0);
     s = config.ResetDefaultConfig();
@@ -970,6 +1200,21 @@ TEST_F(ConfigTest, SERVER_CONFIG_RESET_DEFAULT_CONFIG_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_auto_flush_interval_fail");
 
+    fiu_enable("check_config_merge_policy_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_merge_policy_fail");
+
+    fiu_enable("check_config_merge_io_rate_limit_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_merge_io_rate_limit_fail");
+
+    fiu_enable("check_config_meta_snapshot_interval_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_meta_snapshot_interval_fail");
+
     fiu_enable("check_config_insert_buffer_size_fail", 1, NULL, 0);
     s = config.ResetDefaultConfig();
     ASSERT_FALSE(s.ok());
@@ -1060,6 +1305,11 @@ TEST_F(ConfigTest, SERVER_CONFIG_RESET_DEFAULT_CONFIG_FAIL_TEST) {
     ASSERT_FALSE(s.ok());
     fiu_disable("check_config_wal_buffer_size_fail");
 
+    fiu_enable("check_config_wal_durability_fail", 1, NULL, 0);
+    s = config.ResetDefaultConfig();
+    ASSERT_FALSE(s.ok());
+    fiu_disable("check_config_wal_durability_fail");
+
     fiu_enable("check_wal_path_fail", 1, NULL, 0);
     s = config.ResetDefaultConfig();
     ASSERT_FALSE(s.ok());
@@ -13,7 +13,12 @@
 #include <opentracing/mocktracer/tracer.h>
 
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include "config/Config.h"
 #include "server/Server.h"
@@ -21,6 +26,7 @@
 #include "server/delivery/RequestScheduler.h"
 #include "server/delivery/request/BaseRequest.h"
 #include "server/delivery/RequestHandler.h"
+#include "server/delivery/SearchBatcher.h"
 #include "src/version.h"
 
 #include "grpc/gen-milvus/milvus.grpc.pb.h"
@@ -790,12 +796,6 @@ TEST_F(RpcSchedulerTest, BASE_TASK_TEST) {
     milvus::server::RequestScheduler::GetInstance().ExecuteRequest(base_task_ptr4);
     fiu_disable("RequestScheduler.TakeToExecute.execute_fail");
 
-    std::string dummy5 = "dql5";
-    milvus::server::BaseRequestPtr base_task_ptr5 = DummyRequest::Create(dummy5);
-    fiu_enable("RequestScheduler.PutToQueue.push_null_thread", 1, NULL, 0);
-    milvus::server::RequestScheduler::GetInstance().ExecuteRequest(base_task_ptr5);
-    fiu_disable("RequestScheduler.PutToQueue.push_null_thread");
-
     request_ptr = nullptr;
     milvus::server::RequestScheduler::GetInstance().ExecuteRequest(request_ptr);
 
@@ -813,6 +813,234 @@ TEST_F(RpcSchedulerTest, BASE_TASK_TEST) {
     milvus::server::RequestScheduler::GetInstance().Stop();
 }
 
+namespace {
+class BlockingRequest : public milvus::server::BaseRequest {
+ public:
+    BlockingRequest(const std::shared_ptr<milvus::server::Context>& context, const std::string& group,
+                    std::shared_future<void> gate, std::atomic<int64_t>& running, std::atomic<int64_t>& max_running,
+                    std::mutex& order_mutex, std::vector<int64_t>& order, int64_t no)
+        : BaseRequest(context, group, true),
+          gate_(gate),
+          running_(running),
+          max_running_(max_running),
+          order_mutex_(order_mutex),
+          order_(order),
+          no_(no) {
+    }
+
+    milvus::Status
+    OnExecute() override {
+        int64_t running = ++running_;
+        int64_t max_running = max_running_;
+        while (running > max_running && !max_running_.compare_exchange_weak(max_running, running)) {
+        }
+        {
+            std::lock_guard<std::mutex> lock(order_mutex_);
+            order_.push_back(no_);
+        }
+        gate_.wait();
+        --running_;
+        return milvus::Status::OK();
+    }
+
+ private:
+    std::shared_future<void> gate_;
+    std::atomic<int64_t>& running_;
+    std::atomic<int64_t>& max_running_;
+    std::mutex& order_mutex_;
+    std::vector<int64_t>& order_;
+    int64_t no_;
+};
+}  // namespace
+
+TEST_F(RpcSchedulerTest, GROUP_CONCURRENCY_TEST) {
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+    auto& scheduler = milvus::server::RequestScheduler::GetInstance();
+    scheduler.Stop();
+    ASSERT_TRUE(config.SetServerConfigRequestWorkerNum("4").ok());
+    ASSERT_TRUE(config.SetServerConfigDqlMaxInFlight("2").ok());
+    ASSERT_TRUE(config.SetServerConfigDqlMaxQueue("2").ok());
+    scheduler.Start();
+
+    auto context = std::make_shared<milvus::server::Context>("group_concurrency_test");
+    std::atomic<int64_t> running(0), max_running(0);
+    std::mutex order_mutex;
+    std::vector<int64_t> order;
+
+    // searches run concurrently up to dql_max_in_flight, then wait in queue up to dql_max_queue
+    std::promise<void> dql_gate;
+    std::shared_future<void> dql_future = dql_gate.get_future().share();
+    std::vector<milvus::server::BaseRequestPtr> dql_requests;
+    for (int64_t i = 0; i < 4; ++i) {
+        auto request = std::make_shared<BlockingRequest>(context, milvus::server::DQL_REQUEST_GROUP, dql_future,
+                                                         running, max_running, order_mutex, order, i);
+        dql_requests.push_back(request);
+        ASSERT_TRUE(scheduler.ExecuteRequest(request).ok());
+        if (i == 1) {
+            while (running < 2) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(running, 2);
+
+    auto rejected = std::make_shared<BlockingRequest>(context, milvus::server::DQL_REQUEST_GROUP, dql_future, running,
+                                                      max_running, order_mutex, order, 4);
+    auto status = scheduler.ExecuteRequest(rejected);
+    ASSERT_EQ(status.code(), milvus::SERVER_REQUEST_QUEUE_FULL);
+    ASSERT_EQ(rejected->WaitToFinish().code(), milvus::SERVER_REQUEST_QUEUE_FULL);
+
+    // other groups are not blocked by the searches
+    std::string info_group = milvus::server::INFO_REQUEST_GROUP;
+    milvus::server::BaseRequestPtr info_request = DummyRequest::Create(info_group);
+    ASSERT_TRUE(scheduler.ExecuteRequest(info_request).ok());
+
+    dql_gate.set_value();
+    for (auto& request : dql_requests) {
+        ASSERT_TRUE(request->WaitToFinish().ok());
+    }
+    ASSERT_EQ(max_running, 2);
+
+    // ddl/dml requests are executed one by one in arrival order
+    running = 0;
+    max_running = 0;
+    order.clear();
+    std::promise<void> ddl_gate;
+    std::shared_future<void> ddl_future = ddl_gate.get_future().share();
+    std::vector<milvus::server::BaseRequestPtr> ddl_requests;
+    for (int64_t i = 0; i < 8; ++i) {
+        auto request = std::make_shared<BlockingRequest>(context, milvus::server::DDL_DML_REQUEST_GROUP, ddl_future,
+                                                         running, max_running, order_mutex, order, i);
+        ddl_requests.push_back(request);
+        ASSERT_TRUE(scheduler.ExecuteRequest(request).ok());
+    }
+    ddl_gate.set_value();
+    for (auto& request : ddl_requests) {
+        ASSERT_TRUE(request->WaitToFinish().ok());
+    }
+    ASSERT_EQ(max_running, 1);
+    for (int64_t i = 0; i < 8; ++i) {
+        ASSERT_EQ(order[i], i);
+    }
+
+    scheduler.Stop();
+    ASSERT_FALSE(scheduler.ExecuteRequest(info_request).ok());
+
+    config.SetServerConfigRequestWorkerNum(milvus::server::CONFIG_SERVER_REQUEST_WORKER_NUM_DEFAULT);
+    config.SetServerConfigDqlMaxInFlight(milvus::server::CONFIG_SERVER_DQL_MAX_IN_FLIGHT_DEFAULT);
+    config.SetServerConfigDqlMaxQueue(milvus::server::CONFIG_SERVER_DQL_MAX_QUEUE_DEFAULT);
+    scheduler.Start();
+}
+
+TEST(SearchBatcherTest, COMBINE_TEST) {
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+    auto& batcher = milvus::server::SearchBatcher::GetInstance();
+    const int64_t topk = 2;
+
+    // the fake engine returns the query vector value and its successor as ids
+    std::atomic<int64_t> query_count(0);
+    std::atomic<bool> query_fail(false);
+    std::atomic<bool> query_throw(false);
+    auto query = [&](const milvus::engine::VectorsData& vectors, milvus::engine::ResultIds& ids,
+                     milvus::engine::ResultDistances& distances) {
+        ++query_count;
+        if (query_throw) {
+            throw std::runtime_error("query threw");
+        }
+        if (query_fail) {
+            return milvus::Status(milvus::SERVER_UNEXPECTED_ERROR, "query failed");
+        }
+        for (auto value : vectors.float_data_) {
+            ids.push_back(static_cast<int64_t>(value));
+            ids.push_back(static_cast<int64_t>(value) + 1);
+            distances.push_back(value);
+            distances.push_back(value + 1);
+        }
+        return milvus::Status::OK();
+    };
+
+    auto search = [&](const std::string& key, std::vector<float> values, milvus::engine::ResultIds& ids,
+                      milvus::engine::ResultDistances& distances) {
+        milvus::engine::VectorsData vectors;
+        vectors.vector_count_ = values.size();
+        vectors.float_data_ = values;
+        return batcher.Search(key, topk, vectors, query, ids, distances);
+    };
+
+    // disabled by default
+    milvus::engine::ResultIds ids;
+    milvus::engine::ResultDistances distances;
+    ASSERT_TRUE(search("a", {1, 2}, ids, distances).ok());
+    ASSERT_EQ(ids, milvus::engine::ResultIds({1, 2, 2, 3}));
+    ASSERT_EQ(query_count, 1);
+
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchMaxNq("8").ok());
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchMaxWait("1000").ok());
+
+    // 8 searches of nq 1 fill a batch, the leader doesn't wait until the deadline
+    const int64_t search_num = 8;
+    query_count = 0;
+    std::vector<milvus::engine::ResultIds> results(search_num);
+    std::vector<milvus::Status> statuses(search_num);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < search_num; ++i) {
+        threads.emplace_back([&, i] {
+            milvus::engine::ResultDistances result_distances;
+            statuses[i] = search("a", {static_cast<float>(i * 10)}, results[i], result_distances);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+    ASSERT_EQ(query_count, 1);
+    for (int64_t i = 0; i < search_num; ++i) {
+        ASSERT_TRUE(statuses[i].ok());
+        ASSERT_EQ(results[i], milvus::engine::ResultIds({i * 10, i * 10 + 1}));
+    }
+
+    // searches of different keys are never combined, errors are returned to every search of the batch
+    ASSERT_TRUE(config.SetEngineConfigSearchBatchMaxWait("50").ok());
+    query_count = 0;
+    query_fail = true;
+    threads.clear();
+    for (int64_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            milvus::engine::ResultDistances result_distances;
+            statuses[i] = search(i % 2 == 0 ? "a" : "b", {static_cast<float>(i)}, results[i], result_distances);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_GE(query_count, 2);
+    for (int64_t i = 0; i < 4; ++i) {
+        ASSERT_FALSE(statuses[i].ok());
+    }
+
+    // an exception thrown by the leader's query still wakes up and fails the whole batch
+    query_fail = false;
+    query_throw = true;
+    threads.clear();
+    for (int64_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            milvus::engine::ResultDistances result_distances;
+            statuses[i] = search("a", {static_cast<float>(i)}, results[i], result_distances);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int64_t i = 0; i < 4; ++i) {
+        ASSERT_FALSE(statuses[i].ok());
+    }
+
+    config.SetEngineConfigSearchBatchMaxNq(milvus::server::CONFIG_ENGINE_SEARCH_BATCH_MAX_NQ_DEFAULT);
+    config.SetEngineConfigSearchBatchMaxWait(milvus::server::CONFIG_ENGINE_SEARCH_BATCH_MAX_WAIT_DEFAULT);
+}
+
 TEST(RpcTest, RPC_SERVER_TEST) {
     using GrpcServer =  milvus::server::grpc::GrpcServer;
     GrpcServer& server = GrpcServer::GetInstance();
@@ -11,14 +11,18 @@
 
 
 #include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <cstring>
 #include <fstream>
 #include <memory>
+#include <vector>
 #include <fiu-local.h>
 #include <fiu-control.h>
 
 #include "config/Config.h"
 #include "easyloggingpp/easylogging++.h"
 #include "storage/s3/S3ClientWrapper.h"
+#include "storage/s3/S3DiskCache.h"
 #include "storage/s3/S3IOReader.h"
 #include "storage/s3/S3IOWriter.h"
 #include "storage/utils.h"
@@ -129,6 +133,118 @@ TEST_F(StorageTest, S3_RW_TEST) {
     storage_inst.StopService();
 }
 
+TEST_F(StorageTest, S3_RANGE_READ_TEST) {
+    fiu_init(0);
+
+    const std::string index_name = "/tmp/test_range_index";
+    const std::string cache_path = "/tmp/milvus_test/s3_cache";
+    const size_t chunk_size = 1024 * 1024;
+
+    milvus::server::Config& config = milvus::server::Config::GetInstance();
+    ASSERT_TRUE(config.SetStorageConfigS3ReadChunkSize("1").ok());
+    ASSERT_TRUE(config.SetStorageConfigS3ReadThreadNum("4").ok());
+
+    auto& storage_inst = milvus::storage::S3ClientWrapper::GetInstance();
+    fiu_enable("S3ClientWrapper.StartService.mock_enable", 1, NULL, 0);
+    ASSERT_TRUE(storage_inst.StartService().ok());
+    ASSERT_EQ(storage_inst.read_chunk_size(), chunk_size);
+
+    // a header followed by a body of several chunks
+    size_t body_length = chunk_size * 3 + 12345;
+    std::string content(sizeof(size_t), 0);
+    memcpy(&content[0], &body_length, sizeof(size_t));
+    for (size_t i = 0; i < body_length; ++i) {
+        content.push_back(static_cast<char>(i * 31 % 251));
+    }
+    ASSERT_TRUE(storage_inst.PutObjectStr(index_name, content).ok());
+
+    auto read_object = [&]() {
+        milvus::storage::S3IOReader reader;
+        reader.open(index_name);
+        ASSERT_EQ(reader.length(), content.length());
+
+        size_t len;
+        reader.read(&len, sizeof(len));
+        ASSERT_EQ(len, body_length);
+        // the first bytes of the body come from the read-ahead buffer
+        char head[16];
+        reader.seekg(sizeof(len));
+        reader.read(head, sizeof(head));
+        ASSERT_EQ(std::string(head, sizeof(head)), content.substr(sizeof(len), sizeof(head)));
+
+        std::vector<char> body(len);
+        reader.seekg(sizeof(len));
+        reader.read(body.data(), len);
+        ASSERT_EQ(std::string(body.data(), len), content.substr(sizeof(len)));
+        reader.close();
+    };
+
+    read_object();
+
+    {
+        milvus::storage::S3IOReader reader;
+        reader.open(index_name);
+        char data[16];
+        reader.seekg(content.length() - 8);
+        ASSERT_ANY_THROW(reader.read(data, sizeof(data)));
+
+        reader.seekg(0);
+        fiu_enable("S3ClientWrapper.GetObjectRange.outcome.fail", 1, NULL, 0);
+        ASSERT_ANY_THROW(reader.read(data, sizeof(data)));
+        fiu_disable("S3ClientWrapper.GetObjectRange.outcome.fail");
+
+        fiu_enable("S3ClientWrapper.GetObjectLength.outcome.fail", 1, NULL, 0);
+        reader.open(index_name);
+        ASSERT_EQ(reader.length(), 0);
+        fiu_disable("S3ClientWrapper.GetObjectLength.outcome.fail");
+    }
+
+    // read through the disk cache
+    auto& disk_cache = milvus::storage::S3DiskCache::GetInstance();
+    boost::filesystem::remove_all(cache_path);
+    disk_cache.Init(cache_path, 16 * chunk_size);
+    ASSERT_TRUE(disk_cache.Enabled());
+    read_object();
+    ASSERT_EQ(disk_cache.usage(), content.length());
+    {
+        milvus::storage::S3IOReader reader;
+        reader.open(index_name);
+        ASSERT_NE(reader.local_reader_, nullptr);
+        reader.close();
+    }
+
+    // a corrupted file is restored after a restart and downloaded again when its checksum mismatches
+    std::string file_path;
+    auto fail_fill = [](const std::string& path) { return milvus::Status(milvus::SERVER_UNEXPECTED_ERROR, ""); };
+    ASSERT_TRUE(disk_cache.Fetch(index_name, fail_fill, file_path).ok());
+    {
+        std::fstream file(file_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(100);
+        file.put('x');
+    }
+    disk_cache.Init(cache_path, 16 * chunk_size);
+    ASSERT_EQ(disk_cache.usage(), content.length());
+    ASSERT_FALSE(disk_cache.Fetch(index_name, fail_fill, file_path).ok());
+    ASSERT_EQ(disk_cache.usage(), 0);
+    read_object();
+    ASSERT_EQ(disk_cache.usage(), content.length());
+
+    // an overwritten object is dropped from the disk cache
+    ASSERT_TRUE(storage_inst.PutObjectStr(index_name, content).ok());
+    ASSERT_EQ(disk_cache.usage(), 0);
+
+    // an object larger than the disk cache is read from s3
+    disk_cache.set_capacity(chunk_size);
+    read_object();
+    ASSERT_EQ(disk_cache.usage(), 0);
+
+    disk_cache.Clear();
+    disk_cache.Init(cache_path, 0);
+    boost::filesystem::remove_all(cache_path);
+    ASSERT_TRUE(storage_inst.DeleteObject(index_name).ok());
+    storage_inst.StopService();
+}
+
 TEST_F(StorageTest, S3_FAIL_TEST) {
     fiu_init(0);
 
@@ -248,6 +248,44 @@ TEST_P(KnowhereWrapperTest, SERIALIZE_TEST) {
     }
 }
 
+TEST_P(KnowhereWrapperTest, BLACKLIST_TEST) {
+    if (index_type != milvus::engine::IndexType::HNSW && index_type != milvus::engine::IndexType::FAISS_IDMAP &&
+        index_type != milvus::engine::IndexType::FAISS_IVFFLAT_CPU &&
+        index_type != milvus::engine::IndexType::FAISS_IVFSQ8_CPU) {
+        return;
+    }
+
+    auto elems = nq * k;
+    std::vector<int64_t> res_ids(elems);
+    std::vector<float> res_dis(elems);
+    index_->BuildAll(nb, xb.data(), ids.data(), conf);
+
+    // the query vectors are the first base vectors, delete them and every other vector
+    auto bitset = std::make_shared<faiss::ConcurrentBitset>(nb);
+    for (auto i = 0; i < nb; ++i) {
+        if (i < nq || i % 2 == 0) {
+            bitset->set(i);
+        }
+    }
+    index_->SetBlacklist(bitset);
+    faiss::ConcurrentBitsetPtr list;
+    index_->GetBlacklist(list);
+    ASSERT_EQ(list, bitset);
+
+    index_->Search(nq, xq.data(), res_dis.data(), res_ids.data(), searchconf);
+    for (auto i = 0; i < nq; ++i) {
+        ASSERT_NE(res_ids[i * k], ids[i]);
+    }
+    int64_t found = 0;
+    for (auto id : res_ids) {
+        if (id >= 0) {
+            ASSERT_FALSE(bitset->test(id));
+            found++;
+        }
+    }
+    ASSERT_GT(found, 0);
+}
+
 // #include "wrapper/ConfAdapter.h"
 
 // TEST(whatever, test_config) {